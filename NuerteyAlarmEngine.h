@@ -0,0 +1,431 @@
+/***********************************************************************
+* @file      NuerteyAlarmEngine.h
+*
+*    Threshold alarms evaluated in the sampling path of DHT11/DHT22
+*    sensors, targetted for ARM Mbed platform.
+*
+* @brief   Keep a compact table of per-sensor alarm rules (high/low
+*          temperature and humidity, dew point approaching a surface
+*          temperature, and rate of change), each with hysteresis and a
+*          minimum duration, and evaluate them incrementally as every
+*          successful reading arrives.
+*
+* @note    Rules are compiled on entry into one signed comparison each:
+*          every condition becomes "value above raise point", with BELOW
+*          conditions negated. A rule raises once its condition has held
+*          for MinimumDurationMs (immediately, if 0) and clears once the
+*          value has come back past the threshold by HysteresisTenths.
+*          Callbacks therefore fire on the very reading that satisfies
+*          them; there is no polling.
+*
+*          Dew point is only computed, in tenths, for sensors that have a
+*          dew point rule; rates only for sensors with a rate rule. Rates
+*          are taken over the last RATE_WINDOW_SAMPLES good readings, as
+*          the DHT11's whole-unit steps make any two adjacent readings a
+*          poor slope estimate. For the same reason rate rules are not
+*          evaluated at all until that window has filled.
+*
+*          All state is fixed-size; no heap.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <array>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+
+enum class AlarmCondition_t : uint8_t
+{
+    TEMPERATURE_ABOVE,
+    TEMPERATURE_BELOW,
+    HUMIDITY_ABOVE,
+    HUMIDITY_BELOW,
+    DEW_POINT_MARGIN_BELOW,     // Surface temperature minus dew point.
+    TEMPERATURE_RATE_ABOVE,     // Magnitude, in tenths per minute.
+    HUMIDITY_RATE_ABOVE         // Magnitude, in tenths per minute.
+};
+
+struct AlarmRule_t
+{
+    PinName          SensorPin;
+    AlarmCondition_t Condition;
+    int16_t          ThresholdTenths;           // °C, %RH, °C margin, or per minute.
+    uint16_t         HysteresisTenths;
+    uint32_t         MinimumDurationMs;
+    int16_t          SurfaceTemperatureTenths;  // DEW_POINT_MARGIN_BELOW only.
+};
+
+struct AlarmEvent_t
+{
+    uint8_t          RuleId;
+    PinName          SensorPin;
+    AlarmCondition_t Condition;
+    bool             IsRaised;                  // False when the alarm clears.
+    int16_t          ValueTenths;               // The value the rule compared.
+    uint64_t         TimeUs;                    // SampleTimeUs of the reading.
+};
+
+template <std::size_t MAXIMUM_RULES = 16, std::size_t MAXIMUM_SENSORS = 8>
+class NuerteyAlarmEngine
+{
+    static_assert((MAXIMUM_RULES > 0) && (MAXIMUM_RULES <= UINT8_MAX),
+    "Hey! Rule identifiers must fit in their single byte!!");
+
+public:
+    static constexpr std::size_t RATE_WINDOW_SAMPLES = 8;
+
+    NuerteyAlarmEngine();
+
+    NuerteyAlarmEngine(const NuerteyAlarmEngine&) = delete;
+    NuerteyAlarmEngine& operator=(const NuerteyAlarmEngine&) = delete;
+
+    virtual ~NuerteyAlarmEngine();
+
+    // Returns the rule's identifier, or -1 if the table (or the sensor
+    // table, for a new sensor) is full.
+    int AddRule(const AlarmRule_t & theRule);
+    void ClearRules();
+
+    bool IsRaised(const uint8_t & theRuleId) const;
+    std::size_t GetRaisedCount() const;
+
+    // Sampling path entry point; suitable for direct registration via
+    // NuerteyDHT11Device::SetMeasurementCallback(). Only fresh, good
+    // readings are evaluated, each once (by SequenceNumber).
+    void Update(const Measurement_t & theMeasurement);
+
+    // Invoked, outside of any lock, whenever an alarm raises or clears.
+    void SetAlarmCallback(Callback<void(const AlarmEvent_t &)> theCallback);
+
+protected:
+
+private:
+    enum Quantity_t : uint8_t
+    {
+        QUANTITY_TEMPERATURE      = 0x01,
+        QUANTITY_HUMIDITY         = 0x02,
+        QUANTITY_DEW_POINT        = 0x04,
+        QUANTITY_TEMPERATURE_RATE = 0x08,
+        QUANTITY_HUMIDITY_RATE    = 0x10
+    };
+
+    struct CompiledRule_t
+    {
+        uint8_t          SensorIndex;
+        Quantity_t       Quantity;
+        AlarmCondition_t Condition;
+        int8_t           Sense;             // +1 above, -1 below.
+        int32_t          RaiseAboveTenths;  // Sense-adjusted.
+        int32_t          ClearAtTenths;     // Sense-adjusted, RaiseAbove - hysteresis.
+        int16_t          SurfaceTemperatureTenths;
+        uint64_t         MinimumDurationUs;
+        uint64_t         PendingSinceUs;
+        bool             IsPending;
+        bool             IsRaised;
+    };
+
+    struct Sample_t
+    {
+        int16_t  TemperatureTenths;
+        uint16_t HumidityTenths;
+        uint64_t TimeUs;
+    };
+
+    struct SensorState_t
+    {
+        PinName                                 SensorPin;
+        uint8_t                                 Quantities;     // Quantity_t bits any rule needs.
+        uint32_t                                LastSequenceNumber;
+        std::array<Sample_t, RATE_WINDOW_SAMPLES> Window;
+        std::size_t                             WindowCount;
+        std::size_t                             WindowNext;
+    };
+
+    static Quantity_t ToQuantity(const AlarmCondition_t & theCondition);
+    static int8_t ToSense(const AlarmCondition_t & theCondition);
+    static int32_t RatePerMinute(const int32_t & theDeltaTenths, const uint64_t & theDeltaUs);
+
+    mutable Mutex                                     m_TheAlarmMutex;
+    std::array<CompiledRule_t, MAXIMUM_RULES>         m_TheRules;
+    std::size_t                                       m_TheRuleCount;
+    std::array<SensorState_t, MAXIMUM_SENSORS>        m_TheSensors;
+    std::size_t                                       m_TheSensorCount;
+    Callback<void(const AlarmEvent_t &)>              m_TheAlarmCallback;
+};
+
+template <std::size_t MAXIMUM_RULES, std::size_t MAXIMUM_SENSORS>
+NuerteyAlarmEngine<MAXIMUM_RULES, MAXIMUM_SENSORS>::NuerteyAlarmEngine()
+    : m_TheRules{}
+    , m_TheRuleCount(0)
+    , m_TheSensors{}
+    , m_TheSensorCount(0)
+{
+}
+
+template <std::size_t MAXIMUM_RULES, std::size_t MAXIMUM_SENSORS>
+NuerteyAlarmEngine<MAXIMUM_RULES, MAXIMUM_SENSORS>::~NuerteyAlarmEngine()
+{
+}
+
+template <std::size_t MAXIMUM_RULES, std::size_t MAXIMUM_SENSORS>
+int NuerteyAlarmEngine<MAXIMUM_RULES, MAXIMUM_SENSORS>::AddRule(const AlarmRule_t & theRule)
+{
+    auto theRuleId = -1;
+
+    m_TheAlarmMutex.lock();
+
+    std::size_t theSensorIndex = 0;
+    while ((theSensorIndex < m_TheSensorCount) && (m_TheSensors[theSensorIndex].SensorPin != theRule.SensorPin))
+    {
+        ++theSensorIndex;
+    }
+
+    if ((m_TheRuleCount < MAXIMUM_RULES) && (theSensorIndex < MAXIMUM_SENSORS))
+    {
+        if (theSensorIndex == m_TheSensorCount)
+        {
+            m_TheSensors[m_TheSensorCount++] = SensorState_t{theRule.SensorPin, 0, 0, {}, 0, 0};
+        }
+
+        const auto theQuantity = ToQuantity(theRule.Condition);
+        const auto theSense = ToSense(theRule.Condition);
+        const auto theRaiseAbove = theSense * static_cast<int32_t>(theRule.ThresholdTenths);
+
+        m_TheSensors[theSensorIndex].Quantities |= theQuantity;
+        m_TheRules[m_TheRuleCount] = CompiledRule_t{static_cast<uint8_t>(theSensorIndex), theQuantity,
+                                         theRule.Condition, theSense, theRaiseAbove,
+                                         theRaiseAbove - static_cast<int32_t>(theRule.HysteresisTenths),
+                                         theRule.SurfaceTemperatureTenths,
+                                         static_cast<uint64_t>(theRule.MinimumDurationMs) * 1000U, 0, false, false};
+        theRuleId = static_cast<int>(m_TheRuleCount++);
+    }
+
+    m_TheAlarmMutex.unlock();
+
+    return theRuleId;
+}
+
+template <std::size_t MAXIMUM_RULES, std::size_t MAXIMUM_SENSORS>
+void NuerteyAlarmEngine<MAXIMUM_RULES, MAXIMUM_SENSORS>::ClearRules()
+{
+    m_TheAlarmMutex.lock();
+    m_TheRuleCount = 0;
+    m_TheSensorCount = 0;
+    m_TheAlarmMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_RULES, std::size_t MAXIMUM_SENSORS>
+bool NuerteyAlarmEngine<MAXIMUM_RULES, MAXIMUM_SENSORS>::IsRaised(const uint8_t & theRuleId) const
+{
+    m_TheAlarmMutex.lock();
+    const auto isRaised = (theRuleId < m_TheRuleCount) && m_TheRules[theRuleId].IsRaised;
+    m_TheAlarmMutex.unlock();
+
+    return isRaised;
+}
+
+template <std::size_t MAXIMUM_RULES, std::size_t MAXIMUM_SENSORS>
+std::size_t NuerteyAlarmEngine<MAXIMUM_RULES, MAXIMUM_SENSORS>::GetRaisedCount() const
+{
+    std::size_t theCount = 0;
+
+    m_TheAlarmMutex.lock();
+    for (std::size_t i = 0; i < m_TheRuleCount; ++i)
+    {
+        theCount += m_TheRules[i].IsRaised ? 1 : 0;
+    }
+    m_TheAlarmMutex.unlock();
+
+    return theCount;
+}
+
+template <std::size_t MAXIMUM_RULES, std::size_t MAXIMUM_SENSORS>
+void NuerteyAlarmEngine<MAXIMUM_RULES, MAXIMUM_SENSORS>::Update(const Measurement_t & theMeasurement)
+{
+    if ((theMeasurement.Status != SensorStatus_t::SUCCESS)
+     || (theMeasurement.SampleTimeUs != theMeasurement.CaptureTimeUs))
+    {
+        return;
+    }
+
+    std::array<AlarmEvent_t, MAXIMUM_RULES> theEvents;
+    std::size_t theEventCount = 0;
+    Callback<void(const AlarmEvent_t &)> theCallback;
+
+    m_TheAlarmMutex.lock();
+
+    std::size_t theSensorIndex = 0;
+    while ((theSensorIndex < m_TheSensorCount) && (m_TheSensors[theSensorIndex].SensorPin != theMeasurement.SensorPin))
+    {
+        ++theSensorIndex;
+    }
+
+    if ((theSensorIndex < m_TheSensorCount)
+     && (m_TheSensors[theSensorIndex].LastSequenceNumber != theMeasurement.SequenceNumber))
+    {
+        auto & theSensor = m_TheSensors[theSensorIndex];
+        const auto theNowUs = theMeasurement.SampleTimeUs;
+
+        theSensor.LastSequenceNumber = theMeasurement.SequenceNumber;
+
+        // Derive only what some rule of this sensor actually looks at.
+        int32_t theDewPointTenths = 0;
+        int32_t theTemperatureRate = 0;
+        int32_t theHumidityRate = 0;
+
+        if (theSensor.Quantities & QUANTITY_DEW_POINT)
+        {
+            // Fixed point, as in the logger, so that the sampling path
+            // stays off the FPU and 0%RH cannot yield a NaN.
+            theDewPointTenths = CalculateDewPointTenths(theMeasurement.TemperatureTenths,
+                                                        theMeasurement.HumidityTenths);
+        }
+
+        if (theSensor.Quantities & (QUANTITY_TEMPERATURE_RATE | QUANTITY_HUMIDITY_RATE))
+        {
+            theSensor.Window[theSensor.WindowNext] = Sample_t{theMeasurement.TemperatureTenths,
+                                                              theMeasurement.HumidityTenths, theNowUs};
+            theSensor.WindowNext = (theSensor.WindowNext + 1) % RATE_WINDOW_SAMPLES;
+            if (theSensor.WindowCount < RATE_WINDOW_SAMPLES)
+            {
+                ++theSensor.WindowCount;
+            }
+
+            // The oldest sample is the next one to be overwritten, once full.
+            const auto & theOldest = theSensor.Window[(theSensor.WindowCount < RATE_WINDOW_SAMPLES) ? 0 : theSensor.WindowNext];
+            if (theNowUs > theOldest.TimeUs)
+            {
+                theTemperatureRate = RatePerMinute(theMeasurement.TemperatureTenths - theOldest.TemperatureTenths,
+                                                   theNowUs - theOldest.TimeUs);
+                theHumidityRate = RatePerMinute(static_cast<int32_t>(theMeasurement.HumidityTenths) - theOldest.HumidityTenths,
+                                                theNowUs - theOldest.TimeUs);
+            }
+        }
+
+        for (std::size_t i = 0; i < m_TheRuleCount; ++i)
+        {
+            auto & theRule = m_TheRules[i];
+            if (theRule.SensorIndex != theSensorIndex)
+            {
+                continue;
+            }
+
+            // One whole-unit step across the first two readings would
+            // otherwise read as a steep slope, and trip at start-up.
+            if ((theRule.Quantity & (QUANTITY_TEMPERATURE_RATE | QUANTITY_HUMIDITY_RATE))
+             && (theSensor.WindowCount < RATE_WINDOW_SAMPLES))
+            {
+                continue;
+            }
+
+            int32_t theValue = 0;
+            switch (theRule.Quantity)
+            {
+                case QUANTITY_TEMPERATURE:      theValue = theMeasurement.TemperatureTenths;                break;
+                case QUANTITY_HUMIDITY:         theValue = theMeasurement.HumidityTenths;                   break;
+                case QUANTITY_DEW_POINT:        theValue = theRule.SurfaceTemperatureTenths - theDewPointTenths; break;
+                case QUANTITY_TEMPERATURE_RATE: theValue = std::abs(theTemperatureRate);                    break;
+                case QUANTITY_HUMIDITY_RATE:    theValue = std::abs(theHumidityRate);                       break;
+            }
+
+            const auto theSensed = theRule.Sense * theValue;
+            auto isChanged = false;
+
+            if (!theRule.IsRaised)
+            {
+                if (theSensed > theRule.RaiseAboveTenths)
+                {
+                    if (!theRule.IsPending)
+                    {
+                        theRule.IsPending = true;
+                        theRule.PendingSinceUs = theNowUs;
+                    }
+                    if ((theNowUs - theRule.PendingSinceUs) >= theRule.MinimumDurationUs)
+                    {
+                        theRule.IsRaised = true;
+                        theRule.IsPending = false;
+                        isChanged = true;
+                    }
+                }
+                else
+                {
+                    theRule.IsPending = false;
+                }
+            }
+            else if (theSensed <= theRule.ClearAtTenths)
+            {
+                theRule.IsRaised = false;
+                isChanged = true;
+            }
+
+            if (isChanged)
+            {
+                theEvents[theEventCount++] = AlarmEvent_t{static_cast<uint8_t>(i), theSensor.SensorPin,
+                                                          theRule.Condition, theRule.IsRaised,
+                                                          static_cast<int16_t>(theValue), theNowUs};
+            }
+        }
+    }
+
+    theCallback = m_TheAlarmCallback;
+
+    m_TheAlarmMutex.unlock();
+
+    if (theCallback)
+    {
+        for (std::size_t i = 0; i < theEventCount; ++i)
+        {
+            theCallback(theEvents[i]);
+        }
+    }
+}
+
+template <std::size_t MAXIMUM_RULES, std::size_t MAXIMUM_SENSORS>
+void NuerteyAlarmEngine<MAXIMUM_RULES, MAXIMUM_SENSORS>::SetAlarmCallback(Callback<void(const AlarmEvent_t &)> theCallback)
+{
+    m_TheAlarmMutex.lock();
+    m_TheAlarmCallback = theCallback;
+    m_TheAlarmMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_RULES, std::size_t MAXIMUM_SENSORS>
+typename NuerteyAlarmEngine<MAXIMUM_RULES, MAXIMUM_SENSORS>::Quantity_t
+NuerteyAlarmEngine<MAXIMUM_RULES, MAXIMUM_SENSORS>::ToQuantity(const AlarmCondition_t & theCondition)
+{
+    switch (theCondition)
+    {
+        case AlarmCondition_t::TEMPERATURE_ABOVE:
+        case AlarmCondition_t::TEMPERATURE_BELOW:      return QUANTITY_TEMPERATURE;
+        case AlarmCondition_t::HUMIDITY_ABOVE:
+        case AlarmCondition_t::HUMIDITY_BELOW:         return QUANTITY_HUMIDITY;
+        case AlarmCondition_t::DEW_POINT_MARGIN_BELOW: return QUANTITY_DEW_POINT;
+        case AlarmCondition_t::TEMPERATURE_RATE_ABOVE: return QUANTITY_TEMPERATURE_RATE;
+        case AlarmCondition_t::HUMIDITY_RATE_ABOVE:    return QUANTITY_HUMIDITY_RATE;
+    }
+
+    return QUANTITY_TEMPERATURE;
+}
+
+template <std::size_t MAXIMUM_RULES, std::size_t MAXIMUM_SENSORS>
+int8_t NuerteyAlarmEngine<MAXIMUM_RULES, MAXIMUM_SENSORS>::ToSense(const AlarmCondition_t & theCondition)
+{
+    return ((theCondition == AlarmCondition_t::TEMPERATURE_BELOW)
+         || (theCondition == AlarmCondition_t::HUMIDITY_BELOW)
+         || (theCondition == AlarmCondition_t::DEW_POINT_MARGIN_BELOW)) ? -1 : 1;
+}
+
+template <std::size_t MAXIMUM_RULES, std::size_t MAXIMUM_SENSORS>
+int32_t NuerteyAlarmEngine<MAXIMUM_RULES, MAXIMUM_SENSORS>::RatePerMinute(const int32_t & theDeltaTenths,
+                                                                         const uint64_t & theDeltaUs)
+{
+    return static_cast<int32_t>((static_cast<int64_t>(theDeltaTenths) * 60'000'000)
+                                / static_cast<int64_t>(theDeltaUs));
+}
@@ -0,0 +1,220 @@
+/***********************************************************************
+* @file      NuerteyCaptureBufferPool.h
+*
+*    Fixed pool of edge-timestamp capture buffers, leased to devices for
+*    the duration of a read.
+*
+* @brief   An edge-timestamp capture (CaptureEdgeTimestamps(), see
+*          NuerteyDHT11Protocol.h) records every level change of a frame,
+*          DATA_FRAME_EDGE_COUNT of them at 4 bytes apiece. Were each
+*          device to own such a buffer, RAM would scale with the number of
+*          sensors, whereas only as many captures as there are threads
+*          reading run at once. Devices instead lease a buffer from a pool
+*          shared by the whole array (see SetCaptureBufferPool()) and hand
+*          it back as soon as the edges are decoded, so that a 64-sensor
+*          array gets by on a handful of buffers.
+*
+*          The pool size thus also bounds how many captures may be in
+*          flight: Acquire() blocks for up to the given timeout whilst all
+*          buffers are leased, and the device reports ERROR_BUS_BUSY if it
+*          times out, before it ever touches the bus.
+*
+* @note    Leases are move-only and return their buffer upon destruction.
+*          GetHighWatermark() and GetContentionCount() help size the pool;
+*          a pool whose every lease had to wait is too small.
+*
+* @warning Thread context only; Acquire() may block on the pool's mutex.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include "mbed.h"
+#include "NuerteyDHT11Protocol.h"
+
+using EdgeTimestamps_t = std::array<uint32_t, DATA_FRAME_EDGE_COUNT>;
+
+class NuerteyCaptureBufferPool
+{
+public:
+    static constexpr std::size_t MAXIMUM_POOL_SIZE = 32; // One bit apiece of the free mask.
+
+    class Lease
+    {
+    public:
+        Lease() : m_pThePool(nullptr), m_TheIndex(0) {}
+
+        Lease(Lease && theOther)
+            : m_pThePool(theOther.m_pThePool)
+            , m_TheIndex(theOther.m_TheIndex)
+        {
+            theOther.m_pThePool = nullptr;
+        }
+
+        Lease& operator=(Lease && theOther)
+        {
+            if (this != &theOther)
+            {
+                Release();
+                m_pThePool = theOther.m_pThePool;
+                m_TheIndex = theOther.m_TheIndex;
+                theOther.m_pThePool = nullptr;
+            }
+            return *this;
+        }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        virtual ~Lease() { Release(); }
+
+        explicit operator bool() const { return (m_pThePool != nullptr); }
+
+        EdgeTimestamps_t & GetBuffer() const { return m_pThePool->m_pTheBuffers[m_TheIndex]; }
+
+        void Release()
+        {
+            if (m_pThePool != nullptr)
+            {
+                m_pThePool->Release(m_TheIndex);
+                m_pThePool = nullptr;
+            }
+        }
+
+    private:
+        friend class NuerteyCaptureBufferPool;
+
+        Lease(NuerteyCaptureBufferPool * pThePool, const std::size_t & theIndex)
+            : m_pThePool(pThePool), m_TheIndex(theIndex)
+        {
+        }
+
+        NuerteyCaptureBufferPool * m_pThePool;
+        std::size_t                m_TheIndex;
+    };
+
+    // theBuffers must outlive the pool; see NuerteyStaticCaptureBufferPool
+    // for a pool that owns them.
+    NuerteyCaptureBufferPool(EdgeTimestamps_t * theBuffers, const std::size_t & theCount)
+        : m_pTheBuffers(theBuffers)
+        , m_TheCount((theCount < MAXIMUM_POOL_SIZE) ? theCount : MAXIMUM_POOL_SIZE)
+        , m_TheFreeMask((m_TheCount == MAXIMUM_POOL_SIZE) ? UINT32_MAX : ((1u << m_TheCount) - 1))
+        , m_TheLeasedCount(0)
+        , m_TheHighWatermark(0)
+        , m_TheContentionCount(0)
+        , m_TheTimeoutCount(0)
+        , m_TheBufferReleased(m_TheMutex)
+    {
+    }
+
+    NuerteyCaptureBufferPool(const NuerteyCaptureBufferPool&) = delete;
+    NuerteyCaptureBufferPool& operator=(const NuerteyCaptureBufferPool&) = delete;
+
+    // Every lease must have been released by now.
+    virtual ~NuerteyCaptureBufferPool() = default;
+
+    // Waits up to theTimeoutMs for a free buffer; zero means do not wait.
+    // The returned lease tests false if none became free in time.
+    Lease Acquire(const uint32_t & theTimeoutMs = 0)
+    {
+        m_TheMutex.lock();
+
+        if (m_TheFreeMask == 0)
+        {
+            ++m_TheContentionCount;
+
+            // Spurious wake-ups and stolen buffers merely consume some of
+            // the timeout; measure it against the clock.
+            const auto theStartMs = Kernel::get_ms_count();
+            while (m_TheFreeMask == 0)
+            {
+                const auto theElapsedMs = static_cast<uint32_t>(Kernel::get_ms_count() - theStartMs);
+                if ((theElapsedMs >= theTimeoutMs) || m_TheBufferReleased.wait_for(theTimeoutMs - theElapsedMs))
+                {
+                    if (m_TheFreeMask != 0)
+                    {
+                        break;
+                    }
+
+                    ++m_TheTimeoutCount;
+                    m_TheMutex.unlock();
+                    return Lease();
+                }
+            }
+        }
+
+        const auto theIndex = static_cast<std::size_t>(__builtin_ctz(m_TheFreeMask));
+        m_TheFreeMask &= ~(1u << theIndex);
+
+        if (++m_TheLeasedCount > m_TheHighWatermark)
+        {
+            m_TheHighWatermark = m_TheLeasedCount;
+        }
+
+        m_TheMutex.unlock();
+        return Lease(this, theIndex);
+    }
+
+    std::size_t GetCapacity() const { return m_TheCount; }
+
+    uint32_t GetLeasedCount() const      { return Read(m_TheLeasedCount); }
+    uint32_t GetHighWatermark() const    { return Read(m_TheHighWatermark); }
+    uint32_t GetContentionCount() const  { return Read(m_TheContentionCount); } // Had to wait, or failed.
+    uint32_t GetTimeoutCount() const     { return Read(m_TheTimeoutCount); }    // Failed.
+
+private:
+    void Release(const std::size_t & theIndex)
+    {
+        m_TheMutex.lock();
+        m_TheFreeMask |= (1u << theIndex);
+        --m_TheLeasedCount;
+        m_TheBufferReleased.notify_one();
+        m_TheMutex.unlock();
+    }
+
+    uint32_t Read(const uint32_t & theCounter) const
+    {
+        m_TheMutex.lock();
+        const auto theValue = theCounter;
+        m_TheMutex.unlock();
+
+        return theValue;
+    }
+
+    EdgeTimestamps_t *   m_pTheBuffers;
+    std::size_t          m_TheCount;
+    uint32_t             m_TheFreeMask;         // Bit i set whilst buffer i is free.
+    uint32_t             m_TheLeasedCount;
+    uint32_t             m_TheHighWatermark;
+    uint32_t             m_TheContentionCount;
+    uint32_t             m_TheTimeoutCount;
+    mutable Mutex        m_TheMutex;
+    ConditionVariable    m_TheBufferReleased;
+};
+
+template <std::size_t POOL_SIZE = 4>
+class NuerteyStaticCaptureBufferPool : public NuerteyCaptureBufferPool
+{
+    static_assert((POOL_SIZE >= 1) && (POOL_SIZE <= MAXIMUM_POOL_SIZE),
+    "Hey! A capture buffer pool holds between 1 and 32 buffers!!");
+
+public:
+    // The base class only records the address of the buffers, which is
+    // valid even though they are constructed after it.
+    NuerteyStaticCaptureBufferPool()
+        : NuerteyCaptureBufferPool(m_TheBuffers.data(), POOL_SIZE)
+    {
+    }
+
+    virtual ~NuerteyStaticCaptureBufferPool() = default;
+
+private:
+    std::array<EdgeTimestamps_t, POOL_SIZE> m_TheBuffers;
+};
@@ -0,0 +1,309 @@
+/***********************************************************************
+* @file      NuerteyChangeDetector.h
+*
+*    Deadband/heartbeat change detection on the measurement stream of
+*    DHT11/DHT22 sensors, targetted for ARM Mbed platform.
+*
+* @brief   Pass on a sensor's Measurement_t only when it differs from the
+*          last one passed on by more than a configurable deadband, when
+*          its read status changes, or when a heartbeat interval has gone
+*          by without anything being passed on.
+*
+* @note    At the DHT11's 1°C/1%RH resolution, most consecutive reads in a
+*          stable room are identical. Placing this between the devices and
+*          the uplink, logger or any other consumer that wakes per reading
+*          cuts their traffic by an order of magnitude, whilst the
+*          heartbeat still proves that the sensor is alive.
+*
+*          Comparison is always against the last *emitted* values, not the
+*          last read, so that a slow drift is reported once it has
+*          accumulated past the deadband instead of never at all.
+*
+*          Sensors are tracked, by pin, from their first measurement on.
+*          The heartbeat is judged on CaptureTimeUs as measurements arrive;
+*          there is no timer of its own.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <array>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+
+// Why a measurement was emitted; any combination thereof.
+enum ChangeReason_t : uint8_t
+{
+    CHANGE_REASON_FIRST        = 0x01,  // First measurement seen from this sensor.
+    CHANGE_REASON_TEMPERATURE  = 0x02,
+    CHANGE_REASON_HUMIDITY     = 0x04,
+    CHANGE_REASON_STATUS       = 0x08,  // Read status differs, e.g. a sensor failing or recovering.
+    CHANGE_REASON_HEARTBEAT    = 0x10
+};
+
+struct ChangeEvent_t
+{
+    Measurement_t Measurement;
+    uint8_t       Reasons;              // ChangeReason_t bits.
+    uint32_t      SuppressedReadings;   // Dropped since this sensor's previous event.
+};
+
+template <std::size_t MAXIMUM_SENSORS = 8>
+class NuerteyChangeDetector
+{
+public:
+    // One step of the DHT11's resolution; as it must be exceeded, a
+    // reading flickering between two adjacent values stays quiet. DHT22
+    // users will want less.
+    static constexpr uint16_t DEFAULT_TEMPERATURE_DEADBAND_TENTHS = 10;
+    static constexpr uint16_t DEFAULT_HUMIDITY_DEADBAND_TENTHS    = 10;
+    static constexpr uint32_t DEFAULT_HEARTBEAT_MS                = 300'000;
+
+    NuerteyChangeDetector(const uint16_t & theTemperatureDeadbandTenths = DEFAULT_TEMPERATURE_DEADBAND_TENTHS,
+                          const uint16_t & theHumidityDeadbandTenths = DEFAULT_HUMIDITY_DEADBAND_TENTHS,
+                          const uint32_t & theHeartbeatMs = DEFAULT_HEARTBEAT_MS);
+
+    NuerteyChangeDetector(const NuerteyChangeDetector&) = delete;
+    NuerteyChangeDetector& operator=(const NuerteyChangeDetector&) = delete;
+
+    virtual ~NuerteyChangeDetector();
+
+    // A change is reported when it *exceeds* the deadband; 0 reports any
+    // change at all. A heartbeat of 0 disables it.
+    void SetDeadband(const uint16_t & theTemperatureTenths, const uint16_t & theHumidityTenths);
+    void SetHeartbeatMs(const uint32_t & theHeartbeatMs);
+
+    // Sampling path entry point; suitable for direct registration via
+    // NuerteyDHT11Device::SetMeasurementCallback(). Measurements already
+    // seen (same SequenceNumber) are ignored.
+    void Update(const Measurement_t & theMeasurement);
+
+    // Invoked, outside of any lock, for every measurement passed on.
+    void SetChangeCallback(Callback<void(const ChangeEvent_t &)> theCallback);
+
+    uint32_t GetEmittedCount() const;
+    uint32_t GetSuppressedCount() const;
+
+    // Readings from sensors beyond MAXIMUM_SENSORS are passed on as is,
+    // and counted here.
+    uint32_t GetUntrackedCount() const;
+
+protected:
+
+private:
+    struct SensorState_t
+    {
+        PinName        SensorPin;
+        int16_t        EmittedTemperatureTenths;
+        uint16_t       EmittedHumidityTenths;
+        SensorStatus_t EmittedStatus;
+        uint64_t       EmittedTimeUs;
+        uint32_t       LastSequenceNumber;
+        uint32_t       SuppressedReadings;
+    };
+
+    SensorState_t * FindSensor(const PinName & theSensorPin);
+
+    mutable Mutex                                     m_TheDetectorMutex;
+    std::array<SensorState_t, MAXIMUM_SENSORS>        m_TheSensors;
+    std::size_t                                       m_TheSensorCount;
+    uint16_t                                          m_TheTemperatureDeadbandTenths;
+    uint16_t                                          m_TheHumidityDeadbandTenths;
+    uint32_t                                          m_TheHeartbeatMs;
+    uint32_t                                          m_TheEmittedCount;
+    uint32_t                                          m_TheSuppressedCount;
+    uint32_t                                          m_TheUntrackedCount;
+    Callback<void(const ChangeEvent_t &)>             m_TheChangeCallback;
+};
+
+template <std::size_t MAXIMUM_SENSORS>
+NuerteyChangeDetector<MAXIMUM_SENSORS>::NuerteyChangeDetector(const uint16_t & theTemperatureDeadbandTenths,
+                                                              const uint16_t & theHumidityDeadbandTenths,
+                                                              const uint32_t & theHeartbeatMs)
+    : m_TheSensors{}
+    , m_TheSensorCount(0)
+    , m_TheTemperatureDeadbandTenths(theTemperatureDeadbandTenths)
+    , m_TheHumidityDeadbandTenths(theHumidityDeadbandTenths)
+    , m_TheHeartbeatMs(theHeartbeatMs)
+    , m_TheEmittedCount(0)
+    , m_TheSuppressedCount(0)
+    , m_TheUntrackedCount(0)
+{
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+NuerteyChangeDetector<MAXIMUM_SENSORS>::~NuerteyChangeDetector()
+{
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyChangeDetector<MAXIMUM_SENSORS>::SetDeadband(const uint16_t & theTemperatureTenths,
+                                                         const uint16_t & theHumidityTenths)
+{
+    m_TheDetectorMutex.lock();
+    m_TheTemperatureDeadbandTenths = theTemperatureTenths;
+    m_TheHumidityDeadbandTenths = theHumidityTenths;
+    m_TheDetectorMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyChangeDetector<MAXIMUM_SENSORS>::SetHeartbeatMs(const uint32_t & theHeartbeatMs)
+{
+    m_TheDetectorMutex.lock();
+    m_TheHeartbeatMs = theHeartbeatMs;
+    m_TheDetectorMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyChangeDetector<MAXIMUM_SENSORS>::Update(const Measurement_t & theMeasurement)
+{
+    ChangeEvent_t theEvent{theMeasurement, 0, 0};
+    Callback<void(const ChangeEvent_t &)> theCallback;
+
+    m_TheDetectorMutex.lock();
+
+    auto pTheSensor = FindSensor(theMeasurement.SensorPin);
+    if ((pTheSensor == nullptr) && (m_TheSensorCount < MAXIMUM_SENSORS))
+    {
+        pTheSensor = &m_TheSensors[m_TheSensorCount++];
+        *pTheSensor = SensorState_t{};
+        pTheSensor->SensorPin = theMeasurement.SensorPin;
+        theEvent.Reasons = CHANGE_REASON_FIRST;
+    }
+
+    if (pTheSensor == nullptr)
+    {
+        ++m_TheUntrackedCount;
+        theEvent.Reasons = CHANGE_REASON_FIRST;
+    }
+    else if ((theEvent.Reasons == 0) && (pTheSensor->LastSequenceNumber == theMeasurement.SequenceNumber))
+    {
+        m_TheDetectorMutex.unlock();
+        return;
+    }
+    else
+    {
+        auto & theSensor = *pTheSensor;
+
+        theSensor.LastSequenceNumber = theMeasurement.SequenceNumber;
+
+        if (theEvent.Reasons == 0)
+        {
+            if (theMeasurement.Status != theSensor.EmittedStatus)
+            {
+                theEvent.Reasons |= CHANGE_REASON_STATUS;
+            }
+
+            // A failed read merely repeats the last good values; only its
+            // status can have changed.
+            if (theMeasurement.Status == SensorStatus_t::SUCCESS)
+            {
+                if (std::abs(theMeasurement.TemperatureTenths - theSensor.EmittedTemperatureTenths)
+                    > m_TheTemperatureDeadbandTenths)
+                {
+                    theEvent.Reasons |= CHANGE_REASON_TEMPERATURE;
+                }
+                if (std::abs(static_cast<int32_t>(theMeasurement.HumidityTenths) - theSensor.EmittedHumidityTenths)
+                    > m_TheHumidityDeadbandTenths)
+                {
+                    theEvent.Reasons |= CHANGE_REASON_HUMIDITY;
+                }
+            }
+
+            if ((m_TheHeartbeatMs != 0)
+             && ((theMeasurement.CaptureTimeUs - theSensor.EmittedTimeUs) >= (static_cast<uint64_t>(m_TheHeartbeatMs) * 1000)))
+            {
+                theEvent.Reasons |= CHANGE_REASON_HEARTBEAT;
+            }
+        }
+
+        if (theEvent.Reasons != 0)
+        {
+            theEvent.SuppressedReadings = theSensor.SuppressedReadings;
+            theSensor.EmittedTemperatureTenths = theMeasurement.TemperatureTenths;
+            theSensor.EmittedHumidityTenths = theMeasurement.HumidityTenths;
+            theSensor.EmittedStatus = theMeasurement.Status;
+            theSensor.EmittedTimeUs = theMeasurement.CaptureTimeUs;
+            theSensor.SuppressedReadings = 0;
+        }
+        else
+        {
+            ++theSensor.SuppressedReadings;
+            ++m_TheSuppressedCount;
+        }
+    }
+
+    const auto isEmitted = (theEvent.Reasons != 0);
+    if (isEmitted)
+    {
+        ++m_TheEmittedCount;
+        theCallback = m_TheChangeCallback;
+    }
+
+    m_TheDetectorMutex.unlock();
+
+    if (isEmitted && theCallback)
+    {
+        theCallback(theEvent);
+    }
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyChangeDetector<MAXIMUM_SENSORS>::SetChangeCallback(Callback<void(const ChangeEvent_t &)> theCallback)
+{
+    m_TheDetectorMutex.lock();
+    m_TheChangeCallback = theCallback;
+    m_TheDetectorMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+uint32_t NuerteyChangeDetector<MAXIMUM_SENSORS>::GetEmittedCount() const
+{
+    m_TheDetectorMutex.lock();
+    const auto theCount = m_TheEmittedCount;
+    m_TheDetectorMutex.unlock();
+
+    return theCount;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+uint32_t NuerteyChangeDetector<MAXIMUM_SENSORS>::GetSuppressedCount() const
+{
+    m_TheDetectorMutex.lock();
+    const auto theCount = m_TheSuppressedCount;
+    m_TheDetectorMutex.unlock();
+
+    return theCount;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+uint32_t NuerteyChangeDetector<MAXIMUM_SENSORS>::GetUntrackedCount() const
+{
+    m_TheDetectorMutex.lock();
+    const auto theCount = m_TheUntrackedCount;
+    m_TheDetectorMutex.unlock();
+
+    return theCount;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+typename NuerteyChangeDetector<MAXIMUM_SENSORS>::SensorState_t *
+NuerteyChangeDetector<MAXIMUM_SENSORS>::FindSensor(const PinName & theSensorPin)
+{
+    for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+    {
+        if (m_TheSensors[i].SensorPin == theSensorPin)
+        {
+            return &m_TheSensors[i];
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,762 @@
+/***********************************************************************
+* @file      NuerteyCoapServer.h
+*
+*    Minimal CoAP (RFC 7252) resource server, with Observe (RFC 7641)
+*    support, for DHT11/DHT22 sensor readings targetted for ARM Mbed
+*    platform.
+*
+* @brief   Expose the cached latest Measurement_t of each registered
+*          sensor as a CoAP resource, and push notifications to
+*          observers whenever the sampling path produces a new reading.
+*
+* @note    GET requests are always answered from the cache and never
+*          trigger a bus read. However many dashboard clients poll the
+*          node, the sensors are still only read at the cadence of the
+*          sampling loop, which the 1-2 second sensor cooldown dictates
+*          anyway.
+*
+*          Every buffer (datagrams, encoded payloads, observer table) is
+*          preallocated within the server object, and deferred work is
+*          posted to an EventQueue whose event storage is likewise
+*          preallocated. Serving a request costs no heap allocations.
+*
+*          Supported:
+*            - GET on "<path>" -> 2.05 Content, application/json
+*              e.g. {"t":23.5,"h":41.0,"s":0}
+*            - GET with Observe=0 / Observe=1 to (de)register
+*            - GET on ".well-known/core" -> link-format discovery
+*            - RST on a notification deregisters that observer
+*            - CoAP ping (empty CON) -> RST
+*
+*          Notifications are sent as NON messages. Anything else is
+*          answered with 4.05 Method Not Allowed or 4.04 Not Found.
+*          Requests carrying a critical option that we do not implement
+*          (odd option number) are answered with 4.02 Bad Option if
+*          confirmable and otherwise ignored, per RFC 7252 section 5.4.1;
+*          unknown elective options are simply ignored.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <array>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+
+template <std::size_t MAXIMUM_RESOURCES = 8, std::size_t MAXIMUM_OBSERVERS = 8>
+class NuerteyCoapServer
+{
+    static_assert((MAXIMUM_RESOURCES > 0) && (MAXIMUM_RESOURCES <= 32),
+    "Hey! Pending notifications are tracked in a 32-bit mask; keep MAXIMUM_RESOURCES within 1..32!!");
+
+public:
+    static constexpr uint16_t    COAP_DEFAULT_PORT            = 5683;
+    static constexpr std::size_t MAXIMUM_DATAGRAM_SIZE_BYTES  = 128;
+    static constexpr std::size_t MAXIMUM_PAYLOAD_SIZE_BYTES   = 40;
+    static constexpr std::size_t MAXIMUM_PATH_SIZE_BYTES      = 32;
+    static constexpr std::size_t MAXIMUM_TOKEN_SIZE_BYTES     = 8;
+
+    NuerteyCoapServer(NetworkInterface * theNetworkInterface, EventQueue & theEventQueue);
+
+    NuerteyCoapServer(const NuerteyCoapServer&) = delete;
+    NuerteyCoapServer& operator=(const NuerteyCoapServer&) = delete;
+
+    virtual ~NuerteyCoapServer();
+
+    [[nodiscard]] nsapi_error_t Start(const uint16_t & thePort = COAP_DEFAULT_PORT);
+    void Stop();
+
+    // thePath must have static storage duration, e.g. "dht/0", and must
+    // not carry a leading '/'. Returns false when the table is full.
+    bool AddResource(const char * thePath, const PinName & theSensorPin);
+
+    // Sampling path entry point; suitable for direct registration via
+    // NuerteyDHT11Device::SetMeasurementCallback(). Caches the reading
+    // and schedules observer notifications on the event queue.
+    void Update(const Measurement_t & theMeasurement);
+
+protected:
+
+private:
+    // CoAP message types, codes and option numbers we deal with.
+    static constexpr uint8_t  COAP_VERSION                 = 1;
+    static constexpr uint8_t  COAP_TYPE_CON                = 0;
+    static constexpr uint8_t  COAP_TYPE_NON                = 1;
+    static constexpr uint8_t  COAP_TYPE_ACK                = 2;
+    static constexpr uint8_t  COAP_TYPE_RST                = 3;
+    static constexpr uint8_t  COAP_CODE_EMPTY              = 0x00;
+    static constexpr uint8_t  COAP_CODE_GET                = 0x01;
+    static constexpr uint8_t  COAP_CODE_CONTENT            = 0x45; // 2.05
+    static constexpr uint8_t  COAP_CODE_BAD_OPTION         = 0x82; // 4.02
+    static constexpr uint8_t  COAP_CODE_NOT_FOUND          = 0x84; // 4.04
+    static constexpr uint8_t  COAP_CODE_METHOD_NOT_ALLOWED = 0x85; // 4.05
+    static constexpr uint16_t COAP_OPTION_URI_HOST         = 3;
+    static constexpr uint16_t COAP_OPTION_OBSERVE          = 6;
+    static constexpr uint16_t COAP_OPTION_URI_PORT         = 7;
+    static constexpr uint16_t COAP_OPTION_URI_PATH         = 11;
+    static constexpr uint16_t COAP_OPTION_CONTENT_FORMAT   = 12;
+    static constexpr uint8_t  COAP_FORMAT_LINK             = 40;
+    static constexpr uint8_t  COAP_FORMAT_JSON             = 50;
+    static constexpr uint8_t  COAP_PAYLOAD_MARKER          = 0xFF;
+    // Header, longest token, two options and the payload marker.
+    static constexpr std::size_t COAP_MAXIMUM_OVERHEAD_BYTES = 4 + MAXIMUM_TOKEN_SIZE_BYTES + 4 + 2 + 1;
+    static constexpr uint32_t COAP_OBSERVE_SEQUENCE_MASK   = 0x00FFFFFF;
+    static constexpr uint32_t COAP_OBSERVE_NONE            = 0xFFFFFFFF;
+
+    using Datagram_t = std::array<uint8_t, MAXIMUM_DATAGRAM_SIZE_BYTES>;
+
+    struct Resource_t
+    {
+        const char *    Path;
+        PinName         SensorPin;
+        bool            Valid;
+        uint32_t        ObserveSequence;
+        uint8_t         PayloadLength;
+        char            Payload[MAXIMUM_PAYLOAD_SIZE_BYTES];
+    };
+
+    struct Observer_t
+    {
+        bool            InUse;
+        uint8_t         ResourceIndex;
+        uint8_t         TokenLength;
+        uint8_t         Token[MAXIMUM_TOKEN_SIZE_BYTES];
+        uint16_t        LastMessageId;
+        SocketAddress   Peer;
+    };
+
+    struct Request_t
+    {
+        uint8_t         Type;
+        uint8_t         Code;
+        uint16_t        MessageId;
+        uint8_t         TokenLength;
+        const uint8_t * Token;
+        uint32_t        Observe;
+        bool            HasUnknownCriticalOption;
+        char            Path[MAXIMUM_PATH_SIZE_BYTES];
+    };
+
+    void OnSocketEvent();
+    void ProcessIncoming();
+    void NotifyPending();
+
+    bool ParseRequest(const uint8_t * theBuffer, const std::size_t & theLength, Request_t & theRequest);
+    void HandleRequest(const SocketAddress & thePeer, const Request_t & theRequest);
+    bool RegisterObserver(const SocketAddress & thePeer, const Request_t & theRequest, const uint8_t & theIndex);
+    void DeregisterObserver(const SocketAddress & thePeer, const Request_t & theRequest);
+
+    int FindResource(const char * thePath) const;
+    int FindResource(const PinName & theSensorPin) const;
+    std::size_t EncodeDiscovery(char * theBuffer, const std::size_t & theSize) const;
+    static std::size_t EncodeMeasurement(char * theBuffer, const std::size_t & theSize,
+                                         const Measurement_t & theMeasurement);
+
+    std::size_t BeginMessage(const uint8_t & theType, const uint8_t & theCode, const uint16_t & theMessageId,
+                             const uint8_t * theToken, const uint8_t & theTokenLength);
+    std::size_t AppendOption(std::size_t thePosition, uint16_t & theLastOption,
+                             const uint16_t & theOption, const uint32_t & theValue);
+    std::size_t AppendPayload(std::size_t thePosition, const char * thePayload, const std::size_t & theLength);
+
+    NetworkInterface *                          m_pTheNetworkInterface;
+    EventQueue &                                m_TheEventQueue;
+    UDPSocket                                   m_TheSocket;
+    Mutex                                       m_TheResourceMutex;
+    std::array<Resource_t, MAXIMUM_RESOURCES>   m_TheResources;
+    std::array<Observer_t, MAXIMUM_OBSERVERS>   m_TheObservers;
+    std::size_t                                 m_TheResourceCount;
+    uint32_t                                    m_ThePendingNotifications;
+    uint16_t                                    m_TheNextMessageId;
+    bool                                        m_IsStarted;
+    Datagram_t                                  m_TheReceiveBuffer;
+    Datagram_t                                  m_TheSendBuffer;
+    char                                        m_TheScratchPayload[MAXIMUM_DATAGRAM_SIZE_BYTES];
+};
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::NuerteyCoapServer(NetworkInterface * theNetworkInterface,
+                                                                           EventQueue & theEventQueue)
+    : m_pTheNetworkInterface(theNetworkInterface)
+    , m_TheEventQueue(theEventQueue)
+    , m_TheResources{}
+    , m_TheObservers{}
+    , m_TheResourceCount(0)
+    , m_ThePendingNotifications(0)
+    , m_TheNextMessageId(static_cast<uint16_t>(us_ticker_read()))
+    , m_IsStarted(false)
+    , m_TheReceiveBuffer{}
+    , m_TheSendBuffer{}
+    , m_TheScratchPayload{}
+{
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::~NuerteyCoapServer()
+{
+    Stop();
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+nsapi_error_t NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::Start(const uint16_t & thePort)
+{
+    if (m_pTheNetworkInterface == nullptr)
+    {
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    auto result = m_TheSocket.open(m_pTheNetworkInterface);
+    if (result != NSAPI_ERROR_OK)
+    {
+        return result;
+    }
+
+    result = m_TheSocket.bind(thePort);
+    if (result != NSAPI_ERROR_OK)
+    {
+        m_TheSocket.close();
+        return result;
+    }
+
+    m_TheSocket.set_blocking(false);
+    m_TheSocket.sigio(callback(this, &NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::OnSocketEvent));
+    m_IsStarted = true;
+
+    return NSAPI_ERROR_OK;
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+void NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::Stop()
+{
+    if (m_IsStarted)
+    {
+        m_TheSocket.sigio(nullptr);
+        m_TheSocket.close();
+        m_IsStarted = false;
+    }
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+bool NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::AddResource(const char * thePath,
+                                                                          const PinName & theSensorPin)
+{
+    if ((thePath == nullptr) || (strlen(thePath) >= MAXIMUM_PATH_SIZE_BYTES))
+    {
+        return false;
+    }
+
+    m_TheResourceMutex.lock();
+
+    auto added = false;
+    if (m_TheResourceCount < MAXIMUM_RESOURCES)
+    {
+        auto & theResource = m_TheResources[m_TheResourceCount];
+        theResource.Path = thePath;
+        theResource.SensorPin = theSensorPin;
+        theResource.Valid = false;
+        theResource.ObserveSequence = 0;
+        theResource.PayloadLength = 0;
+        ++m_TheResourceCount;
+        added = true;
+    }
+
+    m_TheResourceMutex.unlock();
+
+    return added;
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+void NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::Update(const Measurement_t & theMeasurement)
+{
+    m_TheResourceMutex.lock();
+
+    auto index = FindResource(theMeasurement.SensorPin);
+    if (index >= 0)
+    {
+        // Encode once here, so that however many GETs and notifications
+        // follow, they merely copy the preformatted bytes.
+        auto & theResource = m_TheResources[index];
+        theResource.PayloadLength = static_cast<uint8_t>(EncodeMeasurement(theResource.Payload,
+                                                         sizeof(theResource.Payload), theMeasurement));
+        theResource.Valid = true;
+        theResource.ObserveSequence = (theResource.ObserveSequence + 1) & COAP_OBSERVE_SEQUENCE_MASK;
+        m_ThePendingNotifications |= (1UL << index);
+    }
+
+    m_TheResourceMutex.unlock();
+
+    if (index >= 0)
+    {
+        // Never send from the sampling thread. Should the queue be out of
+        // event storage the pending bit persists, so the next Update()
+        // (or one already queued) picks it up.
+        (void)m_TheEventQueue.call(this, &NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::NotifyPending);
+    }
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+void NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::OnSocketEvent()
+{
+    // sigio() is invoked from the network stack's context; defer.
+    (void)m_TheEventQueue.call(this, &NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::ProcessIncoming);
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+void NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::ProcessIncoming()
+{
+    SocketAddress thePeer;
+    Request_t theRequest;
+
+    while (m_IsStarted)
+    {
+        auto theLength = m_TheSocket.recvfrom(&thePeer, m_TheReceiveBuffer.data(), m_TheReceiveBuffer.size());
+        if (theLength <= 0)
+        {
+            break; // NSAPI_ERROR_WOULD_BLOCK; drained.
+        }
+
+        if (ParseRequest(m_TheReceiveBuffer.data(), static_cast<std::size_t>(theLength), theRequest))
+        {
+            HandleRequest(thePeer, theRequest);
+        }
+    }
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+void NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::NotifyPending()
+{
+    m_TheResourceMutex.lock();
+    auto thePending = m_ThePendingNotifications;
+    m_ThePendingNotifications = 0;
+    m_TheResourceMutex.unlock();
+
+    for (auto & theObserver : m_TheObservers)
+    {
+        if (!theObserver.InUse || !(thePending & (1UL << theObserver.ResourceIndex)))
+        {
+            continue;
+        }
+
+        theObserver.LastMessageId = m_TheNextMessageId++;
+        auto position = BeginMessage(COAP_TYPE_NON, COAP_CODE_CONTENT, theObserver.LastMessageId,
+                                     theObserver.Token, theObserver.TokenLength);
+        uint16_t theLastOption = 0;
+
+        m_TheResourceMutex.lock();
+        const auto & theResource = m_TheResources[theObserver.ResourceIndex];
+        position = AppendOption(position, theLastOption, COAP_OPTION_OBSERVE, theResource.ObserveSequence);
+        position = AppendOption(position, theLastOption, COAP_OPTION_CONTENT_FORMAT, COAP_FORMAT_JSON);
+        position = AppendPayload(position, theResource.Payload, theResource.PayloadLength);
+        m_TheResourceMutex.unlock();
+
+        (void)m_TheSocket.sendto(theObserver.Peer, m_TheSendBuffer.data(), position);
+    }
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+bool NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::ParseRequest(const uint8_t * theBuffer,
+                                                                           const std::size_t & theLength,
+                                                                           Request_t & theRequest)
+{
+    if (theLength < 4)
+    {
+        return false;
+    }
+
+    theRequest.Type        = (theBuffer[0] >> 4) & 0x03;
+    theRequest.TokenLength = theBuffer[0] & 0x0F;
+    theRequest.Code        = theBuffer[1];
+    theRequest.MessageId   = static_cast<uint16_t>((theBuffer[2] << 8) | theBuffer[3]);
+    theRequest.Token       = &theBuffer[4];
+    theRequest.Observe     = COAP_OBSERVE_NONE;
+    theRequest.HasUnknownCriticalOption = false;
+    theRequest.Path[0]     = '\0';
+
+    // Silently ignore what we cannot even attribute to a request.
+    if (((theBuffer[0] >> 6) != COAP_VERSION)
+     || (theRequest.TokenLength > MAXIMUM_TOKEN_SIZE_BYTES)
+     || ((4U + theRequest.TokenLength) > theLength))
+    {
+        return false;
+    }
+
+    std::size_t position = 4 + theRequest.TokenLength;
+    std::size_t thePathLength = 0;
+    uint16_t theOption = 0;
+
+    while ((position < theLength) && (theBuffer[position] != COAP_PAYLOAD_MARKER))
+    {
+        uint32_t delta  = theBuffer[position] >> 4;
+        uint32_t length = theBuffer[position] & 0x0F;
+        ++position;
+
+        // Resolve the extended delta then length nibbles, in that order.
+        for (auto pNibble : {&delta, &length})
+        {
+            if (*pNibble == 13)
+            {
+                if (position >= theLength) return false;
+                *pNibble = theBuffer[position++] + 13U;
+            }
+            else if (*pNibble == 14)
+            {
+                if ((position + 1) >= theLength) return false;
+                *pNibble = ((theBuffer[position] << 8) | theBuffer[position + 1]) + 269U;
+                position += 2;
+            }
+            else if (*pNibble == 15)
+            {
+                return false;
+            }
+        }
+
+        if ((position + length) > theLength)
+        {
+            return false;
+        }
+
+        theOption = static_cast<uint16_t>(theOption + delta);
+
+        if (theOption == COAP_OPTION_URI_PATH)
+        {
+            // Reassemble the segments as "a/b/c"; paths too long for any
+            // of our resources simply will not match.
+            auto theSeparator = (thePathLength > 0) ? 1U : 0U;
+            if ((thePathLength + theSeparator + length) < MAXIMUM_PATH_SIZE_BYTES)
+            {
+                if (theSeparator)
+                {
+                    theRequest.Path[thePathLength++] = '/';
+                }
+                memcpy(&theRequest.Path[thePathLength], &theBuffer[position], length);
+                thePathLength += length;
+                theRequest.Path[thePathLength] = '\0';
+            }
+            else
+            {
+                theRequest.Path[0] = '\0';
+                thePathLength = MAXIMUM_PATH_SIZE_BYTES;
+            }
+        }
+        else if ((theOption == COAP_OPTION_OBSERVE) && (length <= 3))
+        {
+            theRequest.Observe = 0;
+            for (uint32_t k = 0; k < length; ++k)
+            {
+                theRequest.Observe = (theRequest.Observe << 8) | theBuffer[position + k];
+            }
+        }
+        else if ((theOption & 0x01) && (theOption != COAP_OPTION_URI_HOST) && (theOption != COAP_OPTION_URI_PORT))
+        {
+            // Critical, and not one we implement. Uri-Host and Uri-Port
+            // only ever name this very endpoint, hence are understood.
+            theRequest.HasUnknownCriticalOption = true;
+        }
+
+        position += length;
+    }
+
+    return true;
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+void NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::HandleRequest(const SocketAddress & thePeer,
+                                                                            const Request_t & theRequest)
+{
+    if (theRequest.Type == COAP_TYPE_RST)
+    {
+        // The observer rejected a notification; forget about it.
+        DeregisterObserver(thePeer, theRequest);
+        return;
+    }
+
+    if ((theRequest.Type == COAP_TYPE_ACK) || ((theRequest.Type == COAP_TYPE_NON) && (theRequest.Code == COAP_CODE_EMPTY)))
+    {
+        return;
+    }
+
+    if (theRequest.Code == COAP_CODE_EMPTY)
+    {
+        // CoAP ping.
+        auto position = BeginMessage(COAP_TYPE_RST, COAP_CODE_EMPTY, theRequest.MessageId, nullptr, 0);
+        (void)m_TheSocket.sendto(thePeer, m_TheSendBuffer.data(), position);
+        return;
+    }
+
+    // A NON request is rejected, i.e. silently ignored, rather than
+    // served with the option misunderstood.
+    if (theRequest.HasUnknownCriticalOption && (theRequest.Type != COAP_TYPE_CON))
+    {
+        return;
+    }
+
+    // Piggyback the response onto the ACK of a confirmable request.
+    auto theType = (theRequest.Type == COAP_TYPE_CON) ? COAP_TYPE_ACK : COAP_TYPE_NON;
+    auto theMessageId = (theRequest.Type == COAP_TYPE_CON) ? theRequest.MessageId : m_TheNextMessageId++;
+    uint16_t theLastOption = 0;
+    std::size_t position = 0;
+
+    if (theRequest.HasUnknownCriticalOption)
+    {
+        position = BeginMessage(theType, COAP_CODE_BAD_OPTION, theMessageId,
+                                theRequest.Token, theRequest.TokenLength);
+    }
+    else if (theRequest.Code != COAP_CODE_GET)
+    {
+        position = BeginMessage(theType, COAP_CODE_METHOD_NOT_ALLOWED, theMessageId,
+                                theRequest.Token, theRequest.TokenLength);
+    }
+    else if (strcmp(theRequest.Path, ".well-known/core") == 0)
+    {
+        auto theLength = EncodeDiscovery(m_TheScratchPayload,
+                                         sizeof(m_TheScratchPayload) - COAP_MAXIMUM_OVERHEAD_BYTES);
+        position = BeginMessage(theType, COAP_CODE_CONTENT, theMessageId,
+                                theRequest.Token, theRequest.TokenLength);
+        position = AppendOption(position, theLastOption, COAP_OPTION_CONTENT_FORMAT, COAP_FORMAT_LINK);
+        position = AppendPayload(position, m_TheScratchPayload, theLength);
+    }
+    else
+    {
+        m_TheResourceMutex.lock();
+        auto index = FindResource(theRequest.Path);
+        auto isValid = (index >= 0) && m_TheResources[index].Valid;
+        m_TheResourceMutex.unlock();
+
+        if (index < 0)
+        {
+            position = BeginMessage(theType, COAP_CODE_NOT_FOUND, theMessageId,
+                                    theRequest.Token, theRequest.TokenLength);
+        }
+        else
+        {
+            auto isObserving = false;
+            if (theRequest.Observe == 0)
+            {
+                isObserving = RegisterObserver(thePeer, theRequest, static_cast<uint8_t>(index));
+            }
+            else if (theRequest.Observe == 1)
+            {
+                DeregisterObserver(thePeer, theRequest);
+            }
+
+            position = BeginMessage(theType, COAP_CODE_CONTENT, theMessageId,
+                                    theRequest.Token, theRequest.TokenLength);
+
+            m_TheResourceMutex.lock();
+            const auto & theResource = m_TheResources[index];
+            if (isObserving)
+            {
+                position = AppendOption(position, theLastOption, COAP_OPTION_OBSERVE, theResource.ObserveSequence);
+            }
+            position = AppendOption(position, theLastOption, COAP_OPTION_CONTENT_FORMAT, COAP_FORMAT_JSON);
+            if (isValid)
+            {
+                position = AppendPayload(position, theResource.Payload, theResource.PayloadLength);
+            }
+            m_TheResourceMutex.unlock();
+        }
+    }
+
+    (void)m_TheSocket.sendto(thePeer, m_TheSendBuffer.data(), position);
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+bool NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::RegisterObserver(const SocketAddress & thePeer,
+                                                                               const Request_t & theRequest,
+                                                                               const uint8_t & theIndex)
+{
+    Observer_t * pTheSlot = nullptr;
+
+    // A re-registration (same endpoint and token) replaces the original.
+    for (auto & theObserver : m_TheObservers)
+    {
+        if (theObserver.InUse && (theObserver.Peer == thePeer)
+         && (theObserver.TokenLength == theRequest.TokenLength)
+         && (memcmp(theObserver.Token, theRequest.Token, theRequest.TokenLength) == 0))
+        {
+            pTheSlot = &theObserver;
+            break;
+        }
+
+        if (!theObserver.InUse && (pTheSlot == nullptr))
+        {
+            pTheSlot = &theObserver;
+        }
+    }
+
+    // Per RFC 7641, when we cannot accommodate an observer we merely
+    // answer the GET; the absent Observe option tells the client so.
+    if (pTheSlot == nullptr)
+    {
+        return false;
+    }
+    else
+    {
+        pTheSlot->InUse = true;
+        pTheSlot->ResourceIndex = theIndex;
+        pTheSlot->TokenLength = theRequest.TokenLength;
+        memcpy(pTheSlot->Token, theRequest.Token, theRequest.TokenLength);
+        pTheSlot->LastMessageId = theRequest.MessageId;
+        pTheSlot->Peer = thePeer;
+    }
+
+    return true;
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+void NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::DeregisterObserver(const SocketAddress & thePeer,
+                                                                                 const Request_t & theRequest)
+{
+    for (auto & theObserver : m_TheObservers)
+    {
+        if (!theObserver.InUse || !(theObserver.Peer == thePeer))
+        {
+            continue;
+        }
+
+        // A RST echoes the message ID of our notification; an explicit
+        // deregistration carries the token of the original registration.
+        auto isMatch = (theRequest.Type == COAP_TYPE_RST)
+                     ? (theObserver.LastMessageId == theRequest.MessageId)
+                     : ((theObserver.TokenLength == theRequest.TokenLength)
+                     && (memcmp(theObserver.Token, theRequest.Token, theRequest.TokenLength) == 0));
+
+        if (isMatch)
+        {
+            theObserver.InUse = false;
+        }
+    }
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+int NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::FindResource(const char * thePath) const
+{
+    for (std::size_t i = 0; i < m_TheResourceCount; ++i)
+    {
+        if (strcmp(m_TheResources[i].Path, thePath) == 0)
+        {
+            return static_cast<int>(i);
+        }
+    }
+
+    return -1;
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+int NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::FindResource(const PinName & theSensorPin) const
+{
+    for (std::size_t i = 0; i < m_TheResourceCount; ++i)
+    {
+        if (m_TheResources[i].SensorPin == theSensorPin)
+        {
+            return static_cast<int>(i);
+        }
+    }
+
+    return -1;
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+std::size_t NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::EncodeDiscovery(char * theBuffer,
+                                                                                    const std::size_t & theSize) const
+{
+    std::size_t position = 0;
+
+    // Resource paths are immutable once added, so no lock is required.
+    for (std::size_t i = 0; i < m_TheResourceCount; ++i)
+    {
+        auto written = snprintf(&theBuffer[position], theSize - position, "%s</%s>;obs;ct=%u",
+                                (i > 0) ? "," : "", m_TheResources[i].Path, COAP_FORMAT_JSON);
+
+        if ((written < 0) || (static_cast<std::size_t>(written) >= (theSize - position)))
+        {
+            break; // Truncate the listing at the last complete entry.
+        }
+        position += static_cast<std::size_t>(written);
+    }
+
+    return position;
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+std::size_t NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::EncodeMeasurement(char * theBuffer,
+                                                           const std::size_t & theSize,
+                                                           const Measurement_t & theMeasurement)
+{
+    // Integer-only formatting of the fixed-point values; no float printf.
+    auto t = static_cast<int>(theMeasurement.TemperatureTenths);
+    auto h = static_cast<int>(theMeasurement.HumidityTenths);
+
+    auto written = snprintf(theBuffer, theSize, "{\"t\":%s%d.%d,\"h\":%d.%d,\"s\":%d}",
+                            (t < 0) ? "-" : "", abs(t) / 10, abs(t) % 10, h / 10, h % 10,
+                            ToUnderlyingType(theMeasurement.Status));
+
+    return ((written < 0) ? 0 : std::min(static_cast<std::size_t>(written), theSize - 1));
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+std::size_t NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::BeginMessage(const uint8_t & theType,
+                                                                                 const uint8_t & theCode,
+                                                                                 const uint16_t & theMessageId,
+                                                                                 const uint8_t * theToken,
+                                                                                 const uint8_t & theTokenLength)
+{
+    m_TheSendBuffer[0] = static_cast<uint8_t>((COAP_VERSION << 6) | (theType << 4) | theTokenLength);
+    m_TheSendBuffer[1] = theCode;
+    m_TheSendBuffer[2] = static_cast<uint8_t>(theMessageId >> 8);
+    m_TheSendBuffer[3] = static_cast<uint8_t>(theMessageId & 0xFF);
+
+    if (theTokenLength > 0)
+    {
+        memcpy(&m_TheSendBuffer[4], theToken, theTokenLength);
+    }
+
+    return (4U + theTokenLength);
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+std::size_t NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::AppendOption(std::size_t thePosition,
+                                                                                 uint16_t & theLastOption,
+                                                                                 const uint16_t & theOption,
+                                                                                 const uint32_t & theValue)
+{
+    // Options must be appended in ascending order. The few we emit all
+    // have small deltas (< 13), and uint values of at most 3 bytes,
+    // encoded minimally (zero is encoded as an empty value).
+    uint8_t theLength = (theValue == 0) ? 0 : (theValue <= 0xFF) ? 1 : (theValue <= 0xFFFF) ? 2 : 3;
+
+    m_TheSendBuffer[thePosition++] = static_cast<uint8_t>(((theOption - theLastOption) << 4) | theLength);
+    for (auto k = theLength; k > 0; --k)
+    {
+        m_TheSendBuffer[thePosition++] = static_cast<uint8_t>((theValue >> (8 * (k - 1))) & 0xFF);
+    }
+
+    theLastOption = theOption;
+
+    return thePosition;
+}
+
+template <std::size_t MAXIMUM_RESOURCES, std::size_t MAXIMUM_OBSERVERS>
+std::size_t NuerteyCoapServer<MAXIMUM_RESOURCES, MAXIMUM_OBSERVERS>::AppendPayload(std::size_t thePosition,
+                                                                                  const char * thePayload,
+                                                                                  const std::size_t & theLength)
+{
+    if ((theLength == 0) || ((thePosition + 1 + theLength) > m_TheSendBuffer.size()))
+    {
+        return thePosition;
+    }
+
+    m_TheSendBuffer[thePosition++] = COAP_PAYLOAD_MARKER;
+    memcpy(&m_TheSendBuffer[thePosition], thePayload, theLength);
+
+    return (thePosition + theLength);
+}
@@ -0,0 +1,359 @@
+/***********************************************************************
+* @file      NuerteyCondensationPredictor.h
+*
+*    Condensation-risk forecasting from the dew point trend of a DHT11/
+*    DHT22 sensor, targetted for ARM Mbed platform.
+*
+* @brief   Track the dew point and air temperature of one enclosure over a
+*          sliding window, fit a straight line to each, and extrapolate
+*          when the dew point will reach the temperature of the coldest
+*          surface inside. Warn once that is within a configured lead time,
+*          so that heaters can be switched on before any water forms.
+*
+* @note    The surface temperature is either fixed (e.g. a chilled plate)
+*          or follows the air at a fixed offset (e.g. a wall that runs a
+*          few degrees colder); in the latter case the air temperature
+*          trend enters the forecast too.
+*
+*          The regression sums are kept exactly in 64-bit integers, with
+*          times in milliseconds relative to a base that is moved forward
+*          now and then, and are updated in O(1) per sample as samples
+*          enter and leave the ring. Only the final slopes are floating
+*          point.
+*
+*          A forecast is produced from MINIMUM_SAMPLES on. Until then, and
+*          whenever the margin is not shrinking, the time to condensation
+*          is reported as NEVER_SECONDS.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <array>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+
+struct CondensationForecast_t
+{
+    int16_t     DewPointTenths;             // Fitted, at the latest sample.
+    int16_t     SurfaceTemperatureTenths;   // At the latest sample.
+    int16_t     MarginTenths;               // Surface minus dew point; <= 0 means condensing.
+    int16_t     MarginSlopeTenthsPerHour;   // Negative whilst closing in.
+    uint32_t    SecondsToCondensation;      // 0 if already there; NEVER_SECONDS if not converging.
+    uint64_t    TimeUs;                     // SampleTimeUs of the latest sample.
+    bool        IsWarning;                  // Within the configured lead time.
+    bool        IsValid;
+};
+
+template <std::size_t WINDOW_SAMPLES = 32>
+class NuerteyCondensationPredictor
+{
+    static_assert((WINDOW_SAMPLES >= 4) && (WINDOW_SAMPLES <= 32),
+    "Hey! A trend needs a handful of samples, and the sums need bounding!!");
+
+public:
+    static constexpr uint32_t    NEVER_SECONDS          = UINT32_MAX;
+    static constexpr std::size_t MINIMUM_SAMPLES        = (WINDOW_SAMPLES / 2);
+    static constexpr uint32_t    DEFAULT_LEAD_SECONDS   = 900;
+
+    // A gap longer than this between samples makes the trend so stale
+    // that the window is started afresh. Together with the window size,
+    // it bounds the window's span below MAXIMUM_RELATIVE_MS, and relative
+    // times below that bound every sum (and n times it) within 64 bits.
+    static constexpr uint64_t    MAXIMUM_GAP_US         = 600'000'000;
+    static constexpr int64_t     MAXIMUM_RELATIVE_MS    = (1LL << 26);
+
+    NuerteyCondensationPredictor(const PinName & theSensorPin, const int16_t & theSurfaceTemperatureTenths);
+
+    NuerteyCondensationPredictor(const NuerteyCondensationPredictor&) = delete;
+    NuerteyCondensationPredictor& operator=(const NuerteyCondensationPredictor&) = delete;
+
+    virtual ~NuerteyCondensationPredictor();
+
+    void SetSurfaceTemperature(const int16_t & theTemperatureTenths);
+    // Surface = air temperature - theOffsetTenths, for each sample.
+    void SetSurfaceOffsetFromAir(const int16_t & theOffsetTenths);
+
+    // The warning callback is invoked, outside of any lock, whenever the
+    // forecast enters or leaves the warning state.
+    void SetWarning(const uint32_t & theLeadSeconds, Callback<void(const CondensationForecast_t &)> theCallback);
+
+    // Sampling path entry point; suitable for direct registration via
+    // NuerteyDHT11Device::SetMeasurementCallback(). Only fresh, good
+    // readings of this predictor's sensor are taken, each once.
+    void Update(const Measurement_t & theMeasurement);
+
+    CondensationForecast_t GetForecast() const;
+
+protected:
+
+private:
+    struct Sample_t
+    {
+        int64_t TimeMs;                     // Relative to m_TheBaseTimeUs.
+        int32_t DewPointTenths;
+        int32_t TemperatureTenths;
+    };
+
+    struct Sums_t
+    {
+        int64_t T;
+        int64_t TT;
+        int64_t D;
+        int64_t TD;
+        int64_t A;                          // Air temperature.
+        int64_t TA;
+    };
+
+    void Add(const Sample_t & theSample, const int64_t & theSign);
+    void Rebase(const uint64_t & theNewBaseUs);
+    CondensationForecast_t MakeForecast() const;
+
+    mutable Mutex                                     m_ThePredictorMutex;
+    PinName                                           m_TheSensorPin;
+    int16_t                                           m_TheSurfaceTenths;
+    bool                                              m_IsSurfaceRelative;
+    uint32_t                                          m_TheLeadSeconds;
+    Callback<void(const CondensationForecast_t &)>    m_TheWarningCallback;
+    std::array<Sample_t, WINDOW_SAMPLES>              m_TheWindow;
+    std::size_t                                       m_TheCount;
+    std::size_t                                       m_TheNext;
+    Sums_t                                            m_TheSums;
+    uint64_t                                          m_TheBaseTimeUs;
+    uint64_t                                          m_TheLatestTimeUs;
+    uint32_t                                          m_TheLastSequenceNumber;
+    CondensationForecast_t                            m_TheForecast;
+};
+
+template <std::size_t WINDOW_SAMPLES>
+NuerteyCondensationPredictor<WINDOW_SAMPLES>::NuerteyCondensationPredictor(const PinName & theSensorPin,
+                                                                           const int16_t & theSurfaceTemperatureTenths)
+    : m_TheSensorPin(theSensorPin)
+    , m_TheSurfaceTenths(theSurfaceTemperatureTenths)
+    , m_IsSurfaceRelative(false)
+    , m_TheLeadSeconds(DEFAULT_LEAD_SECONDS)
+    , m_TheWindow{}
+    , m_TheCount(0)
+    , m_TheNext(0)
+    , m_TheSums{}
+    , m_TheBaseTimeUs(0)
+    , m_TheLatestTimeUs(0)
+    , m_TheLastSequenceNumber(0)
+    , m_TheForecast{}
+{
+    m_TheForecast.SecondsToCondensation = NEVER_SECONDS;
+}
+
+template <std::size_t WINDOW_SAMPLES>
+NuerteyCondensationPredictor<WINDOW_SAMPLES>::~NuerteyCondensationPredictor()
+{
+}
+
+template <std::size_t WINDOW_SAMPLES>
+void NuerteyCondensationPredictor<WINDOW_SAMPLES>::SetSurfaceTemperature(const int16_t & theTemperatureTenths)
+{
+    m_ThePredictorMutex.lock();
+    m_TheSurfaceTenths = theTemperatureTenths;
+    m_IsSurfaceRelative = false;
+    m_ThePredictorMutex.unlock();
+}
+
+template <std::size_t WINDOW_SAMPLES>
+void NuerteyCondensationPredictor<WINDOW_SAMPLES>::SetSurfaceOffsetFromAir(const int16_t & theOffsetTenths)
+{
+    m_ThePredictorMutex.lock();
+    m_TheSurfaceTenths = theOffsetTenths;
+    m_IsSurfaceRelative = true;
+    m_ThePredictorMutex.unlock();
+}
+
+template <std::size_t WINDOW_SAMPLES>
+void NuerteyCondensationPredictor<WINDOW_SAMPLES>::SetWarning(const uint32_t & theLeadSeconds,
+                                                              Callback<void(const CondensationForecast_t &)> theCallback)
+{
+    m_ThePredictorMutex.lock();
+    m_TheLeadSeconds = theLeadSeconds;
+    m_TheWarningCallback = theCallback;
+    m_ThePredictorMutex.unlock();
+}
+
+template <std::size_t WINDOW_SAMPLES>
+void NuerteyCondensationPredictor<WINDOW_SAMPLES>::Update(const Measurement_t & theMeasurement)
+{
+    if ((theMeasurement.SensorPin != m_TheSensorPin)
+     || (theMeasurement.Status != SensorStatus_t::SUCCESS)
+     || (theMeasurement.SampleTimeUs != theMeasurement.CaptureTimeUs))
+    {
+        return;
+    }
+
+    // Computed before locking; it is the one expensive step. In fixed
+    // point, as a NaN at 0%RH would corrupt the regression sums for the
+    // whole window.
+    const auto theDewPointTenths = static_cast<int32_t>(CalculateDewPointTenths(theMeasurement.TemperatureTenths,
+                                                                                theMeasurement.HumidityTenths));
+    auto isTransition = false;
+    CondensationForecast_t theForecast;
+    Callback<void(const CondensationForecast_t &)> theCallback;
+
+    m_ThePredictorMutex.lock();
+
+    if ((theMeasurement.SequenceNumber != m_TheLastSequenceNumber)
+     && ((m_TheCount == 0) || (theMeasurement.SampleTimeUs > m_TheLatestTimeUs)))
+    {
+        m_TheLastSequenceNumber = theMeasurement.SequenceNumber;
+
+        if ((m_TheCount != 0) && ((theMeasurement.SampleTimeUs - m_TheLatestTimeUs) > MAXIMUM_GAP_US))
+        {
+            m_TheCount = 0;
+            m_TheNext = 0;
+            m_TheSums = Sums_t{};
+        }
+
+        if (m_TheCount == 0)
+        {
+            m_TheBaseTimeUs = theMeasurement.SampleTimeUs;
+        }
+        else if (((theMeasurement.SampleTimeUs - m_TheBaseTimeUs) / 1000) >= static_cast<uint64_t>(MAXIMUM_RELATIVE_MS))
+        {
+            // Base on the oldest sample that will remain in the window.
+            const auto & theOldest = m_TheWindow[(m_TheCount < WINDOW_SAMPLES) ? 0 : ((m_TheNext + 1) % WINDOW_SAMPLES)];
+            Rebase(m_TheBaseTimeUs + static_cast<uint64_t>(theOldest.TimeMs) * 1000);
+        }
+
+        if (m_TheCount == WINDOW_SAMPLES)
+        {
+            Add(m_TheWindow[m_TheNext], -1);
+        }
+        else
+        {
+            ++m_TheCount;
+        }
+
+        const Sample_t theSample{static_cast<int64_t>((theMeasurement.SampleTimeUs - m_TheBaseTimeUs) / 1000),
+                                 theDewPointTenths, theMeasurement.TemperatureTenths};
+        m_TheWindow[m_TheNext] = theSample;
+        m_TheNext = (m_TheNext + 1) % WINDOW_SAMPLES;
+        Add(theSample, +1);
+        m_TheLatestTimeUs = theMeasurement.SampleTimeUs;
+
+        const auto wasWarning = m_TheForecast.IsWarning;
+        m_TheForecast = MakeForecast();
+        isTransition = (m_TheForecast.IsWarning != wasWarning);
+        theForecast = m_TheForecast;
+        theCallback = m_TheWarningCallback;
+    }
+
+    m_ThePredictorMutex.unlock();
+
+    if (isTransition && theCallback)
+    {
+        theCallback(theForecast);
+    }
+}
+
+template <std::size_t WINDOW_SAMPLES>
+CondensationForecast_t NuerteyCondensationPredictor<WINDOW_SAMPLES>::GetForecast() const
+{
+    m_ThePredictorMutex.lock();
+    const auto theForecast = m_TheForecast;
+    m_ThePredictorMutex.unlock();
+
+    return theForecast;
+}
+
+template <std::size_t WINDOW_SAMPLES>
+void NuerteyCondensationPredictor<WINDOW_SAMPLES>::Add(const Sample_t & theSample, const int64_t & theSign)
+{
+    m_TheSums.T  += theSign * theSample.TimeMs;
+    m_TheSums.TT += theSign * theSample.TimeMs * theSample.TimeMs;
+    m_TheSums.D  += theSign * theSample.DewPointTenths;
+    m_TheSums.TD += theSign * theSample.TimeMs * theSample.DewPointTenths;
+    m_TheSums.A  += theSign * theSample.TemperatureTenths;
+    m_TheSums.TA += theSign * theSample.TimeMs * theSample.TemperatureTenths;
+}
+
+template <std::size_t WINDOW_SAMPLES>
+void NuerteyCondensationPredictor<WINDOW_SAMPLES>::Rebase(const uint64_t & theNewBaseUs)
+{
+    const auto theShiftMs = static_cast<int64_t>((theNewBaseUs - m_TheBaseTimeUs) / 1000);
+
+    m_TheBaseTimeUs += static_cast<uint64_t>(theShiftMs) * 1000;
+    m_TheSums = Sums_t{};
+
+    for (std::size_t i = 0; i < m_TheCount; ++i)
+    {
+        m_TheWindow[i].TimeMs -= theShiftMs;
+        Add(m_TheWindow[i], +1);
+    }
+}
+
+template <std::size_t WINDOW_SAMPLES>
+CondensationForecast_t NuerteyCondensationPredictor<WINDOW_SAMPLES>::MakeForecast() const
+{
+    CondensationForecast_t theForecast{};
+
+    theForecast.TimeUs = m_TheLatestTimeUs;
+    theForecast.SecondsToCondensation = NEVER_SECONDS;
+
+    if (m_TheCount < MINIMUM_SAMPLES)
+    {
+        return theForecast;
+    }
+
+    const auto n = static_cast<int64_t>(m_TheCount);
+    const auto theDenominator = (n * m_TheSums.TT) - (m_TheSums.T * m_TheSums.T);
+    if (theDenominator <= 0)
+    {
+        return theForecast; // All samples at one instant; no trend.
+    }
+
+    // Slopes in tenths per millisecond; fitted values at the latest sample.
+    const auto theLatestMs = static_cast<float>((m_TheLatestTimeUs - m_TheBaseTimeUs) / 1000);
+    const auto theMeanMs = static_cast<float>(m_TheSums.T) / n;
+    const auto theDewSlope = static_cast<float>((n * m_TheSums.TD) - (m_TheSums.T * m_TheSums.D))
+                           / static_cast<float>(theDenominator);
+    const auto theDewPoint = (static_cast<float>(m_TheSums.D) / n) + (theDewSlope * (theLatestMs - theMeanMs));
+
+    auto theSurface = static_cast<float>(m_TheSurfaceTenths);
+    auto theSurfaceSlope = 0.0f;
+    if (m_IsSurfaceRelative)
+    {
+        theSurfaceSlope = static_cast<float>((n * m_TheSums.TA) - (m_TheSums.T * m_TheSums.A))
+                        / static_cast<float>(theDenominator);
+        theSurface = (static_cast<float>(m_TheSums.A) / n) + (theSurfaceSlope * (theLatestMs - theMeanMs))
+                   - static_cast<float>(m_TheSurfaceTenths);
+    }
+
+    const auto theMargin = theSurface - theDewPoint;
+    const auto theMarginSlope = theSurfaceSlope - theDewSlope;
+
+    theForecast.DewPointTenths = static_cast<int16_t>(lroundf(theDewPoint));
+    theForecast.SurfaceTemperatureTenths = static_cast<int16_t>(lroundf(theSurface));
+    theForecast.MarginTenths = static_cast<int16_t>(lroundf(theMargin));
+    theForecast.MarginSlopeTenthsPerHour = static_cast<int16_t>(lroundf(
+                                               std::fmax(-32767.0f, std::fmin(32767.0f, theMarginSlope * 3'600'000.0f))));
+    theForecast.IsValid = true;
+
+    if (theMargin <= 0.0f)
+    {
+        theForecast.SecondsToCondensation = 0;
+    }
+    else if (theMarginSlope < 0.0f)
+    {
+        const auto theSeconds = (theMargin / -theMarginSlope) / 1000.0f;
+        theForecast.SecondsToCondensation = (theSeconds >= static_cast<float>(NEVER_SECONDS - 1))
+                                          ? (NEVER_SECONDS - 1) : static_cast<uint32_t>(theSeconds);
+    }
+
+    theForecast.IsWarning = (theForecast.SecondsToCondensation <= m_TheLeadSeconds);
+
+    return theForecast;
+}
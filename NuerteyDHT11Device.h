@@ -69,130 +69,123 @@
 #include <array>
 #include <time.h> 
 #include "mbed.h"
+#include "NuerteyDHT11Protocol.h"
+#include "NuerteyCaptureBufferPool.h"
 
 #define PIN_HIGH  1
 #define PIN_LOW   0
 
-// Enforce that these errors should always be checked whenever and 
-// whereever they are returned.
-
-// TBD: Nuertey Odzeyem; double-check if the below actually does imply
-// that we dont need a SUCCESS value in the enum and consequent message()
-// translation. What would message() print out then?
+// Time the bus capture with the core's DWT cycle counter, where there is
+// one (Cortex-M3 and up), rather than with us_ticker_read(): a single
+// load from the core's own debug block instead of a call into the ticker
+// HAL and a load across the peripheral bus, on every poll. Define to 0 to
+// fall back to the us ticker.
+#ifndef DHT11_CYCLE_COUNTER_ENABLED
+#define DHT11_CYCLE_COUNTER_ENABLED 1
+#endif
+
+// Guard each device with its own mutex so that it may be shared between
+// threads. Concurrent ReadData() callers then coalesce onto the bus 
+// transaction already in flight instead of colliding on the pin or lining
+// up for transactions of their own. Define to 0 for devices that are only
+// ever touched from a single thread.
+#ifndef DHT11_THREAD_SAFE_ENABLED
+#define DHT11_THREAD_SAFE_ENABLED 1
+#endif
+
+
+// Compact, fixed-point snapshot of a single sensor reading. Temperature
+// and humidity are expressed in tenths of a unit (i.e. 235 == 23.5°C) so
+// that readings can be batched, shipped and compared without dragging 
+// floating point arithmetic, or float printf, into the consumers.
 //
-// "Whatever the reason for failure, after create_directory() returns, 
-// the error_code object ec will contain the OS-specific error code. On 
-// the other hand, if the call was successful then ec contains a zero 
-// value. This follows the tradition (used by errno and GetLastError())
-// of having 0 indicate success and non-zero indicate failure."
-enum class [[nodiscard]] SensorStatus_t : int8_t
-{
-    SUCCESS              =  0,
-    ERROR_BUS_BUSY       = -1,
-    ERROR_NOT_DETECTED   = -2,
-    ERROR_ACK_TOO_LONG   = -3,
-    ERROR_SYNC_TIMEOUT   = -4,
-    ERROR_DATA_TIMEOUT   = -5,
-    ERROR_BAD_CHECKSUM   = -6,
-    ERROR_TOO_FAST_READS = -7
-};
-
-enum class TemperatureScale_t : uint8_t
+// Every snapshot is self-describing as to freshness: a failed read leaves
+// the previous good readings in place, but Status, SequenceNumber and 
+// CaptureTimeUs always describe the most recent read, whereas SampleTimeUs
+// dates the readings themselves. Timestamps are in microseconds on the 
+// monotonic us ticker (ticker_read_us()), and 0 means "never".
+struct Measurement_t
 {
-    CELCIUS = 0,
-    FARENHEIT,
-    KELVIN
+    PinName        SensorPin;
+    int16_t        TemperatureTenths;   // Celsius x 10
+    uint16_t       HumidityTenths;      // %RH x 10
+    SensorStatus_t Status;              // Result of the most recent read.
+    uint32_t       ReadDurationUs;      // Duration of that bus transaction.
+    uint32_t       SequenceNumber;      // Bus transactions so far; bumped by every read.
+    uint64_t       CaptureTimeUs;       // Start of the most recent read.
+    uint64_t       SampleTimeUs;        // Start of the read that produced the readings.
 };
 
-template <typename T, typename U>
-struct TrueTypesEquivalent : std::is_same<typename std::decay<T>::type, U>::type
-{};
-
-template <typename E>
-constexpr auto ToUnderlyingType(E e) -> typename std::underlying_type<E>::type
-{
-    return static_cast<typename std::underlying_type<E>::type>(e);
-}
-
-template <typename E, typename V = int8_t>
-constexpr auto ToEnum(V value) -> E
+// A cached measurement as served without touching the bus; see 
+// NuerteyDHT11Device::GetCachedMeasurement().
+struct CachedMeasurement_t
 {
-    return static_cast<E>(value);
-}
-
-// Register for implicit conversion to error_code:
-//
-// For the SensorStatus_t enumerators to be usable as error_code constants,
-// enable the conversion constructor using the is_error_code_enum type trait:
-namespace std
-{
-    template <>
-    struct is_error_code_enum<SensorStatus_t> : std::true_type {};
-}
+    Measurement_t  Measurement;
+    uint32_t       AgeMs;               // Since the readings were sampled; UINT32_MAX if never.
+    bool           IsRefreshScheduled;  // A background ReadData() is pending.
+};
 
-class DHT11ErrorCategory : public std::error_category
+// The Pin concept of the capture loops (see NuerteyDHT11Protocol.h). On
+// STM targets gpio_read() is itself a static inline load of the cached
+// input data register (IDR) address and mask, so this costs no more than
+// DigitalInOut::read(); it merely names the one operation the loops need.
+class CapturePin : public DigitalInOut
 {
 public:
-    virtual const char* name() const noexcept override;
-    virtual std::string message(int ev) const override;
+    CapturePin(PinName thePinName)
+        : DigitalInOut(thePinName)
+    {
+    }
+
+    inline int Read()
+    {
+        return gpio_read(&gpio);
+    }
 };
 
-const char* DHT11ErrorCategory::name() const noexcept
+// Microsecond time base for the shared bus capture loop.
+struct UsTickerClock
 {
-    return "DHT11-Sensor-Mbed";
-}
+    inline uint32_t NowUs() const { return us_ticker_read(); }
+};
 
-std::string DHT11ErrorCategory::message(int ev) const
+#if DHT11_CYCLE_COUNTER_ENABLED && defined(DWT_CTRL_CYCCNTENA_Msk)
+// Microseconds since construction, off the DWT cycle counter. The
+// cycles-to-microseconds factor is worked out once, as a 0.32 fixed-point
+// reciprocal, so that each NowUs() is a load, a subtraction and a single
+// UMULL rather than a division. Counting from construction, rather than
+// scaling the free-running counter, keeps differences of NowUs() correct
+// across the counter wrapping; construct one per capture, as it is only
+// good for 2^32 cycles (some 19s at 216 MHz).
+class CycleCounterClock
 {
-    switch (ToEnum<SensorStatus_t>(ev))
+public:
+    CycleCounterClock()
+        : m_TheMicrosecondsPerCycleQ32(static_cast<uint32_t>((1'000'000ULL << 32) / SystemCoreClock))
     {
-        case SensorStatus_t::SUCCESS:
-            return "Success - no errors";
-            
-        case SensorStatus_t::ERROR_BUS_BUSY:
-            return "Communication failure - bus busy";
-
-        case SensorStatus_t::ERROR_NOT_DETECTED:
-            return "Communication failure - sensor not detected on bus";
-
-        case SensorStatus_t::ERROR_ACK_TOO_LONG:
-            return "Communication failure - ack too long";
-
-        case SensorStatus_t::ERROR_SYNC_TIMEOUT:
-            return "Communication failure - sync timeout";
-
-        case SensorStatus_t::ERROR_DATA_TIMEOUT:
-            return "Communication failure - data timeout";
-
-        case SensorStatus_t::ERROR_BAD_CHECKSUM:
-            return "Checksum error";
-
-        case SensorStatus_t::ERROR_TOO_FAST_READS:
-            return "Communication failure - too fast reads";            
-        default:
-            return "(unrecognized error)";
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if (__CORTEX_M == 7)
+        DWT->LAR = 0xC5ACCE55;      // Cortex-M7 locks out DWT writes until unlocked.
+#endif
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        m_TheStartCycles = DWT->CYCCNT;
     }
-}
 
-inline const std::error_category& dht11_error_category()
-{
-    static DHT11ErrorCategory instance;
-    return instance;
-}
-
-inline auto make_error_code(SensorStatus_t e)
-{
-    return std::error_code(ToUnderlyingType(e), dht11_error_category());
-}
+    inline uint32_t NowUs() const
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(DWT->CYCCNT - m_TheStartCycles)
+                                    * m_TheMicrosecondsPerCycleQ32) >> 32);
+    }
 
-inline auto make_error_condition(SensorStatus_t e)
-{
-    return std::error_condition(ToUnderlyingType(e), dht11_error_category());
-}
+private:
+    uint32_t m_TheMicrosecondsPerCycleQ32;
+    uint32_t m_TheStartCycles;
+};
 
-// Metaprogramming types to distinguish each sensor module type:
-struct DHT11_t {};
-struct DHT22_t {};
+using CaptureClock_t = CycleCounterClock;
+#else
+using CaptureClock_t = UsTickerClock;
+#endif
 
 template <typename T>
 class NuerteyDHT11Device
@@ -203,12 +196,13 @@ class NuerteyDHT11Device
 
 public:
     static constexpr uint8_t DHT11_MICROCONTROLLER_RESOLUTION_BITS =  8;
-    static constexpr uint8_t SINGLE_BUS_DATA_FRAME_SIZE_BYTES      =  5;
-    static constexpr uint8_t MAXIMUM_DATA_FRAME_SIZE_BITS          = 40; // 5x8
+    static constexpr uint8_t MAXIMUM_DATA_FRAME_SIZE_BITS          = DATA_FRAME_SIZE_BITS;
     static constexpr double  MINIMUM_SAMPLING_PERIOD_SECONDS       =  3; // Be conservative.
+    static constexpr SensorModel_t SENSOR_MODEL                    = ToSensorModel<T>();
+    static constexpr uint32_t DEFAULT_CAPTURE_LEASE_TIMEOUT_MS     = 100; // A few reads' worth.
 
-    using DataFrameBytes_t = std::array<uint8_t, SINGLE_BUS_DATA_FRAME_SIZE_BYTES>;
-    using DataFrameBits_t  = std::array<uint8_t, MAXIMUM_DATA_FRAME_SIZE_BITS>;
+    using DataFrameBytes_t = DataFrame_t;
+    using DataFrameBits_t  = BitWidths_t;
 
     NuerteyDHT11Device(PinName thePinName);
 
@@ -222,6 +216,8 @@ public:
     // of a unique hardware pin. Indeed, the Compiler is our friend. We 
     // simply have to play by its stringent rules. Simple!
 
+    // Cancels any pending background refresh and, should one already be
+    // on the bus, waits for it to finish.
     virtual ~NuerteyDHT11Device();
 
     [[nodiscard]] std::error_code ReadData();
@@ -231,16 +227,70 @@ public:
     float CalculateDewPoint(const float & celsius, const float & humidity) const;
     float CalculateDewPointFast(const float & celsius, const float & humidity) const;
 
+    Measurement_t GetMeasurement() const;
+    DataFrameBytes_t GetDataFrame() const;
+
+    // Invoked from within ReadData(), on the caller's thread, every time
+    // the bus is actually read (successfully or not). Cached results 
+    // returned within MINIMUM_SAMPLING_PERIOD_SECONDS do not trigger it.
+    // Keep the handler short; it runs in the sampling path.
+    void SetMeasurementCallback(Callback<void(const Measurement_t &)> theCallback);
+
+    // Stale-while-revalidate access for latency-sensitive consumers; this
+    // never blocks on the bus. Whenever the readings are older than 
+    // theMaximumAgeMs, a ReadData() is posted to the refresh queue (if one
+    // is set), and later callers get the refreshed readings. Returns the
+    // readings as they are now, along with their age either way.
+    CachedMeasurement_t GetCachedMeasurement(const uint32_t & theMaximumAgeMs = UINT32_MAX);
+
+    // Queue on which background refreshes run. Its dispatch thread then
+    // shares the device with the callers, hence DHT11_THREAD_SAFE_ENABLED
+    // is required unless that is also the only calling thread. A refresh
+    // which the queue has already dequeued, but which has yet to begin,
+    // is beyond the reach of EventQueue::cancel(); so destroy the device
+    // from the dispatch thread, or once the queue has stopped, rather
+    // than whilst it dispatches on another.
+    void SetRefreshQueue(EventQueue * pTheEventQueue);
+
+    // Data bits are decoded by comparing the width of their high phase
+    // against the profile's threshold. With calibration enabled, every
+    // read that passes its checksum refines the profile for this very
+    // sensor (and its cabling). Persist it, see NuerteyTimingProfileStore.h,
+    // so that the first read after a reboot is already tuned.
+    void SetCalibrationEnabled(const bool & isEnabled);
+    bool IsCalibrationEnabled() const;
+    void SetTimingProfile(const TimingProfile_t & theProfile);
+    TimingProfile_t GetTimingProfile() const;
+
+    // Linear offset/gain correction folded into the fixed-point decode of
+    // every subsequent read; the identity (default) costs nothing. See
+    // NuerteyReadingCalibrator.h for estimating it against other sensors.
+    void SetReadingCalibration(const ReadingCalibration_t & theCalibration);
+    ReadingCalibration_t GetReadingCalibration() const;
+
+    // Capture each frame's edge timestamps into a buffer leased from
+    // thePool (shared by any number of devices), rather than timing the
+    // bits as they arrive. A read that cannot lease a buffer within 
+    // theLeaseTimeoutMs fails with ERROR_BUS_BUSY without touching the
+    // bus. Only that caller sees the failure: the measurement, sequence
+    // number and callback are left alone, and the next ReadData() tries
+    // again. nullptr reverts to the default capture. The pool must 
+    // outlive the device.
+    void SetCaptureBufferPool(NuerteyCaptureBufferPool * pThePool,
+                              const uint32_t & theLeaseTimeoutMs = DEFAULT_CAPTURE_LEASE_TIMEOUT_MS);
+    PinName GetPinName() const { return m_TheDataPinName; }
+
 protected:
 
 private:
-    [[nodiscard]] SensorStatus_t ExpectPulse(DigitalInOut & theIO, const int & level, const int & max_time);
+    [[nodiscard]] SensorStatus_t ReadFromBus(const uint8_t & theThresholdUs, DataFrameBytes_t & theDataFrame,
+                                             DataFrameBits_t & theHighWidthsUs, EdgeTimestamps_t * pTheEdgesUs);
     [[nodiscard]] SensorStatus_t ValidateChecksum();
 
     float CalculateTemperature() const;
     float CalculateHumidity() const;
-    float ConvertCelsiusToFarenheit(const float & celcius) const;
-    float ConvertCelsiusToKelvin(const float & celcius) const;
+    int16_t CalculateTemperatureTenths() const;
+    uint16_t CalculateHumidityTenths() const;
 
     PinName              m_TheDataPinName;
     DataFrameBytes_t     m_TheDataFrame;
@@ -248,11 +298,59 @@ private:
     std::error_code      m_TheLastReadResult;
     float                m_TheLastTemperature;
     float                m_TheLastHumidity;
+    int16_t              m_TheLastTemperatureTenths;
+    uint16_t             m_TheLastHumidityTenths;
+    uint32_t             m_TheLastReadDurationUs;
+    Callback<void(const Measurement_t &)> m_TheMeasurementCallback;
+    TimingProfile_t      m_TheTimingProfile;
+    bool                 m_IsCalibrationEnabled;
+    ReadingCalibration_t m_TheReadingCalibration;
+    us_timestamp_t       m_TheLastCaptureTimeUs;
+    us_timestamp_t       m_TheLastSampleTimeUs;
+    uint32_t             m_TheSequenceNumber;
+    EventQueue *         m_pTheRefreshQueue;
+    int                  m_TheRefreshEventId;    // Non-zero whilst a refresh is pending.
+    NuerteyCaptureBufferPool * m_pTheCaptureBufferPool;
+    uint32_t             m_TheCaptureLeaseTimeoutMs;
+
+    // No-ops unless DHT11_THREAD_SAFE_ENABLED. Mbed's Mutex is recursive,
+    // so public methods may freely call one another whilst locked.
+    void Lock() const;
+    void Unlock() const;
+    void Refresh();
+    uint32_t GetAgeMs() const;
+
+#if DHT11_THREAD_SAFE_ENABLED
+    mutable Mutex        m_TheMutex;
+    ConditionVariable    m_TheReadCompleted;
+    bool                 m_IsReadInFlight;
+    bool                 m_IsRefreshInFlight;
+#endif
 };
 
 template <typename T>
 NuerteyDHT11Device<T>::NuerteyDHT11Device(PinName thePinName)
     : m_TheDataPinName(thePinName)
+    , m_TheLastTemperature(0.0f)
+    , m_TheLastHumidity(0.0f)
+    , m_TheLastTemperatureTenths(0)
+    , m_TheLastHumidityTenths(0)
+    , m_TheLastReadDurationUs(0)
+    , m_TheTimingProfile(DEFAULT_TIMING_PROFILE)
+    , m_IsCalibrationEnabled(false)
+    , m_TheReadingCalibration(IDENTITY_READING_CALIBRATION)
+    , m_TheLastCaptureTimeUs(0)
+    , m_TheLastSampleTimeUs(0)
+    , m_TheSequenceNumber(0)
+    , m_pTheRefreshQueue(nullptr)
+    , m_TheRefreshEventId(0)
+    , m_pTheCaptureBufferPool(nullptr)
+    , m_TheCaptureLeaseTimeoutMs(DEFAULT_CAPTURE_LEASE_TIMEOUT_MS)
+#if DHT11_THREAD_SAFE_ENABLED
+    , m_TheReadCompleted(m_TheMutex)
+    , m_IsReadInFlight(false)
+    , m_IsRefreshInFlight(false)
+#endif
 {
     // Using this value ensures that time(NULL) - m_TheLastReadTime will
     // be >= MINIMUM_SAMPLING_PERIOD_SECONDS the first time. Note that  
@@ -266,33 +364,160 @@ NuerteyDHT11Device<T>::NuerteyDHT11Device(PinName thePinName)
 template <typename T>
 NuerteyDHT11Device<T>::~NuerteyDHT11Device()
 {
+    SetRefreshQueue(nullptr);
+
+#if DHT11_THREAD_SAFE_ENABLED
+    // The refresh queue's thread may be mid-Refresh(), which cancel()
+    // cannot stop; let it finish with the device before it goes away.
+    Lock();
+    while (m_IsRefreshInFlight)
+    {
+        m_TheReadCompleted.wait();
+    }
+    Unlock();
+#endif
 }
 
 template <typename T>
 std::error_code NuerteyDHT11Device<T>::ReadData()
 {
-    // Check if sensor was read less than two seconds ago and return 
-    // early to use last reading.
-    auto currentTime = time(NULL);
+    // Released upon return, whichever way we return.
+    NuerteyCaptureBufferPool::Lease theLease;
 
-    if (difftime(currentTime, m_TheLastReadTime) < MINIMUM_SAMPLING_PERIOD_SECONDS)
+    Lock();
+
+    while (true)
     {
-        return m_TheLastReadResult; // return last correct measurement
+#if DHT11_THREAD_SAFE_ENABLED
+        if (m_IsReadInFlight)
+        {
+            // Another thread is on the bus for this very sampling window. 
+            // Rather than queue up behind it, share in its result.
+            // Compared as serial numbers: should this thread not get to
+            // run before yet another read completes, the sequence number
+            // will have moved past theAwaitedRead, not stopped at it.
+            const auto theAwaitedRead = m_TheSequenceNumber + 1;
+            while (static_cast<int32_t>(m_TheSequenceNumber - theAwaitedRead) < 0)
+            {
+                m_TheReadCompleted.wait();
+            }
+
+            const auto theResult = m_TheLastReadResult;
+            Unlock();
+            return theResult;
+        }
+#endif
+
+        // Check if sensor was read less than two seconds ago and return 
+        // early to use last reading.
+        if (difftime(time(NULL), m_TheLastReadTime) < MINIMUM_SAMPLING_PERIOD_SECONDS)
+        {
+            const auto theResult = m_TheLastReadResult;
+            Unlock();
+            return theResult; // return last correct measurement
+        }
+
+        const auto pThePool = m_pTheCaptureBufferPool;
+        if ((pThePool == nullptr) || theLease)
+        {
+            break;
+        }
+
+        // Wait for a capture buffer unlocked and before claiming the read,
+        // so that neither the getters nor coalescing callers wait on the
+        // pool. Others may have read in the meantime, hence the re-check.
+        const auto theLeaseTimeoutMs = m_TheCaptureLeaseTimeoutMs;
+        Unlock();
+        theLease = pThePool->Acquire(theLeaseTimeoutMs);
+
+        if (!theLease)
+        {
+            // The sensor was never asked, so there is nothing to record; 
+            // the measurement, its sequence number and the sampling 
+            // window all remain as they were.
+            return make_error_code(SensorStatus_t::ERROR_BUS_BUSY);
+        }
+        Lock();
+    }
+
+    m_TheLastReadTime = time(NULL);
+    const auto theThresholdUs = m_TheTimingProfile.ThresholdUs;
+#if DHT11_THREAD_SAFE_ENABLED
+    m_IsReadInFlight = true;
+#endif
+    Unlock();
+
+    // The bus transaction itself runs unlocked, so that the getters do
+    // not stall for its duration. It only touches locals.
+    DataFrameBytes_t theDataFrame = {};
+    DataFrameBits_t  theHighWidthsUs = {};
+
+    const auto theCaptureTimeUs = ticker_read_us(get_us_ticker_data());
+    auto result = ReadFromBus(theThresholdUs, theDataFrame, theHighWidthsUs,
+                              theLease ? &theLease.GetBuffer() : nullptr);
+    const auto theDurationUs = static_cast<uint32_t>(ticker_read_us(get_us_ticker_data()) - theCaptureTimeUs);
+
+    // The edges are decoded by now; let the next capture have the buffer.
+    theLease.Release();
+
+    Lock();
+    m_TheDataFrame = theDataFrame;
+    m_TheLastReadDurationUs = theDurationUs;
+    m_TheLastCaptureTimeUs  = theCaptureTimeUs;
+    ++m_TheSequenceNumber;
+
+    if (result == SensorStatus_t::SUCCESS)
+    {
+        result = ValidateChecksum();
+
+        if (result == SensorStatus_t::SUCCESS)
+        {
+            m_TheLastSampleTimeUs = theCaptureTimeUs;
+        }
+
+        if ((result == SensorStatus_t::SUCCESS) && m_IsCalibrationEnabled)
+        {
+            LearnTimingProfile(m_TheTimingProfile, theHighWidthsUs.data(), theHighWidthsUs.size());
+        }
     }
 
-    std::error_code errorCode;
+    // Note that we are relying upon default-construction of std::error_code
+    // being enough to indicate success as per standard practice.
+    m_TheLastReadResult = (result == SensorStatus_t::SUCCESS) ? std::error_code() : make_error_code(result);
+    const auto theResult = m_TheLastReadResult;
+    const auto theMeasurement = GetMeasurement();
+    const auto theCallback = m_TheMeasurementCallback;
+
+#if DHT11_THREAD_SAFE_ENABLED
+    m_IsReadInFlight = false;
+    m_TheReadCompleted.notify_all();
+#endif
+    Unlock();
+
+    // Outside of the lock, so that the handler may call back into us.
+    if (theCallback)
+    {
+        theCallback(theMeasurement);
+    }
+
+    return theResult;
+}
+
+template <typename T>
+SensorStatus_t NuerteyDHT11Device<T>::ReadFromBus(const uint8_t & theThresholdUs, DataFrameBytes_t & theDataFrame,
+                                                  DataFrameBits_t & theHighWidthsUs, EdgeTimestamps_t * pTheEdgesUs)
+{
     auto result = SensorStatus_t::SUCCESS;
-    m_TheLastReadTime = currentTime;
 
     // Reset 40 bits of previously received data to zero.
-    m_TheDataFrame.fill(0);
+    theDataFrame.fill(0);
 
     // DHT11 uses a simplified single-wire bidirectional communication protocol.
     // It follows a Master/Slave paradigm [NUCLEO-F767ZI=Master, DHT11=Slave] 
     // with the MCU observing these states:
     //
     // WAITING, READING.
-    DigitalInOut theDigitalInOutPin(m_TheDataPinName);
+    CapturePin theDigitalInOutPin(m_TheDataPinName);
 
     // MCU Sends out Start Signal to DHT:
     //
@@ -325,9 +550,6 @@ std::error_code NuerteyDHT11Device<T>::ReadData()
         ThisThread::sleep_for(2);
     }
 
-    uint8_t i = 0, j = 0, b = 0;
-    DataFrameBits_t bitValue = {}; // Initialize to zeros.
-
     // "...then MCU will pull up voltage and wait 20-40us for DHT’s response."
     theDigitalInOutPin.mode(PullUp);
 
@@ -336,115 +558,34 @@ std::error_code NuerteyDHT11Device<T>::ReadData()
     wait_us(30);
     theDigitalInOutPin.input();
 
-    // Wait till the sensor grabs the bus.
-    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 1, 40))
+    // Timing critical code.
+    //
+    // TBD; Nuertey Odzeyem: We CANNOT use the CriticalSectionLock here as
+    // the capture spins for up to 7ms. As the Mbed docs further clarifies:
+    //
+    // "Note: You must not use time-consuming operations, standard 
+    // library and RTOS functions inside critical section."
+    //CriticalSectionLock  lock;
+    CaptureClock_t theClock;
+    if (pTheEdgesUs != nullptr)
     {
-        result = SensorStatus_t::ERROR_NOT_DETECTED;
-        errorCode = make_error_code(result);
-        m_TheLastReadResult = errorCode;
-        return errorCode;
+        const auto theNumberOfEdges = CaptureEdgeTimestamps(theDigitalInOutPin, theClock,
+                                                            pTheEdgesUs->data(), pTheEdgesUs->size());
+        // End of timing critical code.
+        result = DecodeEdgeTimestamps(pTheEdgesUs->data(), theNumberOfEdges, theHighWidthsUs);
     }
-
-    // Sensor should signal low 80us and then hi 80us.
-    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 0, 100))
+    else
     {
-        result = SensorStatus_t::ERROR_SYNC_TIMEOUT;
-        errorCode = make_error_code(result);
-        m_TheLastReadResult = errorCode;
-        return errorCode;
+        result = CaptureBitWidths(theDigitalInOutPin, theClock, theHighWidthsUs);
+        // End of timing critical code.
     }
 
-    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 1, 100)) [[unlikely]]
+    if (result == SensorStatus_t::SUCCESS) [[likely]]
     {
-        result = SensorStatus_t::ERROR_TOO_FAST_READS;
-        errorCode = make_error_code(result);
-        m_TheLastReadResult = errorCode;
-        return errorCode;
-    }
-    else [[likely]]
-    {
-        // Timing critical code.
-        {
-            // TBD; Nuertey Odzeyem: We CANNOT use the CriticalSectionLock
-            // here as ExpectPulse() calls wait_us(). As the Mbed docs 
-            // further clarifies:
-            //
-            // "Note: You must not use time-consuming operations, standard 
-            // library and RTOS functions inside critical section."
-            //CriticalSectionLock  lock;
-
-            // capture the data
-            for (i = 0; i < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; i++)
-            {
-                for (j = 0; j < DHT11_MICROCONTROLLER_RESOLUTION_BITS; j++)
-                {
-                    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 0, 75))
-                    {
-                        result = SensorStatus_t::ERROR_DATA_TIMEOUT;
-                        errorCode = make_error_code(result);
-                        m_TheLastReadResult = errorCode;
-                        return errorCode;
-                    }
-                    // logic 0 is 28us max, 1 is 70us
-                    wait_us(40);
-                    bitValue[i*DHT11_MICROCONTROLLER_RESOLUTION_BITS + j] = theDigitalInOutPin;
-                    if (SensorStatus_t::SUCCESS != ExpectPulse(theDigitalInOutPin, 1, 50))
-                    {
-                        result = SensorStatus_t::ERROR_DATA_TIMEOUT;
-                        errorCode = make_error_code(result);
-                        m_TheLastReadResult = errorCode;
-                        return errorCode;
-                    }
-                }
-            }
-        } // End of timing critical code.
-
         // store the data
-        for (i = 0; i < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; i++)
-        {
-            b = 0;
-            for (j = 0; j < DHT11_MICROCONTROLLER_RESOLUTION_BITS; j++)
-            {
-                if (bitValue[i*DHT11_MICROCONTROLLER_RESOLUTION_BITS + j] == 1)
-                {
-                    b |= (1 << (7-j));
-                }
-            }
-            m_TheDataFrame[i] = b;
-        }
-        result = ValidateChecksum();
-    }
-
-    // Note that we are relying upon default-construction of std::error_code
-    // being enough to indicate success as per standard practice.
-    if (result != SensorStatus_t::SUCCESS)
-    {
-        errorCode = make_error_code(result);
+        AssembleDataFrame(theHighWidthsUs, theThresholdUs, theDataFrame);
     }
-    m_TheLastReadResult = errorCode;
-    
-    return errorCode;
-}
 
-template <typename T>
-SensorStatus_t NuerteyDHT11Device<T>::ExpectPulse(DigitalInOut & theIO, const int & level, const int & max_time)
-{
-    auto result = SensorStatus_t::SUCCESS;
- 
-    // This method essentially spins in a loop (i.e. polls) for every 
-    // microsecond until the expected pulse arrives or we timeout.   
-    int count = 0;
-    while (level == theIO)
-    {
-        if (count > max_time)
-        {
-            result = SensorStatus_t::ERROR_TOO_FAST_READS;
-            break;
-        }
-        count++;
-        wait_us(1);
-    }
-    
     return result;
 }
 
@@ -454,8 +595,10 @@ SensorStatus_t NuerteyDHT11Device<T>::ValidateChecksum()
     auto result = SensorStatus_t::ERROR_BAD_CHECKSUM;
     
     // Per the sensor device specs./data sheet:
-    if (m_TheDataFrame[4] == ((m_TheDataFrame[0] + m_TheDataFrame[1] + m_TheDataFrame[2] + m_TheDataFrame[3]) & 0xFF))
+    if (IsChecksumValid(m_TheDataFrame))
     {
+        m_TheLastTemperatureTenths = CalculateTemperatureTenths();
+        m_TheLastHumidityTenths = CalculateHumidityTenths();
         m_TheLastTemperature = CalculateTemperature();
         m_TheLastHumidity = CalculateHumidity();
         result = SensorStatus_t::SUCCESS;
@@ -465,68 +608,230 @@ SensorStatus_t NuerteyDHT11Device<T>::ValidateChecksum()
 }
 
 template <typename T>
-float NuerteyDHT11Device<T>::CalculateTemperature() const
+int16_t NuerteyDHT11Device<T>::CalculateTemperatureTenths() const
 {
-    auto v = 0;
+    const auto theTenths = DecodeTemperatureTenths<T>(m_TheDataFrame);
 
-    // As an alternative to SFINAE template techniques:
-    if constexpr (std::is_same<T, DHT11_t>::value)
+    if (IsIdentityReadingCalibration(m_TheReadingCalibration))
     {
-        v = m_TheDataFrame[2];
+        return theTenths;
     }
-    else if constexpr (std::is_same<T, DHT22_t>::value)
-    {
-        v = m_TheDataFrame[2] & 0x7F;
-        v *= 256;
-        v += m_TheDataFrame[3];
-        v /= 10;
+    return CalibrateTemperatureTenths(theTenths, m_TheReadingCalibration);
+}
 
-        if (m_TheDataFrame[2] & 0x80)
-        {
-            v *= -1;
-        }
+template <typename T>
+uint16_t NuerteyDHT11Device<T>::CalculateHumidityTenths() const
+{
+    const auto theTenths = DecodeHumidityTenths<T>(m_TheDataFrame);
+
+    if (IsIdentityReadingCalibration(m_TheReadingCalibration))
+    {
+        return theTenths;
     }
+    return CalibrateHumidityTenths(theTenths, m_TheReadingCalibration);
+}
 
-    return (static_cast<float>(v));
+template <typename T>
+float NuerteyDHT11Device<T>::CalculateTemperature() const
+{
+    // Derive from the fixed-point value so that both representations 
+    // always agree. Note that this also preserves the DHT22's tenths of 
+    // a degree, which integer division previously truncated away.
+    return (static_cast<float>(CalculateTemperatureTenths()) / 10.0f);
 }
 
 template <typename T>
 float NuerteyDHT11Device<T>::CalculateHumidity() const
 {
-    auto v = 0;
+    return (static_cast<float>(CalculateHumidityTenths()) / 10.0f);
+}
 
-    // As an alternative to SFINAE template techniques:
-    if constexpr (std::is_same<T, DHT11_t>::value)
+template <typename T>
+float NuerteyDHT11Device<T>::GetHumidity() const
+{
+    Lock();
+    const auto theHumidity = m_TheLastHumidity;
+    Unlock();
+
+    return theHumidity;
+}
+
+template <typename T>
+Measurement_t NuerteyDHT11Device<T>::GetMeasurement() const
+{
+    Measurement_t measurement;
+
+    Lock();
+    measurement.SensorPin         = m_TheDataPinName;
+    measurement.TemperatureTenths = m_TheLastTemperatureTenths;
+    measurement.HumidityTenths    = m_TheLastHumidityTenths;
+    measurement.Status            = ToEnum<SensorStatus_t>(m_TheLastReadResult.value());
+    measurement.ReadDurationUs    = m_TheLastReadDurationUs;
+    measurement.SequenceNumber    = m_TheSequenceNumber;
+    measurement.CaptureTimeUs     = m_TheLastCaptureTimeUs;
+    measurement.SampleTimeUs      = m_TheLastSampleTimeUs;
+    Unlock();
+
+    return measurement;
+}
+
+template <typename T>
+typename NuerteyDHT11Device<T>::DataFrameBytes_t NuerteyDHT11Device<T>::GetDataFrame() const
+{
+    Lock();
+    const auto theDataFrame = m_TheDataFrame;
+    Unlock();
+
+    return theDataFrame;
+}
+
+template <typename T>
+void NuerteyDHT11Device<T>::SetMeasurementCallback(Callback<void(const Measurement_t &)> theCallback)
+{
+    Lock();
+    m_TheMeasurementCallback = theCallback;
+    Unlock();
+}
+
+template <typename T>
+CachedMeasurement_t NuerteyDHT11Device<T>::GetCachedMeasurement(const uint32_t & theMaximumAgeMs)
+{
+    CachedMeasurement_t theCached;
+
+    Lock();
+    theCached.Measurement = GetMeasurement();
+    theCached.AgeMs       = GetAgeMs();
+
+    if ((theCached.AgeMs > theMaximumAgeMs) && (m_pTheRefreshQueue != nullptr) && (m_TheRefreshEventId == 0))
     {
-        v = m_TheDataFrame[0];
+        // EventQueue::call() does not block; should its pool be exhausted,
+        // a later caller will simply try again.
+        m_TheRefreshEventId = m_pTheRefreshQueue->call(this, &NuerteyDHT11Device<T>::Refresh);
     }
-    else if constexpr (std::is_same<T, DHT22_t>::value)
+    theCached.IsRefreshScheduled = (m_TheRefreshEventId != 0);
+    Unlock();
+
+    return theCached;
+}
+
+template <typename T>
+void NuerteyDHT11Device<T>::SetRefreshQueue(EventQueue * pTheEventQueue)
+{
+    Lock();
+    if ((m_pTheRefreshQueue != nullptr) && (m_TheRefreshEventId != 0))
+    {
+        m_pTheRefreshQueue->cancel(m_TheRefreshEventId);
+    }
+    m_TheRefreshEventId = 0;
+    m_pTheRefreshQueue  = pTheEventQueue;
+    Unlock();
+}
+
+template <typename T>
+void NuerteyDHT11Device<T>::Refresh()
+{
+    Lock();
+    // Zero if cancelled by SetRefreshQueue(), or the destructor, too
+    // late for the queue to drop it.
+    const auto theEventId = m_TheRefreshEventId;
+    const auto isCancelled = (theEventId == 0);
+#if DHT11_THREAD_SAFE_ENABLED
+    m_IsRefreshInFlight = !isCancelled;
+#endif
+    Unlock();
+
+    if (isCancelled)
+    {
+        return;
+    }
+
+    (void)ReadData();
+
+    Lock();
+    // Unless a new queue has since been set, and a refresh posted to it.
+    if (m_TheRefreshEventId == theEventId)
     {
-        v = m_TheDataFrame[0];
-        v *= 256;
-        v += m_TheDataFrame[1];
-        v /= 10;
+        m_TheRefreshEventId = 0;
     }
+#if DHT11_THREAD_SAFE_ENABLED
+    m_IsRefreshInFlight = false;
+    m_TheReadCompleted.notify_all();
+#endif
+    Unlock();
+}
 
-    return (static_cast<float>(v));
+template <typename T>
+uint32_t NuerteyDHT11Device<T>::GetAgeMs() const
+{
+    if (m_TheLastSampleTimeUs == 0)
+    {
+        return UINT32_MAX;
+    }
+
+    const auto theAgeMs = (ticker_read_us(get_us_ticker_data()) - m_TheLastSampleTimeUs) / 1000;
+    return (theAgeMs < UINT32_MAX) ? static_cast<uint32_t>(theAgeMs) : UINT32_MAX;
 }
 
 template <typename T>
-float NuerteyDHT11Device<T>::ConvertCelsiusToFarenheit(const float & celsius) const
+void NuerteyDHT11Device<T>::SetCalibrationEnabled(const bool & isEnabled)
 {
-    return ((celsius * 9/5) + 32);
+    Lock();
+    m_IsCalibrationEnabled = isEnabled;
+    Unlock();
 }
 
 template <typename T>
-float NuerteyDHT11Device<T>::ConvertCelsiusToKelvin(const float & celsius) const
+bool NuerteyDHT11Device<T>::IsCalibrationEnabled() const
 {
-    return (celsius + 273.15);
+    Lock();
+    const auto isEnabled = m_IsCalibrationEnabled;
+    Unlock();
+
+    return isEnabled;
 }
 
 template <typename T>
-float NuerteyDHT11Device<T>::GetHumidity() const
+void NuerteyDHT11Device<T>::SetTimingProfile(const TimingProfile_t & theProfile)
 {
-    return m_TheLastHumidity;
+    // Refuse anything (e.g. a corrupted persisted profile) that would
+    // stop us from decoding altogether.
+    if (IsTimingProfilePlausible(theProfile))
+    {
+        Lock();
+        m_TheTimingProfile = theProfile;
+        Unlock();
+    }
+}
+
+template <typename T>
+TimingProfile_t NuerteyDHT11Device<T>::GetTimingProfile() const
+{
+    Lock();
+    const auto theProfile = m_TheTimingProfile;
+    Unlock();
+
+    return theProfile;
+}
+
+template <typename T>
+void NuerteyDHT11Device<T>::SetReadingCalibration(const ReadingCalibration_t & theCalibration)
+{
+    if (IsReadingCalibrationPlausible(theCalibration))
+    {
+        Lock();
+        m_TheReadingCalibration = theCalibration;
+        Unlock();
+    }
+}
+
+template <typename T>
+ReadingCalibration_t NuerteyDHT11Device<T>::GetReadingCalibration() const
+{
+    Lock();
+    const auto theCalibration = m_TheReadingCalibration;
+    Unlock();
+
+    return theCalibration;
 }
 
 template <typename T>
@@ -534,17 +839,21 @@ float NuerteyDHT11Device<T>::GetTemperature(const TemperatureScale_t & Scale) co
 {
     auto result = 0.0;
 
+    Lock();
+    const auto theTemperature = m_TheLastTemperature;
+    Unlock();
+
     if (Scale == TemperatureScale_t::FARENHEIT)
     {
-        result = ConvertCelsiusToFarenheit(m_TheLastTemperature);
+        result = ConvertCelsiusToFarenheit(theTemperature);
     }
     else if (Scale == TemperatureScale_t::KELVIN)
     {
-        result = ConvertCelsiusToKelvin(m_TheLastTemperature);
+        result = ConvertCelsiusToKelvin(theTemperature);
     }
     else
     {
-        result = m_TheLastTemperature;
+        result = theTemperature;
     }
 
     return result;
@@ -553,30 +862,36 @@ float NuerteyDHT11Device<T>::GetTemperature(const TemperatureScale_t & Scale) co
 template <typename T>
 float NuerteyDHT11Device<T>::CalculateDewPoint(const float & celsius, const float & humidity) const
 {
-    // dewPoint function NOAA
-    // reference: http://wahiduddin.net/calc/density_algorithms.htm
-    float A0= 373.15/(273.15 + celsius);
-    float SUM = -7.90298 * (A0-1);
-    SUM += 5.02808 * log10(A0);
-    SUM += -1.3816e-7 * (pow(10, (11.344*(1-1/A0)))-1) ;
-    SUM += 8.1328e-3 * (pow(10,(-3.49149*(A0-1)))-1) ;
-    SUM += log10(1013.246);
-    float VP = pow(10, SUM-3) * humidity;
-    float tempVar = log(VP/0.61078);   // temp var
-
-    return (241.88 * tempVar) / (17.558 - tempVar);
+    return ::CalculateDewPoint(celsius, humidity);
 }
 
 template <typename T>
 float NuerteyDHT11Device<T>::CalculateDewPointFast(const float & celsius, const float & humidity) const
 {
-    // delta max = 0.6544 wrt dewPoint()
-    // 5x faster than dewPoint()
-    // reference: http://en.wikipedia.org/wiki/Dew_point
-    float a = 17.271;
-    float b = 237.7;
-    float temp = (a * celsius) / (b + celsius) + log(humidity/100);
-    float Td = (b * temp) / (a - temp);
+    return ::CalculateDewPointFast(celsius, humidity);
+}
+
+template <typename T>
+void NuerteyDHT11Device<T>::SetCaptureBufferPool(NuerteyCaptureBufferPool * pThePool, const uint32_t & theLeaseTimeoutMs)
+{
+    Lock();
+    m_pTheCaptureBufferPool = pThePool;
+    m_TheCaptureLeaseTimeoutMs = theLeaseTimeoutMs;
+    Unlock();
+}
+
+template <typename T>
+void NuerteyDHT11Device<T>::Lock() const
+{
+#if DHT11_THREAD_SAFE_ENABLED
+    m_TheMutex.lock();
+#endif
+}
 
-    return Td;
+template <typename T>
+void NuerteyDHT11Device<T>::Unlock() const
+{
+#if DHT11_THREAD_SAFE_ENABLED
+    m_TheMutex.unlock();
+#endif
 }
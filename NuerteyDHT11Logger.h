@@ -0,0 +1,511 @@
+/***********************************************************************
+* @file      NuerteyDHT11Logger.h
+*
+*    Structured, deferred and rate-limited logging facade for the
+*    DHT11/DHT22 sensor driver targetted for ARM Mbed platform.
+*
+* @brief   Replace formatted printf calls in the sampling path with the
+*          enqueueing of small, fixed-size log records into a lock-free
+*          ring. A low-priority thread drains the ring and does all the
+*          (integer-only) formatting and console I/O.
+*
+* @note    At 9600 baud, each character takes over a millisecond to
+*          leave the UART. Printing a couple of lines per sample used to
+*          block the sampling loop for tens of milliseconds, and the %f
+*          conversions dragged floating point printf into the image.
+*          Logging a record now costs a handful of atomic operations and
+*          a ~32 byte copy, and never blocks: when the ring is full the
+*          record is dropped and counted instead.
+*
+*          In trace mode, reads are logged as compact records of the raw
+*          data frame instead (see NuerteyDHT11Trace.h), leaving all of
+*          the decoding and formatting to the host-side decoder. An
+*          epoch line, pairing the trace timestamps with time(NULL), is
+*          logged on Start() and on every LogEpoch(), so that host tools
+*          can place each boot's records on the wall clock.
+*
+*          Repeated identical errors (same sensor, same status) are
+*          rate-limited by the drain thread: only the first is printed,
+*          subsequent ones within REPEAT_SUPPRESSION_WINDOW_MS are
+*          counted and summarized once the streak ends or the window
+*          expires. Streaks are tracked per sensor, for up to
+*          REPEAT_TRACKER_COUNT sensors at once, so that sensors failing
+*          in turn do not keep ending each other's streaks.
+*
+* @warning The ring is multi-producer safe but must only ever be drained
+*          by the logger's own thread.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdio>
+#include <array>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+#include "NuerteyDHT11Trace.h"
+#include "NuerteyMpscQueue.h"
+
+enum class LogLevel_t : uint8_t
+{
+    DEBUG = 0,
+    INFO,
+    WARNING,
+    ERROR,
+    NONE
+};
+
+enum class LogEvent_t : uint8_t
+{
+    TEXT = 0,
+    MEASUREMENT,
+    READ_ERROR,
+    TRACE,
+    EPOCH
+};
+
+// Plain-old-data record; no formatting happens at the call site.
+struct LogRecord_t
+{
+    uint32_t       TimestampMs;
+    LogLevel_t     Level;
+    LogEvent_t     Event;
+    SensorStatus_t Status;
+    PinName        SensorPin;
+    int16_t        TemperatureTenths;
+    uint16_t       HumidityTenths;
+    SensorModel_t  Model;
+    DataFrame_t    Frame;              // Raw frame, in trace mode only.
+    const char *   Text;               // Must have static storage duration.
+};
+
+template <std::size_t RING_CAPACITY = 32>
+class NuerteyDHT11Logger
+{
+public:
+    static constexpr uint32_t DRAIN_IDLE_PERIOD_MS         =    50;
+    static constexpr uint32_t REPEAT_SUPPRESSION_WINDOW_MS = 60000;
+    static constexpr uint32_t DRAIN_THREAD_STACK_SIZE      =  2048;
+    static constexpr std::size_t REPEAT_TRACKER_COUNT      =     8;
+
+    NuerteyDHT11Logger(const LogLevel_t & theLevel = LogLevel_t::INFO);
+
+    NuerteyDHT11Logger(const NuerteyDHT11Logger&) = delete;
+    NuerteyDHT11Logger& operator=(const NuerteyDHT11Logger&) = delete;
+
+    virtual ~NuerteyDHT11Logger();
+
+    // Spawns the low-priority drain thread, logging an epoch first in
+    // trace mode. The destructor stops and joins it, once it has
+    // emitted whatever is still in the ring.
+    void Start();
+
+    void SetLevel(const LogLevel_t & theLevel) { m_TheLevel.store(theLevel, std::memory_order_relaxed); }
+    LogLevel_t GetLevel() const { return m_TheLevel.load(std::memory_order_relaxed); }
+
+    void SetTraceMode(const bool & isEnabled) { m_IsTraceMode.store(isEnabled, std::memory_order_relaxed); }
+    bool IsTraceMode() const { return m_IsTraceMode.load(std::memory_order_relaxed); }
+
+    // All of the following are non-blocking and safe to call from any
+    // thread. They return false if the record was filtered or dropped.
+    bool Log(const LogLevel_t & theLevel, const char * theStaticText);
+    bool LogMeasurement(const Measurement_t & theMeasurement);
+    bool LogReadResult(const Measurement_t & theMeasurement);
+
+    // Logs the outcome of theDevice's latest ReadData(): as a raw frame
+    // trace in trace mode, otherwise as per LogReadResult().
+    template <typename Device>
+    bool LogRead(const Device & theDevice);
+
+    // In trace mode, logs the current time(NULL) against the trace
+    // timestamp clock. Call it again whenever the RTC has been set, e.g.
+    // via set_time() after an NTP sync.
+    bool LogEpoch();
+
+    uint32_t GetDroppedCount() const { return m_TheRing.GetOverflowCount(); }
+
+protected:
+
+private:
+    struct RepeatTracker_t
+    {
+        bool           Active;
+        PinName        SensorPin;
+        SensorStatus_t Status;
+        uint32_t       FirstTimestampMs;
+        uint32_t       SuppressedCount;
+    };
+
+    void Drain();
+    void Emit(const LogRecord_t & theRecord);
+    RepeatTracker_t & FindTracker(const PinName & theSensorPin);
+    void FlushRepeats(RepeatTracker_t & theTracker, const uint32_t & theNowMs, const bool & isForced);
+
+    static const char * LevelLabel(const LogLevel_t & theLevel);
+    static void PrintTenths(const char * thePrefix, const int & theTenths, const char * theSuffix);
+
+    std::atomic<LogLevel_t>                         m_TheLevel;
+    std::atomic<bool>                               m_IsTraceMode;
+    NuerteyMpscQueue<LogRecord_t, RING_CAPACITY>    m_TheRing;
+    uint32_t                                        m_TheReportedDroppedCount;
+    std::array<RepeatTracker_t, REPEAT_TRACKER_COUNT> m_TheRepeatTrackers;
+    Thread                                          m_TheDrainThread;
+    bool                                            m_IsStarted;
+    std::atomic<bool>                               m_IsStopRequested;
+};
+
+template <std::size_t RING_CAPACITY>
+NuerteyDHT11Logger<RING_CAPACITY>::NuerteyDHT11Logger(const LogLevel_t & theLevel)
+    : m_TheLevel(theLevel)
+    , m_IsTraceMode(false)
+    , m_TheReportedDroppedCount(0)
+    , m_TheRepeatTrackers{}
+    , m_TheDrainThread(osPriorityLow, DRAIN_THREAD_STACK_SIZE)
+    , m_IsStarted(false)
+    , m_IsStopRequested(false)
+{
+}
+
+template <std::size_t RING_CAPACITY>
+NuerteyDHT11Logger<RING_CAPACITY>::~NuerteyDHT11Logger()
+{
+    if (m_IsStarted)
+    {
+        // Seen within DRAIN_IDLE_PERIOD_MS at most.
+        m_IsStopRequested.store(true, std::memory_order_release);
+        m_TheDrainThread.join();
+    }
+}
+
+template <std::size_t RING_CAPACITY>
+void NuerteyDHT11Logger<RING_CAPACITY>::Start()
+{
+    if (!m_IsStarted)
+    {
+        m_IsStarted = true;
+        (void)LogEpoch();
+        m_TheDrainThread.start(callback(this, &NuerteyDHT11Logger<RING_CAPACITY>::Drain));
+    }
+}
+
+template <std::size_t RING_CAPACITY>
+bool NuerteyDHT11Logger<RING_CAPACITY>::Log(const LogLevel_t & theLevel, const char * theStaticText)
+{
+    if (theLevel < GetLevel())
+    {
+        return false;
+    }
+
+    LogRecord_t theRecord{};
+    theRecord.TimestampMs = static_cast<uint32_t>(Kernel::get_ms_count());
+    theRecord.Level = theLevel;
+    theRecord.Event = LogEvent_t::TEXT;
+    theRecord.Text = theStaticText;
+
+    return m_TheRing.Push(theRecord);
+}
+
+template <std::size_t RING_CAPACITY>
+bool NuerteyDHT11Logger<RING_CAPACITY>::LogMeasurement(const Measurement_t & theMeasurement)
+{
+    if (LogLevel_t::INFO < GetLevel())
+    {
+        return false;
+    }
+
+    LogRecord_t theRecord{};
+    theRecord.TimestampMs = static_cast<uint32_t>(Kernel::get_ms_count());
+    theRecord.Level = LogLevel_t::INFO;
+    theRecord.Event = LogEvent_t::MEASUREMENT;
+    theRecord.Status = theMeasurement.Status;
+    theRecord.SensorPin = theMeasurement.SensorPin;
+    theRecord.TemperatureTenths = theMeasurement.TemperatureTenths;
+    theRecord.HumidityTenths = theMeasurement.HumidityTenths;
+
+    return m_TheRing.Push(theRecord);
+}
+
+template <std::size_t RING_CAPACITY>
+bool NuerteyDHT11Logger<RING_CAPACITY>::LogReadResult(const Measurement_t & theMeasurement)
+{
+    if (theMeasurement.Status == SensorStatus_t::SUCCESS)
+    {
+        return LogMeasurement(theMeasurement);
+    }
+
+    if (LogLevel_t::ERROR < GetLevel())
+    {
+        return false;
+    }
+
+    LogRecord_t theRecord{};
+    theRecord.TimestampMs = static_cast<uint32_t>(Kernel::get_ms_count());
+    theRecord.Level = LogLevel_t::ERROR;
+    theRecord.Event = LogEvent_t::READ_ERROR;
+    theRecord.Status = theMeasurement.Status;
+    theRecord.SensorPin = theMeasurement.SensorPin;
+
+    return m_TheRing.Push(theRecord);
+}
+
+template <std::size_t RING_CAPACITY>
+template <typename Device>
+bool NuerteyDHT11Logger<RING_CAPACITY>::LogRead(const Device & theDevice)
+{
+    const auto theMeasurement = theDevice.GetMeasurement();
+
+    if (!IsTraceMode())
+    {
+        return LogReadResult(theMeasurement);
+    }
+
+    // Traces are the whole point of the mode; they bypass level filtering.
+    LogRecord_t theRecord{};
+    theRecord.TimestampMs = static_cast<uint32_t>(Kernel::get_ms_count());
+    theRecord.Level = (theMeasurement.Status == SensorStatus_t::SUCCESS) ? LogLevel_t::INFO : LogLevel_t::ERROR;
+    theRecord.Event = LogEvent_t::TRACE;
+    theRecord.Status = theMeasurement.Status;
+    theRecord.SensorPin = theMeasurement.SensorPin;
+    theRecord.Model = Device::SENSOR_MODEL;
+    theRecord.Frame = theDevice.GetDataFrame();
+
+    return m_TheRing.Push(theRecord);
+}
+
+template <std::size_t RING_CAPACITY>
+bool NuerteyDHT11Logger<RING_CAPACITY>::LogEpoch()
+{
+    if (!IsTraceMode())
+    {
+        return false;
+    }
+
+    // Both clocks are sampled on the drain thread, side by side, when
+    // the epoch is emitted.
+    LogRecord_t theRecord{};
+    theRecord.Level = LogLevel_t::INFO;
+    theRecord.Event = LogEvent_t::EPOCH;
+
+    return m_TheRing.Push(theRecord);
+}
+
+template <std::size_t RING_CAPACITY>
+void NuerteyDHT11Logger<RING_CAPACITY>::Drain()
+{
+    LogRecord_t theRecord;
+
+    while (true)
+    {
+        // Read first, so that the last pass still emits every record
+        // logged before the stop request, and summarizes open streaks.
+        const auto isStopping = m_IsStopRequested.load(std::memory_order_acquire);
+
+        while (m_TheRing.Pop(theRecord))
+        {
+            Emit(theRecord);
+        }
+
+        auto theNowMs = static_cast<uint32_t>(Kernel::get_ms_count());
+        for (auto & theTracker : m_TheRepeatTrackers)
+        {
+            FlushRepeats(theTracker, theNowMs, isStopping);
+        }
+
+        auto theDroppedCount = GetDroppedCount();
+        if (theDroppedCount != m_TheReportedDroppedCount)
+        {
+            printf("[WARN ] %lums logger: %lu record(s) dropped, ring full\r\n",
+                   static_cast<unsigned long>(theNowMs),
+                   static_cast<unsigned long>(theDroppedCount - m_TheReportedDroppedCount));
+            m_TheReportedDroppedCount = theDroppedCount;
+        }
+
+        if (isStopping)
+        {
+            return;
+        }
+
+        ThisThread::sleep_for(DRAIN_IDLE_PERIOD_MS);
+    }
+}
+
+template <std::size_t RING_CAPACITY>
+void NuerteyDHT11Logger<RING_CAPACITY>::Emit(const LogRecord_t & theRecord)
+{
+    if (theRecord.Event == LogEvent_t::TRACE)
+    {
+        // No rate-limiting, and no decoration; the host decoder wants
+        // to see every read exactly as it happened.
+        TraceRecord_t theTrace;
+        theTrace.TimestampMs = theRecord.TimestampMs;
+        theTrace.SensorPin = static_cast<uint16_t>(theRecord.SensorPin);
+        theTrace.Model = theRecord.Model;
+        theTrace.Status = theRecord.Status;
+        theTrace.Frame = theRecord.Frame;
+
+        char theLine[TRACE_LINE_LENGTH + 1];
+        FormatTraceLine(theTrace, theLine);
+        printf("%s\r\n", theLine);
+        return;
+    }
+
+    if (theRecord.Event == LogEvent_t::EPOCH)
+    {
+        TraceEpoch_t theEpoch;
+        theEpoch.TimestampMs = static_cast<uint32_t>(Kernel::get_ms_count());
+        theEpoch.UnixTimeS = static_cast<int64_t>(time(NULL));
+
+        char theLine[TRACE_LINE_LENGTH + 1];
+        FormatEpochLine(theEpoch, theLine);
+        printf("%s\r\n", theLine);
+        return;
+    }
+
+    if (theRecord.Event == LogEvent_t::READ_ERROR)
+    {
+        auto & theTracker = FindTracker(theRecord.SensorPin);
+        if (theTracker.Active && (theTracker.SensorPin == theRecord.SensorPin)
+                              && (theTracker.Status == theRecord.Status)
+                              && ((theRecord.TimestampMs - theTracker.FirstTimestampMs) < REPEAT_SUPPRESSION_WINDOW_MS))
+        {
+            ++theTracker.SuppressedCount;
+            return;
+        }
+
+        // A different error, the window expired, or the slot is being
+        // taken over; summarize the old streak before tracking the new.
+        FlushRepeats(theTracker, theRecord.TimestampMs, true);
+        theTracker.Active = true;
+        theTracker.SensorPin = theRecord.SensorPin;
+        theTracker.Status = theRecord.Status;
+        theTracker.FirstTimestampMs = theRecord.TimestampMs;
+        theTracker.SuppressedCount = 0;
+    }
+    else if (theRecord.Event == LogEvent_t::MEASUREMENT)
+    {
+        // The sensor recovered; its error streak, if any, has ended.
+        auto & theTracker = FindTracker(theRecord.SensorPin);
+        if (theTracker.Active && (theTracker.SensorPin == theRecord.SensorPin))
+        {
+            FlushRepeats(theTracker, theRecord.TimestampMs, true);
+        }
+    }
+
+    printf("[%s] %lums ", LevelLabel(theRecord.Level), static_cast<unsigned long>(theRecord.TimestampMs));
+
+    switch (theRecord.Event)
+    {
+        case LogEvent_t::MEASUREMENT:
+        {
+            // The dew point is derived here, on the drain thread, rather
+            // than costing the sampling path anything; in fixed point, so
+            // that the drain thread never touches the FPU either.
+            const auto theDewPointTenths = CalculateDewPointTenths(theRecord.TemperatureTenths,
+                                                                   theRecord.HumidityTenths);
+
+            printf("dht@%d", static_cast<int>(theRecord.SensorPin));
+            PrintTenths(" T=", theRecord.TemperatureTenths, "C");
+            PrintTenths(" H=", theRecord.HumidityTenths, "%");
+            PrintTenths(" DP=", theDewPointTenths, "C\r\n");
+            break;
+        }
+
+        case LogEvent_t::READ_ERROR:
+            printf("dht@%d read failed: [%d] -> %s\r\n", static_cast<int>(theRecord.SensorPin),
+                   ToUnderlyingType(theRecord.Status), make_error_code(theRecord.Status).message().c_str());
+            break;
+
+        case LogEvent_t::TEXT:
+        default:
+            printf("%s\r\n", (theRecord.Text != nullptr) ? theRecord.Text : "");
+            break;
+    }
+}
+
+template <std::size_t RING_CAPACITY>
+typename NuerteyDHT11Logger<RING_CAPACITY>::RepeatTracker_t &
+NuerteyDHT11Logger<RING_CAPACITY>::FindTracker(const PinName & theSensorPin)
+{
+    // The sensor's own tracker if it has one, else a free one, else the
+    // one whose streak began the longest ago.
+    RepeatTracker_t * pTheFree = nullptr;
+    RepeatTracker_t * pTheOldest = &m_TheRepeatTrackers[0];
+
+    for (auto & theTracker : m_TheRepeatTrackers)
+    {
+        if (!theTracker.Active)
+        {
+            if (pTheFree == nullptr)
+            {
+                pTheFree = &theTracker;
+            }
+            continue;
+        }
+
+        if (theTracker.SensorPin == theSensorPin)
+        {
+            return theTracker;
+        }
+
+        if (static_cast<int32_t>(theTracker.FirstTimestampMs - pTheOldest->FirstTimestampMs) < 0)
+        {
+            pTheOldest = &theTracker;
+        }
+    }
+
+    return (pTheFree != nullptr) ? *pTheFree : *pTheOldest;
+}
+
+template <std::size_t RING_CAPACITY>
+void NuerteyDHT11Logger<RING_CAPACITY>::FlushRepeats(RepeatTracker_t & theTracker, const uint32_t & theNowMs,
+                                                     const bool & isForced)
+{
+    if (!theTracker.Active)
+    {
+        return;
+    }
+
+    if (!isForced && ((theNowMs - theTracker.FirstTimestampMs) < REPEAT_SUPPRESSION_WINDOW_MS))
+    {
+        return;
+    }
+
+    if (theTracker.SuppressedCount > 0)
+    {
+        printf("[%s] %lums dht@%d last error [%d] repeated %lu more time(s)\r\n",
+               LevelLabel(LogLevel_t::ERROR), static_cast<unsigned long>(theNowMs),
+               static_cast<int>(theTracker.SensorPin), ToUnderlyingType(theTracker.Status),
+               static_cast<unsigned long>(theTracker.SuppressedCount));
+    }
+
+    theTracker.Active = false;
+}
+
+template <std::size_t RING_CAPACITY>
+const char * NuerteyDHT11Logger<RING_CAPACITY>::LevelLabel(const LogLevel_t & theLevel)
+{
+    switch (theLevel)
+    {
+        case LogLevel_t::DEBUG:   return "DEBUG";
+        case LogLevel_t::INFO:    return "INFO ";
+        case LogLevel_t::WARNING: return "WARN ";
+        case LogLevel_t::ERROR:   return "ERROR";
+        default:                  return "?????";
+    }
+}
+
+template <std::size_t RING_CAPACITY>
+void NuerteyDHT11Logger<RING_CAPACITY>::PrintTenths(const char * thePrefix, const int & theTenths, const char * theSuffix)
+{
+    // Integer-only rendition of a fixed-point value; e.g. -53 -> "-5.3".
+    printf("%s%s%d.%d%s", thePrefix, (theTenths < 0) ? "-" : "",
+           abs(theTenths) / 10, abs(theTenths) % 10, theSuffix);
+}
@@ -0,0 +1,672 @@
+/***********************************************************************
+* @file      NuerteyDHT11Protocol.h
+*
+*    Platform-independent definitions of the DHT11/DHT22 single-wire
+*    protocol shared by the Mbed driver and by host-side tooling.
+*
+* @brief   Status codes and their std::error_code integration, sensor
+*          module tag types, and the pure functions that validate and
+*          decode a raw 40-bit data frame.
+*
+* @note    Nothing in here depends upon Mbed OS, so that traces, logs
+*          and raw frames captured on a node can be decoded off-target
+*          with exactly the same arithmetic the driver itself uses.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <type_traits>
+#include <system_error>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <array>
+#include <algorithm>
+
+// Enforce that these errors should always be checked whenever and 
+// whereever they are returned.
+
+// TBD: Nuertey Odzeyem; double-check if the below actually does imply
+// that we dont need a SUCCESS value in the enum and consequent message()
+// translation. What would message() print out then?
+//
+// "Whatever the reason for failure, after create_directory() returns, 
+// the error_code object ec will contain the OS-specific error code. On 
+// the other hand, if the call was successful then ec contains a zero 
+// value. This follows the tradition (used by errno and GetLastError())
+// of having 0 indicate success and non-zero indicate failure."
+enum class [[nodiscard]] SensorStatus_t : int8_t
+{
+    SUCCESS              =  0,
+    ERROR_BUS_BUSY       = -1,
+    ERROR_NOT_DETECTED   = -2,
+    ERROR_ACK_TOO_LONG   = -3,
+    ERROR_SYNC_TIMEOUT   = -4,
+    ERROR_DATA_TIMEOUT   = -5,
+    ERROR_BAD_CHECKSUM   = -6,
+    ERROR_TOO_FAST_READS = -7
+};
+
+enum class TemperatureScale_t : uint8_t
+{
+    CELCIUS = 0,
+    FARENHEIT,
+    KELVIN
+};
+
+template <typename T, typename U>
+struct TrueTypesEquivalent : std::is_same<typename std::decay<T>::type, U>::type
+{};
+
+template <typename E>
+constexpr auto ToUnderlyingType(E e) -> typename std::underlying_type<E>::type
+{
+    return static_cast<typename std::underlying_type<E>::type>(e);
+}
+
+template <typename E, typename V = int8_t>
+constexpr auto ToEnum(V value) -> E
+{
+    return static_cast<E>(value);
+}
+
+// Register for implicit conversion to error_code:
+//
+// For the SensorStatus_t enumerators to be usable as error_code constants,
+// enable the conversion constructor using the is_error_code_enum type trait:
+namespace std
+{
+    template <>
+    struct is_error_code_enum<SensorStatus_t> : std::true_type {};
+}
+
+class DHT11ErrorCategory : public std::error_category
+{
+public:
+    virtual const char* name() const noexcept override;
+    virtual std::string message(int ev) const override;
+};
+
+inline const char* DHT11ErrorCategory::name() const noexcept
+{
+    return "DHT11-Sensor-Mbed";
+}
+
+inline std::string DHT11ErrorCategory::message(int ev) const
+{
+    switch (ToEnum<SensorStatus_t>(ev))
+    {
+        case SensorStatus_t::SUCCESS:
+            return "Success - no errors";
+            
+        case SensorStatus_t::ERROR_BUS_BUSY:
+            return "Communication failure - bus busy";
+
+        case SensorStatus_t::ERROR_NOT_DETECTED:
+            return "Communication failure - sensor not detected on bus";
+
+        case SensorStatus_t::ERROR_ACK_TOO_LONG:
+            return "Communication failure - ack too long";
+
+        case SensorStatus_t::ERROR_SYNC_TIMEOUT:
+            return "Communication failure - sync timeout";
+
+        case SensorStatus_t::ERROR_DATA_TIMEOUT:
+            return "Communication failure - data timeout";
+
+        case SensorStatus_t::ERROR_BAD_CHECKSUM:
+            return "Checksum error";
+
+        case SensorStatus_t::ERROR_TOO_FAST_READS:
+            return "Communication failure - too fast reads";            
+        default:
+            return "(unrecognized error)";
+    }
+}
+
+inline const std::error_category& dht11_error_category()
+{
+    static DHT11ErrorCategory instance;
+    return instance;
+}
+
+inline auto make_error_code(SensorStatus_t e)
+{
+    return std::error_code(ToUnderlyingType(e), dht11_error_category());
+}
+
+inline auto make_error_condition(SensorStatus_t e)
+{
+    return std::error_condition(ToUnderlyingType(e), dht11_error_category());
+}
+
+// Metaprogramming types to distinguish each sensor module type:
+struct DHT11_t {};
+struct DHT22_t {};
+
+// Run-time counterpart of the tag types above, for serialized formats.
+enum class SensorModel_t : uint8_t
+{
+    DHT11 = 0,
+    DHT22 = 1
+};
+
+template <typename T>
+constexpr SensorModel_t ToSensorModel()
+{
+    static_assert(TrueTypesEquivalent<T, DHT11_t>::value
+               || TrueTypesEquivalent<T, DHT22_t>::value,
+    "Hey! Only DHT11, or DHT22 sensor modules are supported!!");
+
+    return (std::is_same<T, DHT22_t>::value ? SensorModel_t::DHT22 : SensorModel_t::DHT11);
+}
+
+static constexpr uint8_t SINGLE_BUS_DATA_FRAME_SIZE_BYTES = 5;
+
+using DataFrame_t = std::array<uint8_t, SINGLE_BUS_DATA_FRAME_SIZE_BYTES>;
+
+// Per the sensor device specs./data sheet, the last byte of the frame
+// is the 8-bit sum of the preceding four.
+inline bool IsChecksumValid(const DataFrame_t & theDataFrame)
+{
+    return (theDataFrame[4] == ((theDataFrame[0] + theDataFrame[1] + theDataFrame[2] + theDataFrame[3]) & 0xFF));
+}
+
+// Temperature in tenths of a degree Celsius.
+template <typename T>
+inline int16_t DecodeTemperatureTenths(const DataFrame_t & theDataFrame)
+{
+    static_assert(TrueTypesEquivalent<T, DHT11_t>::value
+               || TrueTypesEquivalent<T, DHT22_t>::value,
+    "Hey! Only DHT11, or DHT22 data frames can be decoded!!");
+
+    auto v = 0;
+
+    // As an alternative to SFINAE template techniques:
+    if constexpr (std::is_same<T, DHT11_t>::value)
+    {
+        v = theDataFrame[2] * 10;
+    }
+    else if constexpr (std::is_same<T, DHT22_t>::value)
+    {
+        // The DHT22 already reports in tenths of a degree, with the sign
+        // carried in the MSB of the high byte.
+        v = theDataFrame[2] & 0x7F;
+        v *= 256;
+        v += theDataFrame[3];
+
+        if (theDataFrame[2] & 0x80)
+        {
+            v *= -1;
+        }
+    }
+
+    return (static_cast<int16_t>(v));
+}
+
+// Relative humidity in tenths of a percent.
+template <typename T>
+inline uint16_t DecodeHumidityTenths(const DataFrame_t & theDataFrame)
+{
+    static_assert(TrueTypesEquivalent<T, DHT11_t>::value
+               || TrueTypesEquivalent<T, DHT22_t>::value,
+    "Hey! Only DHT11, or DHT22 data frames can be decoded!!");
+
+    auto v = 0;
+
+    // As an alternative to SFINAE template techniques:
+    if constexpr (std::is_same<T, DHT11_t>::value)
+    {
+        v = theDataFrame[0] * 10;
+    }
+    else if constexpr (std::is_same<T, DHT22_t>::value)
+    {
+        v = theDataFrame[0];
+        v *= 256;
+        v += theDataFrame[1];
+    }
+
+    return (static_cast<uint16_t>(v));
+}
+
+// Per-sensor bit timing. Each data bit is signalled as a ~50us low 
+// followed by a high whose width encodes the bit: 26-28us for a '0' and
+// ~70us for a '1'. Long cables and weak pull-ups skew both widths (the
+// rising edge slows down), hence the decode threshold is learnable.
+struct TimingProfile_t
+{
+    uint8_t ZeroHighUs;      // Mean observed width of a '0' high phase.
+    uint8_t OneHighUs;       // Mean observed width of a '1' high phase.
+    uint8_t ThresholdUs;     // High phases wider than this decode as '1'.
+    uint8_t LearnedReads;    // Saturating count of reads learned from.
+};
+
+// The threshold matches the driver's original fixed 40us sample point.
+static constexpr TimingProfile_t DEFAULT_TIMING_PROFILE    = { 27, 70, 40, 0 };
+static constexpr uint8_t         MINIMUM_ZERO_HIGH_US      =  8;
+static constexpr uint8_t         MAXIMUM_ONE_HIGH_US       = 90;
+static constexpr uint8_t         TIMING_PROFILE_EMA_SHIFT  =  2; // Weight new reads 1/4.
+
+inline bool IsTimingProfilePlausible(const TimingProfile_t & theProfile)
+{
+    return ((theProfile.ZeroHighUs >= MINIMUM_ZERO_HIGH_US)
+         && (theProfile.ZeroHighUs < theProfile.ThresholdUs)
+         && (theProfile.ThresholdUs < theProfile.OneHighUs)
+         && (theProfile.OneHighUs <= MAXIMUM_ONE_HIGH_US));
+}
+
+// Refine theProfile from the measured high phase widths of a frame whose
+// checksum has already been validated, i.e. whose bit classification by
+// the current threshold is known to be right.
+inline void LearnTimingProfile(TimingProfile_t & theProfile, const uint8_t * theHighWidthsUs,
+                               const std::size_t & theNumberOfBits)
+{
+    uint32_t theZeroSum = 0, theZeroCount = 0, theOneSum = 0, theOneCount = 0;
+
+    for (std::size_t i = 0; i < theNumberOfBits; ++i)
+    {
+        if (theHighWidthsUs[i] > theProfile.ThresholdUs)
+        {
+            theOneSum += theHighWidthsUs[i];
+            ++theOneCount;
+        }
+        else
+        {
+            theZeroSum += theHighWidthsUs[i];
+            ++theZeroCount;
+        }
+    }
+
+    auto theLearned = theProfile;
+    auto Blend = [&theProfile](const uint8_t & theOld, const uint32_t & theMean) -> uint8_t
+    {
+        // Adopt the first observation outright, then smooth.
+        if (theProfile.LearnedReads == 0)
+        {
+            return static_cast<uint8_t>(theMean);
+        }
+        auto delta = static_cast<int32_t>(theMean) - static_cast<int32_t>(theOld);
+        return static_cast<uint8_t>(theOld + (delta / (1 << TIMING_PROFILE_EMA_SHIFT)));
+    };
+
+    if (theZeroCount > 0)
+    {
+        theLearned.ZeroHighUs = Blend(theProfile.ZeroHighUs, (theZeroSum + (theZeroCount / 2)) / theZeroCount);
+    }
+    if (theOneCount > 0)
+    {
+        theLearned.OneHighUs = Blend(theProfile.OneHighUs, (theOneSum + (theOneCount / 2)) / theOneCount);
+    }
+
+    theLearned.ThresholdUs = static_cast<uint8_t>((theLearned.ZeroHighUs + theLearned.OneHighUs) / 2);
+    if (theLearned.LearnedReads < UINT8_MAX)
+    {
+        ++theLearned.LearnedReads;
+    }
+
+    // Never let a pathological frame walk the profile somewhere unusable.
+    if (IsTimingProfilePlausible(theLearned))
+    {
+        theProfile = theLearned;
+    }
+}
+
+// Per-sensor linear correction of the decoded fixed-point readings:
+//
+//   corrected = pivot + Offset + ((raw - pivot) * Gain) / 2^14
+//
+// Pivoting about mid-range values keeps the offset and gain estimates
+// (nearly) independent of one another. The identity leaves readings bit
+// for bit as decoded.
+struct ReadingCalibration_t
+{
+    int16_t TemperatureOffsetTenths;
+    int16_t TemperatureGain;         // Q14, i.e. 16384 == 1.0
+    int16_t HumidityOffsetTenths;
+    int16_t HumidityGain;            // Q14, i.e. 16384 == 1.0
+};
+
+static constexpr uint8_t              CALIBRATION_GAIN_FRACTION_BITS   = 14;
+static constexpr int16_t              CALIBRATION_UNITY_GAIN           = (1 << CALIBRATION_GAIN_FRACTION_BITS);
+static constexpr ReadingCalibration_t IDENTITY_READING_CALIBRATION     = { 0, CALIBRATION_UNITY_GAIN, 0, CALIBRATION_UNITY_GAIN };
+static constexpr int16_t              TEMPERATURE_CALIBRATION_PIVOT    = 250; // 25.0°C
+static constexpr int16_t              HUMIDITY_CALIBRATION_PIVOT       = 500; // 50.0%RH
+static constexpr int16_t              MAXIMUM_TEMPERATURE_OFFSET_TENTHS = 100;
+static constexpr int16_t              MAXIMUM_HUMIDITY_OFFSET_TENTHS   = 200;
+static constexpr int16_t              MINIMUM_CALIBRATION_GAIN         = CALIBRATION_UNITY_GAIN / 2;
+static constexpr int16_t              MAXIMUM_CALIBRATION_GAIN         = CALIBRATION_UNITY_GAIN + (CALIBRATION_UNITY_GAIN / 2);
+
+inline bool IsReadingCalibrationPlausible(const ReadingCalibration_t & theCalibration)
+{
+    return ((std::abs(theCalibration.TemperatureOffsetTenths) <= MAXIMUM_TEMPERATURE_OFFSET_TENTHS)
+         && (std::abs(theCalibration.HumidityOffsetTenths) <= MAXIMUM_HUMIDITY_OFFSET_TENTHS)
+         && (theCalibration.TemperatureGain >= MINIMUM_CALIBRATION_GAIN)
+         && (theCalibration.TemperatureGain <= MAXIMUM_CALIBRATION_GAIN)
+         && (theCalibration.HumidityGain >= MINIMUM_CALIBRATION_GAIN)
+         && (theCalibration.HumidityGain <= MAXIMUM_CALIBRATION_GAIN));
+}
+
+inline bool IsIdentityReadingCalibration(const ReadingCalibration_t & theCalibration)
+{
+    return ((theCalibration.TemperatureOffsetTenths == 0) && (theCalibration.HumidityOffsetTenths == 0)
+         && (theCalibration.TemperatureGain == CALIBRATION_UNITY_GAIN)
+         && (theCalibration.HumidityGain == CALIBRATION_UNITY_GAIN));
+}
+
+inline int32_t ApplyLinearCalibration(const int32_t & theRawTenths, const int32_t & thePivotTenths,
+                                      const int32_t & theOffsetTenths, const int32_t & theGain)
+{
+    // Round to nearest, symmetrically about the pivot.
+    constexpr int32_t HALF = (1 << (CALIBRATION_GAIN_FRACTION_BITS - 1));
+    const int32_t theScaled = (theRawTenths - thePivotTenths) * theGain;
+
+    return thePivotTenths + theOffsetTenths
+         + (((theScaled >= 0) ? (theScaled + HALF) : (theScaled - HALF)) / CALIBRATION_UNITY_GAIN);
+}
+
+inline int16_t CalibrateTemperatureTenths(const int16_t & theRawTenths, const ReadingCalibration_t & theCalibration)
+{
+    return static_cast<int16_t>(ApplyLinearCalibration(theRawTenths, TEMPERATURE_CALIBRATION_PIVOT,
+                                    theCalibration.TemperatureOffsetTenths, theCalibration.TemperatureGain));
+}
+
+inline uint16_t CalibrateHumidityTenths(const uint16_t & theRawTenths, const ReadingCalibration_t & theCalibration)
+{
+    const auto theTenths = ApplyLinearCalibration(theRawTenths, HUMIDITY_CALIBRATION_PIVOT,
+                                    theCalibration.HumidityOffsetTenths, theCalibration.HumidityGain);
+
+    return static_cast<uint16_t>((theTenths < 0) ? 0 : ((theTenths > 1000) ? 1000 : theTenths));
+}
+
+static constexpr uint8_t DATA_FRAME_SIZE_BITS = 40; // 5x8
+
+using BitWidths_t = std::array<uint8_t, DATA_FRAME_SIZE_BITS>;
+
+// Bus phase timeouts, in microseconds, once the MCU has released the line.
+static constexpr uint32_t RESPONSE_TIMEOUT_US  =  40; // Sensor grabs the bus 20-40us later,
+static constexpr uint32_t SYNC_LOW_TIMEOUT_US  = 100; // holds it low ~80us,
+static constexpr uint32_t SYNC_HIGH_TIMEOUT_US = 100; // then high ~80us.
+static constexpr uint32_t BIT_LOW_TIMEOUT_US   =  75; // Every bit opens with a ~50us low.
+
+// Worst case duration of the response and the 40 data bits.
+static constexpr uint32_t MAXIMUM_FRAME_DURATION_US = RESPONSE_TIMEOUT_US + SYNC_LOW_TIMEOUT_US + SYNC_HIGH_TIMEOUT_US
+                                                    + (DATA_FRAME_SIZE_BITS * (BIT_LOW_TIMEOUT_US + MAXIMUM_ONE_HIGH_US));
+
+// Level changes of one frame, counted from the MCU releasing the line: the
+// response's fall, rise and fall, a rise and a fall per data bit, and the
+// rise as the sensor finally releases the bus.
+static constexpr std::size_t DATA_FRAME_EDGE_COUNT = 3 + (2 * DATA_FRAME_SIZE_BITS) + 1;
+
+// Spin while thePin remains at level, or until max_time elapses. Pin need
+// only provide 'int Read()' and Clock 'uint32_t NowUs()', so that the
+// very same loop polls the GPIO on target and a simulated waveform on the
+// host. The timeout is measured against the clock rather than by counting
+// iterations, so that loop overhead (which varies with the target and its
+// core clock) does not stretch the effective timeout.
+template <typename Pin, typename Clock>
+inline SensorStatus_t ExpectPulse(Pin & thePin, Clock & theClock, const int & level, const uint32_t & max_time,
+                                  uint32_t * pTheElapsedUs = nullptr)
+{
+    auto result = SensorStatus_t::SUCCESS;
+
+    const uint32_t start = theClock.NowUs();
+    uint32_t elapsed = 0;
+    while (level == thePin.Read())
+    {
+        elapsed = theClock.NowUs() - start;
+        if (elapsed > max_time)
+        {
+            result = SensorStatus_t::ERROR_TOO_FAST_READS;
+            break;
+        }
+    }
+
+    if (pTheElapsedUs != nullptr)
+    {
+        *pTheElapsedUs = elapsed;
+    }
+
+    return result;
+}
+
+// Follow the sensor's response and time the high phase of each data bit.
+// Call immediately after releasing the line at the end of the start signal.
+template <typename Pin, typename Clock>
+inline SensorStatus_t CaptureBitWidths(Pin & thePin, Clock & theClock, BitWidths_t & theHighWidthsUs)
+{
+    // Wait till the sensor grabs the bus.
+    if (SensorStatus_t::SUCCESS != ExpectPulse(thePin, theClock, 1, RESPONSE_TIMEOUT_US))
+    {
+        return SensorStatus_t::ERROR_NOT_DETECTED;
+    }
+
+    // Sensor should signal low 80us and then hi 80us.
+    if (SensorStatus_t::SUCCESS != ExpectPulse(thePin, theClock, 0, SYNC_LOW_TIMEOUT_US))
+    {
+        return SensorStatus_t::ERROR_SYNC_TIMEOUT;
+    }
+
+    if (SensorStatus_t::SUCCESS != ExpectPulse(thePin, theClock, 1, SYNC_HIGH_TIMEOUT_US)) [[unlikely]]
+    {
+        return SensorStatus_t::ERROR_TOO_FAST_READS;
+    }
+
+    for (std::size_t i = 0; i < DATA_FRAME_SIZE_BITS; i++)
+    {
+        if (SensorStatus_t::SUCCESS != ExpectPulse(thePin, theClock, 0, BIT_LOW_TIMEOUT_US))
+        {
+            return SensorStatus_t::ERROR_DATA_TIMEOUT;
+        }
+
+        // logic 0 is 28us max, 1 is 70us. Rather than sampling the pin
+        // once at a fixed point, time the whole high phase; that lets the
+        // threshold adapt to the sensor.
+        uint32_t highWidthUs = 0;
+        if (SensorStatus_t::SUCCESS != ExpectPulse(thePin, theClock, 1, MAXIMUM_ONE_HIGH_US, &highWidthUs))
+        {
+            return SensorStatus_t::ERROR_DATA_TIMEOUT;
+        }
+        theHighWidthsUs[i] = static_cast<uint8_t>(highWidthUs);
+    }
+
+    return SensorStatus_t::SUCCESS;
+}
+
+// Same contract as CaptureBitWidths(), for capture paths that record the
+// timestamps of level changes (e.g. one sampling loop serving every pin of
+// a GPIO port) instead of following the line as it goes. theEdgesUs[0] is
+// the sensor's response, relative to the MCU releasing the line.
+inline SensorStatus_t DecodeEdgeTimestamps(const uint32_t * theEdgesUs, const std::size_t & theNumberOfEdges,
+                                           BitWidths_t & theHighWidthsUs)
+{
+    if ((theNumberOfEdges < 1) || (theEdgesUs[0] > RESPONSE_TIMEOUT_US))
+    {
+        return SensorStatus_t::ERROR_NOT_DETECTED;
+    }
+
+    if ((theNumberOfEdges < 2) || ((theEdgesUs[1] - theEdgesUs[0]) > SYNC_LOW_TIMEOUT_US))
+    {
+        return SensorStatus_t::ERROR_SYNC_TIMEOUT;
+    }
+
+    if ((theNumberOfEdges < 3) || ((theEdgesUs[2] - theEdgesUs[1]) > SYNC_HIGH_TIMEOUT_US))
+    {
+        return SensorStatus_t::ERROR_TOO_FAST_READS;
+    }
+
+    for (std::size_t i = 0; i < DATA_FRAME_SIZE_BITS; i++)
+    {
+        const auto theFall = 2 + (2 * i);
+
+        if ((theFall + 2) >= theNumberOfEdges)
+        {
+            return SensorStatus_t::ERROR_DATA_TIMEOUT;
+        }
+
+        const auto theLowUs  = theEdgesUs[theFall + 1] - theEdgesUs[theFall];
+        const auto theHighUs = theEdgesUs[theFall + 2] - theEdgesUs[theFall + 1];
+
+        if ((theLowUs > BIT_LOW_TIMEOUT_US) || (theHighUs > MAXIMUM_ONE_HIGH_US))
+        {
+            return SensorStatus_t::ERROR_DATA_TIMEOUT;
+        }
+        theHighWidthsUs[i] = static_cast<uint8_t>(theHighUs);
+    }
+
+    return SensorStatus_t::SUCCESS;
+}
+
+// No phase of a frame lasts longer than this; a line that has not changed
+// level for as long has been abandoned (or never answered).
+static constexpr uint32_t MAXIMUM_PHASE_US = (SYNC_LOW_TIMEOUT_US > MAXIMUM_ONE_HIGH_US) ? SYNC_LOW_TIMEOUT_US
+                                                                                        : MAXIMUM_ONE_HIGH_US;
+
+// Single-pin edge capture for DecodeEdgeTimestamps(): one tight loop that
+// only notes when the level changes, rather than following the protocol
+// phase by phase as CaptureBitWidths() does. Stops after the edges needed
+// to decode the frame (the final release is not), when the line stalls,
+// or at theCapacity; returns the number of edges recorded. Call
+// immediately after releasing the line at the end of the start signal.
+template <typename Pin, typename Clock>
+inline std::size_t CaptureEdgeTimestamps(Pin & thePin, Clock & theClock, uint32_t * theEdgesUs,
+                                         const std::size_t & theCapacity)
+{
+    const auto theLimit = (theCapacity < (DATA_FRAME_EDGE_COUNT - 1)) ? theCapacity : (DATA_FRAME_EDGE_COUNT - 1);
+    const uint32_t start = theClock.NowUs();
+    uint32_t theLastEdgeUs = 0;
+    int theLevel = 1;   // Released, hence pulled up.
+    std::size_t theCount = 0;
+
+    while (theCount < theLimit)
+    {
+        const auto theNowUs = theClock.NowUs() - start;
+        const auto theSample = thePin.Read();
+
+        if (theSample != theLevel)
+        {
+            theLevel = theSample;
+            theLastEdgeUs = theNowUs;
+            theEdgesUs[theCount++] = theNowUs;
+        }
+        else if ((theNowUs - theLastEdgeUs) > MAXIMUM_PHASE_US)
+        {
+            break;
+        }
+    }
+
+    return theCount;
+}
+
+// High phases wider than theThresholdUs decode as '1', MSB first.
+inline void AssembleDataFrame(const BitWidths_t & theHighWidthsUs, const uint8_t & theThresholdUs,
+                              DataFrame_t & theDataFrame)
+{
+    for (std::size_t i = 0; i < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; i++)
+    {
+        uint8_t b = 0;
+        for (std::size_t j = 0; j < 8; j++)
+        {
+            if (theHighWidthsUs[(i * 8) + j] > theThresholdUs)
+            {
+                b |= (1 << (7 - j));
+            }
+        }
+        theDataFrame[i] = b;
+    }
+}
+
+inline float ConvertCelsiusToFarenheit(const float & celsius)
+{
+    return ((celsius * 9/5) + 32);
+}
+
+inline float ConvertCelsiusToKelvin(const float & celsius)
+{
+    return (celsius + 273.15);
+}
+
+inline float CalculateDewPoint(const float & celsius, const float & humidity)
+{
+    // dewPoint function NOAA
+    // reference: http://wahiduddin.net/calc/density_algorithms.htm
+    float A0= 373.15/(273.15 + celsius);
+    float SUM = -7.90298 * (A0-1);
+    SUM += 5.02808 * log10(A0);
+    SUM += -1.3816e-7 * (pow(10, (11.344*(1-1/A0)))-1) ;
+    SUM += 8.1328e-3 * (pow(10,(-3.49149*(A0-1)))-1) ;
+    SUM += log10(1013.246);
+    float VP = pow(10, SUM-3) * humidity;
+    float tempVar = log(VP/0.61078);   // temp var
+
+    return (241.88 * tempVar) / (17.558 - tempVar);
+}
+
+inline float CalculateDewPointFast(const float & celsius, const float & humidity)
+{
+    // delta max = 0.6544 wrt dewPoint()
+    // 5x faster than dewPoint()
+    // reference: http://en.wikipedia.org/wiki/Dew_point
+    float a = 17.271;
+    float b = 237.7;
+    float temp = (a * celsius) / (b + celsius) + log(humidity/100);
+    float Td = (b * temp) / (a - temp);
+
+    return Td;
+}
+
+// log2(theValue) in Q16, theValue > 0, by repeated squaring of the
+// normalized mantissa; one bit of fraction per iteration.
+inline int32_t Log2Q16(const uint32_t & theValue)
+{
+    uint64_t theMantissa = static_cast<uint64_t>(theValue) << 16;
+    int32_t  theResult = 0;
+
+    while (theMantissa >= (2ULL << 16))
+    {
+        theMantissa >>= 1;
+        theResult += (1 << 16);
+    }
+
+    for (int32_t theBit = (1 << 15); theBit > 0; theBit >>= 1)
+    {
+        theMantissa = (theMantissa * theMantissa) >> 16;
+        if (theMantissa >= (2ULL << 16))
+        {
+            theMantissa >>= 1;
+            theResult += theBit;
+        }
+    }
+
+    return theResult;
+}
+
+// CalculateDewPointFast() in integer arithmetic, on the driver's own
+// tenths; for threads that must not touch the FPU or pull in libm.
+// Agrees with it to within a tenth over the sensors' ranges.
+inline int16_t CalculateDewPointTenths(const int16_t & theTemperatureTenths, const uint16_t & theHumidityTenths)
+{
+    constexpr int64_t A_Q16   = (17271LL << 16) / 1000;        // 17.271
+    constexpr int64_t B_TENTHS = 2377;                         // 237.7°C
+    constexpr int64_t LN2_Q16 = 45426;                         // ln(2)
+
+    // ln(RH / 100%) == ln(2) * (log2(RH tenths) - log2(1000)).
+    const auto theHumidity = std::max<uint32_t>(theHumidityTenths, 1);
+    const auto theLnHumidityQ16 = ((static_cast<int64_t>(Log2Q16(theHumidity)) - Log2Q16(1000)) * LN2_Q16) / (1 << 16);
+
+    const auto theTemperature = static_cast<int64_t>(theTemperatureTenths);
+    const auto theGammaQ16 = ((A_Q16 * theTemperature) / (B_TENTHS + theTemperature)) + theLnHumidityQ16;
+
+    const auto theNumerator = B_TENTHS * theGammaQ16;
+    const auto theDenominator = A_Q16 - theGammaQ16;
+    const auto theDewPoint = ((theNumerator >= 0) ? (theNumerator + (theDenominator / 2))
+                                                  : (theNumerator - (theDenominator / 2))) / theDenominator;
+
+    return static_cast<int16_t>(theDewPoint);
+}
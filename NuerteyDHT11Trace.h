@@ -0,0 +1,237 @@
+/***********************************************************************
+* @file      NuerteyDHT11Trace.h
+*
+*    Compact binary trace record for raw DHT11/DHT22 data frames, in
+*    the spirit of "deferred formatting" loggers such as defmt.
+*
+* @brief   Rather than decoding and printing human-readable values on
+*          the MCU, emit only what was on the wire (the raw 5-byte data
+*          frame), the status of the read and a timestamp. Decoding and
+*          formatting, dew point included, then happens off-target in
+*          tools/DHT11TraceDecoder.cpp using the very same arithmetic
+*          as the driver (see NuerteyDHT11Protocol.h).
+*
+* @note    Record layout (13 bytes, little-endian):
+*
+*            [0]      (SensorModel_t << 4) | TRACE_FORMAT_VERSION
+*            [1]      SensorStatus_t of the read
+*            [2..5]   timestamp, milliseconds since boot
+*            [6..7]   sensor pin
+*            [8..12]  raw data frame, as received
+*
+*          As the Mbed console performs newline conversion (see
+*          "platform.stdio-convert-newlines"), raw binary cannot travel
+*          over it intact. Each record is therefore armored as a single
+*          "#D" prefixed line of hex digits, i.e. 30 characters per
+*          reading including the line ending, versus ~120 characters of
+*          float formatted text. Other console output can be freely
+*          interleaved; the decoder passes it through untouched.
+*
+*          Timestamps restart with every boot, so the logger also emits an
+*          epoch record at startup (and whenever asked, e.g. once the RTC
+*          has been set), pairing the timestamp clock with time(NULL):
+*
+*            [0]      TRACE_FORMAT_VERSION
+*            [1..4]   timestamp, milliseconds since boot
+*            [5..12]  time(NULL), seconds since the Unix epoch (signed)
+*
+*          armored alike as a "#E" prefixed line. Host tools use it to
+*          place the following records on the wall clock.
+*
+*          Nothing in here depends upon Mbed OS.
+*
+* @warning Records hold the frame as received, before the device's
+*          ReadingCalibration_t is applied, and no record conveys the
+*          calibration. Readings decoded from traces, by the decoder,
+*          history files or gateway alike, are hence uncalibrated.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include "NuerteyDHT11Protocol.h"
+
+static constexpr uint8_t     TRACE_FORMAT_VERSION     = 1;
+static constexpr std::size_t TRACE_RECORD_SIZE_BYTES  = 13;
+static constexpr char        TRACE_LINE_PREFIX[]      = "#D";
+static constexpr std::size_t TRACE_LINE_PREFIX_LENGTH = sizeof(TRACE_LINE_PREFIX) - 1;
+static constexpr std::size_t TRACE_LINE_LENGTH        = TRACE_LINE_PREFIX_LENGTH + (2 * TRACE_RECORD_SIZE_BYTES);
+static constexpr char        TRACE_EPOCH_PREFIX[]     = "#E";
+
+// Epochs whose time(NULL) precedes 2000-01-01 come from an RTC that was
+// never set; they say nothing about the wall clock.
+static constexpr int64_t     TRACE_EPOCH_MINIMUM_UNIX_TIME_S = 946684800;
+
+struct TraceRecord_t
+{
+    uint32_t       TimestampMs;
+    uint16_t       SensorPin;
+    SensorModel_t  Model;
+    SensorStatus_t Status;
+    DataFrame_t    Frame;
+};
+
+struct TraceEpoch_t
+{
+    uint32_t       TimestampMs;
+    int64_t        UnixTimeS;
+};
+
+namespace TraceDetail
+{
+    // theLine receives thePrefix, two hex digits per byte and a NUL.
+    inline void ArmorLine(const char * thePrefix, const uint8_t * theBytes, char * theLine)
+    {
+        static constexpr char HEX_DIGITS[] = "0123456789ABCDEF";
+
+        memcpy(theLine, thePrefix, TRACE_LINE_PREFIX_LENGTH);
+        auto pTheDigit = theLine + TRACE_LINE_PREFIX_LENGTH;
+        for (std::size_t i = 0; i < TRACE_RECORD_SIZE_BYTES; ++i)
+        {
+            *pTheDigit++ = HEX_DIGITS[theBytes[i] >> 4];
+            *pTheDigit++ = HEX_DIGITS[theBytes[i] & 0x0F];
+        }
+        *pTheDigit = '\0';
+    }
+
+    // False unless theLine starts with thePrefix, followed by hex digits.
+    inline bool DisarmorLine(const char * thePrefix, const char * theLine, uint8_t * theBytes)
+    {
+        if (strncmp(theLine, thePrefix, TRACE_LINE_PREFIX_LENGTH) != 0)
+        {
+            return false;
+        }
+
+        auto FromHex = [](const char & c) -> int
+        {
+            if ((c >= '0') && (c <= '9')) return (c - '0');
+            if ((c >= 'A') && (c <= 'F')) return (c - 'A' + 10);
+            if ((c >= 'a') && (c <= 'f')) return (c - 'a' + 10);
+            return -1;
+        };
+
+        auto pTheDigit = theLine + TRACE_LINE_PREFIX_LENGTH;
+        for (std::size_t i = 0; i < TRACE_RECORD_SIZE_BYTES; ++i)
+        {
+            auto high = FromHex(*pTheDigit++);
+            auto low  = FromHex(*pTheDigit++);
+            if ((high < 0) || (low < 0))
+            {
+                return false;
+            }
+            theBytes[i] = static_cast<uint8_t>((high << 4) | low);
+        }
+
+        return true;
+    }
+}
+
+inline std::size_t EncodeTraceRecord(const TraceRecord_t & theRecord, uint8_t * theBuffer)
+{
+    theBuffer[0] = static_cast<uint8_t>((static_cast<uint8_t>(theRecord.Model) << 4) | TRACE_FORMAT_VERSION);
+    theBuffer[1] = static_cast<uint8_t>(ToUnderlyingType(theRecord.Status));
+    theBuffer[2] = static_cast<uint8_t>(theRecord.TimestampMs & 0xFF);
+    theBuffer[3] = static_cast<uint8_t>((theRecord.TimestampMs >> 8) & 0xFF);
+    theBuffer[4] = static_cast<uint8_t>((theRecord.TimestampMs >> 16) & 0xFF);
+    theBuffer[5] = static_cast<uint8_t>((theRecord.TimestampMs >> 24) & 0xFF);
+    theBuffer[6] = static_cast<uint8_t>(theRecord.SensorPin & 0xFF);
+    theBuffer[7] = static_cast<uint8_t>((theRecord.SensorPin >> 8) & 0xFF);
+    memcpy(&theBuffer[8], theRecord.Frame.data(), SINGLE_BUS_DATA_FRAME_SIZE_BYTES);
+
+    return TRACE_RECORD_SIZE_BYTES;
+}
+
+inline bool DecodeTraceRecord(const uint8_t * theBuffer, const std::size_t & theLength, TraceRecord_t & theRecord)
+{
+    if ((theLength < TRACE_RECORD_SIZE_BYTES) || ((theBuffer[0] & 0x0F) != TRACE_FORMAT_VERSION))
+    {
+        return false;
+    }
+
+    theRecord.Model       = ToEnum<SensorModel_t, uint8_t>(theBuffer[0] >> 4);
+    theRecord.Status      = ToEnum<SensorStatus_t>(static_cast<int8_t>(theBuffer[1]));
+    theRecord.TimestampMs = static_cast<uint32_t>(theBuffer[2])
+                          | (static_cast<uint32_t>(theBuffer[3]) << 8)
+                          | (static_cast<uint32_t>(theBuffer[4]) << 16)
+                          | (static_cast<uint32_t>(theBuffer[5]) << 24);
+    theRecord.SensorPin   = static_cast<uint16_t>(theBuffer[6] | (theBuffer[7] << 8));
+    memcpy(theRecord.Frame.data(), &theBuffer[8], SINGLE_BUS_DATA_FRAME_SIZE_BYTES);
+
+    return ((theRecord.Model == SensorModel_t::DHT11) || (theRecord.Model == SensorModel_t::DHT22));
+}
+
+// Writes TRACE_LINE_LENGTH characters, plus a terminating NUL, into
+// theLine (which must thus hold at least TRACE_LINE_LENGTH + 1).
+inline std::size_t FormatTraceLine(const TraceRecord_t & theRecord, char * theLine)
+{
+    uint8_t theBytes[TRACE_RECORD_SIZE_BYTES];
+    EncodeTraceRecord(theRecord, theBytes);
+    TraceDetail::ArmorLine(TRACE_LINE_PREFIX, theBytes, theLine);
+
+    return TRACE_LINE_LENGTH;
+}
+
+// Returns false for anything that is not a well-formed trace line, so
+// that callers can pass other console output through untouched. The
+// line must be exactly TRACE_LINE_LENGTH long; trim any "\r\n" first.
+inline bool ParseTraceLine(const char * theLine, const std::size_t & theLength, TraceRecord_t & theRecord)
+{
+    uint8_t theBytes[TRACE_RECORD_SIZE_BYTES];
+    if ((theLength != TRACE_LINE_LENGTH) || !TraceDetail::DisarmorLine(TRACE_LINE_PREFIX, theLine, theBytes))
+    {
+        return false;
+    }
+
+    return DecodeTraceRecord(theBytes, TRACE_RECORD_SIZE_BYTES, theRecord);
+}
+
+// As FormatTraceLine(), for an epoch record; the line is as long.
+inline std::size_t FormatEpochLine(const TraceEpoch_t & theEpoch, char * theLine)
+{
+    const auto theUnixTime = static_cast<uint64_t>(theEpoch.UnixTimeS);
+
+    uint8_t theBytes[TRACE_RECORD_SIZE_BYTES];
+    theBytes[0] = TRACE_FORMAT_VERSION;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        theBytes[1 + i] = static_cast<uint8_t>((theEpoch.TimestampMs >> (8 * i)) & 0xFF);
+    }
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        theBytes[5 + i] = static_cast<uint8_t>((theUnixTime >> (8 * i)) & 0xFF);
+    }
+    TraceDetail::ArmorLine(TRACE_EPOCH_PREFIX, theBytes, theLine);
+
+    return TRACE_LINE_LENGTH;
+}
+
+inline bool ParseEpochLine(const char * theLine, const std::size_t & theLength, TraceEpoch_t & theEpoch)
+{
+    uint8_t theBytes[TRACE_RECORD_SIZE_BYTES];
+    if ((theLength != TRACE_LINE_LENGTH) || !TraceDetail::DisarmorLine(TRACE_EPOCH_PREFIX, theLine, theBytes)
+     || (theBytes[0] != TRACE_FORMAT_VERSION))
+    {
+        return false;
+    }
+
+    uint64_t theUnixTime = 0;
+    theEpoch.TimestampMs = 0;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        theEpoch.TimestampMs |= (static_cast<uint32_t>(theBytes[1 + i]) << (8 * i));
+    }
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        theUnixTime |= (static_cast<uint64_t>(theBytes[5 + i]) << (8 * i));
+    }
+    theEpoch.UnixTimeS = static_cast<int64_t>(theUnixTime);
+
+    return true;
+}
@@ -0,0 +1,492 @@
+/***********************************************************************
+* @file      NuerteyInterleavedSensor.h
+*
+*    Virtual sensor interleaving several redundant DHT11/DHT22 sensors
+*    that share an airspace, targetted for ARM Mbed platform.
+*
+* @brief   Read N sensors in rotation, one per tick, so that the combined
+*          stream carries N times the rate at which any single sensor may
+*          be read (NuerteyDHT11Device enforces MINIMUM_SAMPLING_PERIOD_SECONDS).
+*          Each sensor's readings are corrected by per-sensor temperature
+*          and humidity offsets, learned online, so that the rotation does
+*          not inject a sawtooth of inter-sensor disagreement into the
+*          stream.
+*
+* @note    Offsets are learned against either a designated reference
+*          sensor, or, by default, the ensemble: every successful reading
+*          is compared against the mean of the other sensors' latest
+*          corrected readings, and the offsets are then re-centred to sum
+*          to zero so that the ensemble as a whole keeps its absolute level.
+*          Arithmetic is fixed point throughout (tenths, with 4 fractional
+*          bits in the running averages), as in the driver.
+*
+*          Only successful, fresh reads are emitted. A rotation tick whose
+*          device merely returned its cached reading emits nothing.
+*
+*          These offsets and NuerteyReadingCalibrator correct the same
+*          disagreement, so must not both be learning: each would chase
+*          what the other had already corrected. To use the calibrator's
+*          offset and gain fit (applied in the devices' own decode, as a
+*          ReadingCalibration_t) call SetOffsetLearningEnabled(false), and
+*          readings then pass through as the devices report them.
+*
+* @warning Stop() cannot recall a rotation step that the event queue is
+*          already running; such a step, its measurement callback
+*          included, still completes. The destructor waits for it, so do
+*          not destroy this object from within that callback.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+
+template <std::size_t MAXIMUM_SENSORS = 8>
+class NuerteyInterleavedSensor
+{
+public:
+    // Per-sensor read period. The driver's cooldown is measured with the
+    // one second resolution of time(NULL), so leave a margin over it lest
+    // event queue jitter turn some reads into cached ones.
+    static constexpr uint32_t DEFAULT_SENSOR_PERIOD_MS = 3100;
+
+    // Offsets are running averages in tenths << OFFSET_FRACTION_BITS,
+    // weighting every new disagreement 1/(1 << OFFSET_EMA_SHIFT).
+    static constexpr uint8_t  OFFSET_FRACTION_BITS     = 4;
+    static constexpr uint8_t  OFFSET_EMA_SHIFT         = 4;
+
+    NuerteyInterleavedSensor();
+
+    NuerteyInterleavedSensor(const NuerteyInterleavedSensor&) = delete;
+    NuerteyInterleavedSensor& operator=(const NuerteyInterleavedSensor&) = delete;
+
+    virtual ~NuerteyInterleavedSensor();
+
+    // Any mix of NuerteyDHT11Device<DHT11_t> and NuerteyDHT11Device<DHT22_t>.
+    // The device must outlive this object.
+    template <typename Device>
+    bool AddSensor(Device & theDevice);
+
+    // Learn offsets against theSensorPin (whose own offsets stay zero)
+    // instead of against the ensemble. Pass NC to revert.
+    void SetReferenceSensor(const PinName & theSensorPin);
+
+    // Disabling zeroes the learned offsets; see the @note above.
+    void SetOffsetLearningEnabled(const bool & isEnabled);
+
+    // Invoked on the rotation's thread for every emitted reading. Its
+    // SensorPin names the physical sensor; its SequenceNumber is that of
+    // the combined stream.
+    void SetMeasurementCallback(Callback<void(const Measurement_t &)> theCallback);
+
+    // Rotate through the sensors on theEventQueue, reading each one every
+    // theSensorPeriodMilliseconds; i.e. one read per period/N.
+    int Start(EventQueue & theEventQueue, const uint32_t & theSensorPeriodMilliseconds = DEFAULT_SENSOR_PERIOD_MS);
+    void Stop();
+
+    // One rotation step; public for callers that drive the rotation themselves.
+    void Sample();
+
+    Measurement_t GetLatest() const;
+    int16_t GetTemperatureOffsetTenths(const PinName & theSensorPin) const;
+    int16_t GetHumidityOffsetTenths(const PinName & theSensorPin) const;
+
+protected:
+
+private:
+    using Sampler_t = Measurement_t (*)(void *);
+
+    struct SensorState_t
+    {
+        Sampler_t   Sampler;
+        void *      pTheDevice;
+        PinName     SensorPin;
+        uint32_t    LastSequenceNumber;
+        int32_t     TemperatureOffset;          // Tenths << OFFSET_FRACTION_BITS
+        int32_t     HumidityOffset;             // Tenths << OFFSET_FRACTION_BITS
+        int32_t     CorrectedTemperatureTenths;
+        int32_t     CorrectedHumidityTenths;
+        bool        HasReading;
+    };
+
+    template <typename Device>
+    static Measurement_t SampleDevice(void * pTheDevice);
+
+    // What Start() schedules; skips the step once Stop() has been called.
+    void ScheduledSample();
+    void Rotate();
+
+    static int32_t RoundOffset(const int32_t & theOffset);
+
+    void Learn(const std::size_t & theIndex, const int32_t & theTemperatureTenths, const int32_t & theHumidityTenths);
+    int32_t FindSensor(const PinName & theSensorPin) const;
+
+    mutable Mutex                                   m_TheRotationMutex;
+    ConditionVariable                               m_TheSampleCompleted;
+    uint32_t                                        m_TheSamplesInFlight;
+    std::array<SensorState_t, MAXIMUM_SENSORS>      m_TheSensors;
+    std::size_t                                     m_TheSensorCount;
+    std::size_t                                     m_TheNextSensor;
+    PinName                                         m_TheReferencePin;
+    bool                                            m_IsOffsetLearningEnabled;
+    Measurement_t                                   m_TheLatest;
+    uint32_t                                        m_TheSequenceNumber;
+    Callback<void(const Measurement_t &)>           m_TheMeasurementCallback;
+    EventQueue *                                    m_pTheEventQueue;
+    int                                             m_TheEventId;
+};
+
+template <std::size_t MAXIMUM_SENSORS>
+NuerteyInterleavedSensor<MAXIMUM_SENSORS>::NuerteyInterleavedSensor()
+    : m_TheSampleCompleted(m_TheRotationMutex)
+    , m_TheSamplesInFlight(0)
+    , m_TheSensors{}
+    , m_TheSensorCount(0)
+    , m_TheNextSensor(0)
+    , m_TheReferencePin(NC)
+    , m_IsOffsetLearningEnabled(true)
+    , m_TheLatest{}
+    , m_TheSequenceNumber(0)
+    , m_pTheEventQueue(nullptr)
+    , m_TheEventId(0)
+{
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+NuerteyInterleavedSensor<MAXIMUM_SENSORS>::~NuerteyInterleavedSensor()
+{
+    Stop();
+
+    // The queue's thread, or a caller's, may be mid-Sample(); let it
+    // finish with this object before it goes away.
+    m_TheRotationMutex.lock();
+    while (m_TheSamplesInFlight > 0)
+    {
+        m_TheSampleCompleted.wait();
+    }
+    m_TheRotationMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+template <typename Device>
+bool NuerteyInterleavedSensor<MAXIMUM_SENSORS>::AddSensor(Device & theDevice)
+{
+    m_TheRotationMutex.lock();
+
+    auto added = false;
+    if (m_TheSensorCount < MAXIMUM_SENSORS)
+    {
+        auto & theSensor = m_TheSensors[m_TheSensorCount];
+        theSensor = SensorState_t{};
+        theSensor.Sampler = &NuerteyInterleavedSensor<MAXIMUM_SENSORS>::SampleDevice<Device>;
+        theSensor.pTheDevice = &theDevice;
+        theSensor.SensorPin = theDevice.GetPinName();
+        ++m_TheSensorCount;
+        added = true;
+    }
+
+    m_TheRotationMutex.unlock();
+
+    return added;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyInterleavedSensor<MAXIMUM_SENSORS>::SetReferenceSensor(const PinName & theSensorPin)
+{
+    m_TheRotationMutex.lock();
+    m_TheReferencePin = theSensorPin;
+
+    const auto theReference = FindSensor(theSensorPin);
+    if (theReference >= 0)
+    {
+        m_TheSensors[theReference].TemperatureOffset = 0;
+        m_TheSensors[theReference].HumidityOffset = 0;
+    }
+    m_TheRotationMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyInterleavedSensor<MAXIMUM_SENSORS>::SetOffsetLearningEnabled(const bool & isEnabled)
+{
+    m_TheRotationMutex.lock();
+    m_IsOffsetLearningEnabled = isEnabled;
+
+    if (!isEnabled)
+    {
+        for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+        {
+            m_TheSensors[i].TemperatureOffset = 0;
+            m_TheSensors[i].HumidityOffset = 0;
+        }
+    }
+    m_TheRotationMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyInterleavedSensor<MAXIMUM_SENSORS>::SetMeasurementCallback(Callback<void(const Measurement_t &)> theCallback)
+{
+    m_TheRotationMutex.lock();
+    m_TheMeasurementCallback = theCallback;
+    m_TheRotationMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+int NuerteyInterleavedSensor<MAXIMUM_SENSORS>::Start(EventQueue & theEventQueue,
+                                                     const uint32_t & theSensorPeriodMilliseconds)
+{
+    Stop();
+
+    // Held throughout, so that the first tick cannot see the event id
+    // before it is set, and take itself for cancelled.
+    m_TheRotationMutex.lock();
+    const auto theSensorCount = (m_TheSensorCount > 0) ? m_TheSensorCount : 1;
+
+    m_pTheEventQueue = &theEventQueue;
+    m_TheEventId = theEventQueue.call_every(theSensorPeriodMilliseconds / theSensorCount, this,
+                        &NuerteyInterleavedSensor<MAXIMUM_SENSORS>::ScheduledSample);
+    const auto theEventId = m_TheEventId;
+    m_TheRotationMutex.unlock();
+
+    return theEventId;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyInterleavedSensor<MAXIMUM_SENSORS>::Stop()
+{
+    m_TheRotationMutex.lock();
+    if ((m_pTheEventQueue != nullptr) && (m_TheEventId != 0))
+    {
+        m_pTheEventQueue->cancel(m_TheEventId);
+    }
+
+    m_pTheEventQueue = nullptr;
+    m_TheEventId = 0;
+    m_TheRotationMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyInterleavedSensor<MAXIMUM_SENSORS>::Sample()
+{
+    m_TheRotationMutex.lock();
+    ++m_TheSamplesInFlight;
+    m_TheRotationMutex.unlock();
+
+    Rotate();
+
+    m_TheRotationMutex.lock();
+    --m_TheSamplesInFlight;
+    m_TheSampleCompleted.notify_all();
+    m_TheRotationMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyInterleavedSensor<MAXIMUM_SENSORS>::ScheduledSample()
+{
+    m_TheRotationMutex.lock();
+    // Zero if Stop() came too late for the queue to drop this tick.
+    if (m_TheEventId == 0)
+    {
+        m_TheRotationMutex.unlock();
+        return;
+    }
+    ++m_TheSamplesInFlight;
+    m_TheRotationMutex.unlock();
+
+    Rotate();
+
+    m_TheRotationMutex.lock();
+    --m_TheSamplesInFlight;
+    m_TheSampleCompleted.notify_all();
+    m_TheRotationMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyInterleavedSensor<MAXIMUM_SENSORS>::Rotate()
+{
+    m_TheRotationMutex.lock();
+    if (m_TheSensorCount == 0)
+    {
+        m_TheRotationMutex.unlock();
+        return;
+    }
+
+    const auto theIndex = m_TheNextSensor;
+    m_TheNextSensor = (m_TheNextSensor + 1) % m_TheSensorCount;
+    const auto theSampler = m_TheSensors[theIndex].Sampler;
+    const auto pTheDevice = m_TheSensors[theIndex].pTheDevice;
+    m_TheRotationMutex.unlock();
+
+    // The bus transaction runs unlocked; the getters stay responsive.
+    auto theMeasurement = theSampler(pTheDevice);
+
+    m_TheRotationMutex.lock();
+    auto & theSensor = m_TheSensors[theIndex];
+    const auto isFresh = (theMeasurement.SequenceNumber != theSensor.LastSequenceNumber);
+    theSensor.LastSequenceNumber = theMeasurement.SequenceNumber;
+
+    if (!isFresh || (theMeasurement.Status != SensorStatus_t::SUCCESS))
+    {
+        m_TheRotationMutex.unlock();
+        return;
+    }
+
+    Learn(theIndex, theMeasurement.TemperatureTenths, theMeasurement.HumidityTenths);
+
+    theMeasurement.TemperatureTenths = static_cast<int16_t>(theSensor.CorrectedTemperatureTenths);
+    theMeasurement.HumidityTenths    = static_cast<uint16_t>(std::max<int32_t>(theSensor.CorrectedHumidityTenths, 0));
+    theMeasurement.SequenceNumber    = ++m_TheSequenceNumber;
+    m_TheLatest = theMeasurement;
+
+    const auto theCallback = m_TheMeasurementCallback;
+    m_TheRotationMutex.unlock();
+
+    if (theCallback)
+    {
+        theCallback(theMeasurement);
+    }
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+Measurement_t NuerteyInterleavedSensor<MAXIMUM_SENSORS>::GetLatest() const
+{
+    m_TheRotationMutex.lock();
+    const auto theLatest = m_TheLatest;
+    m_TheRotationMutex.unlock();
+
+    return theLatest;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+int16_t NuerteyInterleavedSensor<MAXIMUM_SENSORS>::GetTemperatureOffsetTenths(const PinName & theSensorPin) const
+{
+    m_TheRotationMutex.lock();
+    const auto theIndex = FindSensor(theSensorPin);
+    const auto theOffset = (theIndex >= 0) ? RoundOffset(m_TheSensors[theIndex].TemperatureOffset) : 0;
+    m_TheRotationMutex.unlock();
+
+    return static_cast<int16_t>(theOffset);
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+int16_t NuerteyInterleavedSensor<MAXIMUM_SENSORS>::GetHumidityOffsetTenths(const PinName & theSensorPin) const
+{
+    m_TheRotationMutex.lock();
+    const auto theIndex = FindSensor(theSensorPin);
+    const auto theOffset = (theIndex >= 0) ? RoundOffset(m_TheSensors[theIndex].HumidityOffset) : 0;
+    m_TheRotationMutex.unlock();
+
+    return static_cast<int16_t>(theOffset);
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+template <typename Device>
+Measurement_t NuerteyInterleavedSensor<MAXIMUM_SENSORS>::SampleDevice(void * pTheDevice)
+{
+    auto & theDevice = *static_cast<Device *>(pTheDevice);
+
+    (void)theDevice.ReadData();
+    return theDevice.GetMeasurement();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+int32_t NuerteyInterleavedSensor<MAXIMUM_SENSORS>::RoundOffset(const int32_t & theOffset)
+{
+    constexpr int32_t HALF = (1 << OFFSET_FRACTION_BITS) / 2;
+
+    return ((theOffset >= 0) ? (theOffset + HALF) : (theOffset - HALF)) / (1 << OFFSET_FRACTION_BITS);
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyInterleavedSensor<MAXIMUM_SENSORS>::Learn(const std::size_t & theIndex,
+                                                      const int32_t & theTemperatureTenths,
+                                                      const int32_t & theHumidityTenths)
+{
+    auto & theSensor = m_TheSensors[theIndex];
+    const auto theReference = FindSensor(m_TheReferencePin);
+
+    // What this sensor should have read: the reference sensor's, or the
+    // other sensors' mean, latest corrected reading.
+    int32_t theTemperatureSum = 0, theHumiditySum = 0, theCount = 0;
+    for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+    {
+        const auto & theOther = m_TheSensors[i];
+        if ((i == theIndex) || !theOther.HasReading
+         || ((theReference >= 0) && (static_cast<int32_t>(i) != theReference)))
+        {
+            continue;
+        }
+        theTemperatureSum += theOther.CorrectedTemperatureTenths;
+        theHumiditySum    += theOther.CorrectedHumidityTenths;
+        ++theCount;
+    }
+
+    if (m_IsOffsetLearningEnabled && (theCount > 0) && (static_cast<int32_t>(theIndex) != theReference))
+    {
+        auto Blend = [](int32_t & theOffset, const int32_t & theDisagreement)
+        {
+            theOffset += (theDisagreement - theOffset) / (1 << OFFSET_EMA_SHIFT);
+        };
+
+        Blend(theSensor.TemperatureOffset,
+              ((theTemperatureTenths * theCount) - theTemperatureSum) * (1 << OFFSET_FRACTION_BITS) / theCount);
+        Blend(theSensor.HumidityOffset,
+              ((theHumidityTenths * theCount) - theHumiditySum) * (1 << OFFSET_FRACTION_BITS) / theCount);
+
+        if (theReference < 0)
+        {
+            // Keep the ensemble's own level; only the spread is an error.
+            int32_t theTemperatureMean = 0, theHumidityMean = 0, theLearned = 0;
+            for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+            {
+                if (m_TheSensors[i].HasReading || (i == theIndex))
+                {
+                    theTemperatureMean += m_TheSensors[i].TemperatureOffset;
+                    theHumidityMean    += m_TheSensors[i].HumidityOffset;
+                    ++theLearned;
+                }
+            }
+            theTemperatureMean /= theLearned;
+            theHumidityMean    /= theLearned;
+
+            for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+            {
+                if (m_TheSensors[i].HasReading || (i == theIndex))
+                {
+                    m_TheSensors[i].TemperatureOffset -= theTemperatureMean;
+                    m_TheSensors[i].HumidityOffset    -= theHumidityMean;
+                }
+            }
+        }
+    }
+
+    theSensor.CorrectedTemperatureTenths = theTemperatureTenths - RoundOffset(theSensor.TemperatureOffset);
+    theSensor.CorrectedHumidityTenths    = theHumidityTenths - RoundOffset(theSensor.HumidityOffset);
+    theSensor.HasReading                 = true;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+int32_t NuerteyInterleavedSensor<MAXIMUM_SENSORS>::FindSensor(const PinName & theSensorPin) const
+{
+    if (theSensorPin == NC)
+    {
+        return -1;
+    }
+
+    for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+    {
+        if (m_TheSensors[i].SensorPin == theSensorPin)
+        {
+            return static_cast<int32_t>(i);
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,430 @@
+/***********************************************************************
+* @file      NuerteyMeasurementHistory.h
+*
+*    Bounded, multi-resolution on-device history of a DHT11/DHT22
+*    sensor's readings, targetted for ARM Mbed platform.
+*
+* @brief   Keep the most recent raw readings, and cascade every reading
+*          into per-minute and per-hour rollups (min/max/mean/count), each
+*          tier in its own fixed-size circular buffer. Range queries are
+*          answered from the coarsest tier that fits, using finer tiers
+*          only for the ragged ends of the range.
+*
+* @note    With the default sizes (64 raw readings, 2 hours of minutes and
+*          2 days of hours) the whole history fits in about 4.5KB, and a
+*          "last 24 hours" query touches some 24 hourly rollups, 60-odd
+*          minutely ones and a handful of raw readings, rather than tens of
+*          thousands of readings.
+*
+*          The rollup currently being filled in each tier takes part in
+*          queries too, so that the most recent minutes are never missing.
+*          Data that has aged out of every tier that could cover part of a
+*          range is simply absent from that part; Count says how many
+*          readings a summary actually rests on.
+*
+*          Times are SampleTimeUs, stored internally at one second
+*          resolution; only fresh, good readings are recorded.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <algorithm>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+
+struct HistorySummary_t
+{
+    int16_t     MinimumTemperatureTenths;
+    int16_t     MaximumTemperatureTenths;
+    int16_t     MeanTemperatureTenths;
+    uint16_t    MinimumHumidityTenths;
+    uint16_t    MaximumHumidityTenths;
+    uint16_t    MeanHumidityTenths;
+    uint32_t    Count;                      // Readings summarized; 0 means no data.
+};
+
+template <std::size_t RAW_SAMPLES = 64, std::size_t MINUTE_ROLLUPS = 120, std::size_t HOUR_ROLLUPS = 48>
+class NuerteyMeasurementHistory
+{
+    static_assert((RAW_SAMPLES > 0) && (MINUTE_ROLLUPS > 0) && (HOUR_ROLLUPS > 0),
+    "Hey! Every tier of the history needs room for at least one entry!!");
+
+public:
+    static constexpr uint32_t MINUTE_SECONDS = 60;
+    static constexpr uint32_t HOUR_SECONDS   = 3600;
+
+    NuerteyMeasurementHistory(const PinName & theSensorPin);
+
+    NuerteyMeasurementHistory(const NuerteyMeasurementHistory&) = delete;
+    NuerteyMeasurementHistory& operator=(const NuerteyMeasurementHistory&) = delete;
+
+    virtual ~NuerteyMeasurementHistory();
+
+    // Sampling path entry point; suitable for direct registration via
+    // NuerteyDHT11Device::SetMeasurementCallback(). Readings of other
+    // sensors, failed or repeated readings, and readings older than the
+    // latest recorded are ignored.
+    void Update(const Measurement_t & theMeasurement);
+
+    // Summary of the readings sampled within [theFromUs, theToUs).
+    HistorySummary_t Query(const uint64_t & theFromUs, const uint64_t & theToUs) const;
+
+    // Summary of the last theDurationMs up to the latest reading.
+    HistorySummary_t QueryLast(const uint32_t & theDurationMs) const;
+
+    uint64_t GetLatestTimeUs() const;
+
+protected:
+
+private:
+    struct Rollup_t
+    {
+        uint32_t StartS;
+        int16_t  MinimumTemperature;
+        int16_t  MaximumTemperature;
+        int32_t  TemperatureSum;
+        uint16_t MinimumHumidity;
+        uint16_t MaximumHumidity;
+        int32_t  HumiditySum;
+        uint32_t Count;
+    };
+
+    struct Raw_t
+    {
+        uint32_t TimeS;
+        int16_t  Temperature;
+        uint16_t Humidity;
+    };
+
+    // Bucket storage for one rollup tier: closed buckets, oldest first,
+    // plus the one being filled.
+    template <std::size_t CAPACITY>
+    struct Tier_t
+    {
+        std::array<Rollup_t, CAPACITY> Closed;
+        std::size_t                    Count;
+        std::size_t                    Next;
+        Rollup_t                       Open;
+
+        const Rollup_t & At(const std::size_t & i) const
+        {
+            return Closed[(Next + CAPACITY - Count + i) % CAPACITY];
+        }
+
+        void Push(const Rollup_t & theRollup)
+        {
+            Closed[Next] = theRollup;
+            Next = (Next + 1) % CAPACITY;
+            Count = std::min(Count + 1, CAPACITY);
+        }
+    };
+
+    static void Merge(Rollup_t & theInto, const Rollup_t & theFrom);
+    static Rollup_t MakeRollup(const uint32_t & theStartS, const int16_t & theTemperature, const uint16_t & theHumidity);
+
+    // Each merges the buckets of its tier that lie wholly within
+    // [theFromS, theToS), and defers what is left at either end to the
+    // next finer tier.
+    void QueryHours(Rollup_t & theResult, const uint32_t & theFromS, const uint32_t & theToS) const;
+    void QueryMinutes(Rollup_t & theResult, const uint32_t & theFromS, const uint32_t & theToS) const;
+    void QueryRaw(Rollup_t & theResult, const uint32_t & theFromS, const uint32_t & theToS) const;
+
+    template <std::size_t CAPACITY, typename Finer>
+    void QueryTier(const Tier_t<CAPACITY> & theTier, const uint32_t & theBucketS, Rollup_t & theResult,
+                   const uint32_t & theFromS, const uint32_t & theToS, Finer theFinerQuery) const;
+
+    mutable Mutex                                     m_TheHistoryMutex;
+    PinName                                           m_TheSensorPin;
+    std::array<Raw_t, RAW_SAMPLES>                    m_TheRaw;
+    std::size_t                                       m_TheRawCount;
+    std::size_t                                       m_TheRawNext;
+    Tier_t<MINUTE_ROLLUPS>                            m_TheMinutes;
+    Tier_t<HOUR_ROLLUPS>                              m_TheHours;
+    uint32_t                                          m_TheLatestS;
+    uint32_t                                          m_TheLastSequenceNumber;
+    bool                                              m_IsEmpty;
+};
+
+template <std::size_t RAW_SAMPLES, std::size_t MINUTE_ROLLUPS, std::size_t HOUR_ROLLUPS>
+NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::NuerteyMeasurementHistory(const PinName & theSensorPin)
+    : m_TheSensorPin(theSensorPin)
+    , m_TheRaw{}
+    , m_TheRawCount(0)
+    , m_TheRawNext(0)
+    , m_TheMinutes{}
+    , m_TheHours{}
+    , m_TheLatestS(0)
+    , m_TheLastSequenceNumber(0)
+    , m_IsEmpty(true)
+{
+}
+
+template <std::size_t RAW_SAMPLES, std::size_t MINUTE_ROLLUPS, std::size_t HOUR_ROLLUPS>
+NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::~NuerteyMeasurementHistory()
+{
+}
+
+template <std::size_t RAW_SAMPLES, std::size_t MINUTE_ROLLUPS, std::size_t HOUR_ROLLUPS>
+void NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::Update(const Measurement_t & theMeasurement)
+{
+    if ((theMeasurement.SensorPin != m_TheSensorPin)
+     || (theMeasurement.Status != SensorStatus_t::SUCCESS)
+     || (theMeasurement.SampleTimeUs != theMeasurement.CaptureTimeUs))
+    {
+        return;
+    }
+
+    const auto theTimeS = static_cast<uint32_t>(theMeasurement.SampleTimeUs / 1'000'000);
+    const auto theMinuteS = theTimeS - (theTimeS % MINUTE_SECONDS);
+    const auto theHourS = theTimeS - (theTimeS % HOUR_SECONDS);
+    const auto theSample = MakeRollup(theMinuteS, theMeasurement.TemperatureTenths, theMeasurement.HumidityTenths);
+
+    m_TheHistoryMutex.lock();
+
+    if ((theMeasurement.SequenceNumber != m_TheLastSequenceNumber)
+     && (m_IsEmpty || (theTimeS >= m_TheLatestS)))
+    {
+        m_TheLastSequenceNumber = theMeasurement.SequenceNumber;
+
+        m_TheRaw[m_TheRawNext] = Raw_t{theTimeS, theMeasurement.TemperatureTenths, theMeasurement.HumidityTenths};
+        m_TheRawNext = (m_TheRawNext + 1) % RAW_SAMPLES;
+        m_TheRawCount = std::min(m_TheRawCount + 1, RAW_SAMPLES);
+
+        // Cascade: a minute closes into its ring and into the open hour;
+        // an hour closes into its ring.
+        if (m_IsEmpty)
+        {
+            m_TheMinutes.Open = theSample;
+            m_TheHours.Open = theSample;
+            m_TheHours.Open.StartS = theHourS;
+        }
+        else
+        {
+            if (theMinuteS != m_TheMinutes.Open.StartS)
+            {
+                m_TheMinutes.Push(m_TheMinutes.Open);
+                m_TheMinutes.Open = theSample;
+            }
+            else
+            {
+                Merge(m_TheMinutes.Open, theSample);
+            }
+
+            if (theHourS != m_TheHours.Open.StartS)
+            {
+                m_TheHours.Push(m_TheHours.Open);
+                m_TheHours.Open = theSample;
+                m_TheHours.Open.StartS = theHourS;
+            }
+            else
+            {
+                Merge(m_TheHours.Open, theSample);
+            }
+        }
+
+        m_TheLatestS = theTimeS;
+        m_IsEmpty = false;
+    }
+
+    m_TheHistoryMutex.unlock();
+}
+
+template <std::size_t RAW_SAMPLES, std::size_t MINUTE_ROLLUPS, std::size_t HOUR_ROLLUPS>
+HistorySummary_t NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::Query(const uint64_t & theFromUs,
+                                                                                          const uint64_t & theToUs) const
+{
+    // Readings are kept at whole seconds (truncated), hence the range is
+    // too; both ends are rounded up.
+    const auto theFromS = static_cast<uint32_t>((theFromUs + 999'999) / 1'000'000);
+    const auto theToS = static_cast<uint32_t>((theToUs + 999'999) / 1'000'000);
+    Rollup_t theResult = MakeRollup(0, 0, 0);
+    theResult.Count = 0;
+
+    m_TheHistoryMutex.lock();
+
+    if (!m_IsEmpty && (theFromS < theToS))
+    {
+        QueryHours(theResult, theFromS, theToS);
+    }
+
+    m_TheHistoryMutex.unlock();
+
+    HistorySummary_t theSummary{};
+    theSummary.Count = theResult.Count;
+    if (theResult.Count != 0)
+    {
+        theSummary.MinimumTemperatureTenths = theResult.MinimumTemperature;
+        theSummary.MaximumTemperatureTenths = theResult.MaximumTemperature;
+        theSummary.MeanTemperatureTenths = static_cast<int16_t>(theResult.TemperatureSum / static_cast<int32_t>(theResult.Count));
+        theSummary.MinimumHumidityTenths = theResult.MinimumHumidity;
+        theSummary.MaximumHumidityTenths = theResult.MaximumHumidity;
+        theSummary.MeanHumidityTenths = static_cast<uint16_t>(theResult.HumiditySum / static_cast<int32_t>(theResult.Count));
+    }
+
+    return theSummary;
+}
+
+template <std::size_t RAW_SAMPLES, std::size_t MINUTE_ROLLUPS, std::size_t HOUR_ROLLUPS>
+HistorySummary_t NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::QueryLast(const uint32_t & theDurationMs) const
+{
+    const auto theToUs = GetLatestTimeUs() + 1;
+    const auto theSpanUs = static_cast<uint64_t>(theDurationMs) * 1000;
+
+    return Query((theToUs > theSpanUs) ? (theToUs - theSpanUs) : 0, theToUs);
+}
+
+template <std::size_t RAW_SAMPLES, std::size_t MINUTE_ROLLUPS, std::size_t HOUR_ROLLUPS>
+uint64_t NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::GetLatestTimeUs() const
+{
+    m_TheHistoryMutex.lock();
+    const auto theLatestUs = static_cast<uint64_t>(m_TheLatestS) * 1'000'000;
+    m_TheHistoryMutex.unlock();
+
+    return theLatestUs;
+}
+
+template <std::size_t RAW_SAMPLES, std::size_t MINUTE_ROLLUPS, std::size_t HOUR_ROLLUPS>
+void NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::Merge(Rollup_t & theInto, const Rollup_t & theFrom)
+{
+    if (theFrom.Count == 0)
+    {
+        return;
+    }
+    if (theInto.Count == 0)
+    {
+        const auto theStartS = theInto.StartS;
+        theInto = theFrom;
+        theInto.StartS = theStartS;
+        return;
+    }
+
+    theInto.MinimumTemperature = std::min(theInto.MinimumTemperature, theFrom.MinimumTemperature);
+    theInto.MaximumTemperature = std::max(theInto.MaximumTemperature, theFrom.MaximumTemperature);
+    theInto.TemperatureSum += theFrom.TemperatureSum;
+    theInto.MinimumHumidity = std::min(theInto.MinimumHumidity, theFrom.MinimumHumidity);
+    theInto.MaximumHumidity = std::max(theInto.MaximumHumidity, theFrom.MaximumHumidity);
+    theInto.HumiditySum += theFrom.HumiditySum;
+    theInto.Count += theFrom.Count;
+}
+
+template <std::size_t RAW_SAMPLES, std::size_t MINUTE_ROLLUPS, std::size_t HOUR_ROLLUPS>
+typename NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::Rollup_t
+NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::MakeRollup(const uint32_t & theStartS,
+                                                                              const int16_t & theTemperature,
+                                                                              const uint16_t & theHumidity)
+{
+    return Rollup_t{theStartS, theTemperature, theTemperature, theTemperature,
+                    theHumidity, theHumidity, theHumidity, 1};
+}
+
+template <std::size_t RAW_SAMPLES, std::size_t MINUTE_ROLLUPS, std::size_t HOUR_ROLLUPS>
+void NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::QueryHours(Rollup_t & theResult,
+                                                                                   const uint32_t & theFromS,
+                                                                                   const uint32_t & theToS) const
+{
+    QueryTier(m_TheHours, HOUR_SECONDS, theResult, theFromS, theToS,
+              [this, &theResult](const uint32_t & theFinerFromS, const uint32_t & theFinerToS)
+              {
+                  QueryMinutes(theResult, theFinerFromS, theFinerToS);
+              });
+}
+
+template <std::size_t RAW_SAMPLES, std::size_t MINUTE_ROLLUPS, std::size_t HOUR_ROLLUPS>
+void NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::QueryMinutes(Rollup_t & theResult,
+                                                                                     const uint32_t & theFromS,
+                                                                                     const uint32_t & theToS) const
+{
+    QueryTier(m_TheMinutes, MINUTE_SECONDS, theResult, theFromS, theToS,
+              [this, &theResult](const uint32_t & theFinerFromS, const uint32_t & theFinerToS)
+              {
+                  QueryRaw(theResult, theFinerFromS, theFinerToS);
+              });
+}
+
+template <std::size_t RAW_SAMPLES, std::size_t MINUTE_ROLLUPS, std::size_t HOUR_ROLLUPS>
+void NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::QueryRaw(Rollup_t & theResult,
+                                                                                 const uint32_t & theFromS,
+                                                                                 const uint32_t & theToS) const
+{
+    for (std::size_t i = 0; i < m_TheRawCount; ++i)
+    {
+        const auto & theRaw = m_TheRaw[(m_TheRawNext + RAW_SAMPLES - m_TheRawCount + i) % RAW_SAMPLES];
+        if ((theRaw.TimeS >= theFromS) && (theRaw.TimeS < theToS))
+        {
+            Merge(theResult, MakeRollup(0, theRaw.Temperature, theRaw.Humidity));
+        }
+    }
+}
+
+template <std::size_t RAW_SAMPLES, std::size_t MINUTE_ROLLUPS, std::size_t HOUR_ROLLUPS>
+template <std::size_t CAPACITY, typename Finer>
+void NuerteyMeasurementHistory<RAW_SAMPLES, MINUTE_ROLLUPS, HOUR_ROLLUPS>::QueryTier(const Tier_t<CAPACITY> & theTier,
+                                                                                  const uint32_t & theBucketS,
+                                                                                  Rollup_t & theResult,
+                                                                                  const uint32_t & theFromS,
+                                                                                  const uint32_t & theToS,
+                                                                                  Finer theFinerQuery) const
+{
+    // A bucket is usable if it starts within the range, and everything it
+    // (so far) holds was sampled before the range ends. The open bucket
+    // holds nothing after the latest reading.
+    const auto IsUsable = [&](const Rollup_t & theBucket, const uint32_t & theEndS)
+    {
+        return (theBucket.Count != 0) && (theBucket.StartS >= theFromS) && (theEndS <= theToS);
+    };
+
+    auto theCoveredFromS = theToS;   // Empty coverage, until a bucket is used.
+    auto theCoveredToS = theToS;
+    auto isCovering = false;
+
+    const auto Use = [&](const Rollup_t & theBucket, const uint32_t & theEndS)
+    {
+        if (!isCovering)
+        {
+            theCoveredFromS = theBucket.StartS;
+            isCovering = true;
+        }
+        theCoveredToS = theEndS;
+        Merge(theResult, theBucket);
+    };
+
+    for (std::size_t i = 0; i < theTier.Count; ++i)
+    {
+        const auto & theBucket = theTier.At(i);
+        if (IsUsable(theBucket, theBucket.StartS + theBucketS))
+        {
+            Use(theBucket, theBucket.StartS + theBucketS);
+        }
+    }
+
+    const auto theOpenEndS = std::min(theTier.Open.StartS + theBucketS, m_TheLatestS + 1);
+    if (IsUsable(theTier.Open, theOpenEndS))
+    {
+        Use(theTier.Open, theOpenEndS);
+    }
+
+    if (!isCovering)
+    {
+        theFinerQuery(theFromS, theToS);
+        return;
+    }
+
+    // Usable buckets are contiguous in time (those in between are either
+    // usable too or empty), so only the two ends remain.
+    if (theFromS < theCoveredFromS)
+    {
+        theFinerQuery(theFromS, theCoveredFromS);
+    }
+    if (theCoveredToS < theToS)
+    {
+        theFinerQuery(theCoveredToS, theToS);
+    }
+}
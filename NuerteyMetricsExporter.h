@@ -0,0 +1,524 @@
+/***********************************************************************
+* @file      NuerteyMetricsExporter.h
+*
+*    Prometheus/OpenMetrics-style text exporter for DHT11/DHT22 sensor
+*    and driver statistics targetted for ARM Mbed platform.
+*
+* @brief   Accumulate per-sensor statistics from the sampling path and
+*          render them, on demand, in the Prometheus text exposition
+*          format over a minimal HTTP/1.0 endpoint.
+*
+* @note    The following metric families are exported, each labelled
+*          with the sensor's pin and model:
+*
+*            dht_temperature_celsius               gauge
+*            dht_humidity_percent                  gauge
+*            dht_reads_total{status="..."}         counter, one series
+*                                                  per SensorStatus_t
+*            dht_read_duration_microseconds        histogram
+*            dht_consecutive_failures              gauge
+*            dht_sensor_healthy                    gauge (1 or 0)
+*
+*          Rendering streams through a single fixed-size chunk buffer,
+*          so memory use is bounded regardless of how many sensors are
+*          registered. Each Render() call brings its own buffer, so other
+*          transports may render while a scrape is being served. The accepted connection is likewise a member,
+*          hence scrapes cost no heap allocations. Values are formatted
+*          from their fixed-point representation; no float printf.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cstdarg>
+#include <array>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+
+template <std::size_t MAXIMUM_SENSORS = 8, std::size_t CHUNK_SIZE_BYTES = 512>
+class NuerteyMetricsExporter
+{
+    static_assert(CHUNK_SIZE_BYTES >= 128, "Hey! The chunk buffer must at least hold one complete metric line!!");
+
+public:
+    static constexpr uint16_t    METRICS_DEFAULT_PORT            = 9100;
+    static constexpr uint8_t     UNHEALTHY_CONSECUTIVE_FAILURES  = 3;
+    static constexpr std::size_t NUMBER_OF_SENSOR_STATUSES       = 8;
+    static constexpr std::size_t NUMBER_OF_LATENCY_BUCKETS       = 6;
+
+    // Upper bounds (µs) of the read latency histogram buckets. A healthy
+    // DHT11 read is dominated by its ~20ms start signal, a DHT22's by
+    // the ~4ms data frame; failures tend to cut the transaction short.
+    static constexpr std::array<uint32_t, NUMBER_OF_LATENCY_BUCKETS> LATENCY_BUCKET_BOUNDS_US =
+                                                {{ 2500, 5000, 10000, 20000, 25000, 50000 }};
+
+    NuerteyMetricsExporter();
+
+    NuerteyMetricsExporter(const NuerteyMetricsExporter&) = delete;
+    NuerteyMetricsExporter& operator=(const NuerteyMetricsExporter&) = delete;
+
+    virtual ~NuerteyMetricsExporter();
+
+    // theModel must have static storage duration, e.g. "dht11".
+    bool RegisterSensor(const PinName & theSensorPin, const char * theModel);
+
+    // Sampling path entry point; suitable for direct registration via
+    // NuerteyDHT11Device::SetMeasurementCallback().
+    void Update(const Measurement_t & theMeasurement);
+
+    // Render the full exposition into theSink, in chunks of up to
+    // BUFFER_SIZE_BYTES - 1 bytes staged in theChunk. Exposed so that
+    // other transports (or a host-side harness) can reuse it.
+    template <std::size_t BUFFER_SIZE_BYTES>
+    void Render(char (&theChunk)[BUFFER_SIZE_BYTES], Callback<void(const char *, std::size_t)> theSink);
+
+    [[nodiscard]] nsapi_error_t Start(NetworkInterface * theNetworkInterface, EventQueue & theEventQueue,
+                                      const uint16_t & thePort = METRICS_DEFAULT_PORT);
+    void Stop();
+
+protected:
+
+private:
+    struct SensorStatistics_t
+    {
+        PinName                                         SensorPin;
+        const char *                                    Model;
+        Measurement_t                                   Latest;
+        bool                                            HasReading;
+        uint32_t                                        ConsecutiveFailures;
+        std::array<uint32_t, NUMBER_OF_SENSOR_STATUSES> ReadCounts;
+        std::array<uint32_t, NUMBER_OF_LATENCY_BUCKETS> LatencyBuckets; // Non-cumulative.
+        uint64_t                                        LatencySumUs;
+        uint32_t                                        LatencyCount;
+    };
+
+    // The state of one Render() call.
+    struct RenderContext_t
+    {
+        char *                                          pTheChunk;
+        std::size_t                                     ChunkSize;
+        std::size_t                                     ChunkLength;
+        Callback<void(const char *, std::size_t)>       Sink;
+    };
+
+    static const char * StatusLabel(const std::size_t & theIndex);
+
+    void Render(RenderContext_t & theContext);
+    void RenderSensor(RenderContext_t & theContext, const SensorStatistics_t & theStatistics, const std::size_t & theFamily);
+    static void Emit(RenderContext_t & theContext, const char * theFormat, ...);
+    static void Flush(RenderContext_t & theContext);
+
+    void OnSocketEvent();
+    void ServeClients();
+    void SendToClient(const char * theData, std::size_t theLength);
+
+    Mutex                                               m_TheStatisticsMutex;
+    std::array<SensorStatistics_t, MAXIMUM_SENSORS>     m_TheStatistics;
+    std::size_t                                         m_TheSensorCount;
+    char                                                m_TheChunk[CHUNK_SIZE_BYTES];
+    EventQueue *                                        m_pTheEventQueue;
+    TCPServer                                           m_TheServer;
+    TCPSocket                                           m_TheClient;
+    bool                                                m_IsStarted;
+};
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::NuerteyMetricsExporter()
+    : m_TheStatistics{}
+    , m_TheSensorCount(0)
+    , m_TheChunk{}
+    , m_pTheEventQueue(nullptr)
+    , m_IsStarted(false)
+{
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::~NuerteyMetricsExporter()
+{
+    Stop();
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+bool NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::RegisterSensor(const PinName & theSensorPin,
+                                                                               const char * theModel)
+{
+    m_TheStatisticsMutex.lock();
+
+    auto registered = false;
+    if (m_TheSensorCount < MAXIMUM_SENSORS)
+    {
+        auto & theStatistics = m_TheStatistics[m_TheSensorCount];
+        theStatistics = SensorStatistics_t{};
+        theStatistics.SensorPin = theSensorPin;
+        theStatistics.Model = theModel;
+        ++m_TheSensorCount;
+        registered = true;
+    }
+
+    m_TheStatisticsMutex.unlock();
+
+    return registered;
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+void NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::Update(const Measurement_t & theMeasurement)
+{
+    m_TheStatisticsMutex.lock();
+
+    for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+    {
+        auto & theStatistics = m_TheStatistics[i];
+        if (theStatistics.SensorPin != theMeasurement.SensorPin)
+        {
+            continue;
+        }
+
+        auto theStatusIndex = static_cast<std::size_t>(-ToUnderlyingType(theMeasurement.Status));
+        if (theStatusIndex < NUMBER_OF_SENSOR_STATUSES)
+        {
+            ++theStatistics.ReadCounts[theStatusIndex];
+        }
+
+        if (theMeasurement.Status == SensorStatus_t::SUCCESS)
+        {
+            theStatistics.Latest = theMeasurement;
+            theStatistics.HasReading = true;
+            theStatistics.ConsecutiveFailures = 0;
+        }
+        else
+        {
+            ++theStatistics.ConsecutiveFailures;
+        }
+
+        std::size_t theBucket = 0;
+        while ((theBucket < NUMBER_OF_LATENCY_BUCKETS)
+            && (theMeasurement.ReadDurationUs > LATENCY_BUCKET_BOUNDS_US[theBucket]))
+        {
+            ++theBucket;
+        }
+        if (theBucket < NUMBER_OF_LATENCY_BUCKETS)
+        {
+            ++theStatistics.LatencyBuckets[theBucket];
+        }
+        theStatistics.LatencySumUs += theMeasurement.ReadDurationUs;
+        ++theStatistics.LatencyCount;
+        break;
+    }
+
+    m_TheStatisticsMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+template <std::size_t BUFFER_SIZE_BYTES>
+void NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::Render(char (&theChunk)[BUFFER_SIZE_BYTES],
+                                                                       Callback<void(const char *, std::size_t)> theSink)
+{
+    static_assert(BUFFER_SIZE_BYTES >= 128, "Hey! The chunk buffer must at least hold one complete metric line!!");
+
+    RenderContext_t theContext{theChunk, BUFFER_SIZE_BYTES, 0, theSink};
+    Render(theContext);
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+void NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::Render(RenderContext_t & theContext)
+{
+    static constexpr const char * METRIC_FAMILY_PREAMBLES[] =
+    {
+        "# HELP dht_temperature_celsius Latest successfully read temperature.\n"
+        "# TYPE dht_temperature_celsius gauge\n",
+        "# HELP dht_humidity_percent Latest successfully read relative humidity.\n"
+        "# TYPE dht_humidity_percent gauge\n",
+        "# HELP dht_reads_total Bus reads attempted, by outcome.\n"
+        "# TYPE dht_reads_total counter\n",
+        "# HELP dht_read_duration_microseconds Duration of bus reads.\n"
+        "# TYPE dht_read_duration_microseconds histogram\n",
+        "# HELP dht_consecutive_failures Failed reads since the last success.\n"
+        "# TYPE dht_consecutive_failures gauge\n",
+        "# HELP dht_sensor_healthy Whether the sensor is currently deemed healthy.\n"
+        "# TYPE dht_sensor_healthy gauge\n"
+    };
+
+    for (std::size_t theFamily = 0; theFamily < (sizeof(METRIC_FAMILY_PREAMBLES) / sizeof(METRIC_FAMILY_PREAMBLES[0])); ++theFamily)
+    {
+        Emit(theContext, "%s", METRIC_FAMILY_PREAMBLES[theFamily]);
+
+        for (std::size_t i = 0; i < MAXIMUM_SENSORS; ++i)
+        {
+            // Take a consistent snapshot so that the sampling path is only
+            // ever held off for the duration of a small copy, never for
+            // the duration of a network send.
+            m_TheStatisticsMutex.lock();
+            auto isRegistered = (i < m_TheSensorCount);
+            SensorStatistics_t theSnapshot;
+            if (isRegistered)
+            {
+                theSnapshot = m_TheStatistics[i];
+            }
+            m_TheStatisticsMutex.unlock();
+
+            if (!isRegistered)
+            {
+                break;
+            }
+
+            RenderSensor(theContext, theSnapshot, theFamily);
+        }
+    }
+
+    Flush(theContext);
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+void NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::RenderSensor(RenderContext_t & theContext,
+                                                                             const SensorStatistics_t & theStatistics,
+                                                                             const std::size_t & theFamily)
+{
+    const auto pin = static_cast<int>(theStatistics.SensorPin);
+    const auto model = theStatistics.Model;
+    const auto t = static_cast<int>(theStatistics.Latest.TemperatureTenths);
+    const auto h = static_cast<int>(theStatistics.Latest.HumidityTenths);
+
+    switch (theFamily)
+    {
+        case 0:
+            if (theStatistics.HasReading)
+            {
+                Emit(theContext, "dht_temperature_celsius{sensor=\"%d\",model=\"%s\"} %s%d.%d\n",
+                     pin, model, (t < 0) ? "-" : "", abs(t) / 10, abs(t) % 10);
+            }
+            break;
+
+        case 1:
+            if (theStatistics.HasReading)
+            {
+                Emit(theContext, "dht_humidity_percent{sensor=\"%d\",model=\"%s\"} %d.%d\n",
+                     pin, model, h / 10, h % 10);
+            }
+            break;
+
+        case 2:
+            for (std::size_t s = 0; s < NUMBER_OF_SENSOR_STATUSES; ++s)
+            {
+                Emit(theContext, "dht_reads_total{sensor=\"%d\",model=\"%s\",status=\"%s\"} %lu\n",
+                     pin, model, StatusLabel(s), static_cast<unsigned long>(theStatistics.ReadCounts[s]));
+            }
+            break;
+
+        case 3:
+        {
+            // Prometheus buckets are cumulative.
+            uint32_t theCumulativeCount = 0;
+            for (std::size_t b = 0; b < NUMBER_OF_LATENCY_BUCKETS; ++b)
+            {
+                theCumulativeCount += theStatistics.LatencyBuckets[b];
+                Emit(theContext, "dht_read_duration_microseconds_bucket{sensor=\"%d\",model=\"%s\",le=\"%lu\"} %lu\n",
+                     pin, model, static_cast<unsigned long>(LATENCY_BUCKET_BOUNDS_US[b]),
+                     static_cast<unsigned long>(theCumulativeCount));
+            }
+            Emit(theContext, "dht_read_duration_microseconds_bucket{sensor=\"%d\",model=\"%s\",le=\"+Inf\"} %lu\n",
+                 pin, model, static_cast<unsigned long>(theStatistics.LatencyCount));
+            Emit(theContext, "dht_read_duration_microseconds_sum{sensor=\"%d\",model=\"%s\"} %llu\n",
+                 pin, model, static_cast<unsigned long long>(theStatistics.LatencySumUs));
+            Emit(theContext, "dht_read_duration_microseconds_count{sensor=\"%d\",model=\"%s\"} %lu\n",
+                 pin, model, static_cast<unsigned long>(theStatistics.LatencyCount));
+            break;
+        }
+
+        case 4:
+            Emit(theContext, "dht_consecutive_failures{sensor=\"%d\",model=\"%s\"} %lu\n",
+                 pin, model, static_cast<unsigned long>(theStatistics.ConsecutiveFailures));
+            break;
+
+        case 5:
+            Emit(theContext, "dht_sensor_healthy{sensor=\"%d\",model=\"%s\"} %d\n", pin, model,
+                 (theStatistics.HasReading
+                  && (theStatistics.ConsecutiveFailures < UNHEALTHY_CONSECUTIVE_FAILURES)) ? 1 : 0);
+            break;
+
+        default:
+            break;
+    }
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+const char * NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::StatusLabel(const std::size_t & theIndex)
+{
+    // Indexed by the negated SensorStatus_t value.
+    static constexpr const char * STATUS_LABELS[NUMBER_OF_SENSOR_STATUSES] =
+    {
+        "success", "bus_busy", "not_detected", "ack_too_long",
+        "sync_timeout", "data_timeout", "bad_checksum", "too_fast_reads"
+    };
+
+    return (theIndex < NUMBER_OF_SENSOR_STATUSES) ? STATUS_LABELS[theIndex] : "unknown";
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+void NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::Emit(RenderContext_t & theContext, const char * theFormat, ...)
+{
+    for (auto attempt = 0; attempt < 2; ++attempt)
+    {
+        va_list theArguments;
+        va_start(theArguments, theFormat);
+        auto theAvailable = theContext.ChunkSize - theContext.ChunkLength;
+        auto written = vsnprintf(&theContext.pTheChunk[theContext.ChunkLength], theAvailable, theFormat, theArguments);
+        va_end(theArguments);
+
+        if (written < 0)
+        {
+            return;
+        }
+
+        if (static_cast<std::size_t>(written) < theAvailable)
+        {
+            theContext.ChunkLength += static_cast<std::size_t>(written);
+            return;
+        }
+
+        // Did not fit; ship what we have and retry into an empty chunk.
+        // Should it still not fit, the (pathological) line is dropped.
+        Flush(theContext);
+    }
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+void NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::Flush(RenderContext_t & theContext)
+{
+    if ((theContext.ChunkLength > 0) && theContext.Sink)
+    {
+        theContext.Sink(theContext.pTheChunk, theContext.ChunkLength);
+    }
+
+    theContext.ChunkLength = 0;
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+nsapi_error_t NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::Start(NetworkInterface * theNetworkInterface,
+                                                                               EventQueue & theEventQueue,
+                                                                               const uint16_t & thePort)
+{
+    if (theNetworkInterface == nullptr)
+    {
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    auto result = m_TheServer.open(theNetworkInterface);
+    if (result != NSAPI_ERROR_OK)
+    {
+        return result;
+    }
+
+    result = m_TheServer.bind(thePort);
+    if (result == NSAPI_ERROR_OK)
+    {
+        result = m_TheServer.listen(1);
+    }
+
+    if (result != NSAPI_ERROR_OK)
+    {
+        m_TheServer.close();
+        return result;
+    }
+
+    // TCPServer::accept() into our member TCPSocket, unlike the newer
+    // TCPSocket::accept(), does not allocate the connection on the heap.
+    m_pTheEventQueue = &theEventQueue;
+    m_TheServer.set_blocking(false);
+    m_TheServer.sigio(callback(this, &NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::OnSocketEvent));
+    m_IsStarted = true;
+
+    return NSAPI_ERROR_OK;
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+void NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::Stop()
+{
+    if (m_IsStarted)
+    {
+        m_TheServer.sigio(nullptr);
+        m_TheServer.close();
+        m_IsStarted = false;
+    }
+
+    m_pTheEventQueue = nullptr;
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+void NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::OnSocketEvent()
+{
+    // sigio() is invoked from the network stack's context; defer.
+    if (m_pTheEventQueue != nullptr)
+    {
+        (void)m_pTheEventQueue->call(this, &NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::ServeClients);
+    }
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+void NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::ServeClients()
+{
+    static constexpr const char HTTP_OK_HEADER[] =
+        "HTTP/1.0 200 OK\r\n"
+        "Content-Type: text/plain; version=0.0.4\r\n"
+        "Connection: close\r\n\r\n";
+    static constexpr const char HTTP_NOT_FOUND[] =
+        "HTTP/1.0 404 Not Found\r\n"
+        "Connection: close\r\n\r\n";
+
+    while (m_IsStarted && (m_TheServer.accept(&m_TheClient) == NSAPI_ERROR_OK))
+    {
+        // Scrapers send their request straight away; do not let a stalled
+        // one hold up the event queue for long.
+        m_TheClient.set_timeout(1000);
+
+        // Only the request line matters. Reuse the chunk buffer for it.
+        auto theLength = m_TheClient.recv(m_TheChunk, CHUNK_SIZE_BYTES - 1);
+        if (theLength > 0)
+        {
+            m_TheChunk[theLength] = '\0';
+
+            // "/metrics" exactly, bar a query string; not "/metricsfoo".
+            const auto isMetricsPath = (strncmp(m_TheChunk, "GET /metrics", 12) == 0)
+                                    && ((m_TheChunk[12] == ' ') || (m_TheChunk[12] == '?'));
+
+            if (isMetricsPath || (strncmp(m_TheChunk, "GET / ", 6) == 0))
+            {
+                SendToClient(HTTP_OK_HEADER, sizeof(HTTP_OK_HEADER) - 1);
+                // The request line has been dealt with; the buffer is free
+                // to stage the response.
+                Render(m_TheChunk, callback(this, &NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::SendToClient));
+            }
+            else
+            {
+                SendToClient(HTTP_NOT_FOUND, sizeof(HTTP_NOT_FOUND) - 1);
+            }
+        }
+
+        // HTTP/1.0; closing the connection delimits the body.
+        m_TheClient.close();
+    }
+}
+
+template <std::size_t MAXIMUM_SENSORS, std::size_t CHUNK_SIZE_BYTES>
+void NuerteyMetricsExporter<MAXIMUM_SENSORS, CHUNK_SIZE_BYTES>::SendToClient(const char * theData, std::size_t theLength)
+{
+    while (theLength > 0)
+    {
+        auto sent = m_TheClient.send(theData, theLength);
+        if (sent <= 0)
+        {
+            break; // Scraper went away or timed out; abandon this scrape.
+        }
+
+        theData += sent;
+        theLength -= static_cast<std::size_t>(sent);
+    }
+}
@@ -0,0 +1,181 @@
+/***********************************************************************
+* @file      NuerteyMpscQueue.h
+*
+*    Fixed-size multi-producer, single-consumer queue for handing work
+*    from interrupt context to a thread, e.g. completed data frames from
+*    the capture ISRs of many sensors to one worker thread.
+*
+* @brief   Posting to an EventQueue or Mail from an ISR costs latency and
+*          can fail when the pool is exhausted. Push() here costs two
+*          atomic increments and a copy, never loops on contention with
+*          other producers, and is thus safe from any ISR at any priority,
+*          including one preempting another producer mid-push:
+*
+*            1. Reserve room: increment the occupancy. If it was already
+*               at capacity, undo it, count an overflow and fail.
+*            2. Claim a cell: increment the enqueue position. Room having
+*               been reserved, the consumer is done with that cell.
+*            3. Fill the cell and publish it via its sequence number.
+*
+*          The consumer takes cells in position order, and releases the
+*          room only after it has copied the element out.
+*
+* @note    A producer preempted between steps 2 and 3 holds up the cells
+*          after it; Pop() reports the queue empty until it resumes. An ISR
+*          always resumes before the thread that drains the queue runs
+*          again, so this costs nothing but a little latency.
+*
+*          On Cortex-M3 and up, each atomic increment is an LDREX/STREX
+*          pair that retries only if an interrupt lands in between, i.e. a
+*          bounded number of times. Cortex-M0 has no exclusives; there the
+*          toolchain's atomics briefly mask interrupts instead.
+*
+*          Nothing in here depends upon Mbed OS.
+*
+* @warning Pop() and Drain() must only ever be called from one thread.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <type_traits>
+#include "NuerteyDHT11Protocol.h"
+
+template <typename T, std::size_t CAPACITY = 16>
+class NuerteyMpscQueue
+{
+    static_assert((CAPACITY >= 2) && ((CAPACITY & (CAPACITY - 1)) == 0),
+    "Hey! The queue capacity must be a power of two!!");
+
+    static_assert(std::is_trivially_copyable<T>::value,
+    "Hey! Queue elements are copied in and out of interrupt context, they must be trivially copyable!!");
+
+public:
+    NuerteyMpscQueue()
+        : m_TheOccupancy(0)
+        , m_TheEnqueuePosition(0)
+        , m_TheOverflowCount(0)
+        , m_TheHighWatermark(0)
+        , m_TheDequeuePosition(0)
+    {
+        for (auto & theCell : m_TheCells)
+        {
+            theCell.Sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    NuerteyMpscQueue(const NuerteyMpscQueue&) = delete;
+    NuerteyMpscQueue& operator=(const NuerteyMpscQueue&) = delete;
+
+    virtual ~NuerteyMpscQueue() = default;
+
+    // Safe from any thread or ISR. Returns false, and counts an overflow,
+    // if the queue is full.
+    bool Push(const T & theElement)
+    {
+        // Acquire: the consumer's release of this room orders its copy out
+        // of the cell before our copy in.
+        const auto theOccupancy = m_TheOccupancy.fetch_add(1, std::memory_order_acquire);
+        if (theOccupancy >= CAPACITY)
+        {
+            m_TheOccupancy.fetch_sub(1, std::memory_order_relaxed);
+            m_TheOverflowCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Racing producers may each store their own reading; the mark may
+        // then lag a concurrent peak by one or two, which is good enough
+        // for sizing the queue and keeps this free of retry loops.
+        if ((theOccupancy + 1) > m_TheHighWatermark.load(std::memory_order_relaxed))
+        {
+            m_TheHighWatermark.store(theOccupancy + 1, std::memory_order_relaxed);
+        }
+
+        const auto position = m_TheEnqueuePosition.fetch_add(1, std::memory_order_relaxed);
+        auto & theCell = m_TheCells[position & (CAPACITY - 1)];
+
+        theCell.Element = theElement;
+        theCell.Sequence.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer thread only. Returns false if the queue is empty (or the
+    // next element is still being written).
+    bool Pop(T & theElement)
+    {
+        auto & theCell = m_TheCells[m_TheDequeuePosition & (CAPACITY - 1)];
+
+        if (theCell.Sequence.load(std::memory_order_acquire) != (m_TheDequeuePosition + 1))
+        {
+            return false;
+        }
+
+        theElement = theCell.Element;
+        ++m_TheDequeuePosition;
+        m_TheOccupancy.fetch_sub(1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer thread only. Pops up to theMaximum elements into
+    // theHandler(const T &); returns how many.
+    template <typename Handler>
+    std::size_t Drain(Handler && theHandler, const std::size_t & theMaximum = CAPACITY)
+    {
+        std::size_t theCount = 0;
+        T theElement;
+
+        while ((theCount < theMaximum) && Pop(theElement))
+        {
+            theHandler(theElement);
+            ++theCount;
+        }
+
+        return theCount;
+    }
+
+    // Elements pushed and not yet popped, plus pushes in progress.
+    uint32_t GetSize() const { return m_TheOccupancy.load(std::memory_order_relaxed); }
+
+    uint32_t GetOverflowCount() const  { return m_TheOverflowCount.load(std::memory_order_relaxed); }
+    uint32_t GetHighWatermark() const  { return m_TheHighWatermark.load(std::memory_order_relaxed); }
+
+    static constexpr std::size_t GetCapacity() { return CAPACITY; }
+
+private:
+    struct Cell_t
+    {
+        std::atomic<uint32_t> Sequence;  // Position + 1 once published.
+        T                     Element;
+    };
+
+    std::array<Cell_t, CAPACITY> m_TheCells;
+    std::atomic<uint32_t>        m_TheOccupancy;
+    std::atomic<uint32_t>        m_TheEnqueuePosition;
+    std::atomic<uint32_t>        m_TheOverflowCount;
+    std::atomic<uint32_t>        m_TheHighWatermark;
+    uint32_t                     m_TheDequeuePosition;  // Consumer only.
+};
+
+// A frame as completed by an interrupt-driven capture, for the thread
+// that decodes and publishes it.
+struct CompletedFrame_t
+{
+    uint32_t       CaptureTimeUs;
+    uint16_t       SensorPin;
+    SensorModel_t  Model;
+    SensorStatus_t Status;
+    DataFrame_t    Frame;
+};
+
+template <std::size_t CAPACITY = 16>
+using NuerteyFrameQueue = NuerteyMpscQueue<CompletedFrame_t, CAPACITY>;
@@ -0,0 +1,529 @@
+/***********************************************************************
+* @file      NuerteyReadingCalibrator.h
+*
+*    Online cross-sensor offset/gain calibration of DHT11/DHT22 readings,
+*    targetted for ARM Mbed platform.
+*
+* @brief   Estimate, per sensor, the linear correction that best maps its
+*          raw readings onto those of a reference sensor (or, lacking one,
+*          onto the median of the rest of the fleet) with recursive least
+*          squares, then fold it into the device's fixed-point decode.
+*
+* @note    Each channel of each sensor fits
+*
+*            reference - pivot = Gain * (raw - pivot) + Offset
+*
+*          about the same pivots as ReadingCalibration_t, with exponential
+*          forgetting so that slow sensor ageing is tracked. Readings are
+*          paired only when the reference reading is at most
+*          REFERENCE_MAXIMUM_AGE_US apart; enclosure air seldom moves
+*          appreciably within that.
+*
+*          Feed it already calibrated Measurement_t (e.g. straight from
+*          SetMeasurementCallback()); it undoes the correction it last
+*          applied to recover the raw values. Hence Apply() should run on
+*          the same thread as the reads, or between them, lest a reading
+*          decoded with the previous correction be undone with the new one.
+*
+*          Until MINIMUM_PAIRED_READINGS have been paired, nothing is
+*          applied. Persist what is applied with NuerteyTimingProfileStore,
+*          and hand it back to RegisterSensor() after a reboot so that the
+*          estimate resumes from there rather than from the identity.
+*
+*          Do not combine with NuerteyInterleavedSensor's own offset
+*          learning; call its SetOffsetLearningEnabled(false) first.
+*
+*          A 2x2 covariance and two parameters per channel; no heap.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <array>
+#include <algorithm>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+
+template <std::size_t MAXIMUM_SENSORS = 8>
+class NuerteyReadingCalibrator
+{
+    static_assert(MAXIMUM_SENSORS >= 2,
+    "Hey! Cross-sensor calibration needs at least two sensors to cross!!");
+
+public:
+    // Memory of roughly 1/(1 - FORGETTING_FACTOR) paired readings, i.e.
+    // about an hour at the minimum sampling period.
+    static constexpr float    FORGETTING_FACTOR                   = 0.999f;
+
+    // Prior uncertainty of the parameters, as variances: ±0.1 in gain,
+    // ±2°C and ±5%RH in offset. The covariance is never let to grow past
+    // these, which keeps it from winding up whilst readings hover about
+    // one value and the gain is unobservable.
+    static constexpr float    INITIAL_GAIN_VARIANCE               = 0.01f;
+    static constexpr float    INITIAL_TEMPERATURE_OFFSET_VARIANCE = 4.0f;
+    static constexpr float    INITIAL_HUMIDITY_OFFSET_VARIANCE    = 25.0f;
+
+    // Pairs disagreeing by more than this are disregarded as glitches.
+    static constexpr float    MAXIMUM_TEMPERATURE_RESIDUAL        = 8.0f;   // °C
+    static constexpr float    MAXIMUM_HUMIDITY_RESIDUAL           = 20.0f;  // %RH
+
+    static constexpr uint64_t REFERENCE_MAXIMUM_AGE_US            = 10'000'000;
+    static constexpr uint32_t MINIMUM_PAIRED_READINGS             = 30;
+
+    // Without a reference sensor, at least this many other sensors must
+    // have fresh readings for their median to be worth fitting against.
+    static constexpr std::size_t MINIMUM_FLEET_PEERS              = 2;
+
+    NuerteyReadingCalibrator();
+
+    NuerteyReadingCalibrator(const NuerteyReadingCalibrator&) = delete;
+    NuerteyReadingCalibrator& operator=(const NuerteyReadingCalibrator&) = delete;
+
+    virtual ~NuerteyReadingCalibrator();
+
+    // theApplied is the correction the device currently decodes with,
+    // e.g. as restored from NuerteyTimingProfileStore.
+    bool RegisterSensor(const PinName & theSensorPin,
+                        const ReadingCalibration_t & theApplied = IDENTITY_READING_CALIBRATION);
+
+    // NC (the default) calibrates every sensor against the fleet median.
+    // The reference sensor itself is never recalibrated.
+    void SetReferenceSensor(const PinName & theSensorPin);
+
+    // Sampling path entry point; suitable for direct registration via
+    // NuerteyDHT11Device::SetMeasurementCallback().
+    void Update(const Measurement_t & theMeasurement);
+
+    // False whilst the sensor is unregistered or not yet converged.
+    bool GetCalibration(const PinName & theSensorPin, ReadingCalibration_t & theCalibration) const;
+    uint32_t GetPairedReadings(const PinName & theSensorPin) const;
+
+    // Hands the current estimate to NuerteyDHT11Device<T>, where it costs
+    // one multiply-add per channel per read.
+    template <typename Device>
+    bool Apply(Device & theDevice);
+
+protected:
+
+private:
+    struct Channel_t
+    {
+        float Gain;
+        float Offset;               // Units (°C or %RH), not tenths.
+        float P00;                  // Covariance; symmetric, so P10 == P01.
+        float P01;
+        float P11;
+    };
+
+    struct SensorState_t
+    {
+        PinName              SensorPin;
+        ReadingCalibration_t Applied;
+        Channel_t            Temperature;
+        Channel_t            Humidity;
+        int16_t              LastTemperatureTenths;  // As reported, i.e. calibrated.
+        uint16_t             LastHumidityTenths;
+        uint64_t             LastSampleTimeUs;
+        uint32_t             LastSequenceNumber;
+        uint32_t             PairedReadings;
+        bool                 HasReading;
+    };
+
+    static Channel_t MakeChannel(const float & theGain, const float & theOffset, const float & theOffsetVariance);
+    static void Fit(Channel_t & theChannel, const float & theRaw, const float & theReference,
+                    const float & theOffsetVariance, const float & theMaximumResidual);
+    static float Uncalibrate(const int32_t & theTenths, const int32_t & thePivotTenths,
+                             const int16_t & theOffsetTenths, const int16_t & theGain);
+    static int16_t Quantize(const float & theValue, const float & theScale,
+                            const int16_t & theMinimum, const int16_t & theMaximum);
+
+    SensorState_t * FindSensor(const PinName & theSensorPin);
+    const SensorState_t * FindSensor(const PinName & theSensorPin) const;
+    void Recentre(Channel_t SensorState_t::* theChannel);
+    bool FindReference(const SensorState_t & theSensor, float & theTemperatureTenths, float & theHumidityTenths) const;
+    ReadingCalibration_t MakeCalibration(const SensorState_t & theSensor) const;
+
+    mutable Mutex                                     m_TheCalibratorMutex;
+    std::array<SensorState_t, MAXIMUM_SENSORS>        m_TheSensors;
+    std::size_t                                       m_TheSensorCount;
+    PinName                                           m_TheReferencePin;
+};
+
+template <std::size_t MAXIMUM_SENSORS>
+NuerteyReadingCalibrator<MAXIMUM_SENSORS>::NuerteyReadingCalibrator()
+    : m_TheSensors{}
+    , m_TheSensorCount(0)
+    , m_TheReferencePin(NC)
+{
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+NuerteyReadingCalibrator<MAXIMUM_SENSORS>::~NuerteyReadingCalibrator()
+{
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+bool NuerteyReadingCalibrator<MAXIMUM_SENSORS>::RegisterSensor(const PinName & theSensorPin,
+                                                               const ReadingCalibration_t & theApplied)
+{
+    const auto & theCalibration = IsReadingCalibrationPlausible(theApplied) ? theApplied
+                                                                            : IDENTITY_READING_CALIBRATION;
+    m_TheCalibratorMutex.lock();
+
+    auto registered = false;
+    if ((m_TheSensorCount < MAXIMUM_SENSORS) && (FindSensor(theSensorPin) == nullptr))
+    {
+        auto & theSensor = m_TheSensors[m_TheSensorCount];
+
+        theSensor = SensorState_t{};
+        theSensor.SensorPin = theSensorPin;
+        theSensor.Applied = theCalibration;
+        theSensor.Temperature = MakeChannel(static_cast<float>(theCalibration.TemperatureGain) / CALIBRATION_UNITY_GAIN,
+                                            static_cast<float>(theCalibration.TemperatureOffsetTenths) / 10.0f,
+                                            INITIAL_TEMPERATURE_OFFSET_VARIANCE);
+        theSensor.Humidity = MakeChannel(static_cast<float>(theCalibration.HumidityGain) / CALIBRATION_UNITY_GAIN,
+                                         static_cast<float>(theCalibration.HumidityOffsetTenths) / 10.0f,
+                                         INITIAL_HUMIDITY_OFFSET_VARIANCE);
+        ++m_TheSensorCount;
+        registered = true;
+    }
+
+    m_TheCalibratorMutex.unlock();
+
+    return registered;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyReadingCalibrator<MAXIMUM_SENSORS>::SetReferenceSensor(const PinName & theSensorPin)
+{
+    m_TheCalibratorMutex.lock();
+    m_TheReferencePin = theSensorPin;
+    m_TheCalibratorMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyReadingCalibrator<MAXIMUM_SENSORS>::Update(const Measurement_t & theMeasurement)
+{
+    // Only fresh, good readings; a failed read re-reports stale values.
+    if ((theMeasurement.Status != SensorStatus_t::SUCCESS)
+     || (theMeasurement.SampleTimeUs != theMeasurement.CaptureTimeUs))
+    {
+        return;
+    }
+
+    m_TheCalibratorMutex.lock();
+
+    auto pTheSensor = FindSensor(theMeasurement.SensorPin);
+    if ((pTheSensor != nullptr) && (pTheSensor->LastSequenceNumber != theMeasurement.SequenceNumber))
+    {
+        auto & theSensor = *pTheSensor;
+
+        theSensor.LastSequenceNumber = theMeasurement.SequenceNumber;
+        theSensor.LastTemperatureTenths = theMeasurement.TemperatureTenths;
+        theSensor.LastHumidityTenths = theMeasurement.HumidityTenths;
+        theSensor.LastSampleTimeUs = theMeasurement.SampleTimeUs;
+        theSensor.HasReading = true;
+
+        float theReferenceTemperature = 0.0f;
+        float theReferenceHumidity = 0.0f;
+
+        if ((theSensor.SensorPin != m_TheReferencePin)
+         && FindReference(theSensor, theReferenceTemperature, theReferenceHumidity))
+        {
+            const auto & theApplied = theSensor.Applied;
+            const auto theRawTemperature = Uncalibrate(theMeasurement.TemperatureTenths, TEMPERATURE_CALIBRATION_PIVOT,
+                                                       theApplied.TemperatureOffsetTenths, theApplied.TemperatureGain);
+            const auto theRawHumidity = Uncalibrate(theMeasurement.HumidityTenths, HUMIDITY_CALIBRATION_PIVOT,
+                                                    theApplied.HumidityOffsetTenths, theApplied.HumidityGain);
+
+            // Fit in units relative to the pivots; tenths would make the
+            // offset and gain variances wildly disparate.
+            Fit(theSensor.Temperature,
+                (theRawTemperature - TEMPERATURE_CALIBRATION_PIVOT) / 10.0f,
+                (theReferenceTemperature - TEMPERATURE_CALIBRATION_PIVOT) / 10.0f,
+                INITIAL_TEMPERATURE_OFFSET_VARIANCE, MAXIMUM_TEMPERATURE_RESIDUAL);
+            Fit(theSensor.Humidity,
+                (theRawHumidity - HUMIDITY_CALIBRATION_PIVOT) / 10.0f,
+                (theReferenceHumidity - HUMIDITY_CALIBRATION_PIVOT) / 10.0f,
+                INITIAL_HUMIDITY_OFFSET_VARIANCE, MAXIMUM_HUMIDITY_RESIDUAL);
+            ++theSensor.PairedReadings;
+
+            if (m_TheReferencePin == NC)
+            {
+                Recentre(&SensorState_t::Temperature);
+                Recentre(&SensorState_t::Humidity);
+            }
+        }
+    }
+
+    m_TheCalibratorMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+bool NuerteyReadingCalibrator<MAXIMUM_SENSORS>::GetCalibration(const PinName & theSensorPin,
+                                                               ReadingCalibration_t & theCalibration) const
+{
+    m_TheCalibratorMutex.lock();
+
+    const auto pTheSensor = FindSensor(theSensorPin);
+    const auto isConverged = (pTheSensor != nullptr) && (pTheSensor->PairedReadings >= MINIMUM_PAIRED_READINGS);
+    if (isConverged)
+    {
+        theCalibration = MakeCalibration(*pTheSensor);
+    }
+
+    m_TheCalibratorMutex.unlock();
+
+    return isConverged;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+uint32_t NuerteyReadingCalibrator<MAXIMUM_SENSORS>::GetPairedReadings(const PinName & theSensorPin) const
+{
+    m_TheCalibratorMutex.lock();
+
+    const auto pTheSensor = FindSensor(theSensorPin);
+    const auto thePairedReadings = (pTheSensor != nullptr) ? pTheSensor->PairedReadings : 0;
+
+    m_TheCalibratorMutex.unlock();
+
+    return thePairedReadings;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+template <typename Device>
+bool NuerteyReadingCalibrator<MAXIMUM_SENSORS>::Apply(Device & theDevice)
+{
+    m_TheCalibratorMutex.lock();
+
+    auto pTheSensor = FindSensor(theDevice.GetPinName());
+    const auto isConverged = (pTheSensor != nullptr) && (pTheSensor->PairedReadings >= MINIMUM_PAIRED_READINGS);
+    if (isConverged)
+    {
+        // Record it under the same lock that Update() undoes it under.
+        pTheSensor->Applied = MakeCalibration(*pTheSensor);
+        theDevice.SetReadingCalibration(pTheSensor->Applied);
+    }
+
+    m_TheCalibratorMutex.unlock();
+
+    return isConverged;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+typename NuerteyReadingCalibrator<MAXIMUM_SENSORS>::Channel_t
+NuerteyReadingCalibrator<MAXIMUM_SENSORS>::MakeChannel(const float & theGain, const float & theOffset,
+                                                       const float & theOffsetVariance)
+{
+    return Channel_t{theGain, theOffset, INITIAL_GAIN_VARIANCE, 0.0f, theOffsetVariance};
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyReadingCalibrator<MAXIMUM_SENSORS>::Fit(Channel_t & theChannel, const float & theRaw,
+                                                    const float & theReference, const float & theOffsetVariance,
+                                                    const float & theMaximumResidual)
+{
+    // Regressor phi = [raw, 1], parameters theta = [Gain, Offset].
+    const auto theResidual = theReference - ((theChannel.Gain * theRaw) + theChannel.Offset);
+    if (std::fabs(theResidual) > theMaximumResidual)
+    {
+        return;
+    }
+
+    // P * phi, and the gain vector k = P * phi / (lambda + phi' * P * phi).
+    const auto thePhi0 = (theChannel.P00 * theRaw) + theChannel.P01;
+    const auto thePhi1 = (theChannel.P01 * theRaw) + theChannel.P11;
+    const auto theDenominator = FORGETTING_FACTOR + (theRaw * thePhi0) + thePhi1;
+    const auto theK0 = thePhi0 / theDenominator;
+    const auto theK1 = thePhi1 / theDenominator;
+
+    theChannel.Gain += theK0 * theResidual;
+    theChannel.Offset += theK1 * theResidual;
+
+    // P = (P - k * phi' * P) / lambda
+    theChannel.P00 = (theChannel.P00 - (theK0 * thePhi0)) / FORGETTING_FACTOR;
+    theChannel.P01 = (theChannel.P01 - (theK0 * thePhi1)) / FORGETTING_FACTOR;
+    theChannel.P11 = (theChannel.P11 - (theK1 * thePhi1)) / FORGETTING_FACTOR;
+
+    // Anti-windup: forgetting inflates P along any direction the data do
+    // not excite, e.g. the gain whilst the raw value barely changes.
+    const auto theTraceCap = INITIAL_GAIN_VARIANCE + theOffsetVariance;
+    const auto theTrace = theChannel.P00 + theChannel.P11;
+    if (theTrace > theTraceCap)
+    {
+        const auto theScale = theTraceCap / theTrace;
+        theChannel.P00 *= theScale;
+        theChannel.P01 *= theScale;
+        theChannel.P11 *= theScale;
+    }
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+float NuerteyReadingCalibrator<MAXIMUM_SENSORS>::Uncalibrate(const int32_t & theTenths, const int32_t & thePivotTenths,
+                                                             const int16_t & theOffsetTenths, const int16_t & theGain)
+{
+    // Inverse of ApplyLinearCalibration(), less its rounding.
+    return static_cast<float>(thePivotTenths)
+         + ((static_cast<float>(theTenths - thePivotTenths - theOffsetTenths) * CALIBRATION_UNITY_GAIN) / theGain);
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+int16_t NuerteyReadingCalibrator<MAXIMUM_SENSORS>::Quantize(const float & theValue, const float & theScale,
+                                                            const int16_t & theMinimum, const int16_t & theMaximum)
+{
+    const auto theScaled = std::lround(theValue * theScale);
+
+    return static_cast<int16_t>(std::clamp<long>(theScaled, theMinimum, theMaximum));
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+typename NuerteyReadingCalibrator<MAXIMUM_SENSORS>::SensorState_t *
+NuerteyReadingCalibrator<MAXIMUM_SENSORS>::FindSensor(const PinName & theSensorPin)
+{
+    for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+    {
+        if (m_TheSensors[i].SensorPin == theSensorPin)
+        {
+            return &m_TheSensors[i];
+        }
+    }
+
+    return nullptr;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+const typename NuerteyReadingCalibrator<MAXIMUM_SENSORS>::SensorState_t *
+NuerteyReadingCalibrator<MAXIMUM_SENSORS>::FindSensor(const PinName & theSensorPin) const
+{
+    return const_cast<NuerteyReadingCalibrator *>(this)->FindSensor(theSensorPin);
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteyReadingCalibrator<MAXIMUM_SENSORS>::Recentre(Channel_t SensorState_t::* theChannel)
+{
+    // Fitting every sensor to its calibrated peers leaves the fleet as a
+    // whole free to wander; least squares' attenuation bias alone would
+    // shrink every gain a little with each round. Pin the fleet's mean
+    // correction to the identity, i.e. trust the sensors on average.
+    // Only over sensors that have been fitted at all: one registered but
+    // never yet paired still holds its prior, and counting that would
+    // drag the fleet's mean towards it (and shift the prior in turn).
+    auto theMeanGain = 0.0f;
+    auto theMeanOffset = 0.0f;
+    std::size_t theFittedCount = 0;
+
+    for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+    {
+        if (m_TheSensors[i].PairedReadings > 0)
+        {
+            theMeanGain += (m_TheSensors[i].*theChannel).Gain;
+            theMeanOffset += (m_TheSensors[i].*theChannel).Offset;
+            ++theFittedCount;
+        }
+    }
+
+    if (theFittedCount == 0)
+    {
+        return;
+    }
+    theMeanGain /= theFittedCount;
+    theMeanOffset /= theFittedCount;
+
+    for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+    {
+        if (m_TheSensors[i].PairedReadings == 0)
+        {
+            continue;
+        }
+
+        auto & theState = m_TheSensors[i].*theChannel;
+
+        theState.Gain /= theMeanGain;
+        theState.Offset = (theState.Offset - theMeanOffset) / theMeanGain;
+    }
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+bool NuerteyReadingCalibrator<MAXIMUM_SENSORS>::FindReference(const SensorState_t & theSensor,
+                                                              float & theTemperatureTenths,
+                                                              float & theHumidityTenths) const
+{
+    const auto IsFresh = [&theSensor](const SensorState_t & thePeer)
+    {
+        const auto theApartUs = (thePeer.LastSampleTimeUs > theSensor.LastSampleTimeUs)
+                              ? (thePeer.LastSampleTimeUs - theSensor.LastSampleTimeUs)
+                              : (theSensor.LastSampleTimeUs - thePeer.LastSampleTimeUs);
+        return (thePeer.HasReading && (theApartUs <= REFERENCE_MAXIMUM_AGE_US));
+    };
+
+    if (m_TheReferencePin != NC)
+    {
+        const auto pTheReference = FindSensor(m_TheReferencePin);
+        if ((pTheReference == nullptr) || !IsFresh(*pTheReference))
+        {
+            return false;
+        }
+
+        theTemperatureTenths = pTheReference->LastTemperatureTenths;
+        theHumidityTenths = pTheReference->LastHumidityTenths;
+        return true;
+    }
+
+    // Fleet median: robust to any one sensor, this one included, being off.
+    std::array<int16_t, MAXIMUM_SENSORS> theTemperatures;
+    std::array<uint16_t, MAXIMUM_SENSORS> theHumidities;
+    std::size_t thePeers = 0;
+
+    for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+    {
+        const auto & thePeer = m_TheSensors[i];
+        if ((&thePeer != &theSensor) && IsFresh(thePeer))
+        {
+            theTemperatures[thePeers] = thePeer.LastTemperatureTenths;
+            theHumidities[thePeers] = thePeer.LastHumidityTenths;
+            ++thePeers;
+        }
+    }
+
+    if (thePeers < MINIMUM_FLEET_PEERS)
+    {
+        return false;
+    }
+
+    const auto Median = [thePeers](auto & theValues)
+    {
+        std::sort(theValues.begin(), theValues.begin() + thePeers);
+        const auto theMiddle = thePeers / 2;
+
+        return ((thePeers % 2) != 0) ? static_cast<float>(theValues[theMiddle])
+             : (static_cast<float>(theValues[theMiddle - 1]) + static_cast<float>(theValues[theMiddle])) / 2.0f;
+    };
+
+    theTemperatureTenths = Median(theTemperatures);
+    theHumidityTenths = Median(theHumidities);
+    return true;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+ReadingCalibration_t NuerteyReadingCalibrator<MAXIMUM_SENSORS>::MakeCalibration(const SensorState_t & theSensor) const
+{
+    ReadingCalibration_t theCalibration;
+
+    theCalibration.TemperatureGain = Quantize(theSensor.Temperature.Gain, CALIBRATION_UNITY_GAIN,
+                                              MINIMUM_CALIBRATION_GAIN, MAXIMUM_CALIBRATION_GAIN);
+    theCalibration.TemperatureOffsetTenths = Quantize(theSensor.Temperature.Offset, 10.0f,
+                                              -MAXIMUM_TEMPERATURE_OFFSET_TENTHS, MAXIMUM_TEMPERATURE_OFFSET_TENTHS);
+    theCalibration.HumidityGain = Quantize(theSensor.Humidity.Gain, CALIBRATION_UNITY_GAIN,
+                                              MINIMUM_CALIBRATION_GAIN, MAXIMUM_CALIBRATION_GAIN);
+    theCalibration.HumidityOffsetTenths = Quantize(theSensor.Humidity.Offset, 10.0f,
+                                              -MAXIMUM_HUMIDITY_OFFSET_TENTHS, MAXIMUM_HUMIDITY_OFFSET_TENTHS);
+
+    return theCalibration;
+}
@@ -0,0 +1,353 @@
+/***********************************************************************
+* @file      NuerteySensorFusion.h
+*
+*    Fusion of several co-located DHT11/DHT22 sensors into a single
+*    temperature/humidity estimate, targetted for ARM Mbed platform.
+*
+* @brief   Feed the Measurement_t of every sensor in an enclosure into a
+*          pair of scalar Kalman filters (temperature and humidity, each
+*          modelled as a random walk), weighting every reading by its
+*          sensor's datasheet accuracy and recent health.
+*
+* @note    The sensors need not be read in lockstep. Each reading enters
+*          the filter at its own SampleTimeUs, so staggering reads across
+*          sensors yields a fused estimate that is updated more often than
+*          any one sensor may be sampled.
+*
+*          A sensor's health is a running success rate over its reads,
+*          dragged down further by readings the filter rejects as outliers.
+*          An unhealthy sensor's measurement noise is inflated accordingly,
+*          so that it fades out of the estimate rather than dragging it.
+*
+*          The filter state is a handful of floats per channel; no heap.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <array>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+
+struct FusedEstimate_t
+{
+    int16_t     TemperatureTenths;      // Celsius x 10
+    uint16_t    HumidityTenths;         // %RH x 10
+    float       TemperatureSigma;       // Standard deviation of the estimate, °C.
+    float       HumiditySigma;          // Standard deviation of the estimate, %RH.
+    uint64_t    TimeUs;                 // SampleTimeUs of the latest reading fused in.
+    uint8_t     ContributingSensors;    // Sensors currently deemed healthy.
+    bool        IsValid;                // False until the first good reading.
+};
+
+template <std::size_t MAXIMUM_SENSORS = 4>
+class NuerteySensorFusion
+{
+public:
+    // Datasheet accuracies, treated as one standard deviation; the DHT11
+    // also loses up to a whole unit to its integer resolution (1/12 var).
+    static constexpr float DHT11_TEMPERATURE_VARIANCE = (2.0f * 2.0f) + (1.0f / 12.0f);
+    static constexpr float DHT22_TEMPERATURE_VARIANCE = (0.5f * 0.5f);
+    static constexpr float DHT11_HUMIDITY_VARIANCE    = (5.0f * 5.0f) + (1.0f / 12.0f);
+    static constexpr float DHT22_HUMIDITY_VARIANCE    = (2.0f * 2.0f);
+
+    // How fast enclosure air may drift, as random walk variance per second.
+    static constexpr float TEMPERATURE_PROCESS_NOISE  = 0.0025f;  // ~0.4°C per minute.
+    static constexpr float HUMIDITY_PROCESS_NOISE     = 0.01f;    // ~0.8%RH per minute.
+
+    // Readings further than this many sigmas from the prediction are
+    // treated as outliers. After OUTLIER_RESET_COUNT rejections in a row
+    // (from any sensors), the filter accepts that the world has moved.
+    static constexpr float   OUTLIER_GATE_SIGMAS      = 4.0f;
+    static constexpr uint8_t OUTLIER_RESET_COUNT      = 3;
+
+    // Health is a moving average of read outcomes (1 good, 0 bad) with
+    // weight 1/HEALTH_AVERAGING_READS. Noise variance is divided by its
+    // square, floored at MINIMUM_HEALTH, and sensors below HEALTHY_THRESHOLD
+    // are not counted as contributing.
+    static constexpr float HEALTH_AVERAGING_READS     = 8.0f;
+    static constexpr float MINIMUM_HEALTH             = 0.05f;
+    static constexpr float HEALTHY_THRESHOLD          = 0.5f;
+
+    NuerteySensorFusion();
+
+    NuerteySensorFusion(const NuerteySensorFusion&) = delete;
+    NuerteySensorFusion& operator=(const NuerteySensorFusion&) = delete;
+
+    virtual ~NuerteySensorFusion();
+
+    bool RegisterSensor(const PinName & theSensorPin, const SensorModel_t & theModel);
+
+    // Sampling path entry point; suitable for direct registration via
+    // NuerteyDHT11Device::SetMeasurementCallback(). Readings already fused
+    // (same SequenceNumber) and unregistered sensors are ignored.
+    void Update(const Measurement_t & theMeasurement);
+
+    FusedEstimate_t GetEstimate() const;
+
+    // 0 (dead) to 1 (flawless); negative for unregistered sensors.
+    float GetSensorHealth(const PinName & theSensorPin) const;
+
+    // Invoked, outside of any lock, every time a reading changes the estimate.
+    void SetEstimateCallback(Callback<void(const FusedEstimate_t &)> theCallback);
+
+protected:
+
+private:
+    struct Channel_t
+    {
+        float Estimate;
+        float Variance;
+    };
+
+    struct SensorState_t
+    {
+        PinName        SensorPin;
+        SensorModel_t  Model;
+        float          Health;
+        uint32_t       LastSequenceNumber;
+    };
+
+    static void Predict(Channel_t & theChannel, const float & theProcessNoise, const float & theSeconds);
+    static bool IsOutlier(const Channel_t & theChannel, const float & theReading, const float & theNoise);
+    static void Correct(Channel_t & theChannel, const float & theReading, const float & theNoise);
+
+    void RecordOutcome(SensorState_t & theSensor, const bool & isGood);
+    FusedEstimate_t MakeEstimate() const;
+
+    mutable Mutex                                     m_TheFusionMutex;
+    std::array<SensorState_t, MAXIMUM_SENSORS>        m_TheSensors;
+    std::size_t                                       m_TheSensorCount;
+    Channel_t                                         m_TheTemperature;
+    Channel_t                                         m_TheHumidity;
+    uint64_t                                          m_TheTimeUs;
+    bool                                              m_IsInitialized;
+    uint8_t                                           m_TheConsecutiveOutliers;
+    Callback<void(const FusedEstimate_t &)>           m_TheEstimateCallback;
+};
+
+template <std::size_t MAXIMUM_SENSORS>
+NuerteySensorFusion<MAXIMUM_SENSORS>::NuerteySensorFusion()
+    : m_TheSensors{}
+    , m_TheSensorCount(0)
+    , m_TheTemperature{0.0f, 0.0f}
+    , m_TheHumidity{0.0f, 0.0f}
+    , m_TheTimeUs(0)
+    , m_IsInitialized(false)
+    , m_TheConsecutiveOutliers(0)
+{
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+NuerteySensorFusion<MAXIMUM_SENSORS>::~NuerteySensorFusion()
+{
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+bool NuerteySensorFusion<MAXIMUM_SENSORS>::RegisterSensor(const PinName & theSensorPin,
+                                                          const SensorModel_t & theModel)
+{
+    m_TheFusionMutex.lock();
+
+    auto registered = false;
+    if (m_TheSensorCount < MAXIMUM_SENSORS)
+    {
+        // Presume a new sensor healthy until it proves otherwise.
+        m_TheSensors[m_TheSensorCount] = SensorState_t{theSensorPin, theModel, 1.0f, 0};
+        ++m_TheSensorCount;
+        registered = true;
+    }
+
+    m_TheFusionMutex.unlock();
+
+    return registered;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteySensorFusion<MAXIMUM_SENSORS>::Update(const Measurement_t & theMeasurement)
+{
+    auto isChanged = false;
+    FusedEstimate_t theEstimate;
+    Callback<void(const FusedEstimate_t &)> theCallback;
+
+    m_TheFusionMutex.lock();
+
+    for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+    {
+        auto & theSensor = m_TheSensors[i];
+        if ((theSensor.SensorPin != theMeasurement.SensorPin)
+         || (theSensor.LastSequenceNumber == theMeasurement.SequenceNumber))
+        {
+            continue;
+        }
+        theSensor.LastSequenceNumber = theMeasurement.SequenceNumber;
+
+        if (theMeasurement.Status != SensorStatus_t::SUCCESS)
+        {
+            RecordOutcome(theSensor, false);
+            break;
+        }
+
+        const auto isDHT22 = (theSensor.Model == SensorModel_t::DHT22);
+        const auto theHealth = std::max(theSensor.Health, MINIMUM_HEALTH);
+        const auto theDerating = 1.0f / (theHealth * theHealth);
+        const auto theTemperatureNoise = (isDHT22 ? DHT22_TEMPERATURE_VARIANCE : DHT11_TEMPERATURE_VARIANCE) * theDerating;
+        const auto theHumidityNoise = (isDHT22 ? DHT22_HUMIDITY_VARIANCE : DHT11_HUMIDITY_VARIANCE) * theDerating;
+        const auto theTemperature = static_cast<float>(theMeasurement.TemperatureTenths) / 10.0f;
+        const auto theHumidity = static_cast<float>(theMeasurement.HumidityTenths) / 10.0f;
+
+        if (m_IsInitialized)
+        {
+            // Readings from staggered sensors may arrive slightly out of
+            // order; never predict backwards.
+            if (theMeasurement.SampleTimeUs > m_TheTimeUs)
+            {
+                const auto theSeconds = static_cast<float>(theMeasurement.SampleTimeUs - m_TheTimeUs) / 1000000.0f;
+                Predict(m_TheTemperature, TEMPERATURE_PROCESS_NOISE, theSeconds);
+                Predict(m_TheHumidity, HUMIDITY_PROCESS_NOISE, theSeconds);
+                m_TheTimeUs = theMeasurement.SampleTimeUs;
+            }
+
+            if (IsOutlier(m_TheTemperature, theTemperature, theTemperatureNoise)
+             || IsOutlier(m_TheHumidity, theHumidity, theHumidityNoise))
+            {
+                if (++m_TheConsecutiveOutliers < OUTLIER_RESET_COUNT)
+                {
+                    RecordOutcome(theSensor, false);
+                    break;
+                }
+                // Every sensor disagrees with us; it is the estimate that is stale.
+                m_IsInitialized = false;
+            }
+        }
+
+        if (!m_IsInitialized)
+        {
+            m_TheTemperature = Channel_t{theTemperature, theTemperatureNoise};
+            m_TheHumidity    = Channel_t{theHumidity, theHumidityNoise};
+            m_TheTimeUs      = theMeasurement.SampleTimeUs;
+            m_IsInitialized  = true;
+        }
+        else
+        {
+            Correct(m_TheTemperature, theTemperature, theTemperatureNoise);
+            Correct(m_TheHumidity, theHumidity, theHumidityNoise);
+        }
+
+        m_TheConsecutiveOutliers = 0;
+        RecordOutcome(theSensor, true);
+
+        isChanged   = true;
+        theEstimate = MakeEstimate();
+        theCallback = m_TheEstimateCallback;
+        break;
+    }
+
+    m_TheFusionMutex.unlock();
+
+    if (isChanged && theCallback)
+    {
+        theCallback(theEstimate);
+    }
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+FusedEstimate_t NuerteySensorFusion<MAXIMUM_SENSORS>::GetEstimate() const
+{
+    m_TheFusionMutex.lock();
+    const auto theEstimate = MakeEstimate();
+    m_TheFusionMutex.unlock();
+
+    return theEstimate;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+float NuerteySensorFusion<MAXIMUM_SENSORS>::GetSensorHealth(const PinName & theSensorPin) const
+{
+    auto theHealth = -1.0f;
+
+    m_TheFusionMutex.lock();
+    for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+    {
+        if (m_TheSensors[i].SensorPin == theSensorPin)
+        {
+            theHealth = m_TheSensors[i].Health;
+            break;
+        }
+    }
+    m_TheFusionMutex.unlock();
+
+    return theHealth;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteySensorFusion<MAXIMUM_SENSORS>::SetEstimateCallback(Callback<void(const FusedEstimate_t &)> theCallback)
+{
+    m_TheFusionMutex.lock();
+    m_TheEstimateCallback = theCallback;
+    m_TheFusionMutex.unlock();
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteySensorFusion<MAXIMUM_SENSORS>::Predict(Channel_t & theChannel, const float & theProcessNoise,
+                                                   const float & theSeconds)
+{
+    theChannel.Variance += theProcessNoise * theSeconds;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+bool NuerteySensorFusion<MAXIMUM_SENSORS>::IsOutlier(const Channel_t & theChannel, const float & theReading,
+                                                     const float & theNoise)
+{
+    const auto theInnovation = theReading - theChannel.Estimate;
+    const auto theInnovationVariance = theChannel.Variance + theNoise;
+
+    return ((theInnovation * theInnovation) > (OUTLIER_GATE_SIGMAS * OUTLIER_GATE_SIGMAS * theInnovationVariance));
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteySensorFusion<MAXIMUM_SENSORS>::Correct(Channel_t & theChannel, const float & theReading,
+                                                   const float & theNoise)
+{
+    const auto theGain = theChannel.Variance / (theChannel.Variance + theNoise);
+
+    theChannel.Estimate += theGain * (theReading - theChannel.Estimate);
+    theChannel.Variance *= (1.0f - theGain);
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+void NuerteySensorFusion<MAXIMUM_SENSORS>::RecordOutcome(SensorState_t & theSensor, const bool & isGood)
+{
+    theSensor.Health += ((isGood ? 1.0f : 0.0f) - theSensor.Health) / HEALTH_AVERAGING_READS;
+}
+
+template <std::size_t MAXIMUM_SENSORS>
+FusedEstimate_t NuerteySensorFusion<MAXIMUM_SENSORS>::MakeEstimate() const
+{
+    FusedEstimate_t theEstimate;
+
+    theEstimate.TemperatureTenths   = static_cast<int16_t>(std::lround(m_TheTemperature.Estimate * 10.0f));
+    theEstimate.HumidityTenths      = static_cast<uint16_t>(std::lround(std::max(m_TheHumidity.Estimate, 0.0f) * 10.0f));
+    theEstimate.TemperatureSigma    = std::sqrt(m_TheTemperature.Variance);
+    theEstimate.HumiditySigma       = std::sqrt(m_TheHumidity.Variance);
+    theEstimate.TimeUs              = m_TheTimeUs;
+    theEstimate.ContributingSensors = 0;
+    theEstimate.IsValid             = m_IsInitialized;
+
+    for (std::size_t i = 0; i < m_TheSensorCount; ++i)
+    {
+        if (m_TheSensors[i].Health >= HEALTHY_THRESHOLD)
+        {
+            ++theEstimate.ContributingSensors;
+        }
+    }
+
+    return theEstimate;
+}
@@ -0,0 +1,310 @@
+/***********************************************************************
+* @file      NuerteyTelemetryPublisher.h
+*
+*    Batched telemetry uplink for DHT11/DHT22 sensor readings targetted
+*    for ARM Mbed platform.
+*
+* @brief   Collect Measurement_t snapshots from any number of
+*          NuerteyDHT11Device instances into a bounded queue and ship
+*          them, many readings to a datagram, on a configurable cadence.
+*
+* @note    Each reading costs 20 bytes on the wire. Sending one UDP
+*          datagram per reading would instead pay the ~46 bytes of
+*          Ethernet/IP/UDP overhead, and the header, every time. Batching
+*          therefore cuts the per-reading packet overhead by more than an
+*          order of magnitude once a handful of sensors share a node.
+*
+*          The payload is a compact little-endian binary layout:
+*
+*          Header (12 bytes):
+*            [0..1]  magic 'D' 'H'
+*            [2]     format version
+*            [3]     number of records that follow
+*            [4..7]  batch sequence number
+*            [8..11] readings dropped so far due to back-pressure
+*
+*          Record (20 bytes each):
+*            [0..1]   sensor pin
+*            [2..3]   temperature, signed, tenths of °C
+*            [4..5]   humidity, unsigned, tenths of %RH
+*            [6]      SensorStatus_t of the read
+*            [7]      reserved
+*            [8..11]  the device's sequence number of the read
+*            [12..19] sample time of the readings, us since boot
+*
+*          The sequence number and sample time let a collector order
+*          readings and discard duplicates (a cached Measurement_t
+*          enqueued twice) across batches and retries; batch
+*          order alone cannot. Version 1 records were 8 bytes, without
+*          them.
+*
+* @warning The queue is bounded. When producers outpace the uplink,
+*          Enqueue() refuses further readings (back-pressure) rather
+*          than growing without bound or silently overwriting queued
+*          data; refused readings are accounted for in the header.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include "mbed.h"
+#include "NuerteyDHT11Device.h"
+
+template <std::size_t QUEUE_CAPACITY = 64, std::size_t MAXIMUM_BATCH_SIZE = 32>
+class NuerteyTelemetryPublisher
+{
+    static_assert(QUEUE_CAPACITY > 0, "Hey! The telemetry queue must hold at least one reading!!");
+    static_assert((MAXIMUM_BATCH_SIZE > 0) && (MAXIMUM_BATCH_SIZE <= UINT8_MAX),
+    "Hey! The record count of a batch must fit in its single byte header field!!");
+
+public:
+    static constexpr uint8_t     TELEMETRY_MAGIC_0           = 'D';
+    static constexpr uint8_t     TELEMETRY_MAGIC_1           = 'H';
+    static constexpr uint8_t     TELEMETRY_FORMAT_VERSION    =  2;
+    static constexpr std::size_t TELEMETRY_HEADER_SIZE_BYTES = 12;
+    static constexpr std::size_t TELEMETRY_RECORD_SIZE_BYTES = 20;
+    static constexpr std::size_t MAXIMUM_PAYLOAD_SIZE_BYTES  = TELEMETRY_HEADER_SIZE_BYTES
+                                        + (MAXIMUM_BATCH_SIZE * TELEMETRY_RECORD_SIZE_BYTES);
+
+    using Payload_t = std::array<uint8_t, MAXIMUM_PAYLOAD_SIZE_BYTES>;
+
+    NuerteyTelemetryPublisher(NetworkInterface * theNetworkInterface,
+                              const SocketAddress & theCollectorAddress);
+
+    NuerteyTelemetryPublisher(const NuerteyTelemetryPublisher&) = delete;
+    NuerteyTelemetryPublisher& operator=(const NuerteyTelemetryPublisher&) = delete;
+
+    virtual ~NuerteyTelemetryPublisher();
+
+    [[nodiscard]] nsapi_error_t Open();
+
+    // Safe to call from any thread. Returns false, and counts the
+    // reading as dropped, when the queue is full.
+    bool Enqueue(const Measurement_t & theMeasurement);
+
+    // Publish() periodically from the given queue's dispatch thread.
+    int Start(EventQueue & theEventQueue, const uint32_t & thePeriodMilliseconds);
+    void Stop();
+
+    // Drain up to MAXIMUM_BATCH_SIZE queued readings into one datagram.
+    // Returns the number of bytes sent, 0 if there was nothing to send,
+    // or a negative nsapi error.
+    nsapi_size_or_error_t Publish();
+
+    std::size_t GetQueuedCount() const;
+    uint32_t    GetDroppedCount() const { return m_TheDroppedCount; }
+    uint32_t    GetPublishedBatchCount() const { return m_TheBatchSequence; }
+    uint32_t    GetFailedBatchCount() const { return m_TheFailedBatchCount; }
+
+    // Exposed so that collectors, and host-side tooling, can share the
+    // exact same encoding.
+    static std::size_t EncodeRecord(uint8_t * theBuffer, const Measurement_t & theMeasurement);
+
+protected:
+
+private:
+    std::size_t EncodeBatch();
+
+    static void PutLittleEndian16(uint8_t * theBuffer, const uint16_t & value);
+    static void PutLittleEndian32(uint8_t * theBuffer, const uint32_t & value);
+
+    NetworkInterface *                               m_pTheNetworkInterface;
+    SocketAddress                                    m_TheCollectorAddress;
+    UDPSocket                                        m_TheSocket;
+    CircularBuffer<Measurement_t, QUEUE_CAPACITY>    m_TheQueue;
+    Payload_t                                        m_ThePayload;
+    EventQueue *                                     m_pTheEventQueue;
+    int                                              m_TheEventId;
+    uint32_t                                         m_TheBatchSequence;
+    uint32_t                                         m_TheDroppedCount;
+    uint32_t                                         m_TheFailedBatchCount;
+};
+
+template <std::size_t QUEUE_CAPACITY, std::size_t MAXIMUM_BATCH_SIZE>
+NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::NuerteyTelemetryPublisher(
+                                        NetworkInterface * theNetworkInterface,
+                                        const SocketAddress & theCollectorAddress)
+    : m_pTheNetworkInterface(theNetworkInterface)
+    , m_TheCollectorAddress(theCollectorAddress)
+    , m_ThePayload{}
+    , m_pTheEventQueue(nullptr)
+    , m_TheEventId(0)
+    , m_TheBatchSequence(0)
+    , m_TheDroppedCount(0)
+    , m_TheFailedBatchCount(0)
+{
+}
+
+template <std::size_t QUEUE_CAPACITY, std::size_t MAXIMUM_BATCH_SIZE>
+NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::~NuerteyTelemetryPublisher()
+{
+    Stop();
+    m_TheSocket.close();
+}
+
+template <std::size_t QUEUE_CAPACITY, std::size_t MAXIMUM_BATCH_SIZE>
+nsapi_error_t NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::Open()
+{
+    if (m_pTheNetworkInterface == nullptr)
+    {
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    auto result = m_TheSocket.open(m_pTheNetworkInterface);
+    if (result == NSAPI_ERROR_OK)
+    {
+        // Never let a congested uplink stall the event queue that also
+        // services the sensors.
+        m_TheSocket.set_blocking(false);
+    }
+
+    return result;
+}
+
+template <std::size_t QUEUE_CAPACITY, std::size_t MAXIMUM_BATCH_SIZE>
+bool NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::Enqueue(const Measurement_t & theMeasurement)
+{
+    // CircularBuffer::push() silently overwrites the oldest entry when
+    // full. Check and push atomically with respect to other producers so
+    // that we apply back-pressure instead.
+    CriticalSectionLock lock;
+
+    if (m_TheQueue.full())
+    {
+        ++m_TheDroppedCount;
+        return false;
+    }
+
+    m_TheQueue.push(theMeasurement);
+    return true;
+}
+
+template <std::size_t QUEUE_CAPACITY, std::size_t MAXIMUM_BATCH_SIZE>
+int NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::Start(EventQueue & theEventQueue,
+                                                                       const uint32_t & thePeriodMilliseconds)
+{
+    Stop();
+
+    m_pTheEventQueue = &theEventQueue;
+    m_TheEventId = theEventQueue.call_every(thePeriodMilliseconds, this,
+                        &NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::Publish);
+
+    return m_TheEventId;
+}
+
+template <std::size_t QUEUE_CAPACITY, std::size_t MAXIMUM_BATCH_SIZE>
+void NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::Stop()
+{
+    if ((m_pTheEventQueue != nullptr) && (m_TheEventId != 0))
+    {
+        m_pTheEventQueue->cancel(m_TheEventId);
+    }
+
+    m_pTheEventQueue = nullptr;
+    m_TheEventId = 0;
+}
+
+template <std::size_t QUEUE_CAPACITY, std::size_t MAXIMUM_BATCH_SIZE>
+nsapi_size_or_error_t NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::Publish()
+{
+    auto theSize = EncodeBatch();
+
+    if (theSize == TELEMETRY_HEADER_SIZE_BYTES)
+    {
+        return 0; // Nothing queued; do not waste a datagram on it.
+    }
+
+    auto result = m_TheSocket.sendto(m_TheCollectorAddress, m_ThePayload.data(), theSize);
+
+    if (result < 0)
+    {
+        // Telemetry is best-effort; the readings in this batch are gone.
+        // Account for them so that the collector can tell from the next
+        // header's drop counter that it missed something.
+        ++m_TheFailedBatchCount;
+        CriticalSectionLock lock;
+        m_TheDroppedCount += m_ThePayload[3];
+    }
+
+    return result;
+}
+
+template <std::size_t QUEUE_CAPACITY, std::size_t MAXIMUM_BATCH_SIZE>
+std::size_t NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::GetQueuedCount() const
+{
+    return m_TheQueue.size();
+}
+
+template <std::size_t QUEUE_CAPACITY, std::size_t MAXIMUM_BATCH_SIZE>
+std::size_t NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::EncodeBatch()
+{
+    uint8_t count = 0;
+    auto pRecord = m_ThePayload.data() + TELEMETRY_HEADER_SIZE_BYTES;
+    Measurement_t theMeasurement;
+
+    // CircularBuffer::pop() is itself ISR/thread-safe.
+    while ((count < MAXIMUM_BATCH_SIZE) && m_TheQueue.pop(theMeasurement))
+    {
+        pRecord += EncodeRecord(pRecord, theMeasurement);
+        ++count;
+    }
+
+    uint32_t theDroppedCount = 0;
+    {
+        CriticalSectionLock lock;
+        theDroppedCount = m_TheDroppedCount;
+    }
+
+    if (count > 0)
+    {
+        ++m_TheBatchSequence;
+    }
+
+    m_ThePayload[0] = TELEMETRY_MAGIC_0;
+    m_ThePayload[1] = TELEMETRY_MAGIC_1;
+    m_ThePayload[2] = TELEMETRY_FORMAT_VERSION;
+    m_ThePayload[3] = count;
+    PutLittleEndian32(&m_ThePayload[4], m_TheBatchSequence);
+    PutLittleEndian32(&m_ThePayload[8], theDroppedCount);
+
+    return (TELEMETRY_HEADER_SIZE_BYTES + (count * TELEMETRY_RECORD_SIZE_BYTES));
+}
+
+template <std::size_t QUEUE_CAPACITY, std::size_t MAXIMUM_BATCH_SIZE>
+std::size_t NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::EncodeRecord(uint8_t * theBuffer,
+                                                                      const Measurement_t & theMeasurement)
+{
+    PutLittleEndian16(&theBuffer[0], static_cast<uint16_t>(theMeasurement.SensorPin));
+    PutLittleEndian16(&theBuffer[2], static_cast<uint16_t>(theMeasurement.TemperatureTenths));
+    PutLittleEndian16(&theBuffer[4], theMeasurement.HumidityTenths);
+    theBuffer[6] = static_cast<uint8_t>(ToUnderlyingType(theMeasurement.Status));
+    theBuffer[7] = 0;
+    PutLittleEndian32(&theBuffer[8], theMeasurement.SequenceNumber);
+    PutLittleEndian32(&theBuffer[12], static_cast<uint32_t>(theMeasurement.SampleTimeUs & 0xFFFFFFFF));
+    PutLittleEndian32(&theBuffer[16], static_cast<uint32_t>(theMeasurement.SampleTimeUs >> 32));
+
+    return TELEMETRY_RECORD_SIZE_BYTES;
+}
+
+template <std::size_t QUEUE_CAPACITY, std::size_t MAXIMUM_BATCH_SIZE>
+void NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::PutLittleEndian16(uint8_t * theBuffer,
+                                                                                    const uint16_t & value)
+{
+    theBuffer[0] = static_cast<uint8_t>(value & 0xFF);
+    theBuffer[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+}
+
+template <std::size_t QUEUE_CAPACITY, std::size_t MAXIMUM_BATCH_SIZE>
+void NuerteyTelemetryPublisher<QUEUE_CAPACITY, MAXIMUM_BATCH_SIZE>::PutLittleEndian32(uint8_t * theBuffer,
+                                                                                    const uint32_t & value)
+{
+    PutLittleEndian16(&theBuffer[0], static_cast<uint16_t>(value & 0xFFFF));
+    PutLittleEndian16(&theBuffer[2], static_cast<uint16_t>((value >> 16) & 0xFFFF));
+}
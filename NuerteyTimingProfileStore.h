@@ -0,0 +1,576 @@
+/***********************************************************************
+* @file      NuerteyTimingProfileStore.h
+*
+*    Non-volatile persistence of learned per-sensor timing profiles and
+*    reading calibrations for the DHT11/DHT22 sensor driver targetted for
+*    ARM Mbed platform.
+*
+* @brief   Keep a small table of TimingProfile_t and ReadingCalibration_t,
+*          keyed by data pin, in a BlockDevice so that calibrated
+*          thresholds and offset/gain corrections survive reboots (OTA
+*          updates included) and the very first read is already tuned.
+*
+* @note    Any BlockDevice will do: typically a SlicingBlockDevice over a
+*          spare FlashIAPBlockDevice sector on target, or a HeapBlockDevice
+*          when exercising the store without touching flash. The store
+*          occupies the first two erase units of the device it is given:
+*          two slots, A and B, written alternately. Save() erases and
+*          programs only the slot not holding the newest image, so that a
+*          reset or power loss midway leaves the previous image intact;
+*          Load() takes the newest slot whose CRC checks out.
+*
+*          Image layout (little-endian):
+*            [0..3]   magic "DHTP"
+*            [4]      format version
+*            [5]      number of valid entries
+*            [6..7]   generation; incremented (modulo 2^16) by each Save()
+*            [8..]    MAXIMUM_ENTRIES x { pin (4 bytes), profile (4 bytes),
+*                                         calibration (4 x int16) }
+*            [last 4] CRC-32 of all of the above
+*
+*          Version 1 images (profiles only, 8-byte entries) still load,
+*          with identity calibrations, and are rewritten as version 2 on
+*          the next Save(). Images from before the A/B slots, of either
+*          version, load as generation 0 from slot A.
+*
+*          Mbed OS 5.11 predates the KVStore global API, hence the thin
+*          BlockDevice-based format here.
+*
+* @warning Flash endures a limited number of erase cycles. Save() only
+*          touches the device when a profile has changed since the last
+*          save; nonetheless call it sparingly (e.g. every few hours, or
+*          just before an orderly shutdown/OTA), not after every read.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include "mbed.h"
+#include "NuerteyDHT11Protocol.h"
+
+template <std::size_t MAXIMUM_ENTRIES = 16>
+class NuerteyTimingProfileStore
+{
+    static_assert((MAXIMUM_ENTRIES > 0) && (MAXIMUM_ENTRIES <= UINT8_MAX),
+    "Hey! The entry count must fit in its single byte header field!!");
+
+public:
+    static constexpr uint8_t     STORE_FORMAT_VERSION    = 2;
+    static constexpr std::size_t STORE_HEADER_SIZE_BYTES = 8;
+    static constexpr std::size_t STORE_ENTRY_SIZE_BYTES  = 16;
+    static constexpr std::size_t STORE_IMAGE_SIZE_BYTES  = STORE_HEADER_SIZE_BYTES
+                                     + (MAXIMUM_ENTRIES * STORE_ENTRY_SIZE_BYTES) + sizeof(uint32_t);
+    static constexpr uint8_t     LEGACY_FORMAT_VERSION         = 1;
+    static constexpr std::size_t LEGACY_ENTRY_SIZE_BYTES       = 8;
+    static constexpr std::size_t LEGACY_IMAGE_SIZE_BYTES       = STORE_HEADER_SIZE_BYTES
+                                     + (MAXIMUM_ENTRIES * LEGACY_ENTRY_SIZE_BYTES) + sizeof(uint32_t);
+    // Leave room to pad the image up to the device's read/program size,
+    // which is at most 512 bytes for the block devices Mbed OS ships.
+    static constexpr std::size_t STORE_BUFFER_SIZE_BYTES = ((STORE_IMAGE_SIZE_BYTES + 511) / 512) * 512;
+
+    NuerteyTimingProfileStore(BlockDevice & theBlockDevice);
+
+    NuerteyTimingProfileStore(const NuerteyTimingProfileStore&) = delete;
+    NuerteyTimingProfileStore& operator=(const NuerteyTimingProfileStore&) = delete;
+
+    virtual ~NuerteyTimingProfileStore();
+
+    // Reads the table into RAM from the newest valid slot. Blank,
+    // foreign or corrupted slots are not an error; with neither slot
+    // usable the table is merely empty.
+    [[nodiscard]] int Load();
+
+    // Writes the table to the older slot, if and only if anything changed.
+    [[nodiscard]] int Save();
+
+    bool Find(const PinName & theSensorPin, TimingProfile_t & theProfile) const;
+    bool Update(const PinName & theSensorPin, const TimingProfile_t & theProfile);
+    bool Find(const PinName & theSensorPin, ReadingCalibration_t & theCalibration) const;
+    bool Update(const PinName & theSensorPin, const ReadingCalibration_t & theCalibration);
+
+    // Convenience glue for NuerteyDHT11Device<T>.
+    template <typename Device>
+    bool Restore(Device & theDevice) const;
+
+    template <typename Device>
+    bool Capture(const Device & theDevice);
+
+    std::size_t GetEntryCount() const { return m_TheEntryCount; }
+    uint16_t GetGeneration() const { return m_TheGeneration; }
+    bool IsDirty() const { return m_IsDirty; }
+
+protected:
+
+private:
+    struct Entry_t
+    {
+        PinName              SensorPin;
+        TimingProfile_t      Profile;
+        ReadingCalibration_t Calibration;
+    };
+
+    // Calibrations are re-estimated continuously; changes smaller than
+    // these are not worth an erase cycle.
+    static constexpr int16_t CALIBRATION_OFFSET_HYSTERESIS_TENTHS = 1;
+    static constexpr int16_t CALIBRATION_GAIN_HYSTERESIS          = CALIBRATION_UNITY_GAIN / 1000;
+
+    Entry_t * FindEntry(const PinName & theSensorPin);
+    const Entry_t * FindEntry(const PinName & theSensorPin) const;
+    Entry_t * AddEntry(const PinName & theSensorPin);
+
+    bd_addr_t GetSlotAddress(const std::size_t & theSlot) const;
+    int ReadSlot(const std::size_t & theSlot, bool & isValid, uint16_t & theGeneration);
+
+    static uint32_t Crc32(const uint8_t * theData, const std::size_t & theLength);
+
+    BlockDevice &                                   m_TheBlockDevice;
+    std::array<Entry_t, MAXIMUM_ENTRIES>            m_TheEntries;
+    std::size_t                                     m_TheEntryCount;
+    std::size_t                                     m_TheActiveSlot;
+    uint16_t                                        m_TheGeneration;
+    bool                                            m_IsDirty;
+    std::array<uint8_t, STORE_BUFFER_SIZE_BYTES>    m_TheImage;
+};
+
+template <std::size_t MAXIMUM_ENTRIES>
+NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::NuerteyTimingProfileStore(BlockDevice & theBlockDevice)
+    : m_TheBlockDevice(theBlockDevice)
+    , m_TheEntries{}
+    , m_TheEntryCount(0)
+    , m_TheActiveSlot(1)
+    , m_TheGeneration(0)
+    , m_IsDirty(false)
+    , m_TheImage{}
+{
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::~NuerteyTimingProfileStore()
+{
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+int NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::Load()
+{
+    m_TheEntryCount = 0;
+    m_TheActiveSlot = 1;        // As if slot B were newest, so that the
+    m_TheGeneration = 0;        // first Save() to a blank device goes to A.
+    m_IsDirty = false;
+
+    bool isValid[2] = {false, false};
+    uint16_t theGenerations[2] = {0, 0};
+
+    auto result = ReadSlot(0, isValid[0], theGenerations[0]);
+    if (result != BD_ERROR_OK)
+    {
+        return result;
+    }
+
+    // A device too small for slot B can still yield an older image in A.
+    if (GetSlotAddress(1) < m_TheBlockDevice.size())
+    {
+        result = ReadSlot(1, isValid[1], theGenerations[1]);
+        if (result != BD_ERROR_OK)
+        {
+            return result;
+        }
+    }
+
+    if (!isValid[0] && !isValid[1])
+    {
+        return BD_ERROR_OK; // Never written, or unusable; start afresh.
+    }
+
+    // Generations compare as serial numbers, so wrapping is harmless.
+    const auto theNewest = !isValid[0] ? 1
+                         : !isValid[1] ? 0
+                         : (static_cast<int16_t>(theGenerations[1] - theGenerations[0]) > 0) ? 1 : 0;
+
+    if (theNewest == 0)
+    {
+        // m_TheImage holds whichever slot was read last.
+        result = ReadSlot(0, isValid[0], theGenerations[0]);
+        if ((result != BD_ERROR_OK) || !isValid[0])
+        {
+            return (result != BD_ERROR_OK) ? result : BD_ERROR_DEVICE_ERROR;
+        }
+    }
+
+    m_TheActiveSlot = theNewest;
+    m_TheGeneration = theGenerations[theNewest];
+
+    const auto pTheImage = m_TheImage.data();
+    const auto isLegacy = (pTheImage[4] == LEGACY_FORMAT_VERSION);
+    const auto theEntrySize = isLegacy ? LEGACY_ENTRY_SIZE_BYTES : STORE_ENTRY_SIZE_BYTES;
+
+    const auto ReadInt16 = [](const uint8_t * pTheBytes)
+    {
+        return static_cast<int16_t>(static_cast<uint16_t>(pTheBytes[0])
+                                 | (static_cast<uint16_t>(pTheBytes[1]) << 8));
+    };
+
+    for (std::size_t i = 0; i < pTheImage[5]; ++i)
+    {
+        auto pTheEntry = &pTheImage[STORE_HEADER_SIZE_BYTES + (i * theEntrySize)];
+        Entry_t theEntry;
+
+        theEntry.SensorPin = static_cast<PinName>(static_cast<int32_t>(
+                                    static_cast<uint32_t>(pTheEntry[0])
+                                 | (static_cast<uint32_t>(pTheEntry[1]) << 8)
+                                 | (static_cast<uint32_t>(pTheEntry[2]) << 16)
+                                 | (static_cast<uint32_t>(pTheEntry[3]) << 24)));
+        theEntry.Profile.ZeroHighUs   = pTheEntry[4];
+        theEntry.Profile.OneHighUs    = pTheEntry[5];
+        theEntry.Profile.ThresholdUs  = pTheEntry[6];
+        theEntry.Profile.LearnedReads = pTheEntry[7];
+        theEntry.Calibration = IDENTITY_READING_CALIBRATION;
+
+        if (!isLegacy)
+        {
+            theEntry.Calibration.TemperatureOffsetTenths = ReadInt16(&pTheEntry[8]);
+            theEntry.Calibration.TemperatureGain         = ReadInt16(&pTheEntry[10]);
+            theEntry.Calibration.HumidityOffsetTenths    = ReadInt16(&pTheEntry[12]);
+            theEntry.Calibration.HumidityGain            = ReadInt16(&pTheEntry[14]);
+        }
+
+        if (IsTimingProfilePlausible(theEntry.Profile) && IsReadingCalibrationPlausible(theEntry.Calibration))
+        {
+            m_TheEntries[m_TheEntryCount++] = theEntry;
+        }
+    }
+
+    // Upgrade the image on the next Save().
+    m_IsDirty = isLegacy;
+
+    return BD_ERROR_OK;
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+int NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::Save()
+{
+    if (!m_IsDirty)
+    {
+        return BD_ERROR_OK;
+    }
+
+    const auto theSlot = 1 - m_TheActiveSlot;
+    const auto theGeneration = static_cast<uint16_t>(m_TheGeneration + 1);
+    const auto theAddress = GetSlotAddress(theSlot);
+
+    auto theProgramSize = m_TheBlockDevice.get_program_size();
+    auto theLength = ((STORE_IMAGE_SIZE_BYTES + theProgramSize - 1) / theProgramSize) * theProgramSize;
+    if ((theLength > m_TheImage.size()) || (GetSlotAddress(1) + m_TheBlockDevice.get_erase_size(GetSlotAddress(1))
+                                                > m_TheBlockDevice.size()))
+    {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    auto theEraseSize = m_TheBlockDevice.get_erase_size(theAddress);
+    if (theLength > theEraseSize)
+    {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    m_TheImage.fill(0xFF);
+    auto pTheImage = m_TheImage.data();
+
+    memcpy(pTheImage, "DHTP", 4);
+    pTheImage[4] = STORE_FORMAT_VERSION;
+    pTheImage[5] = static_cast<uint8_t>(m_TheEntryCount);
+    pTheImage[6] = static_cast<uint8_t>(theGeneration & 0xFF);
+    pTheImage[7] = static_cast<uint8_t>((theGeneration >> 8) & 0xFF);
+
+    const auto WriteInt16 = [](uint8_t * pTheBytes, const int16_t & theValue)
+    {
+        pTheBytes[0] = static_cast<uint8_t>(static_cast<uint16_t>(theValue) & 0xFF);
+        pTheBytes[1] = static_cast<uint8_t>((static_cast<uint16_t>(theValue) >> 8) & 0xFF);
+    };
+
+    for (std::size_t i = 0; i < MAXIMUM_ENTRIES; ++i)
+    {
+        auto pTheEntry = &pTheImage[STORE_HEADER_SIZE_BYTES + (i * STORE_ENTRY_SIZE_BYTES)];
+        auto theEntry = (i < m_TheEntryCount) ? m_TheEntries[i] : Entry_t{};
+        auto thePin = static_cast<uint32_t>(static_cast<int32_t>(theEntry.SensorPin));
+
+        pTheEntry[0] = static_cast<uint8_t>(thePin & 0xFF);
+        pTheEntry[1] = static_cast<uint8_t>((thePin >> 8) & 0xFF);
+        pTheEntry[2] = static_cast<uint8_t>((thePin >> 16) & 0xFF);
+        pTheEntry[3] = static_cast<uint8_t>((thePin >> 24) & 0xFF);
+        pTheEntry[4] = theEntry.Profile.ZeroHighUs;
+        pTheEntry[5] = theEntry.Profile.OneHighUs;
+        pTheEntry[6] = theEntry.Profile.ThresholdUs;
+        pTheEntry[7] = theEntry.Profile.LearnedReads;
+        WriteInt16(&pTheEntry[8], theEntry.Calibration.TemperatureOffsetTenths);
+        WriteInt16(&pTheEntry[10], theEntry.Calibration.TemperatureGain);
+        WriteInt16(&pTheEntry[12], theEntry.Calibration.HumidityOffsetTenths);
+        WriteInt16(&pTheEntry[14], theEntry.Calibration.HumidityGain);
+    }
+
+    auto theCrc = Crc32(pTheImage, STORE_IMAGE_SIZE_BYTES - 4);
+    pTheImage[STORE_IMAGE_SIZE_BYTES - 4] = static_cast<uint8_t>(theCrc & 0xFF);
+    pTheImage[STORE_IMAGE_SIZE_BYTES - 3] = static_cast<uint8_t>((theCrc >> 8) & 0xFF);
+    pTheImage[STORE_IMAGE_SIZE_BYTES - 2] = static_cast<uint8_t>((theCrc >> 16) & 0xFF);
+    pTheImage[STORE_IMAGE_SIZE_BYTES - 1] = static_cast<uint8_t>((theCrc >> 24) & 0xFF);
+
+    // The newest image stays untouched in the other slot throughout.
+    auto result = m_TheBlockDevice.erase(theAddress, theEraseSize);
+    if (result == BD_ERROR_OK)
+    {
+        result = m_TheBlockDevice.program(pTheImage, theAddress, theLength);
+    }
+
+    if (result == BD_ERROR_OK)
+    {
+        m_TheActiveSlot = theSlot;
+        m_TheGeneration = theGeneration;
+        m_IsDirty = false;
+    }
+
+    return result;
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+bool NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::Find(const PinName & theSensorPin, TimingProfile_t & theProfile) const
+{
+    const auto pTheEntry = FindEntry(theSensorPin);
+
+    if (pTheEntry == nullptr)
+    {
+        return false;
+    }
+
+    theProfile = pTheEntry->Profile;
+    return true;
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+bool NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::Update(const PinName & theSensorPin, const TimingProfile_t & theProfile)
+{
+    if (!IsTimingProfilePlausible(theProfile))
+    {
+        return false;
+    }
+
+    auto pTheEntry = FindEntry(theSensorPin);
+
+    if (pTheEntry != nullptr)
+    {
+        // Ignore churn of the learned-reads counter alone; it is not
+        // worth an erase cycle.
+        if ((pTheEntry->Profile.ZeroHighUs != theProfile.ZeroHighUs)
+         || (pTheEntry->Profile.OneHighUs != theProfile.OneHighUs)
+         || (pTheEntry->Profile.ThresholdUs != theProfile.ThresholdUs))
+        {
+            m_IsDirty = true;
+        }
+        pTheEntry->Profile = theProfile;
+        return true;
+    }
+
+    pTheEntry = AddEntry(theSensorPin);
+    if (pTheEntry == nullptr)
+    {
+        return false;
+    }
+
+    pTheEntry->Profile = theProfile;
+    return true;
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+bool NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::Find(const PinName & theSensorPin, ReadingCalibration_t & theCalibration) const
+{
+    const auto pTheEntry = FindEntry(theSensorPin);
+
+    if (pTheEntry == nullptr)
+    {
+        return false;
+    }
+
+    theCalibration = pTheEntry->Calibration;
+    return true;
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+bool NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::Update(const PinName & theSensorPin, const ReadingCalibration_t & theCalibration)
+{
+    if (!IsReadingCalibrationPlausible(theCalibration))
+    {
+        return false;
+    }
+
+    auto pTheEntry = FindEntry(theSensorPin);
+
+    if (pTheEntry != nullptr)
+    {
+        const auto & theStored = pTheEntry->Calibration;
+        if ((std::abs(theStored.TemperatureOffsetTenths - theCalibration.TemperatureOffsetTenths) >= CALIBRATION_OFFSET_HYSTERESIS_TENTHS)
+         || (std::abs(theStored.HumidityOffsetTenths - theCalibration.HumidityOffsetTenths) >= CALIBRATION_OFFSET_HYSTERESIS_TENTHS)
+         || (std::abs(theStored.TemperatureGain - theCalibration.TemperatureGain) >= CALIBRATION_GAIN_HYSTERESIS)
+         || (std::abs(theStored.HumidityGain - theCalibration.HumidityGain) >= CALIBRATION_GAIN_HYSTERESIS))
+        {
+            pTheEntry->Calibration = theCalibration;
+            m_IsDirty = true;
+        }
+        return true;
+    }
+
+    pTheEntry = AddEntry(theSensorPin);
+    if (pTheEntry == nullptr)
+    {
+        return false;
+    }
+
+    pTheEntry->Calibration = theCalibration;
+    return true;
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+template <typename Device>
+bool NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::Restore(Device & theDevice) const
+{
+    const auto pTheEntry = FindEntry(theDevice.GetPinName());
+
+    if (pTheEntry == nullptr)
+    {
+        return false;
+    }
+
+    theDevice.SetTimingProfile(pTheEntry->Profile);
+    theDevice.SetReadingCalibration(pTheEntry->Calibration);
+    return true;
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+template <typename Device>
+bool NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::Capture(const Device & theDevice)
+{
+    const auto & theProfile = theDevice.GetTimingProfile();
+    const auto & theCalibration = theDevice.GetReadingCalibration();
+    auto isCaptured = false;
+
+    // Nothing learned yet; do not overwrite a good stored profile, nor
+    // calibration, with the defaults.
+    if (theProfile.LearnedReads != 0)
+    {
+        isCaptured = Update(theDevice.GetPinName(), theProfile);
+    }
+
+    if (!IsIdentityReadingCalibration(theCalibration))
+    {
+        isCaptured = Update(theDevice.GetPinName(), theCalibration) || isCaptured;
+    }
+
+    return isCaptured;
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+typename NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::Entry_t *
+NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::FindEntry(const PinName & theSensorPin)
+{
+    for (std::size_t i = 0; i < m_TheEntryCount; ++i)
+    {
+        if (m_TheEntries[i].SensorPin == theSensorPin)
+        {
+            return &m_TheEntries[i];
+        }
+    }
+
+    return nullptr;
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+const typename NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::Entry_t *
+NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::FindEntry(const PinName & theSensorPin) const
+{
+    return const_cast<NuerteyTimingProfileStore *>(this)->FindEntry(theSensorPin);
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+typename NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::Entry_t *
+NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::AddEntry(const PinName & theSensorPin)
+{
+    if (m_TheEntryCount >= MAXIMUM_ENTRIES)
+    {
+        return nullptr;
+    }
+
+    // Whichever half is not being updated starts out at its default.
+    m_TheEntries[m_TheEntryCount] = Entry_t{theSensorPin, DEFAULT_TIMING_PROFILE, IDENTITY_READING_CALIBRATION};
+    m_IsDirty = true;
+
+    return &m_TheEntries[m_TheEntryCount++];
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+bd_addr_t NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::GetSlotAddress(const std::size_t & theSlot) const
+{
+    // Slot A is the first erase unit, slot B the one after it.
+    return (theSlot == 0) ? 0 : m_TheBlockDevice.get_erase_size(0);
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+int NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::ReadSlot(const std::size_t & theSlot, bool & isValid,
+                                                         uint16_t & theGeneration)
+{
+    isValid = false;
+    theGeneration = 0;
+
+    // Large enough for either format version; the legacy image is smaller.
+    const auto theAddress = GetSlotAddress(theSlot);
+    auto theReadSize = m_TheBlockDevice.get_read_size();
+    auto theLength = ((STORE_IMAGE_SIZE_BYTES + theReadSize - 1) / theReadSize) * theReadSize;
+    if ((theLength > m_TheImage.size()) || ((theAddress + theLength) > m_TheBlockDevice.size()))
+    {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    auto result = m_TheBlockDevice.read(m_TheImage.data(), theAddress, theLength);
+    if (result != BD_ERROR_OK)
+    {
+        return result;
+    }
+
+    const auto pTheImage = m_TheImage.data();
+    const auto isLegacy = (pTheImage[4] == LEGACY_FORMAT_VERSION);
+    const auto theImageSize = isLegacy ? LEGACY_IMAGE_SIZE_BYTES : STORE_IMAGE_SIZE_BYTES;
+    const auto theStoredCrc = static_cast<uint32_t>(pTheImage[theImageSize - 4])
+                            | (static_cast<uint32_t>(pTheImage[theImageSize - 3]) << 8)
+                            | (static_cast<uint32_t>(pTheImage[theImageSize - 2]) << 16)
+                            | (static_cast<uint32_t>(pTheImage[theImageSize - 1]) << 24);
+
+    isValid = (memcmp(pTheImage, "DHTP", 4) == 0)
+           && ((pTheImage[4] == STORE_FORMAT_VERSION) || isLegacy)
+           && (pTheImage[5] <= MAXIMUM_ENTRIES)
+           && (Crc32(pTheImage, theImageSize - 4) == theStoredCrc);
+    theGeneration = static_cast<uint16_t>(pTheImage[6] | (pTheImage[7] << 8));
+
+    return BD_ERROR_OK;
+}
+
+template <std::size_t MAXIMUM_ENTRIES>
+uint32_t NuerteyTimingProfileStore<MAXIMUM_ENTRIES>::Crc32(const uint8_t * theData, const std::size_t & theLength)
+{
+    // Bitwise CRC-32 (IEEE 802.3); the image is far too small, and saved
+    // far too rarely, to warrant a lookup table.
+    uint32_t theCrc = 0xFFFFFFFF;
+
+    for (std::size_t i = 0; i < theLength; ++i)
+    {
+        theCrc ^= theData[i];
+        for (auto k = 0; k < 8; ++k)
+        {
+            theCrc = (theCrc >> 1) ^ (0xEDB88320 & (0U - (theCrc & 1U)));
+        }
+    }
+
+    return ~theCrc;
+}
@@ -1,4 +1,5 @@
 #include "NuerteyDHT11Device.h"
+#include "NuerteyDHT11Logger.h"
 
 static constexpr uint32_t DHT11_DEVICE_STABLE_STATUS_DELAY(1000); // 1 second.
 static constexpr uint32_t DHT11_DEVICE_SAMPLING_PERIOD(3000);     // 3 seconds.
@@ -19,6 +20,10 @@ static constexpr uint32_t DHT11_DEVICE_SAMPLING_PERIOD(3000);     // 3 seconds.
 // Signal   : TIMER_A_PWM3
 NuerteyDHT11Device<DHT11_t> g_DHT11(PE_13);
 
+// Formatting and console I/O at 9600 baud are deferred to the logger's
+// low-priority thread so that they never hold up the sampling loop.
+NuerteyDHT11Logger<> g_Logger;
+
 int main()
 {
     printf("\r\n\r\nDHT11-Mbed-Driver Application - Beginning... \r\n\r\n");
@@ -30,34 +35,17 @@ int main()
     // status phase."
     ThisThread::sleep_for(DHT11_DEVICE_STABLE_STATUS_DELAY);
 
+    // In trace mode only the raw data frames are logged; decode them 
+    // on the host with tools/DHT11TraceDecoder.
+    g_Logger.SetTraceMode(MBED_CONF_APP_TRACE_MODE);
+    g_Logger.Start();
+
     while (1)
     {
-        auto result = g_DHT11.ReadData();
-        if (!result)
-        {
-            // TBD: Nuertey Odzeyem; what does this do? Will message() crash?
-            // Should the enum and message have a SUCCESS case?
-            // Just for learning experience; eventually get rid of it.
-            printf("\n[debug success result] %s :-> \"%s\" -> [%d]\n", 
-               result.category().name(), result.message().c_str(), result.value());
-               
-            auto h = 0.0f, c = 0.0f, f = 0.0f, k = 0.0f, dp = 0.0f, dpf = 0.0f;
-
-            c   = g_DHT11.GetTemperature(TemperatureScale_t::CELCIUS);
-            f   = g_DHT11.GetTemperature(TemperatureScale_t::FARENHEIT);
-            k   = g_DHT11.GetTemperature(TemperatureScale_t::KELVIN);
-            h   = g_DHT11.GetHumidity();
-            dp  = g_DHT11.CalculateDewPoint(c, h);
-            dpf = g_DHT11.CalculateDewPointFast(c, h);
-
-            printf("\nTemperature in Kelvin: %4.2fK, Celcius: %4.2f°C, Farenheit %4.2f°F\n", k, c, f);
-            printf("Humidity is %4.2f, Dewpoint: %4.2f, Dewpoint fast: %4.2f\n", h, dp, dpf);
-        }
-        else
-        {
-            printf("Error! g_DHT11.ReadData() returned: [%d] -> %s\n", 
-                  result.value(), result.message().c_str());
-        }
+        // Successes are logged as measurements, failures as (rate-limited)
+        // errors. Either way, this merely enqueues a small record.
+        (void)g_DHT11.ReadData();
+        (void)g_Logger.LogRead(g_DHT11);
 
         // Per datasheet/device specifications:
         //
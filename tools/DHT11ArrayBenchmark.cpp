@@ -0,0 +1,345 @@
+/***********************************************************************
+* @file      DHT11ArrayBenchmark.cpp
+*
+*    Host-side benchmark of how a node's sweep over an array of DHT11 or
+*    DHT22 sensors scales with the number of sensors attached.
+*
+* @brief   Sweep 1, 4, 16, 64 and 256 simulated sensors (DHT11Simulator.h)
+*          through three acquisition strategies and report, per sweep, the
+*          wall-clock latency, the time the MCU spends busy-polling and the
+*          error rate:
+*
+*            sequential-model
+*                          - The sequence of NuerteyDHT11Device::ReadData()
+*                            on each sensor in turn: start signal, then
+*                            capture. A model of it, not ReadData() itself.
+*            pipelined     - All start signals asserted at once, so every
+*                            sensor but the first has long served its
+*                            start time when its turn to be captured comes.
+*            port-parallel - Up to 16 sensors on one GPIO port started and
+*                            released together, one sampling loop recording
+*                            the edges of all of them for DecodeEdgeTimestamps().
+*
+*          Captures run the driver's own CaptureBitWidths() against the
+*          simulated waveform. Everything else is modelled: start signals
+*          take their nominal durations, as if ThisThread::sleep_for() and
+*          wait_us() were exact, and the device's own bookkeeping is not
+*          run. The output says as much. Sleeps count toward latency but
+*          not toward busy time, since the RTOS gets the CPU back for them.
+*
+* @note    Build and run on the host, e.g.:
+*
+*            g++ -std=c++20 -O2 -I.. DHT11ArrayBenchmark.cpp -o DHT11ArrayBenchmark
+*            ./DHT11ArrayBenchmark --format json --sweeps 10 > scaling.json
+*
+*          --pin-read-cost-us and --clock-read-cost-us model other MCUs,
+*          e.g. --clock-read-cost-us 0.03 the DWT cycle counter clock.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <random>
+#include "DHT11Simulator.h"
+
+namespace
+{
+    // Start signal, in microseconds, as issued by NuerteyDHT11Device::ReadFromBus().
+    constexpr double STABILIZE_US  = 1000.0;  // ThisThread::sleep_for(1)
+    constexpr double START_HIGH_US =   30.0;  // wait_us(30), busy.
+
+    constexpr std::size_t SENSOR_COUNTS[] = { 1, 4, 16, 64, 256 };
+
+    constexpr const char * MODEL_NOTE = "start signals are modelled at their nominal durations; "
+                                        "only the captures run the driver's code";
+
+    template <typename T>
+    constexpr double StartLowUs()
+    {
+        return std::is_same<T, DHT11_t>::value ? 20000.0 : 2000.0;
+    }
+
+    // Longest the MCU may hold the line low before the sensor stops
+    // treating it as a start signal. The DHT11 datasheet sets no upper
+    // bound; the DHT22 (AM2302) one caps it at 20ms.
+    template <typename T>
+    constexpr double MaximumStartLowUs()
+    {
+        return std::is_same<T, DHT11_t>::value ? 1.0e12 : 20000.0;
+    }
+
+    struct Result_t
+    {
+        const char * Model;
+        const char * Mode;
+        std::size_t  Sensors;
+        std::size_t  Sweeps;
+        double       LatencyUs;       // Summed over all sweeps.
+        double       BusyUs;          // Summed over all sweeps.
+        std::size_t  Reads;
+        std::size_t  Errors;
+    };
+
+    struct Options_t
+    {
+        std::size_t    Sweeps = 5;
+        unsigned       Seed   = 2021;
+        bool           Json   = false;
+        SimulatedCpu_t Cpu;
+    };
+
+    // Judge a capture the way the application would: a read is good only
+    // if it completed, passed its checksum and reports what was sent.
+    bool IsReadGood(const SensorStatus_t & theStatus, const BitWidths_t & theHighWidthsUs,
+                    const DataFrame_t & theSentFrame)
+    {
+        if (theStatus != SensorStatus_t::SUCCESS)
+        {
+            return false;
+        }
+
+        DataFrame_t theDataFrame = {};
+        AssembleDataFrame(theHighWidthsUs, DEFAULT_TIMING_PROFILE.ThresholdUs, theDataFrame);
+
+        return (IsChecksumValid(theDataFrame) && (theDataFrame == theSentFrame));
+    }
+
+    // Release the line, hold it high for wait_us(30) and follow the sensor.
+    // Returns the capture's duration, measured from the release.
+    template <typename T>
+    double CaptureOne(SimulatedSensor<T> & theSensor, std::mt19937 & theGenerator,
+                      const Options_t & theOptions, Result_t & theResult)
+    {
+        const auto theSentFrame = theSensor.Sample(theGenerator);
+        const auto theWaveform  = SimulatedWaveform::FromFrame(theSentFrame, theSensor.GetTiming());
+
+        SimulatedClock theClock(theOptions.Cpu, START_HIGH_US);
+        SimulatedPin   thePin(theWaveform, theClock);
+        BitWidths_t    theHighWidthsUs = {};
+
+        const auto theStatus = CaptureBitWidths(thePin, theClock, theHighWidthsUs);
+
+        ++theResult.Reads;
+        if (!IsReadGood(theStatus, theHighWidthsUs, theSentFrame))
+        {
+            ++theResult.Errors;
+        }
+
+        return theClock.GetNowUs();
+    }
+
+    template <typename T>
+    void SweepSequential(std::vector<SimulatedSensor<T>> & theSensors, std::mt19937 & theGenerator,
+                         const Options_t & theOptions, Result_t & theResult)
+    {
+        for (auto & theSensor : theSensors)
+        {
+            const auto theCaptureUs = CaptureOne(theSensor, theGenerator, theOptions, theResult);
+
+            theResult.LatencyUs += STABILIZE_US + StartLowUs<T>() + theCaptureUs;
+            theResult.BusyUs    += theCaptureUs;
+        }
+    }
+
+    template <typename T>
+    void SweepPipelined(std::vector<SimulatedSensor<T>> & theSensors, std::mt19937 & theGenerator,
+                        const Options_t & theOptions, Result_t & theResult)
+    {
+        std::size_t i = 0;
+
+        while (i < theSensors.size())
+        {
+            // A wave: assert every remaining start signal at once, sleep
+            // through the start time once, then capture back to back for
+            // as long as the held lines remain valid start signals.
+            theResult.LatencyUs += STABILIZE_US + StartLowUs<T>();
+
+            auto theHeldLowUs = StartLowUs<T>();
+            do
+            {
+                const auto theCaptureUs = CaptureOne(theSensors[i++], theGenerator, theOptions, theResult);
+
+                theResult.LatencyUs += theCaptureUs;
+                theResult.BusyUs    += theCaptureUs;
+                theHeldLowUs        += theCaptureUs;
+            }
+            while ((i < theSensors.size()) && (theHeldLowUs <= MaximumStartLowUs<T>()));
+        }
+    }
+
+    template <typename T>
+    void SweepPortParallel(std::vector<SimulatedSensor<T>> & theSensors, std::mt19937 & theGenerator,
+                           const Options_t & theOptions, Result_t & theResult)
+    {
+        constexpr auto PORT_WIDTH_PINS = SimulatedPort::PORT_WIDTH_PINS;
+
+        for (std::size_t first = 0; first < theSensors.size(); first += PORT_WIDTH_PINS)
+        {
+            const auto theLineCount = std::min(PORT_WIDTH_PINS, theSensors.size() - first);
+
+            std::vector<DataFrame_t>           theSentFrames(theLineCount);
+            std::vector<SimulatedWaveform>     theWaveforms(theLineCount);
+            std::vector<std::vector<uint32_t>> theEdgesUs;
+
+            SimulatedClock theClock(theOptions.Cpu, START_HIGH_US);
+            SimulatedPort  thePort(theClock);
+
+            for (std::size_t line = 0; line < theLineCount; line++)
+            {
+                theSentFrames[line] = theSensors[first + line].Sample(theGenerator);
+                theWaveforms[line]  = SimulatedWaveform::FromFrame(theSentFrames[line], theSensors[first + line].GetTiming());
+                thePort.Attach(theWaveforms[line]);
+            }
+
+            CapturePortEdges(thePort, theClock, theEdgesUs);
+
+            for (std::size_t line = 0; line < theLineCount; line++)
+            {
+                BitWidths_t theHighWidthsUs = {};
+                const auto  theStatus = DecodeEdgeTimestamps(theEdgesUs[line].data(), theEdgesUs[line].size(),
+                                                             theHighWidthsUs);
+                ++theResult.Reads;
+                if (!IsReadGood(theStatus, theHighWidthsUs, theSentFrames[line]))
+                {
+                    ++theResult.Errors;
+                }
+            }
+
+            theResult.LatencyUs += STABILIZE_US + StartLowUs<T>() + theClock.GetNowUs();
+            theResult.BusyUs    += theClock.GetNowUs();
+        }
+    }
+
+    template <typename T>
+    void RunModel(const char * theModel, const Options_t & theOptions, std::vector<Result_t> & theResults)
+    {
+        using Sweep_t = void (*)(std::vector<SimulatedSensor<T>> &, std::mt19937 &, const Options_t &, Result_t &);
+
+        const std::pair<const char *, Sweep_t> theModes[] =
+        {
+            { "sequential-model", &SweepSequential<T>   },
+            { "pipelined",        &SweepPipelined<T>    },
+            { "port-parallel",    &SweepPortParallel<T> }
+        };
+
+        for (const auto & theSensorCount : SENSOR_COUNTS)
+        {
+            for (const auto & [theMode, theSweep] : theModes)
+            {
+                // Same units and readings for every mode, for a fair comparison.
+                std::mt19937 theGenerator(theOptions.Seed + theSensorCount);
+                std::vector<SimulatedSensor<T>> theSensors;
+                theSensors.reserve(theSensorCount);
+                for (std::size_t i = 0; i < theSensorCount; i++)
+                {
+                    theSensors.emplace_back(theGenerator);
+                }
+
+                Result_t theResult = { theModel, theMode, theSensorCount, theOptions.Sweeps, 0.0, 0.0, 0, 0 };
+                for (std::size_t sweep = 0; sweep < theOptions.Sweeps; sweep++)
+                {
+                    theSweep(theSensors, theGenerator, theOptions, theResult);
+                }
+                theResults.push_back(theResult);
+            }
+        }
+    }
+
+    void PrintCsv(const std::vector<Result_t> & theResults)
+    {
+        // On stderr, lest it trip up CSV readers.
+        fprintf(stderr, "note: %s\n", MODEL_NOTE);
+        printf("model,mode,sensors,sweeps,sweep_latency_ms,cpu_busy_ms,cpu_busy_percent,reads,errors,error_rate\n");
+        for (const auto & r : theResults)
+        {
+            printf("%s,%s,%zu,%zu,%.3f,%.3f,%.2f,%zu,%zu,%.6f\n", r.Model, r.Mode, r.Sensors, r.Sweeps,
+                   r.LatencyUs / r.Sweeps / 1000.0, r.BusyUs / r.Sweeps / 1000.0,
+                   100.0 * r.BusyUs / r.LatencyUs, r.Reads, r.Errors,
+                   static_cast<double>(r.Errors) / r.Reads);
+        }
+    }
+
+    void PrintJson(const std::vector<Result_t> & theResults, const Options_t & theOptions)
+    {
+        printf("{\n  \"note\": \"%s\",\n  \"pin_read_cost_us\": %.3f,\n  \"clock_read_cost_us\": %.3f,\n"
+               "  \"seed\": %u,\n  \"results\": [\n",
+               MODEL_NOTE, theOptions.Cpu.PinReadCostUs, theOptions.Cpu.ClockReadCostUs, theOptions.Seed);
+        for (std::size_t i = 0; i < theResults.size(); i++)
+        {
+            const auto & r = theResults[i];
+            printf("    {\"model\": \"%s\", \"mode\": \"%s\", \"sensors\": %zu, \"sweeps\": %zu, "
+                   "\"sweep_latency_ms\": %.3f, \"cpu_busy_ms\": %.3f, \"cpu_busy_percent\": %.2f, "
+                   "\"reads\": %zu, \"errors\": %zu, \"error_rate\": %.6f}%s\n",
+                   r.Model, r.Mode, r.Sensors, r.Sweeps,
+                   r.LatencyUs / r.Sweeps / 1000.0, r.BusyUs / r.Sweeps / 1000.0,
+                   100.0 * r.BusyUs / r.LatencyUs, r.Reads, r.Errors,
+                   static_cast<double>(r.Errors) / r.Reads,
+                   (i + 1 < theResults.size()) ? "," : "");
+        }
+        printf("  ]\n}\n");
+    }
+
+    void PrintUsage(const char * theProgram)
+    {
+        fprintf(stderr, "Usage: %s [--format csv|json] [--sweeps N] [--seed N]\n"
+                        "       [--pin-read-cost-us X] [--clock-read-cost-us X]\n", theProgram);
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    Options_t theOptions;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+
+        if (!strcmp(argv[i], "--format") && hasValue)
+        {
+            theOptions.Json = !strcmp(argv[++i], "json");
+        }
+        else if (!strcmp(argv[i], "--sweeps") && hasValue)
+        {
+            theOptions.Sweeps = std::max(1ul, strtoul(argv[++i], nullptr, 10));
+        }
+        else if (!strcmp(argv[i], "--seed") && hasValue)
+        {
+            theOptions.Seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (!strcmp(argv[i], "--pin-read-cost-us") && hasValue)
+        {
+            theOptions.Cpu.PinReadCostUs = strtod(argv[++i], nullptr);
+        }
+        else if (!strcmp(argv[i], "--clock-read-cost-us") && hasValue)
+        {
+            theOptions.Cpu.ClockReadCostUs = strtod(argv[++i], nullptr);
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<Result_t> theResults;
+    RunModel<DHT11_t>("DHT11", theOptions, theResults);
+    RunModel<DHT22_t>("DHT22", theOptions, theResults);
+
+    if (theOptions.Json)
+    {
+        PrintJson(theResults, theOptions);
+    }
+    else
+    {
+        PrintCsv(theResults);
+    }
+
+    return EXIT_SUCCESS;
+}
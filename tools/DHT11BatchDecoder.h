@@ -0,0 +1,440 @@
+/***********************************************************************
+* @file      DHT11BatchDecoder.h
+*
+*    Host-side batch decoding of raw DHT11/DHT22 data frames, for replayed
+*    traces and gateway-side decoding.
+*
+* @brief   DecodeDataFrames<T>() validates and decodes thousands of 5-byte
+*          frames at once. For every frame i it produces exactly what the
+*          driver's own scalar arithmetic would (NuerteyDHT11Protocol.h):
+*
+*            theIsValid[i]           = IsChecksumValid(frame)
+*            theTemperatureTenths[i] = DecodeTemperatureTenths<T>(frame)
+*            theHumidityTenths[i]    = DecodeHumidityTenths<T>(frame)
+*
+*          Temperature and humidity are decoded whether or not the checksum
+*          holds; callers mask them with theIsValid.
+*
+*          Frames are packed back to back, so a block of 16 of them spans
+*          five 16-byte vectors. Each byte position of the frame (a "plane")
+*          is gathered from those five vectors with byte shuffles, and
+*          then the checksum, the DHT22 sign bit and the fixed-point scaling
+*          are computed on 16 frames at a time:
+*
+*            AVX2  - two blocks per iteration, one per 128-bit lane.
+*            SSE4  - one block per iteration.
+*            NEON  - one block per iteration, via table lookups (AArch64).
+*            Scalar - the driver's own functions, frame by frame; also
+*                     decodes whatever is left over after the last block.
+*
+*          On x86 the widest backend the CPU supports is picked at run
+*          time, so the tools need no -march flags to benefit.
+*
+* @note    GCC or Clang only (target attributes, __builtin_cpu_supports).
+*          Nothing in here depends upon Mbed OS.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "NuerteyDHT11Protocol.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DHT11_BATCH_DECODER_X86 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DHT11_BATCH_DECODER_NEON 1
+#endif
+
+static_assert(sizeof(DataFrame_t) == SINGLE_BUS_DATA_FRAME_SIZE_BYTES,
+              "Batch decoding relies on frames being packed back to back");
+
+enum class BatchDecoder_t : uint8_t
+{
+    SCALAR,
+    SSE4,
+    AVX2,
+    NEON
+};
+
+inline const char * ToString(const BatchDecoder_t & theDecoder)
+{
+    switch (theDecoder)
+    {
+        case BatchDecoder_t::SSE4: return "sse4";
+        case BatchDecoder_t::AVX2: return "avx2";
+        case BatchDecoder_t::NEON: return "neon";
+        default:                   return "scalar";
+    }
+}
+
+namespace BatchDecoderDetail
+{
+    static constexpr std::size_t BLOCK_FRAMES = 16;
+    static constexpr std::size_t BLOCK_BYTES  = BLOCK_FRAMES * SINGLE_BUS_DATA_FRAME_SIZE_BYTES;
+
+    struct ShuffleTable_t
+    {
+        // [plane][frame]: offset of the plane's byte within the block.
+        alignas(16) uint8_t Index[SINGLE_BUS_DATA_FRAME_SIZE_BYTES][BLOCK_FRAMES];
+
+        // [plane][vector][frame]: the same offset relative to one 16-byte
+        // vector of the block, or 0x80 (zero it) if it lies in another.
+        alignas(16) uint8_t Mask[SINGLE_BUS_DATA_FRAME_SIZE_BYTES][SINGLE_BUS_DATA_FRAME_SIZE_BYTES][BLOCK_FRAMES];
+    };
+
+    constexpr ShuffleTable_t MakeShuffleTable()
+    {
+        ShuffleTable_t theTable{};
+
+        for (std::size_t j = 0; j < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; ++j)
+        {
+            for (std::size_t k = 0; k < BLOCK_FRAMES; ++k)
+            {
+                const auto theOffset = (k * SINGLE_BUS_DATA_FRAME_SIZE_BYTES) + j;
+                theTable.Index[j][k] = static_cast<uint8_t>(theOffset);
+
+                for (std::size_t v = 0; v < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; ++v)
+                {
+                    theTable.Mask[j][v][k] = ((theOffset / 16) == v) ? static_cast<uint8_t>(theOffset % 16) : 0x80;
+                }
+            }
+        }
+
+        return theTable;
+    }
+
+    inline constexpr ShuffleTable_t SHUFFLE_TABLE = MakeShuffleTable();
+
+    template <typename T>
+    inline std::size_t DecodeScalar(const DataFrame_t * theFrames, const std::size_t & theCount,
+                                    int16_t * theTemperatureTenths, uint16_t * theHumidityTenths, uint8_t * theIsValid)
+    {
+        std::size_t theValidCount = 0;
+
+        for (std::size_t i = 0; i < theCount; ++i)
+        {
+            theIsValid[i] = IsChecksumValid(theFrames[i]) ? 1 : 0;
+            theTemperatureTenths[i] = DecodeTemperatureTenths<T>(theFrames[i]);
+            theHumidityTenths[i] = DecodeHumidityTenths<T>(theFrames[i]);
+            theValidCount += theIsValid[i];
+        }
+
+        return theValidCount;
+    }
+
+#if defined(DHT11_BATCH_DECODER_X86)
+    template <typename T>
+    __attribute__((target("sse4.1")))
+    std::size_t DecodeSse4(const uint8_t * theBytes, const std::size_t & theBlocks,
+                           int16_t * theTemperatureTenths, uint16_t * theHumidityTenths, uint8_t * theIsValid)
+    {
+        const auto theZero = _mm_setzero_si128();
+        std::size_t theValidCount = 0;
+
+        for (std::size_t b = 0; b < theBlocks; ++b)
+        {
+            const auto pTheBlock = theBytes + (b * BLOCK_BYTES);
+            __m128i theVectors[SINGLE_BUS_DATA_FRAME_SIZE_BYTES];
+            __m128i thePlanes[SINGLE_BUS_DATA_FRAME_SIZE_BYTES];
+
+            for (std::size_t v = 0; v < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; ++v)
+            {
+                theVectors[v] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pTheBlock + (v * 16)));
+            }
+
+            for (std::size_t j = 0; j < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; ++j)
+            {
+                thePlanes[j] = theZero;
+                for (std::size_t v = 0; v < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; ++v)
+                {
+                    const auto theMask = _mm_load_si128(reinterpret_cast<const __m128i *>(SHUFFLE_TABLE.Mask[j][v]));
+                    thePlanes[j] = _mm_or_si128(thePlanes[j], _mm_shuffle_epi8(theVectors[v], theMask));
+                }
+            }
+
+            // The 8-bit sum wraps exactly as the "& 0xFF" in IsChecksumValid().
+            const auto theSum = _mm_add_epi8(_mm_add_epi8(thePlanes[0], thePlanes[1]), _mm_add_epi8(thePlanes[2], thePlanes[3]));
+            const auto isValid = _mm_cmpeq_epi8(theSum, thePlanes[4]);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(theIsValid + (b * BLOCK_FRAMES)), _mm_and_si128(isValid, _mm_set1_epi8(1)));
+            theValidCount += static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(isValid))));
+
+            __m128i theTemperatures[2], theHumidities[2];
+            if constexpr (std::is_same<T, DHT11_t>::value)
+            {
+                const auto theTen = _mm_set1_epi16(10);
+                theTemperatures[0] = _mm_mullo_epi16(_mm_unpacklo_epi8(thePlanes[2], theZero), theTen);
+                theTemperatures[1] = _mm_mullo_epi16(_mm_unpackhi_epi8(thePlanes[2], theZero), theTen);
+                theHumidities[0]   = _mm_mullo_epi16(_mm_unpacklo_epi8(thePlanes[0], theZero), theTen);
+                theHumidities[1]   = _mm_mullo_epi16(_mm_unpackhi_epi8(thePlanes[0], theZero), theTen);
+            }
+            else
+            {
+                // Magnitude is (b2 & 0x7F):b3; negate, as (m ^ s) - s, where
+                // the sign bit b2.7 spread over the lane gives s.
+                const auto theHigh = _mm_and_si128(thePlanes[2], _mm_set1_epi8(0x7F));
+                const auto theSigns = _mm_cmplt_epi8(thePlanes[2], theZero);
+                const __m128i theMagnitudes[2] = { _mm_unpacklo_epi8(thePlanes[3], theHigh), _mm_unpackhi_epi8(thePlanes[3], theHigh) };
+                const __m128i theSignMasks[2]  = { _mm_unpacklo_epi8(theSigns, theSigns),    _mm_unpackhi_epi8(theSigns, theSigns) };
+
+                for (std::size_t h = 0; h < 2; ++h)
+                {
+                    theTemperatures[h] = _mm_sub_epi16(_mm_xor_si128(theMagnitudes[h], theSignMasks[h]), theSignMasks[h]);
+                }
+                theHumidities[0] = _mm_unpacklo_epi8(thePlanes[1], thePlanes[0]);
+                theHumidities[1] = _mm_unpackhi_epi8(thePlanes[1], thePlanes[0]);
+            }
+
+            for (std::size_t h = 0; h < 2; ++h)
+            {
+                const auto theOffset = (b * BLOCK_FRAMES) + (h * 8);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(theTemperatureTenths + theOffset), theTemperatures[h]);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(theHumidityTenths + theOffset), theHumidities[h]);
+            }
+        }
+
+        return theValidCount;
+    }
+
+    // As DecodeSse4(), with block 2b in the low 128-bit lane and block
+    // 2b + 1 in the high one; AVX2 shuffles and unpacks stay within lanes.
+    template <typename T>
+    __attribute__((target("avx2")))
+    std::size_t DecodeAvx2(const uint8_t * theBytes, const std::size_t & theBlockPairs,
+                           int16_t * theTemperatureTenths, uint16_t * theHumidityTenths, uint8_t * theIsValid)
+    {
+        const auto theZero = _mm256_setzero_si256();
+        std::size_t theValidCount = 0;
+
+        for (std::size_t b = 0; b < theBlockPairs; ++b)
+        {
+            const auto pTheBlock = theBytes + (b * 2 * BLOCK_BYTES);
+            __m256i theVectors[SINGLE_BUS_DATA_FRAME_SIZE_BYTES];
+            __m256i thePlanes[SINGLE_BUS_DATA_FRAME_SIZE_BYTES];
+
+            for (std::size_t v = 0; v < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; ++v)
+            {
+                const auto theLow  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pTheBlock + (v * 16)));
+                const auto theHigh = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pTheBlock + BLOCK_BYTES + (v * 16)));
+                theVectors[v] = _mm256_inserti128_si256(_mm256_castsi128_si256(theLow), theHigh, 1);
+            }
+
+            for (std::size_t j = 0; j < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; ++j)
+            {
+                thePlanes[j] = theZero;
+                for (std::size_t v = 0; v < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; ++v)
+                {
+                    const auto theMask = _mm256_broadcastsi128_si256(
+                                             _mm_load_si128(reinterpret_cast<const __m128i *>(SHUFFLE_TABLE.Mask[j][v])));
+                    thePlanes[j] = _mm256_or_si256(thePlanes[j], _mm256_shuffle_epi8(theVectors[v], theMask));
+                }
+            }
+
+            const auto theSum = _mm256_add_epi8(_mm256_add_epi8(thePlanes[0], thePlanes[1]), _mm256_add_epi8(thePlanes[2], thePlanes[3]));
+            const auto isValid = _mm256_cmpeq_epi8(theSum, thePlanes[4]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(theIsValid + (b * 2 * BLOCK_FRAMES)),
+                                _mm256_and_si256(isValid, _mm256_set1_epi8(1)));
+            theValidCount += static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(isValid))));
+
+            // Unpacks yield frames [0..7 | 16..23] and [8..15 | 24..31].
+            __m256i theTemperatures[2], theHumidities[2];
+            if constexpr (std::is_same<T, DHT11_t>::value)
+            {
+                const auto theTen = _mm256_set1_epi16(10);
+                theTemperatures[0] = _mm256_mullo_epi16(_mm256_unpacklo_epi8(thePlanes[2], theZero), theTen);
+                theTemperatures[1] = _mm256_mullo_epi16(_mm256_unpackhi_epi8(thePlanes[2], theZero), theTen);
+                theHumidities[0]   = _mm256_mullo_epi16(_mm256_unpacklo_epi8(thePlanes[0], theZero), theTen);
+                theHumidities[1]   = _mm256_mullo_epi16(_mm256_unpackhi_epi8(thePlanes[0], theZero), theTen);
+            }
+            else
+            {
+                const auto theHigh = _mm256_and_si256(thePlanes[2], _mm256_set1_epi8(0x7F));
+                const auto theSigns = _mm256_cmpgt_epi8(theZero, thePlanes[2]);
+                const __m256i theMagnitudes[2] = { _mm256_unpacklo_epi8(thePlanes[3], theHigh), _mm256_unpackhi_epi8(thePlanes[3], theHigh) };
+                const __m256i theSignMasks[2]  = { _mm256_unpacklo_epi8(theSigns, theSigns),    _mm256_unpackhi_epi8(theSigns, theSigns) };
+
+                for (std::size_t h = 0; h < 2; ++h)
+                {
+                    theTemperatures[h] = _mm256_sub_epi16(_mm256_xor_si256(theMagnitudes[h], theSignMasks[h]), theSignMasks[h]);
+                }
+                theHumidities[0] = _mm256_unpacklo_epi8(thePlanes[1], thePlanes[0]);
+                theHumidities[1] = _mm256_unpackhi_epi8(thePlanes[1], thePlanes[0]);
+            }
+
+            // Back into frame order: [0..7 | 8..15] and [16..23 | 24..31].
+            const auto theOffset = b * 2 * BLOCK_FRAMES;
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(theTemperatureTenths + theOffset),
+                                _mm256_permute2x128_si256(theTemperatures[0], theTemperatures[1], 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(theTemperatureTenths + theOffset + BLOCK_FRAMES),
+                                _mm256_permute2x128_si256(theTemperatures[0], theTemperatures[1], 0x31));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(theHumidityTenths + theOffset),
+                                _mm256_permute2x128_si256(theHumidities[0], theHumidities[1], 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(theHumidityTenths + theOffset + BLOCK_FRAMES),
+                                _mm256_permute2x128_si256(theHumidities[0], theHumidities[1], 0x31));
+        }
+
+        return theValidCount;
+    }
+#endif
+
+#if defined(DHT11_BATCH_DECODER_NEON)
+    template <typename T>
+    inline std::size_t DecodeNeon(const uint8_t * theBytes, const std::size_t & theBlocks,
+                                  int16_t * theTemperatureTenths, uint16_t * theHumidityTenths, uint8_t * theIsValid)
+    {
+        std::size_t theValidCount = 0;
+
+        for (std::size_t b = 0; b < theBlocks; ++b)
+        {
+            const auto pTheBlock = theBytes + (b * BLOCK_BYTES);
+            const uint8x16x4_t theTable = { { vld1q_u8(pTheBlock), vld1q_u8(pTheBlock + 16),
+                                              vld1q_u8(pTheBlock + 32), vld1q_u8(pTheBlock + 48) } };
+            const auto theLast = vld1q_u8(pTheBlock + 64);
+            uint8x16_t thePlanes[SINGLE_BUS_DATA_FRAME_SIZE_BYTES];
+
+            // Offsets 0..63 come from the four-vector table lookup; for
+            // 64..79 it yields zero and the extension lookup fills them in,
+            // leaving the others (which wrap past 191) untouched.
+            for (std::size_t j = 0; j < SINGLE_BUS_DATA_FRAME_SIZE_BYTES; ++j)
+            {
+                const auto theIndex = vld1q_u8(SHUFFLE_TABLE.Index[j]);
+                thePlanes[j] = vqtbx1q_u8(vqtbl4q_u8(theTable, theIndex), theLast, vsubq_u8(theIndex, vdupq_n_u8(64)));
+            }
+
+            const auto theSum = vaddq_u8(vaddq_u8(thePlanes[0], thePlanes[1]), vaddq_u8(thePlanes[2], thePlanes[3]));
+            const auto isValid = vandq_u8(vceqq_u8(theSum, thePlanes[4]), vdupq_n_u8(1));
+            vst1q_u8(theIsValid + (b * BLOCK_FRAMES), isValid);
+            theValidCount += vaddvq_u8(isValid);
+
+            int16x8_t theTemperatures[2];
+            uint16x8_t theHumidities[2];
+            if constexpr (std::is_same<T, DHT11_t>::value)
+            {
+                theTemperatures[0] = vreinterpretq_s16_u16(vmulq_n_u16(vmovl_u8(vget_low_u8(thePlanes[2])), 10));
+                theTemperatures[1] = vreinterpretq_s16_u16(vmulq_n_u16(vmovl_high_u8(thePlanes[2]), 10));
+                theHumidities[0]   = vmulq_n_u16(vmovl_u8(vget_low_u8(thePlanes[0])), 10);
+                theHumidities[1]   = vmulq_n_u16(vmovl_high_u8(thePlanes[0]), 10);
+            }
+            else
+            {
+                const auto theHigh = vandq_u8(thePlanes[2], vdupq_n_u8(0x7F));
+                const auto theSigns = vreinterpretq_u8_s8(vshrq_n_s8(vreinterpretq_s8_u8(thePlanes[2]), 7));
+                const uint16x8_t theMagnitudes[2] = { vreinterpretq_u16_u8(vzip1q_u8(thePlanes[3], theHigh)),
+                                                      vreinterpretq_u16_u8(vzip2q_u8(thePlanes[3], theHigh)) };
+                const uint16x8_t theSignMasks[2]  = { vreinterpretq_u16_u8(vzip1q_u8(theSigns, theSigns)),
+                                                      vreinterpretq_u16_u8(vzip2q_u8(theSigns, theSigns)) };
+
+                for (std::size_t h = 0; h < 2; ++h)
+                {
+                    theTemperatures[h] = vreinterpretq_s16_u16(vsubq_u16(veorq_u16(theMagnitudes[h], theSignMasks[h]), theSignMasks[h]));
+                }
+                theHumidities[0] = vreinterpretq_u16_u8(vzip1q_u8(thePlanes[1], thePlanes[0]));
+                theHumidities[1] = vreinterpretq_u16_u8(vzip2q_u8(thePlanes[1], thePlanes[0]));
+            }
+
+            for (std::size_t h = 0; h < 2; ++h)
+            {
+                const auto theOffset = (b * BLOCK_FRAMES) + (h * 8);
+                vst1q_s16(theTemperatureTenths + theOffset, theTemperatures[h]);
+                vst1q_u16(theHumidityTenths + theOffset, theHumidities[h]);
+            }
+        }
+
+        return theValidCount;
+    }
+#endif
+}
+
+// Backends usable on this machine, narrowest first.
+inline std::vector<BatchDecoder_t> GetBatchDecoders()
+{
+    std::vector<BatchDecoder_t> theDecoders{BatchDecoder_t::SCALAR};
+
+#if defined(DHT11_BATCH_DECODER_X86)
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        theDecoders.push_back(BatchDecoder_t::SSE4);
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        theDecoders.push_back(BatchDecoder_t::AVX2);
+    }
+#elif defined(DHT11_BATCH_DECODER_NEON)
+    theDecoders.push_back(BatchDecoder_t::NEON);
+#endif
+
+    return theDecoders;
+}
+
+inline BatchDecoder_t GetBestBatchDecoder()
+{
+    static const auto theBest = GetBatchDecoders().back();
+    return theBest;
+}
+
+// Decodes theCount frames with theDecoder, which must be one of
+// GetBatchDecoders(). Returns the number of frames whose checksum holds.
+template <typename T>
+inline std::size_t DecodeDataFrames(const BatchDecoder_t & theDecoder, const DataFrame_t * theFrames, const std::size_t & theCount,
+                                    int16_t * theTemperatureTenths, uint16_t * theHumidityTenths, uint8_t * theIsValid)
+{
+    static_assert(TrueTypesEquivalent<T, DHT11_t>::value
+               || TrueTypesEquivalent<T, DHT22_t>::value,
+    "Hey! Only DHT11, or DHT22 data frames can be decoded!!");
+
+    using namespace BatchDecoderDetail;
+
+    [[maybe_unused]] const auto pTheBytes = reinterpret_cast<const uint8_t *>(theFrames);
+    std::size_t theDecoded = 0;
+    std::size_t theValidCount = 0;
+
+    switch (theDecoder)
+    {
+#if defined(DHT11_BATCH_DECODER_X86)
+        case BatchDecoder_t::AVX2:
+            theDecoded = (theCount / (2 * BLOCK_FRAMES)) * (2 * BLOCK_FRAMES);
+            theValidCount = DecodeAvx2<T>(pTheBytes, theCount / (2 * BLOCK_FRAMES), theTemperatureTenths, theHumidityTenths, theIsValid);
+            break;
+
+        case BatchDecoder_t::SSE4:
+            theDecoded = (theCount / BLOCK_FRAMES) * BLOCK_FRAMES;
+            theValidCount = DecodeSse4<T>(pTheBytes, theCount / BLOCK_FRAMES, theTemperatureTenths, theHumidityTenths, theIsValid);
+            break;
+#endif
+#if defined(DHT11_BATCH_DECODER_NEON)
+        case BatchDecoder_t::NEON:
+            theDecoded = (theCount / BLOCK_FRAMES) * BLOCK_FRAMES;
+            theValidCount = DecodeNeon<T>(pTheBytes, theCount / BLOCK_FRAMES, theTemperatureTenths, theHumidityTenths, theIsValid);
+            break;
+#endif
+        default:
+            break;
+    }
+
+    return theValidCount + DecodeScalar<T>(theFrames + theDecoded, theCount - theDecoded, theTemperatureTenths + theDecoded,
+                                           theHumidityTenths + theDecoded, theIsValid + theDecoded);
+}
+
+template <typename T>
+inline std::size_t DecodeDataFrames(const DataFrame_t * theFrames, const std::size_t & theCount,
+                                    int16_t * theTemperatureTenths, uint16_t * theHumidityTenths, uint8_t * theIsValid)
+{
+    return DecodeDataFrames<T>(GetBestBatchDecoder(), theFrames, theCount, theTemperatureTenths, theHumidityTenths, theIsValid);
+}
+
+// For batches whose model is only known at run time, e.g. from a trace.
+inline std::size_t DecodeDataFrames(const SensorModel_t & theModel, const DataFrame_t * theFrames, const std::size_t & theCount,
+                                    int16_t * theTemperatureTenths, uint16_t * theHumidityTenths, uint8_t * theIsValid)
+{
+    return (theModel == SensorModel_t::DHT22)
+         ? DecodeDataFrames<DHT22_t>(theFrames, theCount, theTemperatureTenths, theHumidityTenths, theIsValid)
+         : DecodeDataFrames<DHT11_t>(theFrames, theCount, theTemperatureTenths, theHumidityTenths, theIsValid);
+}
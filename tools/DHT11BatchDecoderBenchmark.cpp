@@ -0,0 +1,232 @@
+/***********************************************************************
+* @file      DHT11BatchDecoderBenchmark.cpp
+*
+*    Host-side check and benchmark of the batch frame decoder (see
+*    DHT11BatchDecoder.h) against the driver's scalar arithmetic.
+*
+* @brief   Generates random 5-byte frames, about half of them with a good
+*          checksum and with every byte value (so DHT22 sign bits and
+*          out-of-range readings included), and decodes them as DHT11 and
+*          as DHT22 frames:
+*
+*            reference - IsChecksumValid(), DecodeTemperatureTenths<T>()
+*                        and DecodeHumidityTenths<T>() per frame.
+*            <backend> - DecodeDataFrames<T>() with every backend this
+*                        CPU supports (scalar, sse4, avx2 or neon).
+*
+*          Each backend's output must match the reference bit for bit; any
+*          mismatch is reported and fails the run. Throughput is the best
+*          of --repeats passes over the whole batch.
+*
+* @note    Build and run on the host, e.g.:
+*
+*            g++ -std=c++20 -O2 -I.. DHT11BatchDecoderBenchmark.cpp -o DHT11BatchDecoderBenchmark
+*            ./DHT11BatchDecoderBenchmark --frames 1000003 --repeats 20 --format json
+*
+*          An odd --frames also exercises the scalar tail of each backend.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include "DHT11BatchDecoder.h"
+
+namespace
+{
+    struct Options_t
+    {
+        bool        Json = false;
+        std::size_t Frames = 1'000'003;
+        std::size_t Repeats = 10;
+        unsigned    Seed = 1;
+    };
+
+    struct Result_t
+    {
+        const char *  Model;
+        const char *  Decoder;
+        double        NanosecondsPerFrame;
+        double        Speedup;
+        std::size_t   ValidFrames;
+        std::size_t   Mismatches;
+    };
+
+    struct Outputs_t
+    {
+        std::vector<int16_t>  TemperatureTenths;
+        std::vector<uint16_t> HumidityTenths;
+        std::vector<uint8_t>  IsValid;
+        std::size_t           ValidFrames = 0;
+
+        explicit Outputs_t(const std::size_t & theFrames)
+            : TemperatureTenths(theFrames), HumidityTenths(theFrames), IsValid(theFrames)
+        {
+        }
+    };
+
+    template <typename Decode>
+    double BestNanosecondsPerFrame(const Options_t & theOptions, const Decode & theDecode)
+    {
+        auto theBest = 1e300;
+
+        for (std::size_t r = 0; r < theOptions.Repeats; ++r)
+        {
+            const auto theStart = std::chrono::steady_clock::now();
+            theDecode();
+            const auto theElapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - theStart).count();
+            theBest = std::min(theBest, theElapsed / theOptions.Frames);
+        }
+
+        return theBest;
+    }
+
+    template <typename T>
+    void Benchmark(const char * theModel, const std::vector<DataFrame_t> & theFrames,
+                   const Options_t & theOptions, std::vector<Result_t> & theResults)
+    {
+        Outputs_t theReference(theFrames.size());
+
+        // Deliberately the plain per-frame calls, as a caller would write
+        // them without the batch decoder.
+        const auto theReferenceNs = BestNanosecondsPerFrame(theOptions, [&]()
+        {
+            theReference.ValidFrames = 0;
+            for (std::size_t i = 0; i < theFrames.size(); ++i)
+            {
+                const auto isValid = IsChecksumValid(theFrames[i]);
+                theReference.IsValid[i] = isValid ? 1 : 0;
+                theReference.TemperatureTenths[i] = DecodeTemperatureTenths<T>(theFrames[i]);
+                theReference.HumidityTenths[i] = DecodeHumidityTenths<T>(theFrames[i]);
+                theReference.ValidFrames += isValid;
+            }
+        });
+
+        theResults.push_back({theModel, "reference", theReferenceNs, 1.0, theReference.ValidFrames, 0});
+
+        for (const auto & theDecoder : GetBatchDecoders())
+        {
+            Outputs_t theOutputs(theFrames.size());
+
+            const auto theNs = BestNanosecondsPerFrame(theOptions, [&]()
+            {
+                theOutputs.ValidFrames = DecodeDataFrames<T>(theDecoder, theFrames.data(), theFrames.size(),
+                                                             theOutputs.TemperatureTenths.data(),
+                                                             theOutputs.HumidityTenths.data(), theOutputs.IsValid.data());
+            });
+
+            std::size_t theMismatches = (theOutputs.ValidFrames != theReference.ValidFrames) ? 1 : 0;
+            for (std::size_t i = 0; i < theFrames.size(); ++i)
+            {
+                theMismatches += (theOutputs.IsValid[i] != theReference.IsValid[i])
+                              || (theOutputs.TemperatureTenths[i] != theReference.TemperatureTenths[i])
+                              || (theOutputs.HumidityTenths[i] != theReference.HumidityTenths[i]);
+            }
+
+            theResults.push_back({theModel, ToString(theDecoder), theNs, theReferenceNs / theNs,
+                                  theOutputs.ValidFrames, theMismatches});
+        }
+    }
+
+    void PrintUsage(const char * theProgram)
+    {
+        fprintf(stderr, "Usage: %s [--format csv|json] [--frames N] [--repeats N] [--seed N]\n", theProgram);
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    Options_t theOptions;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+
+        if (!strcmp(argv[i], "--format") && hasValue)
+        {
+            theOptions.Json = !strcmp(argv[++i], "json");
+        }
+        else if (!strcmp(argv[i], "--frames") && hasValue)
+        {
+            theOptions.Frames = std::max<std::size_t>(1, strtoull(argv[++i], nullptr, 10));
+        }
+        else if (!strcmp(argv[i], "--repeats") && hasValue)
+        {
+            theOptions.Repeats = std::max<std::size_t>(1, strtoull(argv[++i], nullptr, 10));
+        }
+        else if (!strcmp(argv[i], "--seed") && hasValue)
+        {
+            theOptions.Seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::mt19937 theGenerator(theOptions.Seed);
+    std::uniform_int_distribution<int> theByte(0, 255);
+    std::bernoulli_distribution isCorrupted(0.5);
+    std::vector<DataFrame_t> theFrames(theOptions.Frames);
+
+    for (auto & theFrame : theFrames)
+    {
+        for (std::size_t j = 0; j < 4; ++j)
+        {
+            theFrame[j] = static_cast<uint8_t>(theByte(theGenerator));
+        }
+        theFrame[4] = static_cast<uint8_t>(theFrame[0] + theFrame[1] + theFrame[2] + theFrame[3]);
+
+        if (isCorrupted(theGenerator))
+        {
+            theFrame[theByte(theGenerator) % 5] ^= static_cast<uint8_t>(1 + (theByte(theGenerator) % 255));
+        }
+    }
+
+    std::vector<Result_t> theResults;
+    Benchmark<DHT11_t>("DHT11", theFrames, theOptions, theResults);
+    Benchmark<DHT22_t>("DHT22", theFrames, theOptions, theResults);
+
+    if (!theOptions.Json)
+    {
+        printf("model,decoder,ns_per_frame,mframes_per_s,speedup,valid_frames,mismatches\n");
+        for (const auto & r : theResults)
+        {
+            printf("%s,%s,%.3f,%.1f,%.2f,%zu,%zu\n", r.Model, r.Decoder, r.NanosecondsPerFrame,
+                   1e3 / r.NanosecondsPerFrame, r.Speedup, r.ValidFrames, r.Mismatches);
+        }
+    }
+    else
+    {
+        printf("{\n  \"frames\": %zu,\n  \"results\": [\n", theOptions.Frames);
+        for (std::size_t i = 0; i < theResults.size(); ++i)
+        {
+            const auto & r = theResults[i];
+            printf("    {\"model\": \"%s\", \"decoder\": \"%s\", \"ns_per_frame\": %.3f, \"mframes_per_s\": %.1f, "
+                   "\"speedup\": %.2f, \"valid_frames\": %zu, \"mismatches\": %zu}%s\n",
+                   r.Model, r.Decoder, r.NanosecondsPerFrame, 1e3 / r.NanosecondsPerFrame, r.Speedup,
+                   r.ValidFrames, r.Mismatches, (i + 1 < theResults.size()) ? "," : "");
+        }
+        printf("  ]\n}\n");
+    }
+
+    const auto hasMismatches = std::any_of(theResults.begin(), theResults.end(),
+                                           [](const Result_t & r) { return (r.Mismatches != 0); });
+    if (hasMismatches)
+    {
+        fprintf(stderr, "Error! Batch decoding differs from the scalar reference\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
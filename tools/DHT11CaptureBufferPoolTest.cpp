@@ -0,0 +1,234 @@
+/***********************************************************************
+* @file      DHT11CaptureBufferPoolTest.cpp
+*
+*    Host-side stress test of the shared capture buffer pool (see
+*    NuerteyCaptureBufferPool.h).
+*
+* @brief   First, single-threaded, the lease life cycle:
+*
+*            - leasing every buffer hands out distinct ones and raises the
+*              high watermark to the capacity;
+*            - with none free, Acquire(0) fails at once and Acquire(t) fails
+*              no sooner than t, each counting as contention and timeout;
+*            - a lease moved from is empty, and Release()/destruction return
+*              the buffer exactly once;
+*            - a waiter is woken, within its timeout, by a release on another
+*              thread, which counts as contention but not as a timeout.
+*
+*          Then --threads readers, more than there are buffers, each make
+*          --leases Acquire()s with a short timeout. Each stamps its leased
+*          buffer with its own tag, holds it for a moment and checks that no
+*          one else wrote to it meanwhile, i.e. that no buffer is ever leased
+*          twice. At the end the counters must add up: leases plus timeouts
+*          equals attempts, every timeout was contention, the watermark never
+*          exceeded the capacity and nothing is left leased.
+*
+* @note    Uses the host stand-in for Mbed in tools/host. Build with
+*          ThreadSanitizer and run on the host, e.g.:
+*
+*            g++ -std=c++20 -O1 -g -fsanitize=thread -Ihost -I.. DHT11CaptureBufferPoolTest.cpp -o DHT11CaptureBufferPoolTest -lpthread
+*            ./DHT11CaptureBufferPoolTest --threads 8 --leases 2000
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <set>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include "mbed.h"
+#include "DHT11TestSupport.h"
+#include "NuerteyCaptureBufferPool.h"
+
+namespace
+{
+    constexpr std::size_t POOL_SIZE  = 3;
+    constexpr uint32_t    TIMEOUT_MS = 20;
+
+    struct Options_t
+    {
+        std::size_t Threads = 6;
+        uint32_t    Leases = 1000;
+        uint32_t    HoldUs = 50;
+    };
+
+    uint64_t ElapsedMs(const std::chrono::steady_clock::time_point & theStart)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                     std::chrono::steady_clock::now() - theStart).count());
+    }
+
+    void CheckLifeCycle(Checker_t & theChecker)
+    {
+        NuerteyStaticCaptureBufferPool<POOL_SIZE> thePool;
+        theChecker.Expect(thePool.GetCapacity() == POOL_SIZE, "capacity differs from the pool size");
+
+        {
+            std::vector<NuerteyCaptureBufferPool::Lease> theLeases;
+            std::set<const EdgeTimestamps_t *>           theBuffers;
+            for (std::size_t i = 0; i < POOL_SIZE; i++)
+            {
+                theLeases.push_back(thePool.Acquire());
+                theChecker.Expect(static_cast<bool>(theLeases.back()), "a free buffer was not leased");
+                theBuffers.insert(&theLeases.back().GetBuffer());
+            }
+            theChecker.Expect(theBuffers.size() == POOL_SIZE, "the same buffer was leased twice");
+            theChecker.Expect(thePool.GetLeasedCount() == POOL_SIZE, "leased count wrong with every buffer leased");
+            theChecker.Expect(thePool.GetHighWatermark() == POOL_SIZE, "high watermark short of the capacity");
+
+            auto theStart = std::chrono::steady_clock::now();
+            theChecker.Expect(!thePool.Acquire(), "Acquire(0) succeeded on an exhausted pool");
+            theChecker.Expect(ElapsedMs(theStart) < TIMEOUT_MS, "Acquire(0) waited");
+
+            theStart = std::chrono::steady_clock::now();
+            theChecker.Expect(!thePool.Acquire(TIMEOUT_MS), "Acquire(t) succeeded on an exhausted pool");
+            theChecker.Expect(ElapsedMs(theStart) >= TIMEOUT_MS, "Acquire(t) gave up before its timeout");
+
+            theChecker.Expect(thePool.GetContentionCount() == 2, "exhaustion not counted as contention");
+            theChecker.Expect(thePool.GetTimeoutCount() == 2, "failed leases not counted as timeouts");
+
+            // Moving transfers the buffer; only the destination returns it.
+            NuerteyCaptureBufferPool::Lease theMoved(std::move(theLeases.back()));
+            theChecker.Expect(!theLeases.back() && theMoved, "a move did not transfer the lease");
+            theLeases.back().Release();
+            theChecker.Expect(thePool.GetLeasedCount() == POOL_SIZE, "an emptied lease released a buffer");
+            theMoved.Release();
+            theMoved.Release();
+            theChecker.Expect(thePool.GetLeasedCount() == POOL_SIZE - 1, "Release() did not return exactly one buffer");
+
+            // A release elsewhere wakes a waiter well within its timeout.
+            auto theHeld = thePool.Acquire();
+            std::thread theReleaser([&]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(TIMEOUT_MS / 4));
+                theHeld.Release();
+            });
+
+            theStart = std::chrono::steady_clock::now();
+            auto theWoken = thePool.Acquire(10 * TIMEOUT_MS);
+            const auto theWaitedMs = ElapsedMs(theStart);
+            theReleaser.join();
+
+            theChecker.Expect(static_cast<bool>(theWoken), "a waiter was not handed the released buffer");
+            theChecker.Expect(theWaitedMs < 10 * TIMEOUT_MS, "a waiter was not woken by the release");
+            theChecker.Expect(thePool.GetContentionCount() == 3, "a wait was not counted as contention");
+            theChecker.Expect(thePool.GetTimeoutCount() == 2, "a woken waiter was counted as a timeout");
+        }
+
+        theChecker.Expect(thePool.GetLeasedCount() == 0, "destroyed leases did not return their buffers");
+        theChecker.Expect(static_cast<bool>(thePool.Acquire()), "returned buffers cannot be leased again");
+
+        printf("life cycle: leased=%u high_watermark=%u contention=%u timeouts=%u\n",
+               thePool.GetLeasedCount(), thePool.GetHighWatermark(),
+               thePool.GetContentionCount(), thePool.GetTimeoutCount());
+    }
+
+    void CheckUnderContention(Checker_t & theChecker, const Options_t & theOptions)
+    {
+        NuerteyStaticCaptureBufferPool<POOL_SIZE> thePool;
+        std::atomic<uint64_t> theLeases(0);
+        std::atomic<uint64_t> theFailures(0);
+        std::atomic<uint64_t> theCollisions(0);
+        std::atomic<uint32_t> theMostLeased(0);
+        std::atomic<bool>     isStarted(false);
+
+        std::vector<std::thread> theReaders;
+        for (std::size_t t = 0; t < theOptions.Threads; t++)
+        {
+            theReaders.emplace_back([&, t]()
+            {
+                const auto theTag = static_cast<uint32_t>(t + 1);
+
+                while (!isStarted.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+
+                for (uint32_t n = 0; n < theOptions.Leases; n++)
+                {
+                    auto theLease = thePool.Acquire(TIMEOUT_MS);
+                    if (!theLease)
+                    {
+                        theFailures.fetch_add(1, std::memory_order_relaxed);
+                        continue;
+                    }
+                    theLeases.fetch_add(1, std::memory_order_relaxed);
+
+                    const auto theLeased = thePool.GetLeasedCount();
+                    auto theMost = theMostLeased.load(std::memory_order_relaxed);
+                    while ((theLeased > theMost) && !theMostLeased.compare_exchange_weak(theMost, theLeased))
+                    {
+                    }
+
+                    // Stamp the whole buffer as a capture would; any other
+                    // writer before the check means it was leased twice.
+                    auto & theBuffer = theLease.GetBuffer();
+                    std::fill(theBuffer.begin(), theBuffer.end(), theTag);
+                    std::this_thread::sleep_for(std::chrono::microseconds(theOptions.HoldUs));
+                    if (std::any_of(theBuffer.begin(), theBuffer.end(), [&](const uint32_t & e) { return (e != theTag); }))
+                    {
+                        theCollisions.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+
+        isStarted.store(true, std::memory_order_release);
+        for (auto & theReader : theReaders)
+        {
+            theReader.join();
+        }
+
+        const auto theAttempts = static_cast<uint64_t>(theOptions.Threads) * theOptions.Leases;
+
+        printf("contention: threads=%zu buffers=%zu attempts=%llu leases=%llu timeouts=%u contention=%u "
+               "high_watermark=%u most_leased=%u collisions=%llu leased_at_end=%u\n",
+               theOptions.Threads, POOL_SIZE, static_cast<unsigned long long>(theAttempts),
+               static_cast<unsigned long long>(theLeases.load()), thePool.GetTimeoutCount(),
+               thePool.GetContentionCount(), thePool.GetHighWatermark(), theMostLeased.load(),
+               static_cast<unsigned long long>(theCollisions.load()), thePool.GetLeasedCount());
+
+        theChecker.Expect(theCollisions.load() == 0, "a buffer was leased to two readers at once");
+        theChecker.Expect(theLeases.load() + theFailures.load() == theAttempts, "attempts went unaccounted for");
+        theChecker.Expect(thePool.GetTimeoutCount() == theFailures.load(), "timeout count differs from failed leases");
+        theChecker.Expect(thePool.GetContentionCount() >= thePool.GetTimeoutCount(), "a timeout was not counted as contention");
+        theChecker.Expect(thePool.GetHighWatermark() <= POOL_SIZE, "high watermark exceeds the capacity");
+        theChecker.Expect(theMostLeased.load() <= POOL_SIZE, "more buffers leased than exist");
+        theChecker.Expect(thePool.GetLeasedCount() == 0, "buffers left leased at the end");
+
+        // Only meaningful if the readers actually overlapped.
+        if (theOptions.Threads > POOL_SIZE)
+        {
+            theChecker.Expect(thePool.GetHighWatermark() == POOL_SIZE, "the pool was never exhausted");
+            theChecker.Expect(thePool.GetContentionCount() > 0, "no reader ever had to wait");
+        }
+    }
+
+}
+
+int main(int argc, char * argv[])
+{
+    Options_t theOptions;
+
+    if (!ParseOptions(argc, argv, { { "--threads", theOptions.Threads, 1 },
+                                    { "--leases",  theOptions.Leases,  1, UINT32_MAX },
+                                    { "--hold-us", theOptions.HoldUs,  0, UINT32_MAX } },
+                      "[--threads N] [--leases N] [--hold-us N]"))
+    {
+        return EXIT_FAILURE;
+    }
+
+    Checker_t theChecker;
+    CheckLifeCycle(theChecker);
+    CheckUnderContention(theChecker, theOptions);
+
+    return theChecker.Finish();
+}
@@ -0,0 +1,418 @@
+/***********************************************************************
+* @file      DHT11CoapServerTest.cpp
+*
+*    Host-side loopback test of the CoAP resource server (see
+*    NuerteyCoapServer.h).
+*
+* @brief   A client socket on the host loopback exchanges hand-encoded
+*          CoAP messages with the server, whose deferred work runs when
+*          the test dispatches the event queue, and decodes the replies:
+*
+*            - GET: piggybacked 2.05 on the ACK of a CON (same message ID,
+*              token echoed), a NON reply to a NON, Content-Format JSON and
+*              the cached reading, negative temperatures included; no
+*              payload before the first reading;
+*            - errors: 4.04 for unknown paths, 4.05 for other methods;
+*            - discovery: .well-known/core in link format;
+*            - ping: an empty CON is answered with a RST;
+*            - Observe: registration answers with the Observe option,
+*              each new reading of that sensor (only) is notified with an
+*              increasing sequence, and both a RST on a notification and
+*              Observe=1 deregister;
+*            - options: an unknown critical option gets 4.02 Bad Option on
+*              a CON (and no registration), and no reply at all on a NON;
+*              Uri-Host and unknown elective options, extended option
+*              numbers included, do not get in the way.
+*
+* @note    Uses the host stand-in for Mbed in tools/host, e.g.:
+*
+*            g++ -std=c++20 -O2 -Ihost -I.. DHT11CoapServerTest.cpp -o DHT11CoapServerTest
+*            ./DHT11CoapServerTest
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include "mbed.h"
+#include "DHT11TestSupport.h"
+#include "NuerteyCoapServer.h"
+
+namespace
+{
+    constexpr uint16_t SERVER_PORT = 5683;
+
+    constexpr uint8_t  TYPE_CON = 0;
+    constexpr uint8_t  TYPE_NON = 1;
+    constexpr uint8_t  TYPE_ACK = 2;
+    constexpr uint8_t  TYPE_RST = 3;
+
+    constexpr uint8_t  CODE_EMPTY      = 0x00;
+    constexpr uint8_t  CODE_GET        = 0x01;
+    constexpr uint8_t  CODE_POST       = 0x02;
+    constexpr uint8_t  CODE_CONTENT    = 0x45;
+    constexpr uint8_t  CODE_BAD_OPTION = 0x82;
+    constexpr uint8_t  CODE_NOT_FOUND  = 0x84;
+    constexpr uint8_t  CODE_NOT_ALLOWED = 0x85;
+
+    constexpr uint16_t OPTION_URI_HOST       = 3;
+    constexpr uint16_t OPTION_OBSERVE        = 6;
+    constexpr uint16_t OPTION_URI_PATH       = 11;
+    constexpr uint16_t OPTION_CONTENT_FORMAT = 12;
+    constexpr uint16_t OPTION_URI_QUERY      = 15;
+    constexpr uint16_t OPTION_SIZE1          = 60;     // Elective.
+    constexpr uint16_t OPTION_EXPERIMENTAL   = 65001;  // Critical, needs the 2-byte extended delta.
+
+    using Options_t = std::multimap<uint16_t, std::vector<uint8_t>>;
+
+    struct Message_t
+    {
+        bool                 IsValid = false;
+        uint8_t              Type = 0;
+        uint8_t              Code = 0;
+        uint16_t             MessageId = 0;
+        std::vector<uint8_t> Token;
+        Options_t            Options;
+        std::string          Payload;
+
+        bool HasOption(const uint16_t & theOption) const { return (Options.count(theOption) != 0); }
+
+        uint32_t GetUintOption(const uint16_t & theOption) const
+        {
+            uint32_t theValue = 0;
+            auto theEntry = Options.find(theOption);
+            if (theEntry != Options.end())
+            {
+                for (const auto & b : theEntry->second)
+                {
+                    theValue = (theValue << 8) | b;
+                }
+            }
+            return theValue;
+        }
+    };
+
+    std::vector<uint8_t> Bytes(const std::string & theText) { return std::vector<uint8_t>(theText.begin(), theText.end()); }
+
+    std::vector<uint8_t> UintBytes(const uint32_t & theValue)
+    {
+        std::vector<uint8_t> theBytes;
+        for (auto v = theValue; v != 0; v >>= 8)
+        {
+            theBytes.insert(theBytes.begin(), static_cast<uint8_t>(v & 0xFF));
+        }
+        return theBytes;
+    }
+
+    // Nibble plus extended bytes per RFC 7252 section 3.1.
+    void EncodeNibble(const uint32_t & theValue, uint8_t & theNibble, std::vector<uint8_t> & theExtended)
+    {
+        if (theValue < 13)
+        {
+            theNibble = static_cast<uint8_t>(theValue);
+        }
+        else if (theValue < 269)
+        {
+            theNibble = 13;
+            theExtended.push_back(static_cast<uint8_t>(theValue - 13));
+        }
+        else
+        {
+            theNibble = 14;
+            theExtended.push_back(static_cast<uint8_t>((theValue - 269) >> 8));
+            theExtended.push_back(static_cast<uint8_t>((theValue - 269) & 0xFF));
+        }
+    }
+
+    std::vector<uint8_t> Encode(const uint8_t & theType, const uint8_t & theCode, const uint16_t & theMessageId,
+                                const std::string & theToken, const Options_t & theOptions = {})
+    {
+        std::vector<uint8_t> theBytes = {static_cast<uint8_t>((1 << 6) | (theType << 4) | theToken.size()), theCode,
+                                         static_cast<uint8_t>(theMessageId >> 8), static_cast<uint8_t>(theMessageId & 0xFF)};
+        for (const auto & c : theToken)
+        {
+            theBytes.push_back(static_cast<uint8_t>(c));
+        }
+
+        uint16_t theLastOption = 0;
+        for (const auto & [theOption, theValue] : theOptions)
+        {
+            uint8_t theDelta = 0;
+            uint8_t theLength = 0;
+            std::vector<uint8_t> theExtended;
+            EncodeNibble(theOption - theLastOption, theDelta, theExtended);
+            EncodeNibble(static_cast<uint32_t>(theValue.size()), theLength, theExtended);
+
+            theBytes.push_back(static_cast<uint8_t>((theDelta << 4) | theLength));
+            theBytes.insert(theBytes.end(), theExtended.begin(), theExtended.end());
+            theBytes.insert(theBytes.end(), theValue.begin(), theValue.end());
+            theLastOption = theOption;
+        }
+        return theBytes;
+    }
+
+    Options_t GetPath(const std::string & thePath, Options_t theOptions = {})
+    {
+        std::size_t theStart = 0;
+        while (theStart <= thePath.size())
+        {
+            auto theEnd = thePath.find('/', theStart);
+            if (theEnd == std::string::npos)
+            {
+                theEnd = thePath.size();
+            }
+            theOptions.emplace(OPTION_URI_PATH, Bytes(thePath.substr(theStart, theEnd - theStart)));
+            theStart = theEnd + 1;
+        }
+        return theOptions;
+    }
+
+    // The server only ever emits small deltas and lengths.
+    Message_t Decode(const uint8_t * theBytes, const std::size_t & theSize)
+    {
+        Message_t theMessage;
+        if ((theSize < 4) || ((theBytes[0] >> 6) != 1) || ((4U + (theBytes[0] & 0x0F)) > theSize))
+        {
+            return theMessage;
+        }
+
+        theMessage.Type = (theBytes[0] >> 4) & 0x03;
+        theMessage.Code = theBytes[1];
+        theMessage.MessageId = static_cast<uint16_t>((theBytes[2] << 8) | theBytes[3]);
+        theMessage.Token.assign(&theBytes[4], &theBytes[4 + (theBytes[0] & 0x0F)]);
+
+        std::size_t position = 4 + theMessage.Token.size();
+        uint16_t theOption = 0;
+        while ((position < theSize) && (theBytes[position] != 0xFF))
+        {
+            const auto theDelta = theBytes[position] >> 4;
+            const auto theLength = theBytes[position] & 0x0F;
+            if ((theDelta >= 13) || (theLength >= 13) || ((position + 1 + theLength) > theSize))
+            {
+                return theMessage;
+            }
+
+            theOption = static_cast<uint16_t>(theOption + theDelta);
+            theMessage.Options.emplace(theOption, std::vector<uint8_t>(&theBytes[position + 1], &theBytes[position + 1 + theLength]));
+            position += 1 + theLength;
+        }
+
+        if (position < theSize)
+        {
+            theMessage.Payload.assign(reinterpret_cast<const char *>(&theBytes[position + 1]), theSize - position - 1);
+        }
+        theMessage.IsValid = true;
+        return theMessage;
+    }
+
+    class Client
+    {
+    public:
+        explicit Client(EventQueue & theQueue) : m_TheQueue(theQueue)
+        {
+            (void)m_TheSocket.open(NetworkInterface::get_default_instance());
+            (void)m_TheSocket.bind(0);
+        }
+
+        // Sends, lets the server run, and returns its replies.
+        std::vector<Message_t> Exchange(const std::vector<uint8_t> & theRequest)
+        {
+            (void)m_TheSocket.sendto(SocketAddress("127.0.0.1", SERVER_PORT), theRequest.data(),
+                                     static_cast<unsigned>(theRequest.size()));
+            return Collect();
+        }
+
+        std::vector<Message_t> Collect()
+        {
+            m_TheQueue.dispatch(0);
+
+            std::vector<Message_t> theReplies;
+            uint8_t theBuffer[256];
+            nsapi_size_or_error_t theSize;
+            while ((theSize = m_TheSocket.recvfrom(nullptr, theBuffer, sizeof(theBuffer))) > 0)
+            {
+                theReplies.push_back(Decode(theBuffer, static_cast<std::size_t>(theSize)));
+            }
+            return theReplies;
+        }
+
+        // The single reply to a request, or an invalid message.
+        Message_t Request(const std::vector<uint8_t> & theRequest)
+        {
+            const auto theReplies = Exchange(theRequest);
+            return (theReplies.size() == 1) ? theReplies.front() : Message_t{};
+        }
+
+    private:
+        EventQueue & m_TheQueue;
+        UDPSocket     m_TheSocket;
+    };
+
+    Measurement_t MakeMeasurement(const PinName & thePin, const int16_t & theTemperature, const uint16_t & theHumidity)
+    {
+        return Measurement_t{thePin, theTemperature, theHumidity, SensorStatus_t::SUCCESS, 4200, 1, 1'000'000, 1'000'000};
+    }
+
+    bool IsReplyTo(const Message_t & theReply, const uint8_t & theType, const uint8_t & theCode,
+                   const uint16_t & theMessageId, const std::string & theToken)
+    {
+        return theReply.IsValid && (theReply.Type == theType) && (theReply.Code == theCode)
+            && (theReply.MessageId == theMessageId) && (theReply.Token == Bytes(theToken));
+    }
+
+    void CheckGet(Checker_t & theChecker, NuerteyCoapServer<> & theServer, Client & theClient)
+    {
+        auto theReply = theClient.Request(Encode(TYPE_CON, CODE_GET, 0x1001, "t1", GetPath("dht/0")));
+        theChecker.Expect(IsReplyTo(theReply, TYPE_ACK, CODE_CONTENT, 0x1001, "t1"), "CON GET not answered with a piggybacked 2.05");
+        theChecker.Expect(theReply.GetUintOption(OPTION_CONTENT_FORMAT) == 50, "Content-Format is not JSON");
+        theChecker.Expect(theReply.Payload.empty(), "payload served before the first reading");
+
+        theServer.Update(MakeMeasurement(PE_13, 235, 410));
+        theServer.Update(MakeMeasurement(PE_14, -5, 998));
+        (void)theClient.Collect();
+
+        theReply = theClient.Request(Encode(TYPE_CON, CODE_GET, 0x1002, "t2", GetPath("dht/0")));
+        theChecker.Expect(IsReplyTo(theReply, TYPE_ACK, CODE_CONTENT, 0x1002, "t2"), "CON GET after a reading");
+        theChecker.Expect(theReply.Payload == "{\"t\":23.5,\"h\":41.0,\"s\":0}", "cached reading not served as JSON");
+        theChecker.Expect(!theReply.HasOption(OPTION_OBSERVE), "Observe option on a plain GET");
+
+        theReply = theClient.Request(Encode(TYPE_NON, CODE_GET, 0x1003, "t3", GetPath("dht/1")));
+        theChecker.Expect(theReply.IsValid && (theReply.Type == TYPE_NON) && (theReply.Code == CODE_CONTENT)
+                       && (theReply.Token == Bytes("t3")), "NON GET not answered with a NON 2.05");
+        theChecker.Expect(theReply.Payload == "{\"t\":-0.5,\"h\":99.8,\"s\":0}", "negative temperature misformatted");
+
+        theReply = theClient.Request(Encode(TYPE_CON, CODE_GET, 0x1004, "", GetPath("dht/9")));
+        theChecker.Expect(IsReplyTo(theReply, TYPE_ACK, CODE_NOT_FOUND, 0x1004, ""), "unknown path not answered with 4.04");
+
+        theReply = theClient.Request(Encode(TYPE_CON, CODE_POST, 0x1005, "p", GetPath("dht/0")));
+        theChecker.Expect(IsReplyTo(theReply, TYPE_ACK, CODE_NOT_ALLOWED, 0x1005, "p"), "POST not answered with 4.05");
+
+        theReply = theClient.Request(Encode(TYPE_CON, CODE_GET, 0x1006, "wk", GetPath(".well-known/core")));
+        theChecker.Expect(IsReplyTo(theReply, TYPE_ACK, CODE_CONTENT, 0x1006, "wk"), "discovery not answered with 2.05");
+        theChecker.Expect(theReply.GetUintOption(OPTION_CONTENT_FORMAT) == 40, "discovery Content-Format is not link format");
+        theChecker.Expect(theReply.Payload == "</dht/0>;obs;ct=50,</dht/1>;obs;ct=50", "discovery listing wrong");
+
+        theReply = theClient.Request(Encode(TYPE_CON, CODE_EMPTY, 0x1007, ""));
+        theChecker.Expect(IsReplyTo(theReply, TYPE_RST, CODE_EMPTY, 0x1007, "") && theReply.Options.empty(),
+                          "ping not answered with a RST");
+
+        theChecker.Expect(theClient.Exchange(Encode(TYPE_NON, CODE_EMPTY, 0x1008, "")).empty(), "empty NON answered");
+    }
+
+    void CheckObserve(Checker_t & theChecker, NuerteyCoapServer<> & theServer, Client & theClient)
+    {
+        auto theReply = theClient.Request(Encode(TYPE_CON, CODE_GET, 0x2001, "ob",
+                                                 GetPath("dht/0", {{OPTION_OBSERVE, UintBytes(0)}})));
+        theChecker.Expect(IsReplyTo(theReply, TYPE_ACK, CODE_CONTENT, 0x2001, "ob"), "registration not answered with 2.05");
+        theChecker.Expect(theReply.HasOption(OPTION_OBSERVE), "registration reply lacks the Observe option");
+        auto theSequence = theReply.GetUintOption(OPTION_OBSERVE);
+
+        for (int16_t i = 0; i < 3; i++)
+        {
+            theServer.Update(MakeMeasurement(PE_13, static_cast<int16_t>(200 + i), 500));
+            const auto theNotifications = theClient.Collect();
+            const auto isNotified = (theNotifications.size() == 1) && (theNotifications[0].Type == TYPE_NON)
+                                 && (theNotifications[0].Code == CODE_CONTENT) && (theNotifications[0].Token == Bytes("ob"))
+                                 && (theNotifications[0].GetUintOption(OPTION_OBSERVE) > theSequence)
+                                 && (theNotifications[0].Payload == "{\"t\":20." + std::to_string(i) + ",\"h\":50.0,\"s\":0}");
+            theChecker.Expect(isNotified, "new reading not notified with a fresh sequence");
+            if (isNotified)
+            {
+                theSequence = theNotifications[0].GetUintOption(OPTION_OBSERVE);
+            }
+        }
+
+        theServer.Update(MakeMeasurement(PE_14, 1, 1));
+        theChecker.Expect(theClient.Collect().empty(), "another sensor's reading was notified");
+
+        // Reject a notification; the observer is forgotten.
+        theServer.Update(MakeMeasurement(PE_13, 210, 500));
+        auto theNotifications = theClient.Collect();
+        theChecker.Expect(theNotifications.size() == 1, "notification before the RST missing");
+        if (!theNotifications.empty())
+        {
+            theChecker.Expect(theClient.Exchange(Encode(TYPE_RST, CODE_EMPTY, theNotifications[0].MessageId, "")).empty(),
+                              "RST answered");
+        }
+        theServer.Update(MakeMeasurement(PE_13, 211, 500));
+        theChecker.Expect(theClient.Collect().empty(), "RST did not deregister the observer");
+
+        // Register again, then deregister explicitly.
+        theReply = theClient.Request(Encode(TYPE_CON, CODE_GET, 0x2002, "o2",
+                                            GetPath("dht/0", {{OPTION_OBSERVE, UintBytes(0)}})));
+        theChecker.Expect(theReply.HasOption(OPTION_OBSERVE), "re-registration refused");
+        theServer.Update(MakeMeasurement(PE_13, 212, 500));
+        theChecker.Expect(theClient.Collect().size() == 1, "re-registered observer not notified");
+
+        theReply = theClient.Request(Encode(TYPE_CON, CODE_GET, 0x2003, "o2",
+                                            GetPath("dht/0", {{OPTION_OBSERVE, UintBytes(1)}})));
+        theChecker.Expect(IsReplyTo(theReply, TYPE_ACK, CODE_CONTENT, 0x2003, "o2") && !theReply.HasOption(OPTION_OBSERVE),
+                          "deregistration not answered as a plain GET");
+        theServer.Update(MakeMeasurement(PE_13, 213, 500));
+        theChecker.Expect(theClient.Collect().empty(), "Observe=1 did not deregister the observer");
+    }
+
+    void CheckOptions(Checker_t & theChecker, NuerteyCoapServer<> & theServer, Client & theClient)
+    {
+        auto theReply = theClient.Request(Encode(TYPE_CON, CODE_GET, 0x3001, "q",
+                                                 GetPath("dht/0", {{OPTION_URI_QUERY, Bytes("unit=F")}})));
+        theChecker.Expect(IsReplyTo(theReply, TYPE_ACK, CODE_BAD_OPTION, 0x3001, "q") && theReply.Payload.empty(),
+                          "unknown critical option on a CON not answered with 4.02");
+
+        theReply = theClient.Request(Encode(TYPE_CON, CODE_GET, 0x3002, "x",
+                                            GetPath("dht/0", {{OPTION_EXPERIMENTAL, Bytes("1")}})));
+        theChecker.Expect(IsReplyTo(theReply, TYPE_ACK, CODE_BAD_OPTION, 0x3002, "x"),
+                          "extended critical option on a CON not answered with 4.02");
+
+        theChecker.Expect(theClient.Exchange(Encode(TYPE_NON, CODE_GET, 0x3003, "n",
+                                             GetPath("dht/0", {{OPTION_URI_QUERY, Bytes("unit=F")}}))).empty(),
+                          "unknown critical option on a NON was answered");
+
+        // Not even the Observe registration may take effect.
+        theReply = theClient.Request(Encode(TYPE_CON, CODE_GET, 0x3004, "bo",
+                                            GetPath("dht/0", {{OPTION_OBSERVE, UintBytes(0)},
+                                                              {OPTION_URI_QUERY, Bytes("unit=F")}})));
+        theChecker.Expect(IsReplyTo(theReply, TYPE_ACK, CODE_BAD_OPTION, 0x3004, "bo"), "bad registration not answered with 4.02");
+        theServer.Update(MakeMeasurement(PE_13, 220, 500));
+        theChecker.Expect(theClient.Collect().empty(), "a request rejected with 4.02 registered an observer");
+
+        theReply = theClient.Request(Encode(TYPE_CON, CODE_GET, 0x3005, "h",
+                                            GetPath("dht/0", {{OPTION_URI_HOST, Bytes("127.0.0.1")},
+                                                              {OPTION_SIZE1, UintBytes(300)}})));
+        theChecker.Expect(IsReplyTo(theReply, TYPE_ACK, CODE_CONTENT, 0x3005, "h")
+                       && (theReply.Payload == "{\"t\":22.0,\"h\":50.0,\"s\":0}"),
+                          "Uri-Host or an elective option got in the way of a GET");
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    if (!ParseOptions(argc, argv, {}))
+    {
+        return EXIT_FAILURE;
+    }
+
+    EventQueue theQueue;
+    NuerteyCoapServer<> theServer(NetworkInterface::get_default_instance(), theQueue);
+    Client theClient(theQueue);
+    Checker_t theChecker;
+
+    theChecker.Expect(theServer.AddResource("dht/0", PE_13) && theServer.AddResource("dht/1", PE_14), "resources not added");
+    theChecker.Expect(theServer.Start(SERVER_PORT) == NSAPI_ERROR_OK, "server did not start");
+
+    CheckGet(theChecker, theServer, theClient);
+    CheckObserve(theChecker, theServer, theClient);
+    CheckOptions(theChecker, theServer, theClient);
+
+    theServer.Stop();
+    theChecker.Expect(theClient.Exchange(Encode(TYPE_CON, CODE_EMPTY, 0x4001, "")).empty(), "stopped server answered");
+
+    return theChecker.Finish();
+}
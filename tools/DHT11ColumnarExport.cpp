@@ -0,0 +1,493 @@
+/***********************************************************************
+* @file      DHT11ColumnarExport.cpp
+*
+*    Host-side conversion of DHT11/DHT22 logs into columnar files (see
+*    DHT11ColumnarFile.h), and column-at-a-time queries over them.
+*
+* @brief   Three commands:
+*
+*            export OUT [INPUT...] - Decode history files (.dhh, from
+*                                    DHT11HistoryTool) or captured console
+*                                    logs ("#D" trace lines, "#E" epochs;
+*                                    standard input if none) into columnar
+*                                    file OUT.
+*            stats FILE            - Count, minimum, maximum and mean of
+*                                    one column, optionally per sensor and
+*                                    over a range of log time only.
+*            dump FILE             - Print the rows back out, e.g. to spot
+*                                    check an export.
+*
+*          stats decodes only the chunks it needs: the chosen column,
+*          status only where a row group holds failed reads, sensor only
+*          when asked to group by it, and log time only for row groups that
+*          straddle the ends of the range. Row groups wholly outside the
+*          range are skipped on their footer minimum and maximum alone.
+*
+*          Frames are validated and decoded once, at export, with the
+*          driver's own arithmetic. A frame that the MCU accepted but that
+*          fails the checksum on the host is exported as ERROR_BAD_CHECKSUM.
+*
+* @note    Build and run on the host, e.g.:
+*
+*            g++ -std=c++20 -O2 -I.. DHT11ColumnarExport.cpp -o DHT11ColumnarExport
+*            ./DHT11ColumnarExport export node17.dhc node17.dhh
+*            ./DHT11ColumnarExport stats --column temperature --by-sensor node17.dhc
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include "DHT11ColumnarFile.h"
+
+namespace
+{
+    struct Options_t
+    {
+        bool     Json = false;
+        bool     BySensor = false;
+        Column_t Column = Column_t::TEMPERATURE;
+        uint64_t FromMs = 0;
+        uint64_t ToMs = UINT64_MAX;
+        uint32_t RowGroupSize = COLUMNAR_DEFAULT_ROW_GROUP;
+    };
+
+    struct ColumnStats_t
+    {
+        uint64_t Reads = 0;
+        uint64_t Errors = 0;
+        int64_t  Minimum = INT64_MAX;
+        int64_t  Maximum = INT64_MIN;
+        int64_t  Sum = 0;
+    };
+
+    ColumnarRow_t ToRow(const uint64_t & theLogTimeMs, const TraceRecord_t & theRecord)
+    {
+        ColumnarRow_t theRow{theLogTimeMs, theRecord.SensorPin, 0, 0, theRecord.Status};
+
+        if (theRow.Status != SensorStatus_t::SUCCESS)
+        {
+            return theRow;
+        }
+        if (!IsChecksumValid(theRecord.Frame))
+        {
+            theRow.Status = SensorStatus_t::ERROR_BAD_CHECKSUM;
+            return theRow;
+        }
+
+        const auto isDHT22 = (theRecord.Model == SensorModel_t::DHT22);
+        theRow.TemperatureTenths = isDHT22 ? DecodeTemperatureTenths<DHT22_t>(theRecord.Frame)
+                                           : DecodeTemperatureTenths<DHT11_t>(theRecord.Frame);
+        theRow.HumidityTenths    = isDHT22 ? DecodeHumidityTenths<DHT22_t>(theRecord.Frame)
+                                           : DecodeHumidityTenths<DHT11_t>(theRecord.Frame);
+        return theRow;
+    }
+
+    bool IsHistoryFile(const std::string & thePath)
+    {
+        char theMagic[4] = {};
+        std::ifstream theFile(thePath, std::ios::binary);
+        return theFile.read(theMagic, sizeof(theMagic)) && (memcmp(theMagic, HISTORY_FILE_MAGIC, 4) == 0);
+    }
+
+    int Export(const std::string & theOutput, const std::vector<std::string> & theInputs, const Options_t & theOptions)
+    {
+        DHT11ColumnarWriter theWriter(theOptions.RowGroupSize);
+        if (!theWriter.Open(theOutput))
+        {
+            fprintf(stderr, "Error! Unable to create \"%s\"\n", theOutput.c_str());
+            return EXIT_FAILURE;
+        }
+
+        // Log time runs on across all inputs, as if they were one capture.
+        uint64_t theLogTimeOffset = 0;
+        uint64_t theLastLogTime = 0;
+        auto isWritten = true;
+
+        auto ExportStream = [&](std::istream & theInput)
+        {
+            std::string theLine;
+            TraceRecord_t theRecord;
+            TraceEpoch_t theEpoch;
+            DHT11LogClock theClock;
+
+            while (std::getline(theInput, theLine))
+            {
+                while (!theLine.empty() && ((theLine.back() == '\r') || (theLine.back() == '\n')))
+                {
+                    theLine.pop_back();
+                }
+
+                if (ParseTraceLine(theLine.c_str(), theLine.size(), theRecord))
+                {
+                    auto isAnchored = false;
+                    theLastLogTime = theLogTimeOffset + theClock.Next(theRecord.TimestampMs, isAnchored);
+                    isWritten = theWriter.Append(ToRow(theLastLogTime, theRecord)) && isWritten;
+                }
+                else if (ParseEpochLine(theLine.c_str(), theLine.size(), theEpoch))
+                {
+                    theClock.SetEpoch(theEpoch);
+                }
+            }
+        };
+
+        if (theInputs.empty())
+        {
+            ExportStream(std::cin);
+        }
+
+        for (const auto & theInput : theInputs)
+        {
+            if (IsHistoryFile(theInput))
+            {
+                DHT11HistoryReader theReader;
+                std::string theError;
+
+                if (!theReader.Open(theInput, theError))
+                {
+                    fprintf(stderr, "Error! \"%s\": %s\n", theInput.c_str(), theError.c_str());
+                    return EXIT_FAILURE;
+                }
+
+                theReader.ForEach(0, theReader.GetRecordCount(),
+                    [&](const uint64_t & theLogTime, const TraceRecord_t & theRecord)
+                    {
+                        theLastLogTime = theLogTimeOffset + theLogTime;
+                        isWritten = theWriter.Append(ToRow(theLastLogTime, theRecord)) && isWritten;
+                    });
+            }
+            else
+            {
+                std::ifstream theFile(theInput);
+                if (!theFile)
+                {
+                    fprintf(stderr, "Error! Unable to open \"%s\"\n", theInput.c_str());
+                    return EXIT_FAILURE;
+                }
+                ExportStream(theFile);
+            }
+
+            theLogTimeOffset = theLastLogTime + 1;
+        }
+
+        const auto theRows = theWriter.GetRowCount();
+        if (!theWriter.Close() || !isWritten)
+        {
+            fprintf(stderr, "Error! Writing \"%s\" failed\n", theOutput.c_str());
+            return EXIT_FAILURE;
+        }
+
+        fprintf(stderr, "Exported %llu rows into \"%s\"\n", static_cast<unsigned long long>(theRows), theOutput.c_str());
+        return EXIT_SUCCESS;
+    }
+
+    int Stats(const std::string & thePath, const Options_t & theOptions)
+    {
+        const auto theStart = std::chrono::steady_clock::now();
+        DHT11ColumnarReader theReader;
+        std::string theError;
+
+        if (!theReader.Open(thePath, theError))
+        {
+            fprintf(stderr, "Error! \"%s\": %s\n", thePath.c_str(), theError.c_str());
+            return EXIT_FAILURE;
+        }
+
+        std::map<uint16_t, ColumnStats_t> theStats; // All sensors under key 0 unless --by-sensor.
+        std::vector<int64_t> theTimes;
+        std::vector<int32_t> theValues, theStatuses, theSensors;
+        uint64_t theBytes = 0;
+        uint64_t theRows = 0;
+        std::size_t theSkipped = 0;
+        const auto & theRowGroups = theReader.GetRowGroups();
+
+        for (std::size_t g = 0; g < theRowGroups.size(); ++g)
+        {
+            const auto & theGroup = theRowGroups[g];
+            const auto & theTime = theGroup[Column_t::LOG_TIME];
+
+            if ((static_cast<uint64_t>(theTime.Maximum) < theOptions.FromMs)
+             || (static_cast<uint64_t>(theTime.Minimum) >= theOptions.ToMs))
+            {
+                ++theSkipped;
+                continue;
+            }
+
+            const auto isPartial = (static_cast<uint64_t>(theTime.Minimum) < theOptions.FromMs)
+                                || (static_cast<uint64_t>(theTime.Maximum) >= theOptions.ToMs);
+            const auto hasErrors = (theGroup.ValidRows != theGroup.Rows);
+
+            theValues.resize(theGroup.Rows);
+            auto isDecoded = theReader.DecodeColumn(g, theOptions.Column, theValues.data());
+            theBytes += theGroup[theOptions.Column].Size;
+
+            if (isPartial)
+            {
+                theTimes.resize(theGroup.Rows);
+                isDecoded = isDecoded && theReader.DecodeColumn(g, Column_t::LOG_TIME, theTimes.data());
+                theBytes += theTime.Size;
+            }
+            if (hasErrors)
+            {
+                theStatuses.resize(theGroup.Rows);
+                isDecoded = isDecoded && theReader.DecodeColumn(g, Column_t::STATUS, theStatuses.data());
+                theBytes += theGroup[Column_t::STATUS].Size;
+            }
+            if (theOptions.BySensor)
+            {
+                theSensors.resize(theGroup.Rows);
+                isDecoded = isDecoded && theReader.DecodeColumn(g, Column_t::SENSOR, theSensors.data());
+                theBytes += theGroup[Column_t::SENSOR].Size;
+            }
+
+            if (!isDecoded)
+            {
+                fprintf(stderr, "Error! \"%s\": row group %zu is corrupt\n", thePath.c_str(), g);
+                return EXIT_FAILURE;
+            }
+
+            for (std::size_t i = 0; i < theGroup.Rows; ++i)
+            {
+                if (isPartial && ((static_cast<uint64_t>(theTimes[i]) < theOptions.FromMs)
+                               || (static_cast<uint64_t>(theTimes[i]) >= theOptions.ToMs)))
+                {
+                    continue;
+                }
+
+                auto & theSensorStats = theStats[theOptions.BySensor ? static_cast<uint16_t>(theSensors[i]) : 0];
+                ++theSensorStats.Reads;
+                ++theRows;
+
+                if (hasErrors && (theStatuses[i] != ToUnderlyingType(SensorStatus_t::SUCCESS)))
+                {
+                    ++theSensorStats.Errors;
+                    continue;
+                }
+
+                theSensorStats.Minimum = std::min<int64_t>(theSensorStats.Minimum, theValues[i]);
+                theSensorStats.Maximum = std::max<int64_t>(theSensorStats.Maximum, theValues[i]);
+                theSensorStats.Sum += theValues[i];
+            }
+        }
+
+        const auto theSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - theStart).count();
+        const auto pTheColumn = (theOptions.Column == Column_t::HUMIDITY) ? "humidity" : "temperature";
+
+        if (!theOptions.Json)
+        {
+            printf("%scolumn,reads,errors,min,max,mean\n", theOptions.BySensor ? "sensor," : "");
+        }
+        else
+        {
+            printf("{\n  \"column\": \"%s\",\n  \"stats\": [\n", pTheColumn);
+        }
+
+        std::size_t theIndex = 0;
+        for (const auto & [theSensor, theSensorStats] : theStats)
+        {
+            const auto theGood = theSensorStats.Reads - theSensorStats.Errors;
+            const auto theMinimum = theGood ? (theSensorStats.Minimum / 10.0) : 0.0;
+            const auto theMaximum = theGood ? (theSensorStats.Maximum / 10.0) : 0.0;
+            const auto theMean = theGood ? (static_cast<double>(theSensorStats.Sum) / theGood / 10.0) : 0.0;
+
+            if (!theOptions.Json)
+            {
+                if (theOptions.BySensor)
+                {
+                    printf("%u,", theSensor);
+                }
+                printf("%s,%llu,%llu,%.1f,%.1f,%.2f\n", pTheColumn,
+                       static_cast<unsigned long long>(theSensorStats.Reads), static_cast<unsigned long long>(theSensorStats.Errors),
+                       theMinimum, theMaximum, theMean);
+            }
+            else
+            {
+                printf("    {");
+                if (theOptions.BySensor)
+                {
+                    printf("\"sensor\": %u, ", theSensor);
+                }
+                printf("\"reads\": %llu, \"errors\": %llu, \"min\": %.1f, \"max\": %.1f, \"mean\": %.2f}%s\n",
+                       static_cast<unsigned long long>(theSensorStats.Reads), static_cast<unsigned long long>(theSensorStats.Errors),
+                       theMinimum, theMaximum, theMean, (++theIndex < theStats.size()) ? "," : "");
+            }
+        }
+
+        if (theOptions.Json)
+        {
+            printf("  ]\n}\n");
+        }
+
+        fprintf(stderr, "%llu rows in %.3fs; %zu of %zu row groups skipped; %llu of %zu bytes decoded\n",
+                static_cast<unsigned long long>(theRows), theSeconds, theSkipped, theRowGroups.size(),
+                static_cast<unsigned long long>(theBytes), theReader.GetFileSize());
+
+        return EXIT_SUCCESS;
+    }
+
+    int Dump(const std::string & thePath, const Options_t & theOptions)
+    {
+        DHT11ColumnarReader theReader;
+        std::string theError;
+
+        if (!theReader.Open(thePath, theError))
+        {
+            fprintf(stderr, "Error! \"%s\": %s\n", thePath.c_str(), theError.c_str());
+            return EXIT_FAILURE;
+        }
+
+        std::vector<int64_t> theTimes;
+        std::vector<int32_t> theSensors, theTemperatures, theHumidities, theStatuses;
+        const auto & theRowGroups = theReader.GetRowGroups();
+        auto isFirst = true;
+
+        printf(theOptions.Json ? "[\n" : "log_time_ms,sensor,status,temperature,humidity\n");
+
+        for (std::size_t g = 0; g < theRowGroups.size(); ++g)
+        {
+            const auto theRows = theRowGroups[g].Rows;
+            theTimes.resize(theRows);
+            theSensors.resize(theRows);
+            theTemperatures.resize(theRows);
+            theHumidities.resize(theRows);
+            theStatuses.resize(theRows);
+
+            if (!theReader.DecodeColumn(g, Column_t::LOG_TIME, theTimes.data())
+             || !theReader.DecodeColumn(g, Column_t::SENSOR, theSensors.data())
+             || !theReader.DecodeColumn(g, Column_t::TEMPERATURE, theTemperatures.data())
+             || !theReader.DecodeColumn(g, Column_t::HUMIDITY, theHumidities.data())
+             || !theReader.DecodeColumn(g, Column_t::STATUS, theStatuses.data()))
+            {
+                fprintf(stderr, "Error! \"%s\": row group %zu is corrupt\n", thePath.c_str(), g);
+                return EXIT_FAILURE;
+            }
+
+            for (std::size_t i = 0; i < theRows; ++i)
+            {
+                const auto theLogTime = static_cast<uint64_t>(theTimes[i]);
+                if ((theLogTime < theOptions.FromMs) || (theLogTime >= theOptions.ToMs))
+                {
+                    continue;
+                }
+
+                const auto isGood = (theStatuses[i] == ToUnderlyingType(SensorStatus_t::SUCCESS));
+                if (!theOptions.Json)
+                {
+                    if (isGood)
+                    {
+                        printf("%llu,%d,%d,%.1f,%.1f\n", static_cast<unsigned long long>(theLogTime), theSensors[i],
+                               theStatuses[i], theTemperatures[i] / 10.0, theHumidities[i] / 10.0);
+                    }
+                    else
+                    {
+                        printf("%llu,%d,%d,,\n", static_cast<unsigned long long>(theLogTime), theSensors[i], theStatuses[i]);
+                    }
+                }
+                else
+                {
+                    printf("%s  {\"log_time_ms\": %llu, \"sensor\": %d, \"status\": %d", isFirst ? "" : ",\n",
+                           static_cast<unsigned long long>(theLogTime), theSensors[i], theStatuses[i]);
+                    if (isGood)
+                    {
+                        printf(", \"temperature\": %.1f, \"humidity\": %.1f", theTemperatures[i] / 10.0, theHumidities[i] / 10.0);
+                    }
+                    printf("}");
+                }
+                isFirst = false;
+            }
+        }
+
+        if (theOptions.Json)
+        {
+            printf("%s]\n", isFirst ? "" : "\n");
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    void PrintUsage(const char * theProgram)
+    {
+        fprintf(stderr, "Usage: %s export [--row-group N] OUT [INPUT...]\n"
+                        "       %s stats [--column temperature|humidity] [--by-sensor] [--from-ms N] [--to-ms N] [--format csv|json] FILE\n"
+                        "       %s dump [--from-ms N] [--to-ms N] [--format csv|json] FILE\n",
+                        theProgram, theProgram, theProgram);
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc < 3)
+    {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const std::string theCommand(argv[1]);
+    Options_t theOptions;
+    std::vector<std::string> theArguments;
+
+    for (int i = 2; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+
+        if (!strcmp(argv[i], "--format") && hasValue)
+        {
+            theOptions.Json = !strcmp(argv[++i], "json");
+        }
+        else if (!strcmp(argv[i], "--column") && hasValue)
+        {
+            theOptions.Column = !strcmp(argv[++i], "humidity") ? Column_t::HUMIDITY : Column_t::TEMPERATURE;
+        }
+        else if (!strcmp(argv[i], "--by-sensor"))
+        {
+            theOptions.BySensor = true;
+        }
+        else if (!strcmp(argv[i], "--from-ms") && hasValue)
+        {
+            theOptions.FromMs = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (!strcmp(argv[i], "--to-ms") && hasValue)
+        {
+            theOptions.ToMs = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (!strcmp(argv[i], "--row-group") && hasValue)
+        {
+            theOptions.RowGroupSize = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (!strncmp(argv[i], "--", 2))
+        {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        else
+        {
+            theArguments.emplace_back(argv[i]);
+        }
+    }
+
+    if ((theCommand == "export") && !theArguments.empty())
+    {
+        return Export(theArguments.front(), std::vector<std::string>(theArguments.begin() + 1, theArguments.end()), theOptions);
+    }
+    if ((theCommand == "stats") && (theArguments.size() == 1))
+    {
+        return Stats(theArguments.front(), theOptions);
+    }
+    if ((theCommand == "dump") && (theArguments.size() == 1))
+    {
+        return Dump(theArguments.front(), theOptions);
+    }
+
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+}
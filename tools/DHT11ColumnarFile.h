@@ -0,0 +1,625 @@
+/***********************************************************************
+* @file      DHT11ColumnarFile.h
+*
+*    Host-side columnar file of decoded DHT11/DHT22 readings, for bulk
+*    analytics over long histories.
+*
+* @brief   Rows (log time, sensor, temperature, humidity, status) are cut
+*          into row groups, and each row group stores every column as its
+*          own contiguous chunk. A job that wants only temperature reads
+*          only the temperature chunks (plus status, to mask failed reads)
+*          and never touches the other bytes of the file. Every chunk is
+*          encoded to a fixed width per row group, so decoding is a flat
+*          loop the compiler vectorizes:
+*
+*            log time    - DELTA: successive differences from the minimum.
+*            sensor      - DICTIONARY: distinct pins, then one code per row.
+*            temperature - FRAME_OF_REFERENCE: offsets from the minimum.
+*            humidity    - FRAME_OF_REFERENCE.
+*            status      - DICTIONARY.
+*
+*          The footer keeps each chunk's minimum and maximum, so that
+*          readers skip whole row groups outside of a time range (or a
+*          value range) without decoding anything.
+*
+* @note    File layout (little-endian):
+*
+*            [0..3]   magic "DHTC"
+*            [4]      format version
+*            [5]      column count
+*            [6..7]   reserved
+*            [8..11]  row group count
+*            [12..15] reserved
+*            [16..23] row count
+*            [24..31] footer offset, in bytes from the start of the file
+*            [32..]   column chunks, row group by row group
+*            [footer] per row group: row count (4), valid row count (4),
+*                     then per column: offset (8), size (4), encoding (1),
+*                     width (1), reserved (2), minimum (8), maximum (8)
+*
+*          A DICTIONARY chunk starts with its entry count (4) and entries
+*          (4 each, ascending), followed by the codes. A DELTA chunk holds
+*          one difference per row, the first being zero.
+*
+*          Temperature and humidity are only meaningful for rows whose
+*          status is SUCCESS. Other rows store the chunk minimum, and are
+*          left out of the minimum and maximum (and the valid row count).
+*
+*          POSIX (mmap) only; nothing in here depends upon Mbed OS.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "DHT11HistoryFile.h"
+
+static constexpr char        COLUMNAR_FILE_MAGIC[]         = "DHTC";
+static constexpr uint8_t     COLUMNAR_FILE_VERSION         = 1;
+static constexpr std::size_t COLUMNAR_HEADER_SIZE_BYTES    = 32;
+static constexpr std::size_t COLUMNAR_CHUNK_META_BYTES     = 32;
+static constexpr uint32_t    COLUMNAR_DEFAULT_ROW_GROUP    = 65536;
+
+enum class Column_t : uint8_t
+{
+    LOG_TIME    = 0,
+    SENSOR      = 1,
+    TEMPERATURE = 2,
+    HUMIDITY    = 3,
+    STATUS      = 4
+};
+
+static constexpr std::size_t COLUMN_COUNT                  = 5;
+static constexpr std::size_t COLUMNAR_ROW_GROUP_META_BYTES = 8 + (COLUMN_COUNT * COLUMNAR_CHUNK_META_BYTES);
+
+enum class ColumnEncoding_t : uint8_t
+{
+    DELTA              = 1,
+    DICTIONARY         = 2,
+    FRAME_OF_REFERENCE = 3
+};
+
+struct ColumnarRow_t
+{
+    uint64_t       LogTimeMs;
+    uint16_t       SensorPin;
+    int16_t        TemperatureTenths;
+    uint16_t       HumidityTenths;
+    SensorStatus_t Status;
+};
+
+struct ColumnChunk_t
+{
+    uint64_t         Offset;
+    uint32_t         Size;
+    ColumnEncoding_t Encoding;
+    uint8_t          Width;
+    int64_t          Minimum;
+    int64_t          Maximum;
+};
+
+struct RowGroup_t
+{
+    uint32_t                                Rows;
+    uint32_t                                ValidRows;
+    std::array<ColumnChunk_t, COLUMN_COUNT> Chunks;
+
+    const ColumnChunk_t & operator[](const Column_t & theColumn) const
+    {
+        return Chunks[static_cast<std::size_t>(theColumn)];
+    }
+};
+
+namespace ColumnarDetail
+{
+    // Narrowest of 1, 2, 4 or 8 bytes that holds theRange.
+    inline uint8_t WidthOf(const uint64_t & theRange)
+    {
+        return (theRange <= UINT8_MAX) ? 1 : (theRange <= UINT16_MAX) ? 2 : (theRange <= UINT32_MAX) ? 4 : 8;
+    }
+
+    inline void AppendLittleEndian(std::vector<uint8_t> & theBytes, const uint64_t & theValue, const std::size_t & theWidth)
+    {
+        const auto theSize = theBytes.size();
+        theBytes.resize(theSize + theWidth);
+        HistoryDetail::WriteLittleEndian(&theBytes[theSize], theValue, theWidth);
+    }
+
+    // theValues[i] = theBase + (unsigned W-byte value i). One fixed width
+    // per call keeps the loop free of branches, for the vectorizer.
+    template <typename U, typename T>
+    inline void UnpackFixed(const uint8_t * theBytes, const std::size_t & theCount, const int64_t & theBase, T * theValues)
+    {
+        for (std::size_t i = 0; i < theCount; ++i)
+        {
+            U theOffset;
+            memcpy(&theOffset, theBytes + (i * sizeof(U)), sizeof(U));
+            theValues[i] = static_cast<T>(theBase + static_cast<int64_t>(theOffset));
+        }
+    }
+
+    template <typename T>
+    inline bool Unpack(const uint8_t * theBytes, const std::size_t & theCount, const uint8_t & theWidth,
+                       const int64_t & theBase, T * theValues)
+    {
+        switch (theWidth)
+        {
+            case 1: UnpackFixed<uint8_t>(theBytes, theCount, theBase, theValues);  return true;
+            case 2: UnpackFixed<uint16_t>(theBytes, theCount, theBase, theValues); return true;
+            case 4: UnpackFixed<uint32_t>(theBytes, theCount, theBase, theValues); return true;
+            case 8: UnpackFixed<uint64_t>(theBytes, theCount, theBase, theValues); return true;
+            default: return false;
+        }
+    }
+}
+
+class DHT11ColumnarWriter
+{
+public:
+    DHT11ColumnarWriter(const uint32_t & theRowGroupSize = COLUMNAR_DEFAULT_ROW_GROUP)
+        : m_pTheFile(nullptr)
+        , m_TheRowGroupSize(std::max<uint32_t>(theRowGroupSize, 1))
+        , m_TheOffset(COLUMNAR_HEADER_SIZE_BYTES)
+        , m_TheRowCount(0)
+        , m_TheLastLogTimeMs(0)
+        , m_IsWritten(true)
+    {
+        m_TheRows.reserve(m_TheRowGroupSize);
+    }
+
+    DHT11ColumnarWriter(const DHT11ColumnarWriter&) = delete;
+    DHT11ColumnarWriter& operator=(const DHT11ColumnarWriter&) = delete;
+
+    ~DHT11ColumnarWriter() { (void)Close(); }
+
+    bool Open(const std::string & thePath)
+    {
+        m_pTheFile = fopen(thePath.c_str(), "wb");
+        if (m_pTheFile == nullptr)
+        {
+            return false;
+        }
+
+        // Placeholder; Close() fills in the counts.
+        uint8_t theHeader[COLUMNAR_HEADER_SIZE_BYTES] = {};
+        m_IsWritten = (fwrite(theHeader, sizeof(theHeader), 1, m_pTheFile) == 1);
+        return m_IsWritten;
+    }
+
+    // Rows must arrive in non-decreasing log time.
+    bool Append(const ColumnarRow_t & theRow)
+    {
+        if ((m_TheRowCount != 0) && (theRow.LogTimeMs < m_TheLastLogTimeMs))
+        {
+            return false;
+        }
+
+        m_TheRows.push_back(theRow);
+        m_TheLastLogTimeMs = theRow.LogTimeMs;
+        ++m_TheRowCount;
+
+        if (m_TheRows.size() == m_TheRowGroupSize)
+        {
+            FlushRowGroup();
+        }
+        return m_IsWritten;
+    }
+
+    bool Close()
+    {
+        if (m_pTheFile == nullptr)
+        {
+            return true;
+        }
+
+        FlushRowGroup();
+
+        std::vector<uint8_t> theFooter;
+        for (const auto & theRowGroup : m_TheRowGroups)
+        {
+            ColumnarDetail::AppendLittleEndian(theFooter, theRowGroup.Rows, 4);
+            ColumnarDetail::AppendLittleEndian(theFooter, theRowGroup.ValidRows, 4);
+
+            for (const auto & theChunk : theRowGroup.Chunks)
+            {
+                ColumnarDetail::AppendLittleEndian(theFooter, theChunk.Offset, 8);
+                ColumnarDetail::AppendLittleEndian(theFooter, theChunk.Size, 4);
+                theFooter.push_back(static_cast<uint8_t>(theChunk.Encoding));
+                theFooter.push_back(theChunk.Width);
+                ColumnarDetail::AppendLittleEndian(theFooter, 0, 2);
+                ColumnarDetail::AppendLittleEndian(theFooter, static_cast<uint64_t>(theChunk.Minimum), 8);
+                ColumnarDetail::AppendLittleEndian(theFooter, static_cast<uint64_t>(theChunk.Maximum), 8);
+            }
+        }
+
+        uint8_t theHeader[COLUMNAR_HEADER_SIZE_BYTES] = {};
+        memcpy(theHeader, COLUMNAR_FILE_MAGIC, 4);
+        theHeader[4] = COLUMNAR_FILE_VERSION;
+        theHeader[5] = static_cast<uint8_t>(COLUMN_COUNT);
+        HistoryDetail::WriteLittleEndian(&theHeader[8], m_TheRowGroups.size(), 4);
+        HistoryDetail::WriteLittleEndian(&theHeader[16], m_TheRowCount, 8);
+        HistoryDetail::WriteLittleEndian(&theHeader[24], m_TheOffset, 8);
+
+        auto isWritten = m_IsWritten
+                      && (theFooter.empty() || (fwrite(theFooter.data(), theFooter.size(), 1, m_pTheFile) == 1))
+                      && (fseek(m_pTheFile, 0, SEEK_SET) == 0)
+                      && (fwrite(theHeader, sizeof(theHeader), 1, m_pTheFile) == 1);
+        isWritten = (fclose(m_pTheFile) == 0) && isWritten;
+        m_pTheFile = nullptr;
+
+        return isWritten;
+    }
+
+    uint64_t GetRowCount() const { return m_TheRowCount; }
+
+private:
+    template <typename Projection>
+    ColumnChunk_t EncodeFrameOfReference(const Projection & theProjection, const bool & isMasked)
+    {
+        ColumnChunk_t theChunk{m_TheOffset, 0, ColumnEncoding_t::FRAME_OF_REFERENCE, 1, 0, 0};
+        auto hasValue = false;
+
+        for (const auto & theRow : m_TheRows)
+        {
+            if (isMasked && (theRow.Status != SensorStatus_t::SUCCESS))
+            {
+                continue;
+            }
+
+            const int64_t theValue = theProjection(theRow);
+            theChunk.Minimum = hasValue ? std::min(theChunk.Minimum, theValue) : theValue;
+            theChunk.Maximum = hasValue ? std::max(theChunk.Maximum, theValue) : theValue;
+            hasValue = true;
+        }
+
+        theChunk.Width = ColumnarDetail::WidthOf(static_cast<uint64_t>(theChunk.Maximum - theChunk.Minimum));
+        m_TheChunkBytes.clear();
+
+        for (const auto & theRow : m_TheRows)
+        {
+            const auto isValid = !isMasked || (theRow.Status == SensorStatus_t::SUCCESS);
+            const auto theOffset = isValid ? static_cast<uint64_t>(theProjection(theRow) - theChunk.Minimum) : 0;
+            ColumnarDetail::AppendLittleEndian(m_TheChunkBytes, theOffset, theChunk.Width);
+        }
+
+        return WriteChunk(theChunk);
+    }
+
+    ColumnChunk_t EncodeDelta()
+    {
+        ColumnChunk_t theChunk{m_TheOffset, 0, ColumnEncoding_t::DELTA, 1,
+                               static_cast<int64_t>(m_TheRows.front().LogTimeMs),
+                               static_cast<int64_t>(m_TheRows.back().LogTimeMs)};
+        uint64_t theLargestDelta = 0;
+
+        for (std::size_t i = 1; i < m_TheRows.size(); ++i)
+        {
+            theLargestDelta = std::max(theLargestDelta, m_TheRows[i].LogTimeMs - m_TheRows[i - 1].LogTimeMs);
+        }
+
+        theChunk.Width = ColumnarDetail::WidthOf(theLargestDelta);
+        m_TheChunkBytes.clear();
+
+        for (std::size_t i = 0; i < m_TheRows.size(); ++i)
+        {
+            const auto theDelta = (i == 0) ? 0 : (m_TheRows[i].LogTimeMs - m_TheRows[i - 1].LogTimeMs);
+            ColumnarDetail::AppendLittleEndian(m_TheChunkBytes, theDelta, theChunk.Width);
+        }
+
+        return WriteChunk(theChunk);
+    }
+
+    template <typename Projection>
+    ColumnChunk_t EncodeDictionary(const Projection & theProjection)
+    {
+        std::vector<int32_t> theEntries;
+        for (const auto & theRow : m_TheRows)
+        {
+            theEntries.push_back(theProjection(theRow));
+        }
+        std::sort(theEntries.begin(), theEntries.end());
+        theEntries.erase(std::unique(theEntries.begin(), theEntries.end()), theEntries.end());
+
+        ColumnChunk_t theChunk{m_TheOffset, 0, ColumnEncoding_t::DICTIONARY,
+                               ColumnarDetail::WidthOf(theEntries.size() - 1),
+                               theEntries.front(), theEntries.back()};
+        m_TheChunkBytes.clear();
+
+        ColumnarDetail::AppendLittleEndian(m_TheChunkBytes, theEntries.size(), 4);
+        for (const auto & theEntry : theEntries)
+        {
+            ColumnarDetail::AppendLittleEndian(m_TheChunkBytes, static_cast<uint32_t>(theEntry), 4);
+        }
+
+        for (const auto & theRow : m_TheRows)
+        {
+            const auto theCode = std::lower_bound(theEntries.begin(), theEntries.end(), theProjection(theRow)) - theEntries.begin();
+            ColumnarDetail::AppendLittleEndian(m_TheChunkBytes, static_cast<uint64_t>(theCode), theChunk.Width);
+        }
+
+        return WriteChunk(theChunk);
+    }
+
+    ColumnChunk_t WriteChunk(ColumnChunk_t & theChunk)
+    {
+        theChunk.Size = static_cast<uint32_t>(m_TheChunkBytes.size());
+        m_IsWritten = m_IsWritten && (fwrite(m_TheChunkBytes.data(), m_TheChunkBytes.size(), 1, m_pTheFile) == 1);
+        m_TheOffset += m_TheChunkBytes.size();
+        return theChunk;
+    }
+
+    void FlushRowGroup()
+    {
+        if (m_TheRows.empty())
+        {
+            return;
+        }
+
+        RowGroup_t theRowGroup;
+        theRowGroup.Rows = static_cast<uint32_t>(m_TheRows.size());
+        theRowGroup.ValidRows = static_cast<uint32_t>(std::count_if(m_TheRows.begin(), m_TheRows.end(),
+                                    [](const ColumnarRow_t & theRow) { return (theRow.Status == SensorStatus_t::SUCCESS); }));
+
+        // In Column_t order.
+        theRowGroup.Chunks[0] = EncodeDelta();
+        theRowGroup.Chunks[1] = EncodeDictionary([](const ColumnarRow_t & theRow) { return static_cast<int32_t>(theRow.SensorPin); });
+        theRowGroup.Chunks[2] = EncodeFrameOfReference([](const ColumnarRow_t & theRow) { return static_cast<int64_t>(theRow.TemperatureTenths); }, true);
+        theRowGroup.Chunks[3] = EncodeFrameOfReference([](const ColumnarRow_t & theRow) { return static_cast<int64_t>(theRow.HumidityTenths); }, true);
+        theRowGroup.Chunks[4] = EncodeDictionary([](const ColumnarRow_t & theRow) { return static_cast<int32_t>(ToUnderlyingType(theRow.Status)); });
+
+        m_TheRowGroups.push_back(theRowGroup);
+        m_TheRows.clear();
+    }
+
+    FILE *                     m_pTheFile;
+    uint32_t                   m_TheRowGroupSize;
+    uint64_t                   m_TheOffset;
+    uint64_t                   m_TheRowCount;
+    uint64_t                   m_TheLastLogTimeMs;
+    bool                       m_IsWritten;
+    std::vector<ColumnarRow_t> m_TheRows;
+    std::vector<uint8_t>       m_TheChunkBytes;
+    std::vector<RowGroup_t>    m_TheRowGroups;
+};
+
+class DHT11ColumnarReader
+{
+public:
+    DHT11ColumnarReader()
+        : m_pTheMapping(nullptr)
+        , m_TheMappingSize(0)
+        , m_TheRowCount(0)
+    {
+    }
+
+    DHT11ColumnarReader(const DHT11ColumnarReader&) = delete;
+    DHT11ColumnarReader& operator=(const DHT11ColumnarReader&) = delete;
+
+    ~DHT11ColumnarReader() { Close(); }
+
+    // Maps the file read-only and loads the footer. On failure, theError
+    // says why.
+    bool Open(const std::string & thePath, std::string & theError)
+    {
+        Close();
+
+        auto theDescriptor = open(thePath.c_str(), O_RDONLY);
+        if (theDescriptor < 0)
+        {
+            theError = "unable to open";
+            return false;
+        }
+
+        struct stat theStatus;
+        if ((fstat(theDescriptor, &theStatus) != 0) || (static_cast<std::size_t>(theStatus.st_size) < COLUMNAR_HEADER_SIZE_BYTES))
+        {
+            close(theDescriptor);
+            theError = "too short to be a columnar file";
+            return false;
+        }
+
+        m_TheMappingSize = static_cast<std::size_t>(theStatus.st_size);
+        auto pTheMapping = mmap(nullptr, m_TheMappingSize, PROT_READ, MAP_PRIVATE, theDescriptor, 0);
+        close(theDescriptor); // The mapping holds its own reference.
+
+        if (pTheMapping == MAP_FAILED)
+        {
+            theError = "unable to map";
+            return false;
+        }
+        m_pTheMapping = static_cast<const uint8_t *>(pTheMapping);
+
+        // Column reads jump from chunk to chunk; read-ahead would mostly
+        // fetch the columns that were not asked for.
+        (void)madvise(pTheMapping, m_TheMappingSize, MADV_RANDOM);
+
+        const auto theRowGroupCount = HistoryDetail::ReadLittleEndian(&m_pTheMapping[8], 4);
+        const auto theFooterOffset = HistoryDetail::ReadLittleEndian(&m_pTheMapping[24], 8);
+        m_TheRowCount = HistoryDetail::ReadLittleEndian(&m_pTheMapping[16], 8);
+
+        if ((memcmp(m_pTheMapping, COLUMNAR_FILE_MAGIC, 4) != 0)
+         || (m_pTheMapping[4] != COLUMNAR_FILE_VERSION)
+         || (m_pTheMapping[5] != COLUMN_COUNT)
+         || (theFooterOffset < COLUMNAR_HEADER_SIZE_BYTES)
+         || (theFooterOffset > m_TheMappingSize)
+         || (theRowGroupCount > ((m_TheMappingSize - theFooterOffset) / COLUMNAR_ROW_GROUP_META_BYTES)))
+        {
+            Close();
+            theError = "not a columnar file, or truncated";
+            return false;
+        }
+
+        uint64_t theRows = 0;
+        auto pTheMeta = m_pTheMapping + theFooterOffset;
+
+        for (uint64_t g = 0; g < theRowGroupCount; ++g)
+        {
+            RowGroup_t theRowGroup;
+            theRowGroup.Rows = static_cast<uint32_t>(HistoryDetail::ReadLittleEndian(&pTheMeta[0], 4));
+            theRowGroup.ValidRows = static_cast<uint32_t>(HistoryDetail::ReadLittleEndian(&pTheMeta[4], 4));
+            pTheMeta += 8;
+
+            for (auto & theChunk : theRowGroup.Chunks)
+            {
+                theChunk.Offset = HistoryDetail::ReadLittleEndian(&pTheMeta[0], 8);
+                theChunk.Size = static_cast<uint32_t>(HistoryDetail::ReadLittleEndian(&pTheMeta[8], 4));
+                theChunk.Encoding = static_cast<ColumnEncoding_t>(pTheMeta[12]);
+                theChunk.Width = pTheMeta[13];
+                theChunk.Minimum = static_cast<int64_t>(HistoryDetail::ReadLittleEndian(&pTheMeta[16], 8));
+                theChunk.Maximum = static_cast<int64_t>(HistoryDetail::ReadLittleEndian(&pTheMeta[24], 8));
+                pTheMeta += COLUMNAR_CHUNK_META_BYTES;
+
+                if (!IsChunkSound(theChunk, theRowGroup.Rows, theFooterOffset))
+                {
+                    Close();
+                    theError = "corrupt column chunk";
+                    return false;
+                }
+            }
+
+            theRows += theRowGroup.Rows;
+            m_TheRowGroups.push_back(theRowGroup);
+        }
+
+        if (theRows != m_TheRowCount)
+        {
+            Close();
+            theError = "row counts disagree";
+            return false;
+        }
+
+        return true;
+    }
+
+    void Close()
+    {
+        if (m_pTheMapping != nullptr)
+        {
+            munmap(const_cast<uint8_t *>(m_pTheMapping), m_TheMappingSize);
+        }
+        m_pTheMapping = nullptr;
+        m_TheMappingSize = 0;
+        m_TheRowCount = 0;
+        m_TheRowGroups.clear();
+    }
+
+    uint64_t GetRowCount() const { return m_TheRowCount; }
+    std::size_t GetFileSize() const { return m_TheMappingSize; }
+    const std::vector<RowGroup_t> & GetRowGroups() const { return m_TheRowGroups; }
+
+    // Decodes one column of one row group into theValues, which must hold
+    // the row group's Rows values. Only that chunk's bytes are touched.
+    template <typename T>
+    bool DecodeColumn(const std::size_t & theRowGroup, const Column_t & theColumn, T * theValues) const
+    {
+        if (theRowGroup >= m_TheRowGroups.size())
+        {
+            return false;
+        }
+
+        const auto & theGroup = m_TheRowGroups[theRowGroup];
+        const auto & theChunk = theGroup[theColumn];
+        const auto pTheBytes = m_pTheMapping + theChunk.Offset;
+
+        switch (theChunk.Encoding)
+        {
+            case ColumnEncoding_t::FRAME_OF_REFERENCE:
+                return ColumnarDetail::Unpack(pTheBytes, theGroup.Rows, theChunk.Width, theChunk.Minimum, theValues);
+
+            case ColumnEncoding_t::DELTA:
+            {
+                if (!ColumnarDetail::Unpack(pTheBytes, theGroup.Rows, theChunk.Width, 0, theValues))
+                {
+                    return false;
+                }
+
+                // Prefix sum; the first delta is zero.
+                auto theValue = theChunk.Minimum;
+                for (std::size_t i = 0; i < theGroup.Rows; ++i)
+                {
+                    theValue += static_cast<int64_t>(theValues[i]);
+                    theValues[i] = static_cast<T>(theValue);
+                }
+                return true;
+            }
+
+            case ColumnEncoding_t::DICTIONARY:
+            {
+                const auto theEntryCount = HistoryDetail::ReadLittleEndian(pTheBytes, 4);
+                const auto pTheCodes = pTheBytes + 4 + (theEntryCount * 4);
+                std::vector<T> theEntries(theEntryCount);
+
+                for (std::size_t e = 0; e < theEntryCount; ++e)
+                {
+                    theEntries[e] = static_cast<T>(static_cast<int32_t>(HistoryDetail::ReadLittleEndian(pTheBytes + 4 + (e * 4), 4)));
+                }
+
+                if (!ColumnarDetail::Unpack(pTheCodes, theGroup.Rows, theChunk.Width, 0, theValues))
+                {
+                    return false;
+                }
+
+                // Codes are only checked here, so that opening a file does
+                // not read every dictionary chunk.
+                for (std::size_t i = 0; i < theGroup.Rows; ++i)
+                {
+                    const auto theCode = static_cast<uint64_t>(theValues[i]);
+                    if (theCode >= theEntryCount)
+                    {
+                        return false;
+                    }
+                    theValues[i] = theEntries[theCode];
+                }
+                return true;
+            }
+
+            default:
+                return false;
+        }
+    }
+
+private:
+    bool IsChunkSound(const ColumnChunk_t & theChunk, const uint32_t & theRows, const uint64_t & theFooterOffset) const
+    {
+        if ((theChunk.Offset < COLUMNAR_HEADER_SIZE_BYTES) || ((theChunk.Offset + theChunk.Size) > theFooterOffset)
+         || ((theChunk.Width != 1) && (theChunk.Width != 2) && (theChunk.Width != 4) && (theChunk.Width != 8)))
+        {
+            return false;
+        }
+
+        uint64_t theExpected = static_cast<uint64_t>(theRows) * theChunk.Width;
+        if (theChunk.Encoding == ColumnEncoding_t::DICTIONARY)
+        {
+            if (theChunk.Size < 4)
+            {
+                return false;
+            }
+
+            const auto theEntryCount = HistoryDetail::ReadLittleEndian(m_pTheMapping + theChunk.Offset, 4);
+            theExpected += 4 + (theEntryCount * 4);
+            return ((theEntryCount != 0) && (theExpected == theChunk.Size));
+        }
+
+        return (theExpected == theChunk.Size);
+    }
+
+    const uint8_t *         m_pTheMapping;
+    std::size_t             m_TheMappingSize;
+    uint64_t                m_TheRowCount;
+    std::vector<RowGroup_t> m_TheRowGroups;
+};
@@ -0,0 +1,292 @@
+/***********************************************************************
+* @file      DHT11GatewayBenchmark.cpp
+*
+*    Host-side benchmark of how the gateway ingestion engine (see
+*    DHT11GatewayEngine.h) scales with the number of worker threads.
+*
+* @brief   Synthesizes the traffic of a gateway fleet: --nodes MCU nodes
+*          with --sensors sensors each (DHT11 and DHT22 alternately), whose
+*          readings drift in a random walk. Frames are built with the
+*          simulator's EncodeDataFrame<T>() (DHT11Simulator.h), and about
+*          1% fail on the node, 0.5% arrive with a corrupt checksum and
+*          0.5% read outside the rated range. Nodes send --batch records
+*          at a time, interleaved as a gateway would receive them.
+*
+*          The same batches are then ingested with 1, 2, 4, ... worker
+*          threads, up to --threads. For each count it reports throughput,
+*          speedup and parallel efficiency against one thread, and the
+*          number of steals. Every run's aggregates must agree with the
+*          single-threaded run; a mismatch fails the run.
+*
+* @note    Build and run on the host, e.g.:
+*
+*            g++ -std=c++20 -O2 -I.. DHT11GatewayBenchmark.cpp -o DHT11GatewayBenchmark -lpthread
+*            ./DHT11GatewayBenchmark --nodes 500 --records 20000000 --format json
+*
+*          Batch generation and copying happen before the clock starts;
+*          the timed part is Submit() of every batch plus the final Drain().
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include "DHT11GatewayEngine.h"
+#include "DHT11Simulator.h"
+
+namespace
+{
+    struct Options_t
+    {
+        bool        Json = false;
+        uint32_t    Nodes = 256;
+        uint16_t    Sensors = 4;
+        std::size_t BatchRecords = 256;
+        uint64_t    Records = 10'000'000;
+        std::size_t Threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        unsigned    Seed = 1;
+    };
+
+    struct Batch_t
+    {
+        uint32_t             NodeId;
+        std::vector<uint8_t> Bytes;
+    };
+
+    struct Result_t
+    {
+        std::size_t Threads;
+        double      Seconds;
+        double      Speedup;
+        double      Efficiency;
+        uint64_t    Steals;
+        bool        IsConsistent;
+    };
+
+    std::vector<Batch_t> SynthesizeBatches(const Options_t & theOptions)
+    {
+        std::mt19937 theGenerator(theOptions.Seed);
+        std::uniform_int_distribution<int> theStep(-2, 2);
+        std::uniform_real_distribution<double> theFault(0.0, 1.0);
+        std::uniform_int_distribution<uint32_t> theNode(0, theOptions.Nodes - 1);
+
+        const auto theSensorCount = static_cast<std::size_t>(theOptions.Nodes) * theOptions.Sensors;
+        std::vector<int16_t> theTemperatures(theSensorCount, 220);
+        std::vector<int16_t> theHumidities(theSensorCount, 450);
+        std::vector<uint32_t> theClocksMs(theOptions.Nodes, 1000);
+        std::vector<Batch_t> theBatches;
+
+        for (uint64_t theRecords = 0; theRecords < theOptions.Records; )
+        {
+            const auto theNodeId = theNode(theGenerator);
+            const auto theCount = std::min<uint64_t>(theOptions.BatchRecords, theOptions.Records - theRecords);
+            Batch_t theBatch{theNodeId, std::vector<uint8_t>(theCount * TRACE_RECORD_SIZE_BYTES)};
+
+            for (uint64_t i = 0; i < theCount; ++i)
+            {
+                const auto theSensorPin = static_cast<uint16_t>(i % theOptions.Sensors);
+                const auto theSensor = (static_cast<std::size_t>(theNodeId) * theOptions.Sensors) + theSensorPin;
+                const auto isDHT22 = ((theSensorPin % 2) != 0);
+                auto & theTemperature = theTemperatures[theSensor];
+                auto & theHumidity = theHumidities[theSensor];
+
+                theTemperature = static_cast<int16_t>(std::clamp(theTemperature + theStep(theGenerator), 50, 450));
+                theHumidity = static_cast<int16_t>(std::clamp(theHumidity + theStep(theGenerator), 250, 850));
+                theClocksMs[theNodeId] += 2000 / theOptions.Sensors;
+
+                TraceRecord_t theRecord;
+                theRecord.TimestampMs = theClocksMs[theNodeId];
+                theRecord.SensorPin = theSensorPin;
+                theRecord.Model = isDHT22 ? SensorModel_t::DHT22 : SensorModel_t::DHT11;
+                theRecord.Status = SensorStatus_t::SUCCESS;
+
+                const auto theFaultDraw = theFault(theGenerator);
+                const auto isOutOfRange = (theFaultDraw < 0.005);
+                const auto theReported = !isOutOfRange ? theTemperature : static_cast<int16_t>(isDHT22 ? -600 : 600);
+                theRecord.Frame = isDHT22 ? EncodeDataFrame<DHT22_t>(theReported, static_cast<uint16_t>(theHumidity))
+                                          : EncodeDataFrame<DHT11_t>(theReported, static_cast<uint16_t>(theHumidity));
+                if (theFaultDraw >= 0.99)
+                {
+                    theRecord.Status = SensorStatus_t::ERROR_DATA_TIMEOUT;
+                }
+                else if (theFaultDraw >= 0.985)
+                {
+                    theRecord.Frame[4] ^= 0x01;
+                }
+
+                EncodeTraceRecord(theRecord, &theBatch.Bytes[i * TRACE_RECORD_SIZE_BYTES]);
+            }
+
+            theRecords += theCount;
+            theBatches.push_back(std::move(theBatch));
+        }
+
+        return theBatches;
+    }
+
+    std::vector<SensorAggregate_t> Ingest(const std::vector<Batch_t> & theBatches, const std::size_t & theThreads,
+                                          double & theSeconds, GatewayCounters_t & theCounters)
+    {
+        DHT11GatewayEngine theEngine(theThreads);
+        std::vector<Batch_t> theCopies(theBatches);
+        std::vector<SensorAggregate_t> theAggregates;
+
+        const auto theStart = std::chrono::steady_clock::now();
+        for (auto & theBatch : theCopies)
+        {
+            theEngine.Submit(theBatch.NodeId, std::move(theBatch.Bytes));
+        }
+        theEngine.Drain([&theAggregates](const SensorAggregate_t & theAggregate) { theAggregates.push_back(theAggregate); });
+        theSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - theStart).count();
+
+        theCounters = theEngine.GetCounters();
+        return theAggregates;
+    }
+
+    bool IsSame(const std::vector<SensorAggregate_t> & theLeft, const std::vector<SensorAggregate_t> & theRight)
+    {
+        return std::equal(theLeft.begin(), theLeft.end(), theRight.begin(), theRight.end(),
+            [](const SensorAggregate_t & l, const SensorAggregate_t & r)
+            {
+                return (l.NodeId == r.NodeId) && (l.SensorPin == r.SensorPin) && (l.Reads == r.Reads)
+                    && (l.Errors == r.Errors) && (l.Filtered == r.Filtered)
+                    && (l.MinimumTemperatureTenths == r.MinimumTemperatureTenths)
+                    && (l.MaximumTemperatureTenths == r.MaximumTemperatureTenths)
+                    && (l.TemperatureSum == r.TemperatureSum) && (l.HumiditySum == r.HumiditySum)
+                    && (l.MinimumHumidityTenths == r.MinimumHumidityTenths)
+                    && (l.MaximumHumidityTenths == r.MaximumHumidityTenths)
+                    && (l.LastTimestampMs == r.LastTimestampMs);
+            });
+    }
+
+    void PrintUsage(const char * theProgram)
+    {
+        fprintf(stderr, "Usage: %s [--format csv|json] [--nodes N] [--sensors N] [--batch N] [--records N] [--threads N] [--seed N]\n",
+                theProgram);
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    Options_t theOptions;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+
+        if (!strcmp(argv[i], "--format") && hasValue)
+        {
+            theOptions.Json = !strcmp(argv[++i], "json");
+        }
+        else if (!strcmp(argv[i], "--nodes") && hasValue)
+        {
+            theOptions.Nodes = std::max(1u, static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10)));
+        }
+        else if (!strcmp(argv[i], "--sensors") && hasValue)
+        {
+            theOptions.Sensors = static_cast<uint16_t>(std::max(1ul, strtoul(argv[++i], nullptr, 10)));
+        }
+        else if (!strcmp(argv[i], "--batch") && hasValue)
+        {
+            theOptions.BatchRecords = std::max<std::size_t>(1, strtoull(argv[++i], nullptr, 10));
+        }
+        else if (!strcmp(argv[i], "--records") && hasValue)
+        {
+            theOptions.Records = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (!strcmp(argv[i], "--threads") && hasValue)
+        {
+            theOptions.Threads = std::max<std::size_t>(1, strtoull(argv[++i], nullptr, 10));
+        }
+        else if (!strcmp(argv[i], "--seed") && hasValue)
+        {
+            theOptions.Seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    const auto theBatches = SynthesizeBatches(theOptions);
+
+    std::vector<std::size_t> theThreadCounts;
+    for (std::size_t t = 1; t < theOptions.Threads; t *= 2)
+    {
+        theThreadCounts.push_back(t);
+    }
+    theThreadCounts.push_back(theOptions.Threads);
+
+    std::vector<Result_t> theResults;
+    std::vector<SensorAggregate_t> theBaseline;
+    GatewayCounters_t theCounters{};
+    double theBaselineSeconds = 0.0;
+
+    for (const auto & theThreads : theThreadCounts)
+    {
+        double theSeconds = 0.0;
+        const auto theAggregates = Ingest(theBatches, theThreads, theSeconds, theCounters);
+
+        if (theResults.empty())
+        {
+            theBaseline = theAggregates;
+            theBaselineSeconds = theSeconds;
+        }
+
+        const auto theSpeedup = theBaselineSeconds / theSeconds;
+        theResults.push_back({theThreads, theSeconds, theSpeedup, theSpeedup / theThreads,
+                              theCounters.Steals, IsSame(theAggregates, theBaseline)});
+    }
+
+    uint64_t theErrors = 0, theFiltered = 0;
+    for (const auto & theAggregate : theBaseline)
+    {
+        theErrors += theAggregate.Errors;
+        theFiltered += theAggregate.Filtered;
+    }
+
+    if (!theOptions.Json)
+    {
+        printf("threads,seconds,mrecords_per_s,speedup,efficiency,steals,consistent\n");
+        for (const auto & r : theResults)
+        {
+            printf("%zu,%.3f,%.1f,%.2f,%.2f,%llu,%s\n", r.Threads, r.Seconds, theOptions.Records / r.Seconds / 1e6,
+                   r.Speedup, r.Efficiency, static_cast<unsigned long long>(r.Steals), r.IsConsistent ? "yes" : "no");
+        }
+    }
+    else
+    {
+        printf("{\n  \"records\": %llu,\n  \"batches\": %zu,\n  \"sensors\": %zu,\n  \"errors\": %llu,\n  \"filtered\": %llu,\n  \"results\": [\n",
+               static_cast<unsigned long long>(theOptions.Records), theBatches.size(), theBaseline.size(),
+               static_cast<unsigned long long>(theErrors), static_cast<unsigned long long>(theFiltered));
+        for (std::size_t i = 0; i < theResults.size(); ++i)
+        {
+            const auto & r = theResults[i];
+            printf("    {\"threads\": %zu, \"seconds\": %.3f, \"mrecords_per_s\": %.1f, \"speedup\": %.2f, "
+                   "\"efficiency\": %.2f, \"steals\": %llu, \"consistent\": %s}%s\n",
+                   r.Threads, r.Seconds, theOptions.Records / r.Seconds / 1e6, r.Speedup, r.Efficiency,
+                   static_cast<unsigned long long>(r.Steals), r.IsConsistent ? "true" : "false",
+                   (i + 1 < theResults.size()) ? "," : "");
+        }
+        printf("  ]\n}\n");
+    }
+
+    const auto isConsistent = std::all_of(theResults.begin(), theResults.end(), [](const Result_t & r) { return r.IsConsistent; });
+    if (!isConsistent)
+    {
+        fprintf(stderr, "Error! Aggregates differ between thread counts\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
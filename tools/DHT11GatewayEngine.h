@@ -0,0 +1,290 @@
+/***********************************************************************
+* @file      DHT11GatewayEngine.h
+*
+*    Host-side ingestion engine for gateways that collect raw frame
+*    streams from many MCU nodes.
+*
+* @brief   Nodes send their readings as binary trace records
+*          (NuerteyDHT11Trace.h): the raw 5-byte frame, the status of the
+*          read, the sensor pin and a timestamp, 13 bytes apiece. The
+*          gateway hands each batch of records it receives to Submit(),
+*          and a work-stealing pool (DHT11WorkStealingPool.h) takes it
+*          from there:
+*
+*            decode    - DecodeTraceRecord(); bytes that do not form a
+*                        record are counted as malformed.
+*            validate  - the node's own status, then IsChecksumValid() and
+*                        DecodeTemperatureTenths<T>()/DecodeHumidityTenths<T>(),
+*                        exactly as NuerteyDHT11Device decodes.
+*            filter    - by default, readings outside the sensor's rated
+*                        range; SetFilter() substitutes any predicate.
+*            aggregate - per (node, sensor): reads, errors, filtered, and
+*                        minimum/maximum/sum of temperature and humidity.
+*
+*          Each worker aggregates into a table of its own, so the hot path
+*          shares nothing between cores. Drain() waits for the batches in
+*          flight, merges the tables and hands every sensor's aggregate to
+*          the sink, then starts afresh.
+*
+* @note    SetFilter() and SetReadingSink() must be called before the first
+*          Submit(). The reading sink, if set, sees each batch's accepted
+*          readings on the worker that decoded them, concurrently with the
+*          other workers; it must be thread-safe.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include "NuerteyDHT11Trace.h"
+#include "DHT11WorkStealingPool.h"
+
+struct GatewayReading_t
+{
+    uint32_t      NodeId;
+    uint32_t      TimestampMs;
+    uint16_t      SensorPin;
+    SensorModel_t Model;
+    int16_t       TemperatureTenths;
+    uint16_t      HumidityTenths;
+};
+
+struct SensorAggregate_t
+{
+    uint32_t      NodeId = 0;
+    uint16_t      SensorPin = 0;
+    SensorModel_t Model = SensorModel_t::DHT11;
+    uint64_t      Reads = 0;       // Every record, whatever became of it.
+    uint64_t      Errors = 0;      // Failed on the node, or checksum here.
+    uint64_t      Filtered = 0;    // Valid, but rejected by the filter.
+    int16_t       MinimumTemperatureTenths = INT16_MAX;
+    int16_t       MaximumTemperatureTenths = INT16_MIN;
+    int64_t       TemperatureSum = 0;
+    uint16_t      MinimumHumidityTenths = UINT16_MAX;
+    uint16_t      MaximumHumidityTenths = 0;
+    int64_t       HumiditySum = 0;
+    uint32_t      LastTimestampMs = 0;
+
+    uint64_t GetAccepted() const { return (Reads - Errors - Filtered); }
+
+    void Merge(const SensorAggregate_t & theOther)
+    {
+        Model = theOther.Model;
+        Reads += theOther.Reads;
+        Errors += theOther.Errors;
+        Filtered += theOther.Filtered;
+        MinimumTemperatureTenths = std::min(MinimumTemperatureTenths, theOther.MinimumTemperatureTenths);
+        MaximumTemperatureTenths = std::max(MaximumTemperatureTenths, theOther.MaximumTemperatureTenths);
+        TemperatureSum += theOther.TemperatureSum;
+        MinimumHumidityTenths = std::min(MinimumHumidityTenths, theOther.MinimumHumidityTenths);
+        MaximumHumidityTenths = std::max(MaximumHumidityTenths, theOther.MaximumHumidityTenths);
+        HumiditySum += theOther.HumiditySum;
+        LastTimestampMs = std::max(LastTimestampMs, theOther.LastTimestampMs);
+    }
+};
+
+struct GatewayCounters_t
+{
+    uint64_t Batches;
+    uint64_t Records;
+    uint64_t MalformedBytes;
+    uint64_t Steals;
+};
+
+// Rated ranges per the datasheets: DHT11 0..50°C and 20..90% RH, DHT22
+// -40..80°C and 0..100% RH.
+inline bool IsReadingInRatedRange(const GatewayReading_t & theReading)
+{
+    if (theReading.Model == SensorModel_t::DHT22)
+    {
+        return (theReading.TemperatureTenths >= -400) && (theReading.TemperatureTenths <= 800)
+            && (theReading.HumidityTenths <= 1000);
+    }
+
+    return (theReading.TemperatureTenths >= 0) && (theReading.TemperatureTenths <= 500)
+        && (theReading.HumidityTenths >= 200) && (theReading.HumidityTenths <= 900);
+}
+
+class DHT11GatewayEngine
+{
+public:
+    using Filter_t        = std::function<bool(const GatewayReading_t &)>;
+    using ReadingSink_t   = std::function<void(const GatewayReading_t *, const std::size_t &)>;
+    using AggregateSink_t = std::function<void(const SensorAggregate_t &)>;
+
+    // Zero threads means one per hardware thread.
+    explicit DHT11GatewayEngine(const std::size_t & theThreads = 0)
+        : m_TheFilter(IsReadingInRatedRange)
+        , m_ThePool(theThreads)
+        , m_TheTables(m_ThePool.GetWorkerCount())
+        , m_TheBatches(0)
+        , m_TheRecords(0)
+        , m_TheMalformedBytes(0)
+    {
+    }
+
+    DHT11GatewayEngine(const DHT11GatewayEngine&) = delete;
+    DHT11GatewayEngine& operator=(const DHT11GatewayEngine&) = delete;
+
+    // The pool outlives the tables its tasks write to; let them finish.
+    virtual ~DHT11GatewayEngine() { m_ThePool.Wait(); }
+
+    void SetFilter(Filter_t && theFilter)            { m_TheFilter = std::move(theFilter); }
+    void SetReadingSink(ReadingSink_t && theSink)    { m_TheReadingSink = std::move(theSink); }
+
+    // theBytes holds whole trace records from node theNodeId, back to back.
+    void Submit(const uint32_t & theNodeId, std::vector<uint8_t> && theBytes)
+    {
+        auto pTheBytes = std::make_shared<std::vector<uint8_t>>(std::move(theBytes));
+        m_ThePool.Submit([this, theNodeId, pTheBytes](const std::size_t & theWorker)
+        {
+            Process(theWorker, theNodeId, *pTheBytes);
+        });
+    }
+
+    // Waits for every batch submitted so far, then passes each sensor's
+    // aggregate to theSink in (node, sensor) order and resets them.
+    // Must not be called concurrently with Submit().
+    void Drain(const AggregateSink_t & theSink)
+    {
+        m_ThePool.Wait();
+
+        std::map<uint64_t, SensorAggregate_t> theMerged;
+        for (auto & theTable : m_TheTables)
+        {
+            for (const auto & [theKey, theAggregate] : theTable.Sensors)
+            {
+                auto theResult = theMerged.try_emplace(theKey, theAggregate);
+                if (!theResult.second)
+                {
+                    theResult.first->second.Merge(theAggregate);
+                }
+            }
+            theTable.Sensors.clear();
+        }
+
+        for (const auto & [theKey, theAggregate] : theMerged)
+        {
+            theSink(theAggregate);
+        }
+    }
+
+    GatewayCounters_t GetCounters() const
+    {
+        return GatewayCounters_t{m_TheBatches.load(std::memory_order_relaxed),
+                                 m_TheRecords.load(std::memory_order_relaxed),
+                                 m_TheMalformedBytes.load(std::memory_order_relaxed),
+                                 m_ThePool.GetStealCount()};
+    }
+
+    std::size_t GetWorkerCount() const { return m_ThePool.GetWorkerCount(); }
+
+private:
+    // One per worker, padded apart so that workers never share a line.
+    struct alignas(64) WorkerTable_t
+    {
+        std::unordered_map<uint64_t, SensorAggregate_t> Sensors;
+        std::vector<GatewayReading_t>                   Accepted;
+    };
+
+    void Process(const std::size_t & theWorker, const uint32_t & theNodeId, const std::vector<uint8_t> & theBytes)
+    {
+        auto & theTable = m_TheTables[theWorker];
+        const auto theRecordCount = theBytes.size() / TRACE_RECORD_SIZE_BYTES;
+        uint64_t theMalformedBytes = theBytes.size() % TRACE_RECORD_SIZE_BYTES;
+
+        // Consecutive records nearly always come from the same sensor;
+        // skip the hash lookup when they do.
+        SensorAggregate_t * pTheAggregate = nullptr;
+        uint16_t theSensorPin = 0;
+        TraceRecord_t theRecord;
+
+        theTable.Accepted.clear();
+
+        for (std::size_t i = 0; i < theRecordCount; ++i)
+        {
+            if (!DecodeTraceRecord(&theBytes[i * TRACE_RECORD_SIZE_BYTES], TRACE_RECORD_SIZE_BYTES, theRecord))
+            {
+                theMalformedBytes += TRACE_RECORD_SIZE_BYTES;
+                continue;
+            }
+
+            if ((pTheAggregate == nullptr) || (theRecord.SensorPin != theSensorPin))
+            {
+                const auto theKey = (static_cast<uint64_t>(theNodeId) << 16) | theRecord.SensorPin;
+                pTheAggregate = &theTable.Sensors[theKey];
+                pTheAggregate->NodeId = theNodeId;
+                pTheAggregate->SensorPin = theRecord.SensorPin;
+                theSensorPin = theRecord.SensorPin;
+            }
+
+            auto & theAggregate = *pTheAggregate;
+            theAggregate.Model = theRecord.Model;
+            theAggregate.LastTimestampMs = std::max(theAggregate.LastTimestampMs, theRecord.TimestampMs);
+            ++theAggregate.Reads;
+
+            if ((theRecord.Status != SensorStatus_t::SUCCESS) || !IsChecksumValid(theRecord.Frame))
+            {
+                ++theAggregate.Errors;
+                continue;
+            }
+
+            const auto isDHT22 = (theRecord.Model == SensorModel_t::DHT22);
+            const GatewayReading_t theReading{theNodeId, theRecord.TimestampMs, theRecord.SensorPin, theRecord.Model,
+                                              isDHT22 ? DecodeTemperatureTenths<DHT22_t>(theRecord.Frame)
+                                                      : DecodeTemperatureTenths<DHT11_t>(theRecord.Frame),
+                                              isDHT22 ? DecodeHumidityTenths<DHT22_t>(theRecord.Frame)
+                                                      : DecodeHumidityTenths<DHT11_t>(theRecord.Frame)};
+
+            if (m_TheFilter && !m_TheFilter(theReading))
+            {
+                ++theAggregate.Filtered;
+                continue;
+            }
+
+            theAggregate.MinimumTemperatureTenths = std::min(theAggregate.MinimumTemperatureTenths, theReading.TemperatureTenths);
+            theAggregate.MaximumTemperatureTenths = std::max(theAggregate.MaximumTemperatureTenths, theReading.TemperatureTenths);
+            theAggregate.TemperatureSum += theReading.TemperatureTenths;
+            theAggregate.MinimumHumidityTenths = std::min(theAggregate.MinimumHumidityTenths, theReading.HumidityTenths);
+            theAggregate.MaximumHumidityTenths = std::max(theAggregate.MaximumHumidityTenths, theReading.HumidityTenths);
+            theAggregate.HumiditySum += theReading.HumidityTenths;
+
+            if (m_TheReadingSink)
+            {
+                theTable.Accepted.push_back(theReading);
+            }
+        }
+
+        if (m_TheReadingSink && !theTable.Accepted.empty())
+        {
+            m_TheReadingSink(theTable.Accepted.data(), theTable.Accepted.size());
+        }
+
+        m_TheBatches.fetch_add(1, std::memory_order_relaxed);
+        m_TheRecords.fetch_add(theRecordCount, std::memory_order_relaxed);
+        if (theMalformedBytes != 0)
+        {
+            m_TheMalformedBytes.fetch_add(theMalformedBytes, std::memory_order_relaxed);
+        }
+    }
+
+    Filter_t                   m_TheFilter;
+    ReadingSink_t              m_TheReadingSink;
+    DHT11WorkStealingPool      m_ThePool;
+    std::vector<WorkerTable_t> m_TheTables;
+    std::atomic<uint64_t>      m_TheBatches;
+    std::atomic<uint64_t>      m_TheRecords;
+    std::atomic<uint64_t>      m_TheMalformedBytes;
+};
@@ -0,0 +1,552 @@
+/***********************************************************************
+* @file      DHT11HistoryFile.h
+*
+*    Host-side binary history file of DHT11/DHT22 trace records, with a
+*    time index, and a memory-mapped reader for it.
+*
+* @brief   Captured "#D" trace lines (NuerteyDHT11Trace.h) are compact on
+*          the wire but still text, and have to be parsed line by line.
+*          Packing their 13-byte records back to back into one file per
+*          node makes months of readings a flat array: the reader maps the
+*          file, decodes records in place on demand, and seeks by time via
+*          a sparse index, so range scans can be split across cores.
+*
+* @note    File layout (little-endian):
+*
+*            [0..3]   magic "DHTH"
+*            [4]      format version
+*            [5]      record size, TRACE_RECORD_SIZE_BYTES
+*            [6..7]   index stride, in records
+*            [8..15]  record count
+*            [16..23] index offset, in bytes from the start of the file
+*            [24..27] index entry count
+*            [28..31] anchor count (version 2; zero in version 1)
+*            [32..]   records, as EncodeTraceRecord(), in capture order
+*            [index]  one 64-bit log time per index stride of records
+*            [anchor] per anchor, a 64-bit record number and log time
+*
+*          Trace timestamps are milliseconds since boot, so they restart
+*          with every reboot (and wrap after 49.7 days). The log time of a
+*          record is its timestamp plus an offset that grows whenever the
+*          timestamp goes backwards, which keeps log time non-decreasing
+*          over the whole file. By how much it grows is known only when
+*          the "#E" epochs (NuerteyDHT11Trace.h) of both boots put them on
+*          the wall clock: log time then advances by the real downtime, and
+*          an anchor records the log time of the first record of the new
+*          boot. Otherwise, e.g. on a wrap or without an RTC, it advances by
+*          1 ms. The index holds the log time of every stride-th record;
+*          any other record's log time follows by replaying the same rules
+*          from the preceding index entry, anchors included.
+*
+*          POSIX (mmap) only; nothing in here depends upon Mbed OS.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "NuerteyDHT11Trace.h"
+
+static constexpr char        HISTORY_FILE_MAGIC[]        = "DHTH";
+static constexpr uint8_t     HISTORY_FILE_VERSION        = 2;
+static constexpr std::size_t HISTORY_HEADER_SIZE_BYTES   = 32;
+static constexpr uint16_t    HISTORY_DEFAULT_INDEX_STRIDE = 4096;
+
+namespace HistoryDetail
+{
+    inline uint64_t ReadLittleEndian(const uint8_t * theBytes, const std::size_t & theWidth)
+    {
+        uint64_t theValue = 0;
+        for (std::size_t i = 0; i < theWidth; ++i)
+        {
+            theValue |= (static_cast<uint64_t>(theBytes[i]) << (8 * i));
+        }
+        return theValue;
+    }
+
+    inline void WriteLittleEndian(uint8_t * theBytes, const uint64_t & theValue, const std::size_t & theWidth)
+    {
+        for (std::size_t i = 0; i < theWidth; ++i)
+        {
+            theBytes[i] = static_cast<uint8_t>((theValue >> (8 * i)) & 0xFF);
+        }
+    }
+
+    inline uint32_t TimestampOf(const uint8_t * theRecord)
+    {
+        return static_cast<uint32_t>(ReadLittleEndian(&theRecord[2], 4));
+    }
+
+    // Log time of a record, given the log time and timestamp of the one
+    // before it.
+    inline uint64_t NextLogTime(const uint64_t & thePreviousLogTime, const uint32_t & thePreviousTimestamp,
+                                const uint32_t & theTimestamp)
+    {
+        return (theTimestamp >= thePreviousTimestamp)
+             ? (thePreviousLogTime + (theTimestamp - thePreviousTimestamp))
+             : (thePreviousLogTime + 1); // Reboot or wrap; the gap is unknown.
+    }
+}
+
+// Log time of a stream of trace records, as per the rules above; fed the
+// "#E" epochs of the same stream, it measures reboots by the wall clock.
+class DHT11LogClock
+{
+public:
+    DHT11LogClock()
+        : m_HasRecord(false)
+        , m_IsEpochPending(false)
+        , m_IsBootAnchored(false)
+        , m_ThePendingOffsetMs(0)
+        , m_TheBootOffsetMs(0)
+        , m_TheLogTime(0)
+        , m_TheTimestamp(0)
+    {
+    }
+
+    // Applies to the next record: the first of a new boot, if the
+    // timestamp goes backwards, else a later one of the current boot.
+    void SetEpoch(const TraceEpoch_t & theEpoch)
+    {
+        if (theEpoch.UnixTimeS >= TRACE_EPOCH_MINIMUM_UNIX_TIME_S)
+        {
+            m_IsEpochPending = true;
+            m_ThePendingOffsetMs = (theEpoch.UnixTimeS * 1000) - static_cast<int64_t>(theEpoch.TimestampMs);
+        }
+    }
+
+    // Log time of the next record. isAnchored tells whether a reboot was
+    // measured by the wall clock, i.e. whether replaying NextLogTime()
+    // would get this record wrong.
+    uint64_t Next(const uint32_t & theTimestamp, bool & isAnchored)
+    {
+        isAnchored = false;
+
+        if (!m_HasRecord)
+        {
+            m_TheLogTime = theTimestamp;
+            m_IsBootAnchored = m_IsEpochPending;
+            m_TheBootOffsetMs = m_ThePendingOffsetMs;
+        }
+        else if (theTimestamp >= m_TheTimestamp)
+        {
+            m_TheLogTime += (theTimestamp - m_TheTimestamp);
+            if (m_IsEpochPending)
+            {
+                m_IsBootAnchored = true;
+                m_TheBootOffsetMs = m_ThePendingOffsetMs;
+            }
+        }
+        else
+        {
+            if (m_IsBootAnchored && m_IsEpochPending)
+            {
+                const auto theDowntimeMs = (static_cast<int64_t>(theTimestamp) + m_ThePendingOffsetMs)
+                                         - (static_cast<int64_t>(m_TheTimestamp) + m_TheBootOffsetMs);
+
+                // A clock set backwards still may not reorder log time.
+                m_TheLogTime += static_cast<uint64_t>(std::max<int64_t>(theDowntimeMs, 1));
+                isAnchored = (theDowntimeMs > 1);
+            }
+            else
+            {
+                m_TheLogTime += 1;
+            }
+            m_IsBootAnchored = m_IsEpochPending;
+            m_TheBootOffsetMs = m_ThePendingOffsetMs;
+        }
+
+        m_HasRecord = true;
+        m_IsEpochPending = false;
+        m_TheTimestamp = theTimestamp;
+        return m_TheLogTime;
+    }
+
+private:
+    bool     m_HasRecord;
+    bool     m_IsEpochPending;
+    bool     m_IsBootAnchored;
+    int64_t  m_ThePendingOffsetMs;        // Wall clock minus timestamp, in ms.
+    int64_t  m_TheBootOffsetMs;
+    uint64_t m_TheLogTime;
+    uint32_t m_TheTimestamp;
+};
+
+class DHT11HistoryWriter
+{
+public:
+    DHT11HistoryWriter(const uint16_t & theIndexStride = HISTORY_DEFAULT_INDEX_STRIDE)
+        : m_pTheFile(nullptr)
+        , m_TheIndexStride(std::max<uint16_t>(theIndexStride, 1))
+        , m_TheRecordCount(0)
+    {
+    }
+
+    DHT11HistoryWriter(const DHT11HistoryWriter&) = delete;
+    DHT11HistoryWriter& operator=(const DHT11HistoryWriter&) = delete;
+
+    ~DHT11HistoryWriter() { (void)Close(); }
+
+    bool Open(const std::string & thePath)
+    {
+        m_pTheFile = fopen(thePath.c_str(), "wb");
+        if (m_pTheFile == nullptr)
+        {
+            return false;
+        }
+
+        // Placeholder; Close() fills in the counts.
+        uint8_t theHeader[HISTORY_HEADER_SIZE_BYTES] = {};
+        return (fwrite(theHeader, sizeof(theHeader), 1, m_pTheFile) == 1);
+    }
+
+    // An epoch ("#E" line) of the capture, in capture order.
+    void SetEpoch(const TraceEpoch_t & theEpoch) { m_TheClock.SetEpoch(theEpoch); }
+
+    bool Append(const TraceRecord_t & theRecord)
+    {
+        uint8_t theBytes[TRACE_RECORD_SIZE_BYTES];
+        EncodeTraceRecord(theRecord, theBytes);
+
+        auto isAnchored = false;
+        const auto theLogTime = m_TheClock.Next(theRecord.TimestampMs, isAnchored);
+
+        if ((m_TheRecordCount % m_TheIndexStride) == 0)
+        {
+            m_TheIndex.push_back(theLogTime);
+        }
+        if (isAnchored)
+        {
+            m_TheAnchors.push_back({m_TheRecordCount, theLogTime});
+        }
+        ++m_TheRecordCount;
+
+        return (fwrite(theBytes, sizeof(theBytes), 1, m_pTheFile) == 1);
+    }
+
+    bool Close()
+    {
+        if (m_pTheFile == nullptr)
+        {
+            return true;
+        }
+
+        const auto theIndexOffset = HISTORY_HEADER_SIZE_BYTES + (m_TheRecordCount * TRACE_RECORD_SIZE_BYTES);
+        auto isWritten = true;
+
+        for (const auto & theLogTime : m_TheIndex)
+        {
+            uint8_t theBytes[8];
+            HistoryDetail::WriteLittleEndian(theBytes, theLogTime, 8);
+            isWritten = isWritten && (fwrite(theBytes, sizeof(theBytes), 1, m_pTheFile) == 1);
+        }
+
+        for (const auto & theAnchor : m_TheAnchors)
+        {
+            uint8_t theBytes[16];
+            HistoryDetail::WriteLittleEndian(&theBytes[0], theAnchor.first, 8);
+            HistoryDetail::WriteLittleEndian(&theBytes[8], theAnchor.second, 8);
+            isWritten = isWritten && (fwrite(theBytes, sizeof(theBytes), 1, m_pTheFile) == 1);
+        }
+
+        uint8_t theHeader[HISTORY_HEADER_SIZE_BYTES] = {};
+        memcpy(theHeader, HISTORY_FILE_MAGIC, 4);
+        theHeader[4] = HISTORY_FILE_VERSION;
+        theHeader[5] = static_cast<uint8_t>(TRACE_RECORD_SIZE_BYTES);
+        HistoryDetail::WriteLittleEndian(&theHeader[6], m_TheIndexStride, 2);
+        HistoryDetail::WriteLittleEndian(&theHeader[8], m_TheRecordCount, 8);
+        HistoryDetail::WriteLittleEndian(&theHeader[16], theIndexOffset, 8);
+        HistoryDetail::WriteLittleEndian(&theHeader[24], m_TheIndex.size(), 4);
+        HistoryDetail::WriteLittleEndian(&theHeader[28], m_TheAnchors.size(), 4);
+
+        isWritten = isWritten && (fseek(m_pTheFile, 0, SEEK_SET) == 0)
+                              && (fwrite(theHeader, sizeof(theHeader), 1, m_pTheFile) == 1);
+        isWritten = (fclose(m_pTheFile) == 0) && isWritten;
+        m_pTheFile = nullptr;
+
+        return isWritten;
+    }
+
+    uint64_t GetRecordCount() const { return m_TheRecordCount; }
+
+private:
+    FILE *                                     m_pTheFile;
+    uint16_t                                   m_TheIndexStride;
+    uint64_t                                   m_TheRecordCount;
+    DHT11LogClock                              m_TheClock;
+    std::vector<uint64_t>                      m_TheIndex;
+    std::vector<std::pair<uint64_t, uint64_t>> m_TheAnchors;   // Record, log time.
+};
+
+class DHT11HistoryReader
+{
+public:
+    DHT11HistoryReader()
+        : m_pTheMapping(nullptr)
+        , m_TheMappingSize(0)
+        , m_pTheRecords(nullptr)
+        , m_pTheIndex(nullptr)
+        , m_pTheAnchors(nullptr)
+        , m_TheRecordCount(0)
+        , m_TheIndexCount(0)
+        , m_TheAnchorCount(0)
+        , m_TheIndexStride(1)
+    {
+    }
+
+    DHT11HistoryReader(const DHT11HistoryReader&) = delete;
+    DHT11HistoryReader& operator=(const DHT11HistoryReader&) = delete;
+
+    ~DHT11HistoryReader() { Close(); }
+
+    // Maps the file read-only. On failure, theError says why.
+    bool Open(const std::string & thePath, std::string & theError)
+    {
+        Close();
+
+        auto theDescriptor = open(thePath.c_str(), O_RDONLY);
+        if (theDescriptor < 0)
+        {
+            theError = "unable to open";
+            return false;
+        }
+
+        struct stat theStatus;
+        if ((fstat(theDescriptor, &theStatus) != 0) || (static_cast<std::size_t>(theStatus.st_size) < HISTORY_HEADER_SIZE_BYTES))
+        {
+            close(theDescriptor);
+            theError = "too short to be a history file";
+            return false;
+        }
+
+        m_TheMappingSize = static_cast<std::size_t>(theStatus.st_size);
+        auto pTheMapping = mmap(nullptr, m_TheMappingSize, PROT_READ, MAP_PRIVATE, theDescriptor, 0);
+        close(theDescriptor); // The mapping holds its own reference.
+
+        if (pTheMapping == MAP_FAILED)
+        {
+            theError = "unable to map";
+            return false;
+        }
+        m_pTheMapping = static_cast<const uint8_t *>(pTheMapping);
+
+        // Scans go front to back; let the kernel read ahead aggressively.
+        (void)madvise(pTheMapping, m_TheMappingSize, MADV_SEQUENTIAL);
+
+        const auto pTheHeader = m_pTheMapping;
+        const auto theIndexOffset = HistoryDetail::ReadLittleEndian(&pTheHeader[16], 8);
+
+        m_TheIndexStride = static_cast<uint16_t>(HistoryDetail::ReadLittleEndian(&pTheHeader[6], 2));
+        m_TheRecordCount = HistoryDetail::ReadLittleEndian(&pTheHeader[8], 8);
+        m_TheIndexCount  = HistoryDetail::ReadLittleEndian(&pTheHeader[24], 4);
+        m_TheAnchorCount = HistoryDetail::ReadLittleEndian(&pTheHeader[28], 4);
+
+        const auto theAnchorOffset = theIndexOffset + (m_TheIndexCount * 8);
+
+        if ((memcmp(pTheHeader, HISTORY_FILE_MAGIC, 4) != 0)
+         || (pTheHeader[4] < 1) || (pTheHeader[4] > HISTORY_FILE_VERSION)
+         || ((pTheHeader[4] == 1) && (m_TheAnchorCount != 0))
+         || (pTheHeader[5] != TRACE_RECORD_SIZE_BYTES)
+         || (m_TheIndexStride == 0)
+         || (m_TheRecordCount > ((m_TheMappingSize - HISTORY_HEADER_SIZE_BYTES) / TRACE_RECORD_SIZE_BYTES))
+         || (theIndexOffset != (HISTORY_HEADER_SIZE_BYTES + (m_TheRecordCount * TRACE_RECORD_SIZE_BYTES)))
+         || (m_TheIndexCount != ((m_TheRecordCount + m_TheIndexStride - 1) / m_TheIndexStride))
+         || (theAnchorOffset > m_TheMappingSize)
+         || (m_TheAnchorCount > ((m_TheMappingSize - theAnchorOffset) / 16)))
+        {
+            Close();
+            theError = "not a history file, or truncated";
+            return false;
+        }
+
+        m_pTheRecords = m_pTheMapping + HISTORY_HEADER_SIZE_BYTES;
+        m_pTheIndex = m_pTheMapping + theIndexOffset;
+        m_pTheAnchors = m_pTheMapping + theAnchorOffset;
+        return true;
+    }
+
+    void Close()
+    {
+        if (m_pTheMapping != nullptr)
+        {
+            munmap(const_cast<uint8_t *>(m_pTheMapping), m_TheMappingSize);
+        }
+        m_pTheMapping = nullptr;
+        m_TheMappingSize = 0;
+        m_pTheRecords = nullptr;
+        m_pTheIndex = nullptr;
+        m_pTheAnchors = nullptr;
+        m_TheRecordCount = 0;
+        m_TheIndexCount = 0;
+        m_TheAnchorCount = 0;
+    }
+
+    uint64_t GetRecordCount() const { return m_TheRecordCount; }
+    uint16_t GetIndexStride() const { return m_TheIndexStride; }
+
+    // Zero-copy access to the i-th record's bytes, for DecodeTraceRecord().
+    const uint8_t * GetRecordBytes(const uint64_t & i) const
+    {
+        return m_pTheRecords + (i * TRACE_RECORD_SIZE_BYTES);
+    }
+
+    uint64_t GetLogTime(const uint64_t & i) const
+    {
+        const auto theEntry = i / m_TheIndexStride;
+        auto theRecord = theEntry * m_TheIndexStride;
+        auto theLogTime = IndexLogTime(theEntry);
+
+        for (; theRecord < i; ++theRecord)
+        {
+            theLogTime = NextLogTime(theRecord + 1, theLogTime, HistoryDetail::TimestampOf(GetRecordBytes(theRecord)),
+                                     HistoryDetail::TimestampOf(GetRecordBytes(theRecord + 1)));
+        }
+
+        return theLogTime;
+    }
+
+    // First record whose log time is not less than theLogTime: a binary
+    // search over the index, then at most one stride of records.
+    uint64_t LowerBound(const uint64_t & theLogTime) const
+    {
+        std::size_t theLow = 0;
+        auto theHigh = static_cast<std::size_t>(m_TheIndexCount);
+
+        while (theLow < theHigh)
+        {
+            const auto theMiddle = theLow + ((theHigh - theLow) / 2);
+            if (IndexLogTime(theMiddle) < theLogTime)
+            {
+                theLow = theMiddle + 1;
+            }
+            else
+            {
+                theHigh = theMiddle;
+            }
+        }
+
+        if (theLow == 0)
+        {
+            return 0;
+        }
+
+        // The answer lies after index entry theLow - 1, by at most a stride.
+        auto theRecord = (theLow - 1) * static_cast<uint64_t>(m_TheIndexStride);
+        const auto theEnd = std::min<uint64_t>(theRecord + m_TheIndexStride, m_TheRecordCount);
+        auto theRecordLogTime = IndexLogTime(theLow - 1);
+
+        while ((theRecord < theEnd) && (theRecordLogTime < theLogTime))
+        {
+            ++theRecord;
+            if (theRecord < m_TheRecordCount)
+            {
+                theRecordLogTime = NextLogTime(theRecord, theRecordLogTime,
+                                               HistoryDetail::TimestampOf(GetRecordBytes(theRecord - 1)),
+                                               HistoryDetail::TimestampOf(GetRecordBytes(theRecord)));
+            }
+        }
+
+        return theRecord;
+    }
+
+    // Visits records [theBegin, theEnd) in order, as
+    // theVisitor(uint64_t logTime, const TraceRecord_t & record). Records
+    // that fail to decode are skipped.
+    template <typename Visitor>
+    void ForEach(const uint64_t & theBegin, const uint64_t & theEnd, Visitor && theVisitor) const
+    {
+        const auto theLast = std::min(theEnd, m_TheRecordCount);
+        if (theBegin >= theLast)
+        {
+            return;
+        }
+
+        auto theLogTime = GetLogTime(theBegin);
+        auto theTimestamp = HistoryDetail::TimestampOf(GetRecordBytes(theBegin));
+        TraceRecord_t theRecord;
+
+        for (auto i = theBegin; i < theLast; ++i)
+        {
+            const auto pTheBytes = GetRecordBytes(i);
+            const auto theNextTimestamp = HistoryDetail::TimestampOf(pTheBytes);
+
+            if (i != theBegin)
+            {
+                theLogTime = NextLogTime(i, theLogTime, theTimestamp, theNextTimestamp);
+            }
+            theTimestamp = theNextTimestamp;
+
+            if (DecodeTraceRecord(pTheBytes, TRACE_RECORD_SIZE_BYTES, theRecord))
+            {
+                theVisitor(theLogTime, theRecord);
+            }
+        }
+    }
+
+private:
+    uint64_t IndexLogTime(const std::size_t & theEntry) const
+    {
+        return HistoryDetail::ReadLittleEndian(m_pTheIndex + (theEntry * 8), 8);
+    }
+
+    // HistoryDetail::NextLogTime() for record theRecord, but for anchors.
+    // Those only ever follow a timestamp going backwards, so the anchor
+    // table is searched at reboots and wraps alone.
+    uint64_t NextLogTime(const uint64_t & theRecord, const uint64_t & thePreviousLogTime,
+                         const uint32_t & thePreviousTimestamp, const uint32_t & theTimestamp) const
+    {
+        if ((theTimestamp >= thePreviousTimestamp) || (m_TheAnchorCount == 0))
+        {
+            return HistoryDetail::NextLogTime(thePreviousLogTime, thePreviousTimestamp, theTimestamp);
+        }
+
+        std::size_t theLow = 0;
+        auto theHigh = static_cast<std::size_t>(m_TheAnchorCount);
+
+        while (theLow < theHigh)
+        {
+            const auto theMiddle = theLow + ((theHigh - theLow) / 2);
+            const auto theAnchoredRecord = HistoryDetail::ReadLittleEndian(m_pTheAnchors + (theMiddle * 16), 8);
+
+            if (theAnchoredRecord == theRecord)
+            {
+                return HistoryDetail::ReadLittleEndian(m_pTheAnchors + (theMiddle * 16) + 8, 8);
+            }
+            if (theAnchoredRecord < theRecord)
+            {
+                theLow = theMiddle + 1;
+            }
+            else
+            {
+                theHigh = theMiddle;
+            }
+        }
+
+        return HistoryDetail::NextLogTime(thePreviousLogTime, thePreviousTimestamp, theTimestamp);
+    }
+
+    const uint8_t * m_pTheMapping;
+    std::size_t     m_TheMappingSize;
+    const uint8_t * m_pTheRecords;
+    const uint8_t * m_pTheIndex;
+    const uint8_t * m_pTheAnchors;
+    uint64_t        m_TheRecordCount;
+    uint64_t        m_TheIndexCount;
+    uint64_t        m_TheAnchorCount;
+    uint16_t        m_TheIndexStride;
+};
@@ -0,0 +1,258 @@
+/***********************************************************************
+* @file      DHT11HistoryFileTest.cpp
+*
+*    Host-side test of the history file writer, reader and log clock
+*    (see DHT11HistoryFile.h).
+*
+* @brief   Writes captures of several boots, with and without "#E"
+*          epochs, through a small index stride so that replays cross
+*          index entries and reboots alike:
+*
+*            - log clock: a reboot between two anchored boots advances log
+*              time by the downtime on the wall clock; without an epoch on
+*              either side, with an RTC that was never set, or with a clock
+*              set backwards, by 1 ms as before;
+*            - reader: GetLogTime(), ForEach() from every record and
+*              LowerBound() of every log time agree with the writer;
+*            - version 1 files, which have no anchors, still open; a
+*              version 1 header claiming anchors does not.
+*
+* @note    Build and run on the host, e.g.:
+*
+*            g++ -std=c++20 -O2 -Ihost -I.. DHT11HistoryFileTest.cpp -o DHT11HistoryFileTest
+*            ./DHT11HistoryFileTest
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include "DHT11TestSupport.h"
+#include "DHT11HistoryFile.h"
+#include "DHT11Simulator.h"
+
+namespace
+{
+    constexpr uint16_t INDEX_STRIDE = 4;
+    constexpr int64_t  UNIX_TIME_S  = 1'700'000'000;
+
+    // One "#D" record, or (if IsEpoch) one "#E" epoch, of a capture.
+    struct Line_t
+    {
+        bool         IsEpoch;
+        uint32_t     TimestampMs;
+        int64_t      UnixTimeS;
+    };
+
+    TraceRecord_t ToRecord(const uint32_t & theTimestampMs)
+    {
+        TraceRecord_t theRecord;
+        theRecord.TimestampMs = theTimestampMs;
+        theRecord.SensorPin = static_cast<uint16_t>(theTimestampMs % 3);
+        theRecord.Model = SensorModel_t::DHT22;
+        theRecord.Status = SensorStatus_t::SUCCESS;
+        theRecord.Frame = EncodeDataFrame<DHT22_t>(215, 450);
+        return theRecord;
+    }
+
+    // Five records per boot, 2 s apart, the first at 1 s of uptime.
+    void AppendBoot(std::vector<Line_t> & theCapture, const bool & hasEpoch, const int64_t & theUnixTimeS)
+    {
+        if (hasEpoch)
+        {
+            theCapture.push_back({true, 500, theUnixTimeS});
+        }
+        for (uint32_t i = 0; i < 5; ++i)
+        {
+            theCapture.push_back({false, 1000 + (i * 2000), 0});
+        }
+    }
+
+    // Writes theCapture to thePath; theLogTimes receives the log time the
+    // writer's clock gave each record.
+    bool Write(const std::string & thePath, const std::vector<Line_t> & theCapture, std::vector<uint64_t> & theLogTimes)
+    {
+        DHT11HistoryWriter theWriter(INDEX_STRIDE);
+        DHT11LogClock theClock;
+        auto isWritten = theWriter.Open(thePath);
+
+        theLogTimes.clear();
+        for (const auto & theLine : theCapture)
+        {
+            if (theLine.IsEpoch)
+            {
+                theWriter.SetEpoch({theLine.TimestampMs, theLine.UnixTimeS});
+                theClock.SetEpoch({theLine.TimestampMs, theLine.UnixTimeS});
+                continue;
+            }
+
+            auto isAnchored = false;
+            theLogTimes.push_back(theClock.Next(theLine.TimestampMs, isAnchored));
+            isWritten = theWriter.Append(ToRecord(theLine.TimestampMs)) && isWritten;
+        }
+
+        return theWriter.Close() && isWritten;
+    }
+
+    void CheckReader(Checker_t & theChecker, const std::string & thePath, const std::vector<uint64_t> & theLogTimes)
+    {
+        DHT11HistoryReader theReader;
+        std::string theError;
+
+        theChecker.Expect(theReader.Open(thePath, theError), "file does not open");
+        theChecker.Expect(theReader.GetRecordCount() == theLogTimes.size(), "record count");
+
+        auto isGetLogTimeRight = true;
+        auto isForEachRight = true;
+        auto isLowerBoundRight = true;
+
+        for (uint64_t i = 0; i < theReader.GetRecordCount(); ++i)
+        {
+            isGetLogTimeRight = isGetLogTimeRight && (theReader.GetLogTime(i) == theLogTimes[i]);
+
+            auto j = i;
+            theReader.ForEach(i, theReader.GetRecordCount(), [&](const uint64_t & theLogTime, const TraceRecord_t &)
+            {
+                isForEachRight = isForEachRight && (theLogTime == theLogTimes[j++]);
+            });
+            isForEachRight = isForEachRight && (j == theLogTimes.size());
+
+            // Log times are strictly increasing here, so each is found at
+            // its own record.
+            isLowerBoundRight = isLowerBoundRight && (theReader.LowerBound(theLogTimes[i]) == i)
+                                                  && (theReader.LowerBound(theLogTimes[i] + 1) == (i + 1));
+        }
+
+        theChecker.Expect(isGetLogTimeRight, "GetLogTime() differs from the writer");
+        theChecker.Expect(isForEachRight, "ForEach() differs from the writer");
+        theChecker.Expect(isLowerBoundRight, "LowerBound() misses a record");
+    }
+
+    void TestLogClock(Checker_t & theChecker)
+    {
+        DHT11LogClock theClock;
+        auto isAnchored = false;
+
+        // Boot 1 anchored at 500 ms of uptime; last record at 9 s, i.e.
+        // wall clock 1700000008.5 s.
+        theClock.SetEpoch({500, UNIX_TIME_S});
+        theChecker.Expect(theClock.Next(1000, isAnchored) == 1000, "first record is not at its timestamp");
+        theChecker.Expect(theClock.Next(9000, isAnchored) == 9000, "log time does not follow the timestamp");
+
+        // Boot 2, its first record at 1700000060.5 s: 52 s of downtime.
+        theClock.SetEpoch({500, UNIX_TIME_S + 60});
+        theChecker.Expect((theClock.Next(1000, isAnchored) == 61000) && isAnchored, "downtime not measured");
+        theChecker.Expect((theClock.Next(9000, isAnchored) == 69000) && !isAnchored, "anchored boot does not follow");
+
+        // Boot 3 has no epoch, so its reboot and the next are unmeasured.
+        theChecker.Expect((theClock.Next(1000, isAnchored) == 69001) && !isAnchored, "unanchored reboot not 1 ms");
+        theClock.Next(9000, isAnchored);
+        theClock.SetEpoch({500, UNIX_TIME_S + 600});
+        theChecker.Expect((theClock.Next(1000, isAnchored) == 77002) && !isAnchored, "reboot from unanchored boot not 1 ms");
+        theClock.Next(9000, isAnchored);
+
+        // Boot 5: an RTC that was never set says nothing.
+        theClock.SetEpoch({500, 3});
+        theChecker.Expect((theClock.Next(1000, isAnchored) == 85003) && !isAnchored, "unset RTC epoch was used");
+
+        // An epoch later in a boot anchors it from then on; boot 6 then
+        // starts 9.5 s after the last record of boot 5.
+        theClock.SetEpoch({4000, UNIX_TIME_S + 1000});
+        theChecker.Expect((theClock.Next(5000, isAnchored) == 89003) && !isAnchored, "mid-boot epoch moved log time");
+        theClock.SetEpoch({500, UNIX_TIME_S + 1010});
+        theChecker.Expect((theClock.Next(1000, isAnchored) == 98503) && isAnchored, "mid-boot epoch not used");
+        theClock.Next(9000, isAnchored);
+
+        // A clock set backwards still may not reorder log time.
+        theClock.SetEpoch({500, UNIX_TIME_S});
+        theChecker.Expect((theClock.Next(1000, isAnchored) == 106504) && !isAnchored, "clock set backwards reordered log time");
+    }
+
+    void TestFile(Checker_t & theChecker, const std::string & thePath)
+    {
+        // Anchored, unanchored, anchored and anchored boots: two anchors.
+        std::vector<Line_t> theCapture;
+        AppendBoot(theCapture, true, UNIX_TIME_S);
+        AppendBoot(theCapture, true, UNIX_TIME_S + 3600);
+        AppendBoot(theCapture, false, 0);
+        AppendBoot(theCapture, true, UNIX_TIME_S + 7200);
+        AppendBoot(theCapture, true, UNIX_TIME_S + 86400);
+
+        std::vector<uint64_t> theLogTimes;
+        theChecker.Expect(Write(thePath, theCapture, theLogTimes), "writing failed");
+        theChecker.Expect(theLogTimes[5] == (theLogTimes[4] + 3'592'000), "hour of downtime not in log time");
+        theChecker.Expect(theLogTimes[10] == (theLogTimes[9] + 1), "unanchored reboot not 1 ms");
+        theChecker.Expect(theLogTimes[20] == (theLogTimes[19] + 79'192'000), "day of downtime not in log time");
+
+        uint8_t theHeader[HISTORY_HEADER_SIZE_BYTES] = {};
+        {
+            std::ifstream theFile(thePath, std::ios::binary);
+            theFile.read(reinterpret_cast<char *>(theHeader), sizeof(theHeader));
+        }
+        theChecker.Expect(theHeader[4] == 2, "not written as version 2");
+        theChecker.Expect(HistoryDetail::ReadLittleEndian(&theHeader[28], 4) == 2, "anchor count");
+
+        CheckReader(theChecker, thePath, theLogTimes);
+
+        // A version 1 header cannot hold anchors.
+        std::fstream theFile(thePath, std::ios::binary | std::ios::in | std::ios::out);
+        theFile.seekp(4);
+        theFile.put(1);
+        theFile.close();
+
+        DHT11HistoryReader theReader;
+        std::string theError;
+        theChecker.Expect(!theReader.Open(thePath, theError), "version 1 file with anchors opened");
+    }
+
+    void TestVersion1(Checker_t & theChecker, const std::string & thePath)
+    {
+        // Without epochs there are no anchors, i.e. what version 1 wrote.
+        std::vector<Line_t> theCapture;
+        AppendBoot(theCapture, false, 0);
+        AppendBoot(theCapture, false, 0);
+
+        std::vector<uint64_t> theLogTimes;
+        theChecker.Expect(Write(thePath, theCapture, theLogTimes), "writing failed");
+
+        std::fstream theFile(thePath, std::ios::binary | std::ios::in | std::ios::out);
+        theFile.seekp(4);
+        theFile.put(1);
+        theFile.close();
+
+        CheckReader(theChecker, thePath, theLogTimes);
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    if (!ParseOptions(argc, argv, {}))
+    {
+        return EXIT_FAILURE;
+    }
+
+    char thePath[] = "/tmp/DHT11HistoryFileTestXXXXXX";
+    const auto theDescriptor = mkstemp(thePath);
+    if (theDescriptor < 0)
+    {
+        fprintf(stderr, "Error! Unable to create a temporary file\n");
+        return EXIT_FAILURE;
+    }
+    close(theDescriptor);
+
+    Checker_t theChecker;
+
+    TestLogClock(theChecker);
+    TestFile(theChecker, thePath);
+    TestVersion1(theChecker, thePath);
+
+    unlink(thePath);
+    return theChecker.Finish();
+}
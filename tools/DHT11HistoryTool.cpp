@@ -0,0 +1,444 @@
+/***********************************************************************
+* @file      DHT11HistoryTool.cpp
+*
+*    Host-side packing and parallel scanning of DHT11/DHT22 history
+*    files (see DHT11HistoryFile.h).
+*
+* @brief   Three commands:
+*
+*            pack OUT [LOG...]  - Pack the "#D" trace lines of captured
+*                                 console logs (standard input if none)
+*                                 into history file OUT, placing reboots
+*                                 on the wall clock by their "#E" lines.
+*            synth OUT          - Write a synthetic history file, e.g. for
+*                                 benchmarking scans without real logs.
+*            scan FILE...       - Summarize every sensor of every file
+*                                 (reads, errors, min/max/mean temperature
+*                                 and humidity), optionally over a range
+*                                 of log time only.
+*
+*          Scans map each file, seek to the range through its time index,
+*          split the range into index-aligned chunks and reduce them with
+*          std::transform_reduce(std::execution::par, ...), so one large
+*          file or hundreds of small ones alike keep every core busy. No
+*          record is copied or parsed from text; each is decoded in place
+*          with the driver's own frame arithmetic.
+*
+* @note    Build and run on the host, e.g.:
+*
+*            g++ -std=c++20 -O2 -I.. DHT11HistoryTool.cpp -o DHT11HistoryTool -ltbb
+*            ./DHT11HistoryTool pack node17.dhh node17_console.log
+*            ./DHT11HistoryTool scan --from-ms 0 --to-ms 86400000 node17.dhh node18.dhh
+*
+*          libstdc++ runs the parallel algorithms on TBB; without it they
+*          quietly run sequentially.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <execution>
+#include "DHT11HistoryFile.h"
+#include "DHT11Simulator.h"
+
+namespace
+{
+    struct SensorStats_t
+    {
+        SensorModel_t Model = SensorModel_t::DHT11;
+        uint64_t      Reads = 0;
+        uint64_t      Errors = 0;              // Failed on the MCU, or checksum on the host.
+        int32_t       MinimumTemperatureTenths = INT32_MAX;
+        int32_t       MaximumTemperatureTenths = INT32_MIN;
+        int64_t       TemperatureSum = 0;
+        int32_t       MinimumHumidityTenths = INT32_MAX;
+        int32_t       MaximumHumidityTenths = INT32_MIN;
+        int64_t       HumiditySum = 0;
+
+        void Merge(const SensorStats_t & theOther)
+        {
+            Model = theOther.Model;
+            Reads += theOther.Reads;
+            Errors += theOther.Errors;
+            MinimumTemperatureTenths = std::min(MinimumTemperatureTenths, theOther.MinimumTemperatureTenths);
+            MaximumTemperatureTenths = std::max(MaximumTemperatureTenths, theOther.MaximumTemperatureTenths);
+            TemperatureSum += theOther.TemperatureSum;
+            MinimumHumidityTenths = std::min(MinimumHumidityTenths, theOther.MinimumHumidityTenths);
+            MaximumHumidityTenths = std::max(MaximumHumidityTenths, theOther.MaximumHumidityTenths);
+            HumiditySum += theOther.HumiditySum;
+        }
+    };
+
+    // Keyed by (file, sensor pin).
+    using Summary_t = std::map<std::pair<std::size_t, uint16_t>, SensorStats_t>;
+
+    struct Chunk_t
+    {
+        std::size_t File;
+        uint64_t    Begin;
+        uint64_t    End;
+    };
+
+    struct Options_t
+    {
+        bool     Json = false;
+        uint64_t FromMs = 0;
+        uint64_t ToMs = UINT64_MAX;
+        uint64_t Records = 10'000'000;
+        uint32_t Sensors = 16;
+        unsigned Seed = 1;
+    };
+
+    void Accumulate(SensorStats_t & theStats, const TraceRecord_t & theRecord)
+    {
+        theStats.Model = theRecord.Model;
+        ++theStats.Reads;
+
+        if ((theRecord.Status != SensorStatus_t::SUCCESS) || !IsChecksumValid(theRecord.Frame))
+        {
+            ++theStats.Errors;
+            return;
+        }
+
+        const int32_t theTemperature = (theRecord.Model == SensorModel_t::DHT22)
+                                     ? DecodeTemperatureTenths<DHT22_t>(theRecord.Frame)
+                                     : DecodeTemperatureTenths<DHT11_t>(theRecord.Frame);
+        const int32_t theHumidity    = (theRecord.Model == SensorModel_t::DHT22)
+                                     ? DecodeHumidityTenths<DHT22_t>(theRecord.Frame)
+                                     : DecodeHumidityTenths<DHT11_t>(theRecord.Frame);
+
+        theStats.MinimumTemperatureTenths = std::min(theStats.MinimumTemperatureTenths, theTemperature);
+        theStats.MaximumTemperatureTenths = std::max(theStats.MaximumTemperatureTenths, theTemperature);
+        theStats.TemperatureSum += theTemperature;
+        theStats.MinimumHumidityTenths = std::min(theStats.MinimumHumidityTenths, theHumidity);
+        theStats.MaximumHumidityTenths = std::max(theStats.MaximumHumidityTenths, theHumidity);
+        theStats.HumiditySum += theHumidity;
+    }
+
+    int Pack(const std::string & theOutput, const std::vector<std::string> & theInputs)
+    {
+        DHT11HistoryWriter theWriter;
+        if (!theWriter.Open(theOutput))
+        {
+            fprintf(stderr, "Error! Unable to create \"%s\"\n", theOutput.c_str());
+            return EXIT_FAILURE;
+        }
+
+        auto PackStream = [&theWriter](std::istream & theInput)
+        {
+            std::string theLine;
+            TraceRecord_t theRecord;
+            TraceEpoch_t theEpoch;
+            auto isWritten = true;
+
+            while (std::getline(theInput, theLine))
+            {
+                while (!theLine.empty() && ((theLine.back() == '\r') || (theLine.back() == '\n')))
+                {
+                    theLine.pop_back();
+                }
+
+                if (ParseTraceLine(theLine.c_str(), theLine.size(), theRecord))
+                {
+                    isWritten = theWriter.Append(theRecord) && isWritten;
+                }
+                else if (ParseEpochLine(theLine.c_str(), theLine.size(), theEpoch))
+                {
+                    theWriter.SetEpoch(theEpoch);
+                }
+            }
+
+            return isWritten;
+        };
+
+        auto isWritten = true;
+        if (theInputs.empty())
+        {
+            isWritten = PackStream(std::cin);
+        }
+        for (const auto & theInput : theInputs)
+        {
+            std::ifstream theFile(theInput);
+            if (!theFile)
+            {
+                fprintf(stderr, "Error! Unable to open \"%s\"\n", theInput.c_str());
+                return EXIT_FAILURE;
+            }
+            isWritten = PackStream(theFile) && isWritten;
+        }
+
+        const auto theRecords = theWriter.GetRecordCount();
+        if (!theWriter.Close() || !isWritten)
+        {
+            fprintf(stderr, "Error! Writing \"%s\" failed\n", theOutput.c_str());
+            return EXIT_FAILURE;
+        }
+
+        fprintf(stderr, "Packed %llu records into \"%s\"\n", static_cast<unsigned long long>(theRecords), theOutput.c_str());
+        return EXIT_SUCCESS;
+    }
+
+    int Synthesize(const std::string & theOutput, const Options_t & theOptions)
+    {
+        DHT11HistoryWriter theWriter;
+        if (!theWriter.Open(theOutput))
+        {
+            fprintf(stderr, "Error! Unable to create \"%s\"\n", theOutput.c_str());
+            return EXIT_FAILURE;
+        }
+
+        // Sensors read round-robin, one every 3s / sensors, with the odd
+        // failed read, and a reboot after five minutes of downtime every
+        // million records. Each boot starts with an epoch, as on target.
+        std::mt19937 theGenerator(theOptions.Seed);
+        std::uniform_int_distribution<int> theStep(-3, 3);
+        std::bernoulli_distribution theFailure(0.01);
+        std::vector<int16_t> theTemperatures(theOptions.Sensors, 220);
+        uint32_t theTimestampMs = 0;
+        int64_t theUnixTimeMs = 1'700'000'000'000;
+        auto isWritten = true;
+
+        for (uint64_t i = 0; i < theOptions.Records; ++i)
+        {
+            const auto theSensor = static_cast<uint32_t>(i % theOptions.Sensors);
+            const auto isDHT22 = ((theSensor % 2) != 0);
+            auto & theTemperature = theTemperatures[theSensor];
+
+            theTemperature = static_cast<int16_t>(std::clamp(theTemperature + theStep(theGenerator), 0, 500));
+            if ((i % 1'000'000) == 0)
+            {
+                theTimestampMs = 1000;
+                theUnixTimeMs += 300'000;
+                theWriter.SetEpoch({theTimestampMs, theUnixTimeMs / 1000});
+            }
+            else
+            {
+                theTimestampMs += (3000 / theOptions.Sensors) + 1;
+                theUnixTimeMs += (3000 / theOptions.Sensors) + 1;
+            }
+
+            TraceRecord_t theRecord;
+            theRecord.TimestampMs = theTimestampMs;
+            theRecord.SensorPin = static_cast<uint16_t>(theSensor);
+            theRecord.Model = isDHT22 ? SensorModel_t::DHT22 : SensorModel_t::DHT11;
+            theRecord.Status = theFailure(theGenerator) ? SensorStatus_t::ERROR_BAD_CHECKSUM : SensorStatus_t::SUCCESS;
+            theRecord.Frame = isDHT22 ? EncodeDataFrame<DHT22_t>(theTemperature, 450)
+                                      : EncodeDataFrame<DHT11_t>(static_cast<int16_t>((theTemperature / 10) * 10), 450);
+            isWritten = theWriter.Append(theRecord) && isWritten;
+        }
+
+        if (!theWriter.Close() || !isWritten)
+        {
+            fprintf(stderr, "Error! Writing \"%s\" failed\n", theOutput.c_str());
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    void PrintSummary(const Summary_t & theSummary, const std::vector<std::string> & theFiles, const bool & isJson)
+    {
+        if (!isJson)
+        {
+            printf("file,sensor,model,reads,errors,error_rate,min_t,max_t,mean_t,min_h,max_h,mean_h\n");
+        }
+        else
+        {
+            printf("{\n  \"sensors\": [\n");
+        }
+
+        std::size_t theIndex = 0;
+        for (const auto & [theKey, theStats] : theSummary)
+        {
+            const auto theGood = theStats.Reads - theStats.Errors;
+            const auto theMeanT = theGood ? (static_cast<double>(theStats.TemperatureSum) / theGood / 10.0) : 0.0;
+            const auto theMeanH = theGood ? (static_cast<double>(theStats.HumiditySum) / theGood / 10.0) : 0.0;
+            const auto theMinT  = theGood ? (theStats.MinimumTemperatureTenths / 10.0) : 0.0;
+            const auto theMaxT  = theGood ? (theStats.MaximumTemperatureTenths / 10.0) : 0.0;
+            const auto theMinH  = theGood ? (theStats.MinimumHumidityTenths / 10.0) : 0.0;
+            const auto theMaxH  = theGood ? (theStats.MaximumHumidityTenths / 10.0) : 0.0;
+            const auto pTheModel = (theStats.Model == SensorModel_t::DHT22) ? "DHT22" : "DHT11";
+            const auto theErrorRate = static_cast<double>(theStats.Errors) / theStats.Reads;
+
+            if (!isJson)
+            {
+                printf("%s,%u,%s,%llu,%llu,%.6f,%.1f,%.1f,%.2f,%.1f,%.1f,%.2f\n",
+                       theFiles[theKey.first].c_str(), theKey.second, pTheModel,
+                       static_cast<unsigned long long>(theStats.Reads), static_cast<unsigned long long>(theStats.Errors),
+                       theErrorRate, theMinT, theMaxT, theMeanT, theMinH, theMaxH, theMeanH);
+            }
+            else
+            {
+                printf("    {\"file\": \"%s\", \"sensor\": %u, \"model\": \"%s\", \"reads\": %llu, \"errors\": %llu, "
+                       "\"error_rate\": %.6f, \"min_t\": %.1f, \"max_t\": %.1f, \"mean_t\": %.2f, "
+                       "\"min_h\": %.1f, \"max_h\": %.1f, \"mean_h\": %.2f}%s\n",
+                       theFiles[theKey.first].c_str(), theKey.second, pTheModel,
+                       static_cast<unsigned long long>(theStats.Reads), static_cast<unsigned long long>(theStats.Errors),
+                       theErrorRate, theMinT, theMaxT, theMeanT, theMinH, theMaxH, theMeanH,
+                       (++theIndex < theSummary.size()) ? "," : "");
+            }
+        }
+
+        if (isJson)
+        {
+            printf("  ]\n}\n");
+        }
+    }
+
+    int Scan(const std::vector<std::string> & theFiles, const Options_t & theOptions)
+    {
+        const auto theStart = std::chrono::steady_clock::now();
+        std::vector<std::unique_ptr<DHT11HistoryReader>> theReaders;
+        std::vector<Chunk_t> theChunks;
+        uint64_t theRecords = 0;
+
+        for (std::size_t f = 0; f < theFiles.size(); ++f)
+        {
+            auto pTheReader = std::make_unique<DHT11HistoryReader>();
+            std::string theError;
+
+            if (!pTheReader->Open(theFiles[f], theError))
+            {
+                fprintf(stderr, "Error! \"%s\": %s\n", theFiles[f].c_str(), theError.c_str());
+                return EXIT_FAILURE;
+            }
+
+            const auto theBegin = pTheReader->LowerBound(theOptions.FromMs);
+            const auto theEnd = (theOptions.ToMs == UINT64_MAX) ? pTheReader->GetRecordCount()
+                                                                : pTheReader->LowerBound(theOptions.ToMs);
+            const auto theStride = pTheReader->GetIndexStride();
+
+            // Chunk boundaries on index entries, so that each chunk's
+            // first log time is read straight from the index.
+            for (auto theChunkBegin = theBegin; theChunkBegin < theEnd; )
+            {
+                const auto theChunkEnd = std::min<uint64_t>(((theChunkBegin / theStride) + 1) * theStride, theEnd);
+                theChunks.push_back(Chunk_t{f, theChunkBegin, theChunkEnd});
+                theChunkBegin = theChunkEnd;
+            }
+
+            theRecords += (theEnd > theBegin) ? (theEnd - theBegin) : 0;
+            theReaders.push_back(std::move(pTheReader));
+        }
+
+        const auto theSummary = std::transform_reduce(std::execution::par, theChunks.begin(), theChunks.end(),
+            Summary_t{},
+            [](Summary_t theLeft, const Summary_t & theRight)
+            {
+                for (const auto & [theKey, theStats] : theRight)
+                {
+                    theLeft[theKey].Merge(theStats);
+                }
+                return theLeft;
+            },
+            [&theReaders](const Chunk_t & theChunk)
+            {
+                Summary_t theChunkSummary;
+                theReaders[theChunk.File]->ForEach(theChunk.Begin, theChunk.End,
+                    [&theChunkSummary, &theChunk](const uint64_t &, const TraceRecord_t & theRecord)
+                    {
+                        Accumulate(theChunkSummary[{theChunk.File, theRecord.SensorPin}], theRecord);
+                    });
+                return theChunkSummary;
+            });
+
+        const auto theSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - theStart).count();
+
+        PrintSummary(theSummary, theFiles, theOptions.Json);
+        fprintf(stderr, "Scanned %llu records from %zu file(s) in %.3fs (%.1fM records/s)\n",
+                static_cast<unsigned long long>(theRecords), theFiles.size(), theSeconds,
+                (theSeconds > 0.0) ? (theRecords / theSeconds / 1e6) : 0.0);
+
+        return EXIT_SUCCESS;
+    }
+
+    void PrintUsage(const char * theProgram)
+    {
+        fprintf(stderr, "Usage: %s pack OUT [LOG...]\n"
+                        "       %s synth OUT [--records N] [--sensors N] [--seed N]\n"
+                        "       %s scan [--format csv|json] [--from-ms N] [--to-ms N] FILE...\n",
+                        theProgram, theProgram, theProgram);
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc < 3)
+    {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const std::string theCommand(argv[1]);
+    Options_t theOptions;
+    std::vector<std::string> theArguments;
+
+    for (int i = 2; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+
+        if (!strcmp(argv[i], "--format") && hasValue)
+        {
+            theOptions.Json = !strcmp(argv[++i], "json");
+        }
+        else if (!strcmp(argv[i], "--from-ms") && hasValue)
+        {
+            theOptions.FromMs = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (!strcmp(argv[i], "--to-ms") && hasValue)
+        {
+            theOptions.ToMs = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (!strcmp(argv[i], "--records") && hasValue)
+        {
+            theOptions.Records = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (!strcmp(argv[i], "--sensors") && hasValue)
+        {
+            theOptions.Sensors = std::max(1ul, strtoul(argv[++i], nullptr, 10));
+        }
+        else if (!strcmp(argv[i], "--seed") && hasValue)
+        {
+            theOptions.Seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (!strncmp(argv[i], "--", 2))
+        {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        else
+        {
+            theArguments.emplace_back(argv[i]);
+        }
+    }
+
+    if ((theCommand == "pack") && !theArguments.empty())
+    {
+        return Pack(theArguments.front(), std::vector<std::string>(theArguments.begin() + 1, theArguments.end()));
+    }
+    if ((theCommand == "synth") && (theArguments.size() == 1))
+    {
+        return Synthesize(theArguments.front(), theOptions);
+    }
+    if ((theCommand == "scan") && !theArguments.empty())
+    {
+        return Scan(theArguments, theOptions);
+    }
+
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+}
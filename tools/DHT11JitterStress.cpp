@@ -0,0 +1,378 @@
+/***********************************************************************
+* @file      DHT11JitterStress.cpp
+*
+*    Host-side stress harness characterizing how robust the driver's
+*    decode backends are against a noisy bus and a busy MCU.
+*
+* @brief   Sweep injected edge jitter, rise-time skew and preemption
+*          stalls through simulated sensor waveforms (DHT11Simulator.h),
+*          decode every frame with each backend and each candidate bit
+*          threshold, and tabulate the resulting SensorStatus_t
+*          distribution per grid point; i.e. an error rate vs jitter
+*          surface. The backends are:
+*
+*            polling    - CaptureBitWidths(), as NuerteyDHT11Device uses.
+*            port-edges - Port-parallel edge capture, CapturePortEdges()
+*                         followed by DecodeEdgeTimestamps().
+*
+*          'undetected' counts frames that passed their checksum but did
+*          not carry what the sensor sent; by far the worst outcome.
+*
+* @note    Build and run on the host, e.g.:
+*
+*            g++ -std=c++20 -O2 -I.. DHT11JitterStress.cpp -o DHT11JitterStress
+*            ./DHT11JitterStress --thresholds 36,40,48 --trials 128 > surface.csv
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <random>
+#include "DHT11Simulator.h"
+
+namespace
+{
+    constexpr double START_HIGH_US = 30.0; // wait_us(30), see NuerteyDHT11Device::ReadFromBus().
+
+    // Outcome slots; the SensorStatus_t codes are 0..-7, so negate them.
+    constexpr std::size_t OUTCOME_UNDETECTED = 8;
+    constexpr std::size_t OUTCOME_COUNT      = 9;
+
+    struct Options_t
+    {
+        std::size_t          Trials = 64;
+        unsigned             Seed   = 2021;
+        bool                 Json   = false;
+        bool                 IsDHT22 = false;
+        std::vector<double>  EdgeJitterUs  = { 0, 2, 4, 6, 8, 12 };
+        std::vector<double>  RiseSkewUs    = { 0, 5, 10, 15, 20 };
+        std::vector<double>  PreemptionUs  = { 0, 10, 20, 40 };
+        std::vector<uint8_t> ThresholdsUs  = { 36, 40, 48 };
+        SimulatedCpu_t       Cpu;
+    };
+
+    struct Point_t
+    {
+        const char *  Backend;
+        uint8_t       ThresholdUs;
+        double        EdgeJitterUs;
+        double        RiseSkewUs;
+        double        PreemptionUs;
+        std::size_t   Outcomes[OUTCOME_COUNT];
+    };
+
+    // Per threshold, classify one capture into its outcome slot.
+    void Tally(const SensorStatus_t & theStatus, const BitWidths_t & theHighWidthsUs,
+               const DataFrame_t & theSentFrame, const Options_t & theOptions,
+               std::vector<Point_t> & thePoints, const std::size_t & theFirstPoint)
+    {
+        for (std::size_t i = 0; i < theOptions.ThresholdsUs.size(); i++)
+        {
+            auto theOutcome = static_cast<std::size_t>(-ToUnderlyingType(theStatus));
+
+            if (theStatus == SensorStatus_t::SUCCESS)
+            {
+                DataFrame_t theDataFrame = {};
+                AssembleDataFrame(theHighWidthsUs, theOptions.ThresholdsUs[i], theDataFrame);
+
+                if (!IsChecksumValid(theDataFrame))
+                {
+                    theOutcome = static_cast<std::size_t>(-ToUnderlyingType(SensorStatus_t::ERROR_BAD_CHECKSUM));
+                }
+                else if (theDataFrame != theSentFrame)
+                {
+                    theOutcome = OUTCOME_UNDETECTED;
+                }
+            }
+            ++thePoints[theFirstPoint + i].Outcomes[theOutcome];
+        }
+    }
+
+    template <typename T>
+    void RunPolling(const SimulatedJitter_t & theJitter, const SimulatedCpu_t & theCpu,
+                    std::mt19937 & theGenerator, const Options_t & theOptions,
+                    std::vector<Point_t> & thePoints, const std::size_t & theFirstPoint)
+    {
+        std::uniform_real_distribution<double> thePhase(0.0, theCpu.PreemptionPeriodUs);
+
+        for (std::size_t trial = 0; trial < theOptions.Trials; trial++)
+        {
+            SimulatedSensor<T> theSensor(theGenerator);
+            const auto theSentFrame = theSensor.Sample(theGenerator);
+            auto theWaveform = SimulatedWaveform::FromFrame(theSentFrame, theSensor.GetTiming());
+            theWaveform.ApplyJitter(theJitter, theGenerator);
+
+            SimulatedClock theClock(theCpu, START_HIGH_US, thePhase(theGenerator));
+            SimulatedPin   thePin(theWaveform, theClock);
+            BitWidths_t    theHighWidthsUs = {};
+
+            const auto theStatus = CaptureBitWidths(thePin, theClock, theHighWidthsUs);
+            Tally(theStatus, theHighWidthsUs, theSentFrame, theOptions, thePoints, theFirstPoint);
+        }
+    }
+
+    template <typename T>
+    void RunPortEdges(const SimulatedJitter_t & theJitter, const SimulatedCpu_t & theCpu,
+                      std::mt19937 & theGenerator, const Options_t & theOptions,
+                      std::vector<Point_t> & thePoints, const std::size_t & theFirstPoint)
+    {
+        constexpr auto PORT_WIDTH_PINS = SimulatedPort::PORT_WIDTH_PINS;
+        std::uniform_real_distribution<double> thePhase(0.0, theCpu.PreemptionPeriodUs);
+
+        for (std::size_t trial = 0; trial < theOptions.Trials; trial += PORT_WIDTH_PINS)
+        {
+            const auto theLineCount = std::min(PORT_WIDTH_PINS, theOptions.Trials - trial);
+
+            std::vector<DataFrame_t>           theSentFrames(theLineCount);
+            std::vector<SimulatedWaveform>     theWaveforms(theLineCount);
+            std::vector<std::vector<uint32_t>> theEdgesUs;
+
+            SimulatedClock theClock(theCpu, START_HIGH_US, thePhase(theGenerator));
+            SimulatedPort  thePort(theClock);
+
+            for (std::size_t line = 0; line < theLineCount; line++)
+            {
+                SimulatedSensor<T> theSensor(theGenerator);
+                theSentFrames[line] = theSensor.Sample(theGenerator);
+                theWaveforms[line]  = SimulatedWaveform::FromFrame(theSentFrames[line], theSensor.GetTiming());
+                theWaveforms[line].ApplyJitter(theJitter, theGenerator);
+                thePort.Attach(theWaveforms[line]);
+            }
+
+            CapturePortEdges(thePort, theClock, theEdgesUs);
+
+            for (std::size_t line = 0; line < theLineCount; line++)
+            {
+                BitWidths_t theHighWidthsUs = {};
+                const auto  theStatus = DecodeEdgeTimestamps(theEdgesUs[line].data(), theEdgesUs[line].size(),
+                                                             theHighWidthsUs);
+                Tally(theStatus, theHighWidthsUs, theSentFrames[line], theOptions, thePoints, theFirstPoint);
+            }
+        }
+    }
+
+    template <typename T>
+    std::vector<Point_t> Run(const Options_t & theOptions)
+    {
+        using Backend_t = void (*)(const SimulatedJitter_t &, const SimulatedCpu_t &, std::mt19937 &,
+                                   const Options_t &, std::vector<Point_t> &, const std::size_t &);
+
+        const std::pair<const char *, Backend_t> theBackends[] =
+        {
+            { "polling",    &RunPolling<T>   },
+            { "port-edges", &RunPortEdges<T> }
+        };
+
+        std::vector<Point_t> thePoints;
+
+        for (const auto & [theBackend, theRun] : theBackends)
+        {
+            for (const auto & theEdgeJitterUs : theOptions.EdgeJitterUs)
+            {
+                for (const auto & theRiseSkewUs : theOptions.RiseSkewUs)
+                {
+                    for (const auto & thePreemptionUs : theOptions.PreemptionUs)
+                    {
+                        const auto theFirstPoint = thePoints.size();
+                        for (const auto & theThresholdUs : theOptions.ThresholdsUs)
+                        {
+                            thePoints.push_back({ theBackend, theThresholdUs, theEdgeJitterUs,
+                                                  theRiseSkewUs, thePreemptionUs, {} });
+                        }
+
+                        // Identical sensors and waveforms at every grid point and
+                        // for every backend, so that only the injected noise varies.
+                        std::mt19937 theGenerator(theOptions.Seed);
+
+                        SimulatedJitter_t theJitter;
+                        theJitter.EdgeJitterUs = theEdgeJitterUs;
+                        theJitter.RiseSkewUs   = theRiseSkewUs;
+
+                        auto theCpu = theOptions.Cpu;
+                        theCpu.PreemptionUs = thePreemptionUs;
+
+                        theRun(theJitter, theCpu, theGenerator, theOptions, thePoints, theFirstPoint);
+                    }
+                }
+            }
+        }
+
+        return thePoints;
+    }
+
+    double ErrorRate(const Point_t & thePoint)
+    {
+        std::size_t theTotal = 0;
+        for (const auto & theCount : thePoint.Outcomes)
+        {
+            theTotal += theCount;
+        }
+        return (theTotal > 0) ? (1.0 - (static_cast<double>(thePoint.Outcomes[0]) / theTotal)) : 0.0;
+    }
+
+    void PrintCsv(const std::vector<Point_t> & thePoints)
+    {
+        printf("backend,threshold_us,edge_jitter_us,rise_skew_us,preemption_us,"
+               "success,bus_busy,not_detected,ack_too_long,sync_timeout,data_timeout,bad_checksum,too_fast_reads,"
+               "undetected,error_rate\n");
+        for (const auto & p : thePoints)
+        {
+            printf("%s,%u,%.1f,%.1f,%.1f", p.Backend, static_cast<unsigned>(p.ThresholdUs),
+                   p.EdgeJitterUs, p.RiseSkewUs, p.PreemptionUs);
+            for (const auto & theCount : p.Outcomes)
+            {
+                printf(",%zu", theCount);
+            }
+            printf(",%.6f\n", ErrorRate(p));
+        }
+    }
+
+    void PrintJson(const std::vector<Point_t> & thePoints, const Options_t & theOptions)
+    {
+        static const char * const OUTCOME_NAMES[OUTCOME_COUNT] =
+        {
+            "success", "bus_busy", "not_detected", "ack_too_long", "sync_timeout",
+            "data_timeout", "bad_checksum", "too_fast_reads", "undetected"
+        };
+
+        printf("{\n  \"model\": \"%s\",\n  \"trials\": %zu,\n  \"preemption_period_us\": %.1f,\n  \"surface\": [\n",
+               theOptions.IsDHT22 ? "DHT22" : "DHT11", theOptions.Trials, theOptions.Cpu.PreemptionPeriodUs);
+        for (std::size_t i = 0; i < thePoints.size(); i++)
+        {
+            const auto & p = thePoints[i];
+            printf("    {\"backend\": \"%s\", \"threshold_us\": %u, \"edge_jitter_us\": %.1f, "
+                   "\"rise_skew_us\": %.1f, \"preemption_us\": %.1f, \"status\": {",
+                   p.Backend, static_cast<unsigned>(p.ThresholdUs), p.EdgeJitterUs, p.RiseSkewUs, p.PreemptionUs);
+            for (std::size_t j = 0; j < OUTCOME_COUNT; j++)
+            {
+                printf("%s\"%s\": %zu", (j > 0) ? ", " : "", OUTCOME_NAMES[j], p.Outcomes[j]);
+            }
+            printf("}, \"error_rate\": %.6f}%s\n", ErrorRate(p), (i + 1 < thePoints.size()) ? "," : "");
+        }
+        printf("  ]\n}\n");
+    }
+
+    template <typename V>
+    bool ParseList(const char * theText, std::vector<V> & theValues)
+    {
+        theValues.clear();
+        std::string theList(theText);
+        std::size_t theStart = 0;
+
+        while (theStart <= theList.size())
+        {
+            auto theEnd = theList.find(',', theStart);
+            if (theEnd == std::string::npos)
+            {
+                theEnd = theList.size();
+            }
+            const auto theItem = theList.substr(theStart, theEnd - theStart);
+            if (theItem.empty())
+            {
+                return false;
+            }
+            theValues.push_back(static_cast<V>(strtod(theItem.c_str(), nullptr)));
+            theStart = theEnd + 1;
+        }
+        return !theValues.empty();
+    }
+
+    void PrintUsage(const char * theProgram)
+    {
+        fprintf(stderr, "Usage: %s [--format csv|json] [--model dht11|dht22] [--trials N] [--seed N]\n"
+                        "       [--edge-jitter-us a,b,..] [--rise-skew-us a,b,..] [--preemption-us a,b,..]\n"
+                        "       [--preemption-period-us X] [--thresholds a,b,..]\n"
+                        "       [--pin-read-cost-us X] [--clock-read-cost-us X]\n", theProgram);
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    Options_t theOptions;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+        bool isValid = hasValue;
+
+        if (!hasValue)
+        {
+            isValid = false;
+        }
+        else if (!strcmp(argv[i], "--format"))
+        {
+            theOptions.Json = !strcmp(argv[++i], "json");
+        }
+        else if (!strcmp(argv[i], "--model"))
+        {
+            theOptions.IsDHT22 = !strcmp(argv[++i], "dht22");
+        }
+        else if (!strcmp(argv[i], "--trials"))
+        {
+            theOptions.Trials = std::max(1ul, strtoul(argv[++i], nullptr, 10));
+        }
+        else if (!strcmp(argv[i], "--seed"))
+        {
+            theOptions.Seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (!strcmp(argv[i], "--edge-jitter-us"))
+        {
+            isValid = ParseList(argv[++i], theOptions.EdgeJitterUs);
+        }
+        else if (!strcmp(argv[i], "--rise-skew-us"))
+        {
+            isValid = ParseList(argv[++i], theOptions.RiseSkewUs);
+        }
+        else if (!strcmp(argv[i], "--preemption-us"))
+        {
+            isValid = ParseList(argv[++i], theOptions.PreemptionUs);
+        }
+        else if (!strcmp(argv[i], "--preemption-period-us"))
+        {
+            theOptions.Cpu.PreemptionPeriodUs = strtod(argv[++i], nullptr);
+            isValid = (theOptions.Cpu.PreemptionPeriodUs > 0.0);
+        }
+        else if (!strcmp(argv[i], "--thresholds"))
+        {
+            isValid = ParseList(argv[++i], theOptions.ThresholdsUs);
+        }
+        else if (!strcmp(argv[i], "--pin-read-cost-us"))
+        {
+            theOptions.Cpu.PinReadCostUs = strtod(argv[++i], nullptr);
+        }
+        else if (!strcmp(argv[i], "--clock-read-cost-us"))
+        {
+            theOptions.Cpu.ClockReadCostUs = strtod(argv[++i], nullptr);
+        }
+        else
+        {
+            isValid = false;
+        }
+
+        if (!isValid)
+        {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    const auto thePoints = theOptions.IsDHT22 ? Run<DHT22_t>(theOptions) : Run<DHT11_t>(theOptions);
+
+    if (theOptions.Json)
+    {
+        PrintJson(thePoints, theOptions);
+    }
+    else
+    {
+        PrintCsv(thePoints);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,305 @@
+/***********************************************************************
+* @file      DHT11MeasurementHistoryTest.cpp
+*
+*    Host-side test of the multi-resolution measurement history (see
+*    NuerteyMeasurementHistory.h).
+*
+* @brief   Feeds synthetic readings through Update() and checks each
+*          Query() summary (count, min, max and mean of both temperature
+*          and humidity) against a brute-force summary of the readings the
+*          history should still be able to account for:
+*
+*            - cascade: 100 minutes of readings spanning two hour
+*              boundaries. Whole hours, single minutes, the open hour and
+*              the whole history are all summarized exactly;
+*            - ragged ends: ranges starting and ending part-way through
+*              hours and minutes are made up from the finer tiers, down to
+*              raw readings, and are still exact;
+*            - aging: with tiny tiers, five hours of readings. A range that
+*              has aged out of every tier is empty; one whose start has aged
+*              out of the finer tiers loses exactly that ragged start;
+*            - rejects: repeated sequence numbers, readings older than the
+*              latest, other sensors, failures and stale (cached) readings
+*              are all ignored by Update().
+*
+* @note    Uses the host stand-in for Mbed in tools/host, e.g.:
+*
+*            g++ -std=c++20 -O2 -Ihost -I.. DHT11MeasurementHistoryTest.cpp -o DHT11MeasurementHistoryTest
+*            ./DHT11MeasurementHistoryTest
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include "mbed.h"
+#include "DHT11TestSupport.h"
+#include "NuerteyMeasurementHistory.h"
+
+namespace
+{
+    constexpr PinName  SENSOR_PIN = PE_13;
+    constexpr uint32_t MINUTE_S   = 60;
+    constexpr uint32_t HOUR_S     = 3600;
+    constexpr uint32_t EPOCH_S    = 10 * HOUR_S;      // Well clear of zero.
+
+    struct Reading_t
+    {
+        uint32_t TimeS;
+        int16_t  Temperature;
+        uint16_t Humidity;
+    };
+
+    void ExpectSummary(Checker_t & theChecker, const HistorySummary_t & theActual, const HistorySummary_t & theExpected, const char * theWhat)
+    {
+        const auto isEqual = (theActual.Count == theExpected.Count)
+            && ((theActual.Count == 0)
+             || ((theActual.MinimumTemperatureTenths == theExpected.MinimumTemperatureTenths)
+              && (theActual.MaximumTemperatureTenths == theExpected.MaximumTemperatureTenths)
+              && (theActual.MeanTemperatureTenths == theExpected.MeanTemperatureTenths)
+              && (theActual.MinimumHumidityTenths == theExpected.MinimumHumidityTenths)
+              && (theActual.MaximumHumidityTenths == theExpected.MaximumHumidityTenths)
+              && (theActual.MeanHumidityTenths == theExpected.MeanHumidityTenths)));
+
+        theChecker.Expect(isEqual, theWhat);
+        if (!isEqual)
+        {
+            fprintf(stderr, "    got      count=%u T=[%d %d %d] H=[%u %u %u]\n", theActual.Count,
+                    theActual.MinimumTemperatureTenths, theActual.MaximumTemperatureTenths, theActual.MeanTemperatureTenths,
+                    theActual.MinimumHumidityTenths, theActual.MaximumHumidityTenths, theActual.MeanHumidityTenths);
+            fprintf(stderr, "    expected count=%u T=[%d %d %d] H=[%u %u %u]\n", theExpected.Count,
+                    theExpected.MinimumTemperatureTenths, theExpected.MaximumTemperatureTenths, theExpected.MeanTemperatureTenths,
+                    theExpected.MinimumHumidityTenths, theExpected.MaximumHumidityTenths, theExpected.MeanHumidityTenths);
+        }
+    }
+
+    uint64_t ToUs(const uint32_t & theTimeS) { return static_cast<uint64_t>(theTimeS) * 1'000'000; }
+
+    Measurement_t MakeMeasurement(const Reading_t & theReading, const uint32_t & theSequenceNumber)
+    {
+        // Sub-second offsets, as real sample times have; the history
+        // truncates them.
+        const auto theTimeUs = ToUs(theReading.TimeS) + (theSequenceNumber * 7919) % 1'000'000;
+
+        return Measurement_t{SENSOR_PIN, theReading.Temperature, theReading.Humidity, SensorStatus_t::SUCCESS,
+                             4200, theSequenceNumber, theTimeUs, theTimeUs};
+    }
+
+    // Readings every theStepS for theDurationS, varying enough that a
+    // wrong bucket shows in the extremes as well as the means.
+    std::vector<Reading_t> MakeReadings(const uint32_t & theStartS, const uint32_t & theDurationS, const uint32_t & theStepS)
+    {
+        std::vector<Reading_t> theReadings;
+        for (uint32_t t = 0, i = 0; t < theDurationS; t += theStepS, i++)
+        {
+            theReadings.push_back(Reading_t{theStartS + t, static_cast<int16_t>(150 + static_cast<int32_t>((i * 37) % 101) - 50),
+                                            static_cast<uint16_t>(400 + (i * 53) % 211)});
+        }
+        return theReadings;
+    }
+
+    // Brute force over the readings in [theFromS, theToS).
+    HistorySummary_t Summarize(const std::vector<Reading_t> & theReadings, const uint32_t & theFromS, const uint32_t & theToS)
+    {
+        HistorySummary_t theSummary{};
+        int32_t theTemperatureSum = 0;
+        int32_t theHumiditySum = 0;
+
+        for (const auto & r : theReadings)
+        {
+            if ((r.TimeS < theFromS) || (r.TimeS >= theToS))
+            {
+                continue;
+            }
+
+            if (theSummary.Count++ == 0)
+            {
+                theSummary.MinimumTemperatureTenths = theSummary.MaximumTemperatureTenths = r.Temperature;
+                theSummary.MinimumHumidityTenths = theSummary.MaximumHumidityTenths = r.Humidity;
+            }
+            theSummary.MinimumTemperatureTenths = std::min(theSummary.MinimumTemperatureTenths, r.Temperature);
+            theSummary.MaximumTemperatureTenths = std::max(theSummary.MaximumTemperatureTenths, r.Temperature);
+            theSummary.MinimumHumidityTenths = std::min(theSummary.MinimumHumidityTenths, r.Humidity);
+            theSummary.MaximumHumidityTenths = std::max(theSummary.MaximumHumidityTenths, r.Humidity);
+            theTemperatureSum += r.Temperature;
+            theHumiditySum += r.Humidity;
+        }
+
+        if (theSummary.Count != 0)
+        {
+            theSummary.MeanTemperatureTenths = static_cast<int16_t>(theTemperatureSum / static_cast<int32_t>(theSummary.Count));
+            theSummary.MeanHumidityTenths = static_cast<uint16_t>(theHumiditySum / static_cast<int32_t>(theSummary.Count));
+        }
+        return theSummary;
+    }
+
+    template <typename History>
+    void Record(History & theHistory, const std::vector<Reading_t> & theReadings, uint32_t & theSequenceNumber)
+    {
+        for (const auto & r : theReadings)
+        {
+            theHistory.Update(MakeMeasurement(r, ++theSequenceNumber));
+        }
+    }
+
+    void CheckCascade(Checker_t & theChecker)
+    {
+        // 10:50 to 12:30, every 5s: 100 minutes across two hour boundaries,
+        // all of them within the 120 minutes kept, the last 320s raw.
+        const auto theStartS = EPOCH_S + 50 * MINUTE_S;
+        const auto theReadings = MakeReadings(theStartS, 100 * MINUTE_S, 5);
+        const auto theLatestS = theReadings.back().TimeS;
+
+        NuerteyMeasurementHistory<> theHistory(SENSOR_PIN);
+        uint32_t theSequenceNumber = 0;
+        Record(theHistory, theReadings, theSequenceNumber);
+
+        theChecker.Expect(theHistory.GetLatestTimeUs() == ToUs(theLatestS), "latest time is not that of the last reading");
+
+        const auto theHour11S = EPOCH_S + HOUR_S;
+        const auto theHour12S = EPOCH_S + 2 * HOUR_S;
+
+        ExpectSummary(theChecker, theHistory.Query(0, ToUs(theLatestS + 1)),
+                                 Summarize(theReadings, 0, theLatestS + 1), "whole history");
+        ExpectSummary(theChecker, theHistory.QueryLast(24 * HOUR_S * 1000),
+                                 Summarize(theReadings, 0, theLatestS + 1), "QueryLast() of a day");
+        ExpectSummary(theChecker, theHistory.Query(ToUs(theHour11S), ToUs(theHour12S)),
+                                 Summarize(theReadings, theHour11S, theHour12S), "closed hour");
+        ExpectSummary(theChecker, theHistory.Query(ToUs(theHour12S), ToUs(theLatestS + 1)),
+                                 Summarize(theReadings, theHour12S, theLatestS + 1), "open hour");
+        ExpectSummary(theChecker, theHistory.Query(ToUs(theStartS), ToUs(theHour11S)),
+                                 Summarize(theReadings, theStartS, theHour11S), "first, partial, hour");
+        ExpectSummary(theChecker, theHistory.Query(ToUs(theHour11S + 17 * MINUTE_S), ToUs(theHour11S + 18 * MINUTE_S)),
+                                 Summarize(theReadings, theHour11S + 17 * MINUTE_S, theHour11S + 18 * MINUTE_S), "closed minute");
+
+        // Minute-aligned start in the previous hour; raw-only end within
+        // the open minute.
+        const auto theRaggedFromS = theHour11S - 7 * MINUTE_S;
+        const auto theRaggedToS = theLatestS - 23;
+        ExpectSummary(theChecker, theHistory.Query(ToUs(theRaggedFromS), ToUs(theRaggedToS)),
+                                 Summarize(theReadings, theRaggedFromS, theRaggedToS), "ragged ends across an hour");
+
+        // Both ends mid-minute, inside the raw window.
+        const auto theRawFromS = theLatestS - 250;
+        ExpectSummary(theChecker, theHistory.Query(ToUs(theRawFromS), ToUs(theRaggedToS)),
+                                 Summarize(theReadings, theRawFromS, theRaggedToS), "ragged ends within raw readings");
+
+        // Sub-second query ends round up to the next second, as the
+        // readings' own times are truncated.
+        ExpectSummary(theChecker, theHistory.Query(ToUs(theRawFromS) - 400'000, ToUs(theRaggedToS) + 1),
+                                 Summarize(theReadings, theRawFromS, theRaggedToS + 1), "sub-second ends");
+
+        theChecker.Expect(theHistory.Query(ToUs(theHour12S), ToUs(theHour12S)).Count == 0, "empty range is not empty");
+        theChecker.Expect(theHistory.Query(ToUs(theLatestS + 1), ToUs(theLatestS + HOUR_S)).Count == 0, "the future is not empty");
+    }
+
+    void CheckAging(Checker_t & theChecker)
+    {
+        // 8 raw readings (80s), 4+1 minutes and 3+1 hours.
+        using History_t = NuerteyMeasurementHistory<8, 4, 3>;
+
+        const auto theReadings = MakeReadings(EPOCH_S, 5 * HOUR_S + 30 * MINUTE_S, 10);
+        const auto theLatestS = theReadings.back().TimeS;     // 15:29:50.
+
+        History_t theHistory(SENSOR_PIN);
+        uint32_t theSequenceNumber = 0;
+        Record(theHistory, theReadings, theSequenceNumber);
+
+        const auto theOldestHourS = EPOCH_S + 2 * HOUR_S;     // 12:00, the oldest of the 3 closed hours.
+        const auto theOldestMinuteS = theLatestS - (theLatestS % MINUTE_S) - 4 * MINUTE_S;
+        const auto theOldestRawS = theLatestS - 70;
+
+        ExpectSummary(theChecker, theHistory.Query(ToUs(EPOCH_S), ToUs(theOldestHourS)),
+                                 HistorySummary_t{}, "range aged out of every tier");
+        ExpectSummary(theChecker, theHistory.Query(0, ToUs(theLatestS + 1)),
+                                 Summarize(theReadings, theOldestHourS, theLatestS + 1), "whole history after aging");
+
+        // Starting mid-hour, two hours back: that hour's rollup starts too
+        // early, and its minutes and raw readings are long gone, hence the
+        // summary starts at the next hour.
+        const auto theMidHourS = theOldestHourS + HOUR_S + 20 * MINUTE_S;
+        ExpectSummary(theChecker, theHistory.Query(ToUs(theMidHourS), ToUs(theLatestS + 1)),
+                                 Summarize(theReadings, theOldestHourS + 2 * HOUR_S, theLatestS + 1),
+                                 "ragged start aged out of the finer tiers");
+
+        // Mid-minute within the kept minutes: only raw readings could fill
+        // in that minute, and they have aged out.
+        const auto theMidMinuteS = theOldestMinuteS + MINUTE_S + 30;
+        ExpectSummary(theChecker, theHistory.Query(ToUs(theMidMinuteS), ToUs(theLatestS + 1)),
+                                 Summarize(theReadings, theOldestMinuteS + 2 * MINUTE_S, theLatestS + 1),
+                                 "ragged start aged out of raw readings");
+
+        // Within the raw window everything is still there.
+        ExpectSummary(theChecker, theHistory.Query(ToUs(theOldestRawS + 5), ToUs(theLatestS + 1)),
+                                 Summarize(theReadings, theOldestRawS + 5, theLatestS + 1), "raw window after aging");
+    }
+
+    void CheckRejects(Checker_t & theChecker)
+    {
+        NuerteyMeasurementHistory<> theHistory(SENSOR_PIN);
+        const auto theReadings = MakeReadings(EPOCH_S, 5 * MINUTE_S, 10);
+        uint32_t theSequenceNumber = 0;
+        Record(theHistory, theReadings, theSequenceNumber);
+
+        const auto theLatestS = theReadings.back().TimeS;
+        const auto theExpected = Summarize(theReadings, 0, theLatestS + 1);
+        const auto Unchanged = [&](const char * theWhat)
+        {
+            ExpectSummary(theChecker, theHistory.Query(0, ToUs(theLatestS + HOUR_S)), theExpected, theWhat);
+            theChecker.Expect(theHistory.GetLatestTimeUs() == ToUs(theLatestS), theWhat);
+        };
+
+        const Reading_t theOutlier{theLatestS + 5, 999, 999};
+
+        // The device repeats the sequence number of a reading it serves
+        // again; so does a callback registered twice.
+        theHistory.Update(MakeMeasurement(theOutlier, theSequenceNumber));
+        Unchanged("repeated sequence number recorded");
+
+        theHistory.Update(MakeMeasurement(Reading_t{theLatestS - 30, 999, 999}, theSequenceNumber + 1));
+        Unchanged("reading older than the latest recorded");
+
+        auto theMeasurement = MakeMeasurement(theOutlier, theSequenceNumber + 1);
+        theMeasurement.SensorPin = PE_14;
+        theHistory.Update(theMeasurement);
+        Unchanged("another sensor's reading recorded");
+
+        theMeasurement = MakeMeasurement(theOutlier, theSequenceNumber + 1);
+        theMeasurement.Status = SensorStatus_t::ERROR_BAD_CHECKSUM;
+        theHistory.Update(theMeasurement);
+        Unchanged("failed reading recorded");
+
+        theMeasurement = MakeMeasurement(theOutlier, theSequenceNumber + 1);
+        theMeasurement.CaptureTimeUs += 2'000'000;
+        theHistory.Update(theMeasurement);
+        Unchanged("stale reading recorded");
+
+        // A new sequence number at the latest second is a reading still.
+        auto theAccepted = theReadings;
+        theAccepted.push_back(Reading_t{theLatestS, 999, 999});
+        theHistory.Update(MakeMeasurement(theAccepted.back(), theSequenceNumber + 1));
+        ExpectSummary(theChecker, theHistory.Query(0, ToUs(theLatestS + 1)),
+                                 Summarize(theAccepted, 0, theLatestS + 1), "reading at the latest second rejected");
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    if (!ParseOptions(argc, argv, {}))
+    {
+        return EXIT_FAILURE;
+    }
+
+    Checker_t theChecker;
+    CheckCascade(theChecker);
+    CheckAging(theChecker);
+    CheckRejects(theChecker);
+
+    return theChecker.Finish();
+}
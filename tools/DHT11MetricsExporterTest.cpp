@@ -0,0 +1,292 @@
+/***********************************************************************
+* @file      DHT11MetricsExporterTest.cpp
+*
+*    Host-side test of the Prometheus text exporter (see
+*    NuerteyMetricsExporter.h).
+*
+* @brief   Feeds a known sequence of readings through Update() and checks:
+*
+*            - the exposition text against a golden copy, byte for byte:
+*              HELP/TYPE preambles, label sets, fixed-point values,
+*              per-status read counters, the cumulative latency histogram
+*              with its +Inf, _sum and _count series, and the failure and
+*              health gauges. A sensor yet to read successfully has no
+*              temperature or humidity sample;
+*            - the exposition format generically: every sample line is
+*              "name{labels} value", follows its family's TYPE line, and
+*              histogram buckets never decrease up to +Inf == _count;
+*            - chunking: rendered through the smallest chunk buffer, the
+*              text is unchanged and every chunk ends on a line boundary;
+*            - HTTP: a scrape of /metrics (with or without a query string)
+*              over the loopback returns the 200 header followed by the
+*              very same text, and any other path, /metricsfoo included,
+*              a 404.
+*
+* @note    Uses the host stand-in for Mbed in tools/host, e.g.:
+*
+*            g++ -std=c++20 -O2 -Ihost -I.. DHT11MetricsExporterTest.cpp -o DHT11MetricsExporterTest
+*            ./DHT11MetricsExporterTest
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include "mbed.h"
+#include "DHT11TestSupport.h"
+#include "NuerteyMetricsExporter.h"
+
+namespace
+{
+    constexpr uint16_t METRICS_PORT = 9100;
+
+    // Sensor "77" (PE_13 on the host) read once successfully, then failed
+    // a checksum and a slow read with a status unknown to the exporter
+    // (counted in the histogram, not in dht_reads_total); sensor "78"
+    // (PE_14) has never been detected.
+    constexpr const char GOLDEN_EXPOSITION[] =
+        "# HELP dht_temperature_celsius Latest successfully read temperature.\n"
+        "# TYPE dht_temperature_celsius gauge\n"
+        "dht_temperature_celsius{sensor=\"77\",model=\"dht11\"} -12.3\n"
+        "# HELP dht_humidity_percent Latest successfully read relative humidity.\n"
+        "# TYPE dht_humidity_percent gauge\n"
+        "dht_humidity_percent{sensor=\"77\",model=\"dht11\"} 41.0\n"
+        "# HELP dht_reads_total Bus reads attempted, by outcome.\n"
+        "# TYPE dht_reads_total counter\n"
+        "dht_reads_total{sensor=\"77\",model=\"dht11\",status=\"success\"} 1\n"
+        "dht_reads_total{sensor=\"77\",model=\"dht11\",status=\"bus_busy\"} 0\n"
+        "dht_reads_total{sensor=\"77\",model=\"dht11\",status=\"not_detected\"} 0\n"
+        "dht_reads_total{sensor=\"77\",model=\"dht11\",status=\"ack_too_long\"} 0\n"
+        "dht_reads_total{sensor=\"77\",model=\"dht11\",status=\"sync_timeout\"} 0\n"
+        "dht_reads_total{sensor=\"77\",model=\"dht11\",status=\"data_timeout\"} 0\n"
+        "dht_reads_total{sensor=\"77\",model=\"dht11\",status=\"bad_checksum\"} 1\n"
+        "dht_reads_total{sensor=\"77\",model=\"dht11\",status=\"too_fast_reads\"} 0\n"
+        "dht_reads_total{sensor=\"78\",model=\"dht22\",status=\"success\"} 0\n"
+        "dht_reads_total{sensor=\"78\",model=\"dht22\",status=\"bus_busy\"} 0\n"
+        "dht_reads_total{sensor=\"78\",model=\"dht22\",status=\"not_detected\"} 3\n"
+        "dht_reads_total{sensor=\"78\",model=\"dht22\",status=\"ack_too_long\"} 0\n"
+        "dht_reads_total{sensor=\"78\",model=\"dht22\",status=\"sync_timeout\"} 0\n"
+        "dht_reads_total{sensor=\"78\",model=\"dht22\",status=\"data_timeout\"} 0\n"
+        "dht_reads_total{sensor=\"78\",model=\"dht22\",status=\"bad_checksum\"} 0\n"
+        "dht_reads_total{sensor=\"78\",model=\"dht22\",status=\"too_fast_reads\"} 0\n"
+        "# HELP dht_read_duration_microseconds Duration of bus reads.\n"
+        "# TYPE dht_read_duration_microseconds histogram\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"77\",model=\"dht11\",le=\"2500\"} 0\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"77\",model=\"dht11\",le=\"5000\"} 1\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"77\",model=\"dht11\",le=\"10000\"} 1\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"77\",model=\"dht11\",le=\"20000\"} 1\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"77\",model=\"dht11\",le=\"25000\"} 2\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"77\",model=\"dht11\",le=\"50000\"} 2\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"77\",model=\"dht11\",le=\"+Inf\"} 3\n"
+        "dht_read_duration_microseconds_sum{sensor=\"77\",model=\"dht11\"} 85200\n"
+        "dht_read_duration_microseconds_count{sensor=\"77\",model=\"dht11\"} 3\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"78\",model=\"dht22\",le=\"2500\"} 3\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"78\",model=\"dht22\",le=\"5000\"} 3\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"78\",model=\"dht22\",le=\"10000\"} 3\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"78\",model=\"dht22\",le=\"20000\"} 3\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"78\",model=\"dht22\",le=\"25000\"} 3\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"78\",model=\"dht22\",le=\"50000\"} 3\n"
+        "dht_read_duration_microseconds_bucket{sensor=\"78\",model=\"dht22\",le=\"+Inf\"} 3\n"
+        "dht_read_duration_microseconds_sum{sensor=\"78\",model=\"dht22\"} 3000\n"
+        "dht_read_duration_microseconds_count{sensor=\"78\",model=\"dht22\"} 3\n"
+        "# HELP dht_consecutive_failures Failed reads since the last success.\n"
+        "# TYPE dht_consecutive_failures gauge\n"
+        "dht_consecutive_failures{sensor=\"77\",model=\"dht11\"} 2\n"
+        "dht_consecutive_failures{sensor=\"78\",model=\"dht22\"} 3\n"
+        "# HELP dht_sensor_healthy Whether the sensor is currently deemed healthy.\n"
+        "# TYPE dht_sensor_healthy gauge\n"
+        "dht_sensor_healthy{sensor=\"77\",model=\"dht11\"} 1\n"
+        "dht_sensor_healthy{sensor=\"78\",model=\"dht22\"} 0\n";
+
+    Measurement_t MakeMeasurement(const PinName & thePin, const SensorStatus_t & theStatus, const uint32_t & theDurationUs,
+                                  const int16_t & theTemperature = 0, const uint16_t & theHumidity = 0)
+    {
+        return Measurement_t{thePin, theTemperature, theHumidity, theStatus, theDurationUs, 1, 1'000'000, 1'000'000};
+    }
+
+    template <typename Exporter>
+    void Feed(Exporter & theExporter)
+    {
+        (void)theExporter.RegisterSensor(PE_13, "dht11");
+        (void)theExporter.RegisterSensor(PE_14, "dht22");
+
+        theExporter.Update(MakeMeasurement(PE_13, SensorStatus_t::SUCCESS, 4200, -123, 410));
+        theExporter.Update(MakeMeasurement(PE_13, SensorStatus_t::ERROR_BAD_CHECKSUM, 21000, 999, 999));
+        theExporter.Update(MakeMeasurement(PE_13, static_cast<SensorStatus_t>(-42), 60000));   // Unknown status.
+        for (auto i = 0; i < 3; i++)
+        {
+            theExporter.Update(MakeMeasurement(PE_14, SensorStatus_t::ERROR_NOT_DETECTED, 1000));
+        }
+        theExporter.Update(MakeMeasurement(PE_15, SensorStatus_t::SUCCESS, 4000, 100, 100));    // Not registered.
+    }
+
+    template <std::size_t CHUNK_SIZE_BYTES = 512, typename Exporter>
+    std::string Render(Exporter & theExporter, std::vector<std::string> * pTheChunks = nullptr)
+    {
+        char theChunk[CHUNK_SIZE_BYTES];
+        std::string theText;
+        theExporter.Render(theChunk, [&](const char * theData, std::size_t theLength)
+        {
+            theText.append(theData, theLength);
+            if (pTheChunks != nullptr)
+            {
+                pTheChunks->emplace_back(theData, theLength);
+            }
+        });
+        return theText;
+    }
+
+    // Generic checks of the text exposition format, as far as we use it.
+    void CheckFormat(Checker_t & theChecker, const std::string & theText)
+    {
+        std::map<std::string, std::string> theTypes;
+        std::map<std::string, long>        theLastBucket;
+        std::string theFamily;
+        bool isWellFormed = !theText.empty() && (theText.back() == '\n');
+        bool isCumulative = true;
+        bool isInfCount = true;
+
+        std::size_t theStart = 0;
+        while (theStart < theText.size())
+        {
+            const auto theEnd = theText.find('\n', theStart);
+            const auto theLine = theText.substr(theStart, theEnd - theStart);
+            theStart = (theEnd == std::string::npos) ? theText.size() : theEnd + 1;
+
+            char theName[96];
+            char theType[16];
+            if (sscanf(theLine.c_str(), "# TYPE %95s %15s", theName, theType) == 2)
+            {
+                theFamily = theName;
+                theTypes[theFamily] = theType;
+                continue;
+            }
+            if (theLine.rfind("# HELP ", 0) == 0)
+            {
+                continue;
+            }
+
+            // name{labels} value
+            const auto theBrace = theLine.find('{');
+            const auto theClose = theLine.find("} ");
+            if ((theBrace == std::string::npos) || (theClose == std::string::npos) || (theClose < theBrace)
+             || (theLine.find_first_not_of("-+.0123456789", theClose + 2) != std::string::npos)
+             || (theLine.compare(0, theFamily.size(), theFamily) != 0) || (theTypes.count(theFamily) == 0))
+            {
+                fprintf(stderr, "    malformed: %s\n", theLine.c_str());
+                isWellFormed = false;
+                continue;
+            }
+
+            const auto theMetric = theLine.substr(0, theBrace);
+            const auto theValue = strtol(theLine.c_str() + theClose + 2, nullptr, 10);
+            const auto theSensor = theLine.substr(theBrace, theLine.find(',', theBrace) - theBrace);
+
+            if (theMetric == theFamily + "_bucket")
+            {
+                auto theLast = theLastBucket.find(theSensor);
+                isCumulative = isCumulative && ((theLast == theLastBucket.end()) || (theValue >= theLast->second));
+                theLastBucket[theSensor] = theValue;
+            }
+            else if (theMetric == theFamily + "_count")
+            {
+                isInfCount = isInfCount && (theLastBucket[theSensor] == theValue);
+            }
+        }
+
+        theChecker.Expect(isWellFormed, "exposition lines malformed or outside their family");
+        theChecker.Expect(isCumulative, "histogram buckets decrease");
+        theChecker.Expect(isInfCount, "the +Inf bucket differs from _count");
+        theChecker.Expect((theTypes.size() == 6) && (theTypes["dht_read_duration_microseconds"] == "histogram")
+                       && (theTypes["dht_reads_total"] == "counter"), "metric families or their types wrong");
+    }
+
+    std::string Scrape(EventQueue & theQueue, const char * theRequest)
+    {
+        TCPSocket theSocket;
+        (void)theSocket.open(NetworkInterface::get_default_instance());
+        if (theSocket.connect(SocketAddress("127.0.0.1", METRICS_PORT)) != NSAPI_ERROR_OK)
+        {
+            return std::string();
+        }
+        (void)theSocket.send(theRequest, static_cast<unsigned>(strlen(theRequest)));
+        theQueue.dispatch(0);
+
+        std::string theResponse;
+        char theBuffer[256];
+        nsapi_size_or_error_t theLength;
+        while ((theLength = theSocket.recv(theBuffer, sizeof(theBuffer))) > 0)
+        {
+            theResponse.append(theBuffer, static_cast<std::size_t>(theLength));
+        }
+        return theResponse;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    if (!ParseOptions(argc, argv, {}))
+    {
+        return EXIT_FAILURE;
+    }
+
+    Checker_t theChecker;
+
+    NuerteyMetricsExporter<2> theExporter;
+    Feed(theExporter);
+    theChecker.Expect(!theExporter.RegisterSensor(PE_15, "dht11"), "more sensors registered than there is room for");
+
+    const auto theText = Render(theExporter);
+    theChecker.Expect(theText == GOLDEN_EXPOSITION, "exposition differs from the golden copy");
+    if (theText != GOLDEN_EXPOSITION)
+    {
+        fprintf(stderr, "%s", theText.c_str());
+    }
+    CheckFormat(theChecker, theText);
+
+    // The smallest chunk buffer allowed; the text must not change.
+    std::vector<std::string> theChunks;
+    theChecker.Expect(Render<128>(theExporter, &theChunks) == theText, "chunked rendering differs");
+    theChecker.Expect(theChunks.size() > 10, "small chunks were not used");
+    theChecker.Expect(std::all_of(theChunks.begin(), theChunks.end(), [](const std::string & c)
+                      { return !c.empty() && (c.size() < 128) && (c.back() == '\n'); }),
+                      "a chunk is oversized or splits a line");
+
+    // A success resets the failure run and restores health.
+    theExporter.Update(MakeMeasurement(PE_14, SensorStatus_t::SUCCESS, 4000, 5, 990));
+    const auto theRecovered = Render(theExporter);
+    theChecker.Expect(theRecovered.find("dht_sensor_healthy{sensor=\"78\",model=\"dht22\"} 1\n") != std::string::npos
+                   && theRecovered.find("dht_consecutive_failures{sensor=\"78\",model=\"dht22\"} 0\n") != std::string::npos
+                   && theRecovered.find("dht_temperature_celsius{sensor=\"78\",model=\"dht22\"} 0.5\n") != std::string::npos,
+                      "recovery not reflected in the gauges");
+
+    // Over HTTP.
+    EventQueue theQueue;
+    theChecker.Expect(theExporter.Start(NetworkInterface::get_default_instance(), theQueue, METRICS_PORT) == NSAPI_ERROR_OK,
+                      "exporter did not start");
+
+    const std::string theHeader = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nConnection: close\r\n\r\n";
+    theChecker.Expect(Scrape(theQueue, "GET /metrics HTTP/1.0\r\n\r\n") == theHeader + theRecovered,
+                      "scrape of /metrics is not the header plus the exposition");
+    theChecker.Expect(Scrape(theQueue, "GET / HTTP/1.0\r\n\r\n") == theHeader + theRecovered, "scrape of / failed");
+    theChecker.Expect(Scrape(theQueue, "GET /metrics?name[]=dht_sensor_healthy HTTP/1.0\r\n\r\n") == theHeader + theRecovered,
+                      "scrape of /metrics with a query string failed");
+    theChecker.Expect(Scrape(theQueue, "GET /favicon.ico HTTP/1.0\r\n\r\n").rfind("HTTP/1.0 404 Not Found\r\n", 0) == 0,
+                      "unknown path not answered with 404");
+    theChecker.Expect(Scrape(theQueue, "GET /metricsfoo HTTP/1.0\r\n\r\n").rfind("HTTP/1.0 404 Not Found\r\n", 0) == 0,
+                      "path merely starting with /metrics not answered with 404");
+
+    theExporter.Stop();
+    theChecker.Expect(Scrape(theQueue, "GET /metrics HTTP/1.0\r\n\r\n").empty(), "stopped exporter still serves");
+
+    printf("bytes=%zu chunks=%zu\n", theText.size(), theChunks.size());
+    return theChecker.Finish();
+}
@@ -0,0 +1,179 @@
+/***********************************************************************
+* @file      DHT11MpscQueueTest.cpp
+*
+*    Host-side concurrency test of the ISR-to-thread handoff queue (see
+*    NuerteyMpscQueue.h).
+*
+* @brief   --producers threads stand in for the capture ISRs of as many
+*          sensors. Each pushes --items elements tagged with its index and
+*          a running sequence number, retrying whenever the queue is full.
+*          One consumer thread pops, or Drain()s in bursts, until every
+*          element has arrived, and checks that:
+*
+*            - every element arrives exactly once, and in order per
+*              producer (each sequence number is the previous plus one);
+*            - the overflow count matches the pushes refused;
+*            - the high watermark never exceeds the capacity, and the
+*              queue ends empty.
+*
+*          The queue is kept small so that the full path is exercised too.
+*
+* @note    Build with ThreadSanitizer and run on the host, e.g.:
+*
+*            g++ -std=c++20 -O1 -g -fsanitize=thread -Ihost -I.. DHT11MpscQueueTest.cpp -o DHT11MpscQueueTest -lpthread
+*            ./DHT11MpscQueueTest --producers 8 --items 200000
+*
+*          Any race is reported by TSan; any lost, duplicated or reordered
+*          element by the test itself, which then fails.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include "DHT11TestSupport.h"
+#include "NuerteyMpscQueue.h"
+
+namespace
+{
+    constexpr std::size_t QUEUE_CAPACITY = 64;
+
+    struct Options_t
+    {
+        std::size_t Producers = 4;
+        uint32_t    Items = 100'000;
+    };
+
+    struct Element_t
+    {
+        uint32_t Producer;
+        uint32_t Sequence;
+    };
+
+    struct Consumed_t
+    {
+        std::vector<uint32_t> NextSequence;    // Per producer.
+        uint64_t              Received = 0;
+        uint64_t              OutOfOrder = 0;
+        uint64_t              BadProducer = 0;
+
+        explicit Consumed_t(const std::size_t & theProducers) : NextSequence(theProducers, 0) {}
+
+        void Check(const Element_t & theElement)
+        {
+            ++Received;
+            if (theElement.Producer >= NextSequence.size())
+            {
+                ++BadProducer;
+                return;
+            }
+
+            // A loss, duplicate or reordering all break the running sequence.
+            auto & theNext = NextSequence[theElement.Producer];
+            if (theElement.Sequence != theNext)
+            {
+                ++OutOfOrder;
+            }
+            theNext = theElement.Sequence + 1;
+        }
+    };
+}
+
+int main(int argc, char * argv[])
+{
+    Options_t theOptions;
+
+    if (!ParseOptions(argc, argv, { { "--producers", theOptions.Producers, 1 },
+                                    { "--items",     theOptions.Items,     1, UINT32_MAX } },
+                      "[--producers N] [--items N]"))
+    {
+        return EXIT_FAILURE;
+    }
+
+    NuerteyMpscQueue<Element_t, QUEUE_CAPACITY> theQueue;
+    std::atomic<uint64_t> theRefused(0);
+    std::atomic<bool>     isStarted(false);
+
+    std::vector<std::thread> theProducers;
+    for (std::size_t p = 0; p < theOptions.Producers; p++)
+    {
+        theProducers.emplace_back([&, p]()
+        {
+            while (!isStarted.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            for (uint32_t s = 0; s < theOptions.Items; s++)
+            {
+                while (!theQueue.Push(Element_t{static_cast<uint32_t>(p), s}))
+                {
+                    theRefused.fetch_add(1, std::memory_order_relaxed);
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    const auto theExpected = static_cast<uint64_t>(theOptions.Producers) * theOptions.Items;
+    Consumed_t theConsumed(theOptions.Producers);
+    uint64_t   theBursts = 0;
+
+    isStarted.store(true, std::memory_order_release);
+
+    // Alternate single pops with bounded bursts, as a worker thread might.
+    while (theConsumed.Received < theExpected)
+    {
+        Element_t theElement;
+        if (theQueue.Pop(theElement))
+        {
+            theConsumed.Check(theElement);
+        }
+
+        if (theQueue.Drain([&](const Element_t & e) { theConsumed.Check(e); }, QUEUE_CAPACITY / 4) == 0)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            ++theBursts;
+        }
+    }
+
+    for (auto & theProducer : theProducers)
+    {
+        theProducer.join();
+    }
+
+    Element_t theStray;
+    const auto isDrained = !theQueue.Pop(theStray) && (theQueue.GetSize() == 0);
+    const auto isAllInOrder = std::all_of(theConsumed.NextSequence.begin(), theConsumed.NextSequence.end(),
+                                          [&](const uint32_t & n) { return (n == theOptions.Items); });
+
+    printf("producers=%zu items=%u received=%llu out_of_order=%llu bad_producer=%llu "
+           "overflows=%u refused=%llu high_watermark=%u capacity=%zu bursts=%llu drained=%s\n",
+           theOptions.Producers, theOptions.Items,
+           static_cast<unsigned long long>(theConsumed.Received),
+           static_cast<unsigned long long>(theConsumed.OutOfOrder),
+           static_cast<unsigned long long>(theConsumed.BadProducer),
+           theQueue.GetOverflowCount(), static_cast<unsigned long long>(theRefused.load()),
+           theQueue.GetHighWatermark(), theQueue.GetCapacity(),
+           static_cast<unsigned long long>(theBursts), isDrained ? "yes" : "no");
+
+    const auto isPassed = (theConsumed.Received == theExpected) && (theConsumed.OutOfOrder == 0)
+                       && (theConsumed.BadProducer == 0) && isAllInOrder && isDrained
+                       && (theQueue.GetOverflowCount() == theRefused.load())
+                       && (theQueue.GetHighWatermark() <= QUEUE_CAPACITY);
+
+    Checker_t theChecker;
+    theChecker.Expect(isPassed, "Elements were lost, duplicated or reordered");
+    return theChecker.Finish();
+}
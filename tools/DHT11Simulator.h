@@ -0,0 +1,377 @@
+/***********************************************************************
+* @file      DHT11Simulator.h
+*
+*    Host-side simulation of DHT11/DHT22 sensors on their single-wire
+*    bus, for benchmarking and stress testing the driver's decode path
+*    off-target.
+*
+* @brief   Synthesize the waveform a sensor drives in reply to the start
+*          signal, and present it through the Pin and Clock concepts that
+*          CaptureBitWidths() (NuerteyDHT11Protocol.h) polls. The decode
+*          path under test is therefore the driver's own, not a model of
+*          it; only the GPIO and the microsecond ticker are simulated.
+*
+* @note    Simulated time is kept in (fractional) microseconds from the
+*          instant the MCU releases the line at the end of its start
+*          signal. Every pin sample and every clock read advance it by a
+*          configurable cost, which is what bounds the poll rate on a
+*          real MCU.
+*
+*          For stress testing, waveforms can be roughened with per-edge
+*          jitter and rise-time skew (SimulatedJitter_t), and the polling
+*          loop can be preempted periodically (SimulatedCpu_t), as by the
+*          RTOS tick and higher priority threads.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include "NuerteyDHT11Protocol.h"
+
+// Nominal datasheet timing of a sensor's reply, in microseconds.
+struct SimulatedTiming_t
+{
+    double ResponseDelayUs = 30.0;  // Release of the line to the sensor pulling it low.
+    double SyncLowUs       = 80.0;
+    double SyncHighUs      = 80.0;
+    double BitLowUs        = 50.0;
+    double ZeroHighUs      = 26.0;
+    double OneHighUs       = 70.0;
+    double EndLowUs        = 50.0;  // Low after the last bit, before releasing the bus.
+};
+
+// Cost of the MCU's polling primitives, in microseconds. The defaults
+// approximate a Cortex-M7 at 216 MHz timing with us_ticker_read(); the
+// DWT cycle counter (DHT11_CYCLE_COUNTER_ENABLED) is nearer 0.03 a read.
+struct SimulatedCpu_t
+{
+    double PinReadCostUs      = 0.05;
+    double ClockReadCostUs    = 0.20;
+    double EdgeRecordCostUs   = 0.05;    // Per-edge bookkeeping, see CapturePortEdges().
+    double PreemptionUs       = 0.0;     // Polling loop stalled this long...
+    double PreemptionPeriodUs = 1000.0;  // ...once per period (1 kHz RTOS tick).
+};
+
+// Bus noise, in microseconds. Edges are displaced by Gaussian jitter of
+// standard deviation EdgeJitterUs. Rising edges are further delayed by
+// RiseSkewUs, as the pull-up (unlike the sensor driving the line low)
+// charges the cable capacitance slowly.
+struct SimulatedJitter_t
+{
+    double EdgeJitterUs = 0.0;
+    double RiseSkewUs   = 0.0;
+};
+
+// Produce the frame a sensor would send for the given reading.
+template <typename T>
+inline DataFrame_t EncodeDataFrame(const int16_t & theTemperatureTenths, const uint16_t & theHumidityTenths)
+{
+    static_assert(TrueTypesEquivalent<T, DHT11_t>::value
+               || TrueTypesEquivalent<T, DHT22_t>::value,
+    "Hey! Only DHT11, or DHT22 data frames can be encoded!!");
+
+    DataFrame_t theDataFrame = {};
+
+    // As an alternative to SFINAE template techniques:
+    if constexpr (std::is_same<T, DHT11_t>::value)
+    {
+        theDataFrame[0] = static_cast<uint8_t>(theHumidityTenths / 10);
+        theDataFrame[2] = static_cast<uint8_t>(theTemperatureTenths / 10);
+    }
+    else if constexpr (std::is_same<T, DHT22_t>::value)
+    {
+        const auto theMagnitude = static_cast<uint16_t>(std::abs(theTemperatureTenths));
+
+        theDataFrame[0] = static_cast<uint8_t>(theHumidityTenths >> 8);
+        theDataFrame[1] = static_cast<uint8_t>(theHumidityTenths & 0xFF);
+        theDataFrame[2] = static_cast<uint8_t>(((theMagnitude >> 8) & 0x7F) | ((theTemperatureTenths < 0) ? 0x80 : 0x00));
+        theDataFrame[3] = static_cast<uint8_t>(theMagnitude & 0xFF);
+    }
+    theDataFrame[4] = static_cast<uint8_t>(theDataFrame[0] + theDataFrame[1] + theDataFrame[2] + theDataFrame[3]);
+
+    return theDataFrame;
+}
+
+// The line as a sorted list of level change timestamps. The line idles
+// high (pulled up) before the first edge, and levels alternate thereafter.
+class SimulatedWaveform
+{
+public:
+    SimulatedWaveform() = default;
+
+    static SimulatedWaveform FromFrame(const DataFrame_t & theDataFrame, const SimulatedTiming_t & theTiming)
+    {
+        SimulatedWaveform theWaveform;
+        auto & theEdges = theWaveform.m_TheEdgesUs;
+        theEdges.reserve(DATA_FRAME_EDGE_COUNT);
+
+        auto t = theTiming.ResponseDelayUs;
+        theEdges.push_back(t);                           // Sensor pulls low,
+        theEdges.push_back(t += theTiming.SyncLowUs);    // releases,
+        theEdges.push_back(t += theTiming.SyncHighUs);   // and opens bit 0.
+
+        for (std::size_t i = 0; i < DATA_FRAME_SIZE_BITS; i++)
+        {
+            const bool isOne = (theDataFrame[i / 8] >> (7 - (i % 8))) & 0x01;
+
+            theEdges.push_back(t += theTiming.BitLowUs);
+            theEdges.push_back(t += (isOne ? theTiming.OneHighUs : theTiming.ZeroHighUs));
+        }
+        theEdges.push_back(t += theTiming.EndLowUs);     // Bus released.
+
+        return theWaveform;
+    }
+
+    // Edges keep their order; one pushed past its successor is clamped
+    // to just before it, so that no pulse vanishes altogether.
+    void ApplyJitter(const SimulatedJitter_t & theJitter, std::mt19937 & theGenerator)
+    {
+        constexpr double MINIMUM_PULSE_US = 0.1;
+        std::normal_distribution<double> theNoise(0.0, (theJitter.EdgeJitterUs > 0.0) ? theJitter.EdgeJitterUs : 1.0);
+
+        double thePreviousUs = 0.0;
+        for (std::size_t i = 0; i < m_TheEdgesUs.size(); i++)
+        {
+            auto & theEdgeUs = m_TheEdgesUs[i];
+
+            if (theJitter.EdgeJitterUs > 0.0)
+            {
+                theEdgeUs += theNoise(theGenerator);
+            }
+
+            // Level changes alternate from the idle high, so odd edges rise.
+            if ((i % 2) == 1)
+            {
+                theEdgeUs += theJitter.RiseSkewUs;
+            }
+
+            theEdgeUs = std::max(theEdgeUs, thePreviousUs + MINIMUM_PULSE_US);
+            thePreviousUs = theEdgeUs;
+        }
+    }
+
+    int LevelAt(const double & theTimeUs) const
+    {
+        auto theEdgesPassed = std::upper_bound(m_TheEdgesUs.begin(), m_TheEdgesUs.end(), theTimeUs) - m_TheEdgesUs.begin();
+        return ((theEdgesPassed % 2) == 0) ? 1 : 0;
+    }
+
+    double GetEndUs() const { return m_TheEdgesUs.empty() ? 0.0 : m_TheEdgesUs.back(); }
+
+    std::vector<double> &       GetEdges()       { return m_TheEdgesUs; }
+    const std::vector<double> & GetEdges() const { return m_TheEdgesUs; }
+
+private:
+    std::vector<double> m_TheEdgesUs;
+};
+
+// Stands in for us_ticker_read(); the returned value is truncated to
+// whole microseconds exactly as the hardware ticker's would be. The
+// first preemption, if any, falls thePreemptionPhaseUs after theStartUs.
+class SimulatedClock
+{
+public:
+    SimulatedClock(const SimulatedCpu_t & theCpu, const double & theStartUs = 0.0,
+                   const double & thePreemptionPhaseUs = 0.0)
+        : m_TheCpu(theCpu)
+        , m_TheNowUs(theStartUs)
+        , m_TheNextPreemptionUs(theStartUs + thePreemptionPhaseUs)
+    {
+    }
+
+    uint32_t NowUs()
+    {
+        Advance(m_TheCpu.ClockReadCostUs);
+        return static_cast<uint32_t>(m_TheNowUs);
+    }
+
+    // The loop only notices a preemption once it gets the CPU back, so
+    // the stall lands after whatever step crossed the preemption point.
+    void Advance(const double & theUs)
+    {
+        m_TheNowUs += theUs;
+
+        if ((m_TheCpu.PreemptionUs > 0.0) && (m_TheNowUs >= m_TheNextPreemptionUs))
+        {
+            m_TheNowUs += m_TheCpu.PreemptionUs;
+
+            const auto thePeriodsMissed = std::floor((m_TheNowUs - m_TheNextPreemptionUs) / m_TheCpu.PreemptionPeriodUs);
+            m_TheNextPreemptionUs += (thePeriodsMissed + 1.0) * m_TheCpu.PreemptionPeriodUs;
+        }
+    }
+
+    double GetNowUs() const { return m_TheNowUs; }
+    const SimulatedCpu_t & GetCpu() const { return m_TheCpu; }
+
+private:
+    SimulatedCpu_t m_TheCpu;
+    double         m_TheNowUs;
+    double         m_TheNextPreemptionUs;
+};
+
+// Stands in for CapturePin.
+class SimulatedPin
+{
+public:
+    SimulatedPin(const SimulatedWaveform & theWaveform, SimulatedClock & theClock)
+        : m_TheWaveform(theWaveform)
+        , m_TheClock(theClock)
+    {
+    }
+
+    int Read()
+    {
+        m_TheClock.Advance(m_TheClock.GetCpu().PinReadCostUs);
+        return m_TheWaveform.LevelAt(m_TheClock.GetNowUs());
+    }
+
+private:
+    const SimulatedWaveform & m_TheWaveform;
+    SimulatedClock &          m_TheClock;
+};
+
+// Several lines of one GPIO port, sampled together through a single read
+// of its input data register.
+class SimulatedPort
+{
+public:
+    static constexpr std::size_t PORT_WIDTH_PINS = 16;
+
+    SimulatedPort(SimulatedClock & theClock)
+        : m_TheClock(theClock)
+    {
+    }
+
+    // Lines are numbered in order of attachment; at most PORT_WIDTH_PINS.
+    bool Attach(const SimulatedWaveform & theWaveform)
+    {
+        if (m_TheLines.size() >= PORT_WIDTH_PINS)
+        {
+            return false;
+        }
+        m_TheLines.push_back(&theWaveform);
+        return true;
+    }
+
+    uint32_t ReadPort()
+    {
+        m_TheClock.Advance(m_TheClock.GetCpu().PinReadCostUs);
+
+        uint32_t theLevels = 0;
+        for (std::size_t i = 0; i < m_TheLines.size(); i++)
+        {
+            theLevels |= static_cast<uint32_t>(m_TheLines[i]->LevelAt(m_TheClock.GetNowUs())) << i;
+        }
+        return theLevels;
+    }
+
+    std::size_t GetLineCount() const { return m_TheLines.size(); }
+
+private:
+    SimulatedClock &                        m_TheClock;
+    std::vector<const SimulatedWaveform *>  m_TheLines;
+};
+
+// One sampling loop recording the edges of every line of thePort, as for
+// DecodeEdgeTimestamps(); theEdgesUs gets one list per line. The lines
+// must have been released together, just before the call. Returns the
+// number of lines that delivered every edge needed to decode a frame.
+inline std::size_t CapturePortEdges(SimulatedPort & thePort, SimulatedClock & theClock,
+                                    std::vector<std::vector<uint32_t>> & theEdgesUs)
+{
+    const auto theLineCount = thePort.GetLineCount();
+    const auto theDeadlineUs = theClock.GetNowUs() + MAXIMUM_FRAME_DURATION_US;
+
+    theEdgesUs.assign(theLineCount, {});
+    for (auto & theEdges : theEdgesUs)
+    {
+        theEdges.reserve(DATA_FRAME_EDGE_COUNT);
+    }
+
+    // Every line was driven high until now.
+    uint32_t thePrevious = (1u << theLineCount) - 1;
+    std::size_t theLinesComplete = 0;
+
+    while (theLinesComplete < theLineCount)
+    {
+        const auto theNowUs = theClock.NowUs();
+        if (theNowUs > theDeadlineUs)
+        {
+            break;
+        }
+
+        const auto theLevels  = thePort.ReadPort();
+        auto       theChanged = theLevels ^ thePrevious;
+        thePrevious = theLevels;
+
+        while (theChanged != 0)
+        {
+            const auto line = static_cast<std::size_t>(__builtin_ctz(theChanged));
+            theChanged &= (theChanged - 1);
+
+            theClock.Advance(theClock.GetCpu().EdgeRecordCostUs);
+            theEdgesUs[line].push_back(theNowUs);
+
+            // The final release is not needed to decode the frame.
+            if (theEdgesUs[line].size() == (DATA_FRAME_EDGE_COUNT - 1))
+            {
+                ++theLinesComplete;
+            }
+        }
+    }
+
+    return theLinesComplete;
+}
+
+// A simulated sensor unit.Units differ slightly from one another, and
+// from the datasheet, which is what the decode threshold has to absorb.
+template <typename T>
+class SimulatedSensor
+{
+public:
+    SimulatedSensor(std::mt19937 & theGenerator)
+    {
+        std::uniform_real_distribution<double> theResponseDelay(20.0, 40.0);
+        std::uniform_real_distribution<double> theSpread(-2.0, 2.0);
+
+        m_TheTiming.ResponseDelayUs = theResponseDelay(theGenerator);
+        m_TheTiming.SyncLowUs      += theSpread(theGenerator);
+        m_TheTiming.SyncHighUs     += theSpread(theGenerator);
+        m_TheTiming.BitLowUs       += theSpread(theGenerator);
+        m_TheTiming.ZeroHighUs     += theSpread(theGenerator);
+        m_TheTiming.OneHighUs      += theSpread(theGenerator);
+    }
+
+    // Take a fresh, plausible, reading and return the frame reporting it.
+    DataFrame_t Sample(std::mt19937 & theGenerator)
+    {
+        std::uniform_int_distribution<int> theTemperature(0, 500);
+        std::uniform_int_distribution<int> theHumidity(200, 900);
+
+        auto theTemperatureTenths = static_cast<int16_t>(theTemperature(theGenerator));
+        auto theHumidityTenths    = static_cast<uint16_t>(theHumidity(theGenerator));
+
+        if constexpr (std::is_same<T, DHT22_t>::value)
+        {
+            theTemperatureTenths -= 200; // Exercise the sign bit as well.
+        }
+
+        return EncodeDataFrame<T>(theTemperatureTenths, theHumidityTenths);
+    }
+
+    const SimulatedTiming_t & GetTiming() const { return m_TheTiming; }
+    SimulatedTiming_t &       GetTiming()       { return m_TheTiming; }
+
+private:
+    SimulatedTiming_t m_TheTiming;
+};
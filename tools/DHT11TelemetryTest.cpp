@@ -0,0 +1,382 @@
+/***********************************************************************
+* @file      DHT11TelemetryTest.cpp
+*
+*    Host-side loopback test of the batched telemetry uplink (see
+*    NuerteyTelemetryPublisher.h).
+*
+* @brief   A collector socket on the host loopback receives what the
+*          publisher sends, and decodes it independently, byte by byte,
+*          as the header comment of the publisher lays it out:
+*
+*            - packing: the 12-byte header ('D' 'H', version, record
+*              count, batch sequence and dropped count, little-endian)
+*              and the 20-byte records (pin, signed temperature, humidity,
+*              status, reserved, sequence number, 64-bit sample time),
+*              including negative temperatures and failed reads;
+*            - batching: a backlog leaves in MAXIMUM_BATCH_SIZE chunks, in
+*              order, and an empty queue sends nothing;
+*            - back-pressure: once the queue is full Enqueue() refuses
+*              readings, rather than overwriting queued ones, and the
+*              refusals are reported in the next header;
+*            - scheduling: Start() publishes from the event queue until
+*              Stop();
+*            - concurrency: --producers threads Enqueue() while the main
+*              thread publishes; every reading is either received, in
+*              sequence number order per producer, or counted as dropped.
+*
+* @note    Uses the host stand-in for Mbed in tools/host. Build with
+*          ThreadSanitizer and run on the host, e.g.:
+*
+*            g++ -std=c++20 -O1 -g -fsanitize=thread -Ihost -I.. DHT11TelemetryTest.cpp -o DHT11TelemetryTest -lpthread
+*            ./DHT11TelemetryTest --producers 4 --items 20000
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include "mbed.h"
+#include "DHT11TestSupport.h"
+#include "NuerteyTelemetryPublisher.h"
+
+namespace
+{
+    constexpr uint16_t COLLECTOR_PORT = 9125;
+
+    struct Options_t
+    {
+        std::size_t Producers = 4;
+        uint32_t    Items = 5000;
+    };
+
+    struct Record_t
+    {
+        uint16_t Pin;
+        int16_t  TemperatureTenths;
+        uint16_t HumidityTenths;
+        int8_t   Status;
+        uint8_t  Reserved;
+        uint32_t SequenceNumber;
+        uint64_t SampleTimeUs;
+    };
+
+    struct Batch_t
+    {
+        bool                  IsValid = false;
+        uint8_t               Version = 0;
+        uint32_t              Sequence = 0;
+        uint32_t              Dropped = 0;
+        std::vector<Record_t> Records;
+    };
+
+    uint16_t GetLittleEndian16(const uint8_t * theBytes)
+    {
+        return static_cast<uint16_t>(theBytes[0] | (theBytes[1] << 8));
+    }
+
+    uint32_t GetLittleEndian32(const uint8_t * theBytes)
+    {
+        return (static_cast<uint32_t>(GetLittleEndian16(&theBytes[2])) << 16) | GetLittleEndian16(&theBytes[0]);
+    }
+
+    uint64_t GetLittleEndian64(const uint8_t * theBytes)
+    {
+        return (static_cast<uint64_t>(GetLittleEndian32(&theBytes[4])) << 32) | GetLittleEndian32(&theBytes[0]);
+    }
+
+    // Decodes per the documented layout, not via the publisher's code.
+    Batch_t Decode(const uint8_t * theBytes, const std::size_t & theSize)
+    {
+        Batch_t theBatch;
+        if ((theSize < 12) || (theBytes[0] != 'D') || (theBytes[1] != 'H'))
+        {
+            return theBatch;
+        }
+
+        const auto theCount = theBytes[3];
+        if (theSize != 12 + 20 * static_cast<std::size_t>(theCount))
+        {
+            return theBatch;
+        }
+
+        theBatch.Version = theBytes[2];
+        theBatch.Sequence = GetLittleEndian32(&theBytes[4]);
+        theBatch.Dropped = GetLittleEndian32(&theBytes[8]);
+        for (std::size_t i = 0; i < theCount; i++)
+        {
+            const auto pTheRecord = &theBytes[12 + 20 * i];
+            theBatch.Records.push_back(Record_t{GetLittleEndian16(&pTheRecord[0]),
+                                                static_cast<int16_t>(GetLittleEndian16(&pTheRecord[2])),
+                                                GetLittleEndian16(&pTheRecord[4]),
+                                                static_cast<int8_t>(pTheRecord[6]), pTheRecord[7],
+                                                GetLittleEndian32(&pTheRecord[8]),
+                                                GetLittleEndian64(&pTheRecord[12])});
+        }
+        theBatch.IsValid = true;
+        return theBatch;
+    }
+
+    class Collector
+    {
+    public:
+        Collector()
+        {
+            (void)m_TheSocket.open(NetworkInterface::get_default_instance());
+            m_IsBound = (m_TheSocket.bind(COLLECTOR_PORT) == NSAPI_ERROR_OK);
+        }
+
+        bool IsBound() const { return m_IsBound; }
+        std::size_t GetPendingCount() const { return m_TheSocket.GetPendingCount(); }
+
+        // An invalid batch if nothing is pending.
+        Batch_t Receive()
+        {
+            uint8_t theBuffer[1500];
+            const auto theSize = m_TheSocket.recvfrom(nullptr, theBuffer, sizeof(theBuffer));
+            return (theSize > 0) ? Decode(theBuffer, static_cast<std::size_t>(theSize)) : Batch_t{};
+        }
+
+    private:
+        UDPSocket m_TheSocket;
+        bool      m_IsBound = false;
+    };
+
+    Measurement_t MakeMeasurement(const PinName & thePin, const int16_t & theTemperature, const uint16_t & theHumidity,
+                                  const SensorStatus_t & theStatus = SensorStatus_t::SUCCESS,
+                                  const uint32_t & theSequenceNumber = 1, const uint64_t & theSampleTimeUs = 1'000'000)
+    {
+        return Measurement_t{thePin, theTemperature, theHumidity, theStatus, 4200, theSequenceNumber,
+                             theSampleTimeUs, theSampleTimeUs};
+    }
+
+    SocketAddress GetCollectorAddress() { return SocketAddress("127.0.0.1", COLLECTOR_PORT); }
+
+    void CheckPacking(Checker_t & theChecker)
+    {
+        Collector theCollector;
+        NuerteyTelemetryPublisher<> thePublisher(NetworkInterface::get_default_instance(), GetCollectorAddress());
+        theChecker.Expect(theCollector.IsBound() && (thePublisher.Open() == NSAPI_ERROR_OK), "loopback sockets did not open");
+
+        theChecker.Expect(thePublisher.Publish() == 0, "an empty queue was published");
+        theChecker.Expect(theCollector.GetPendingCount() == 0, "an empty batch reached the collector");
+
+        const Measurement_t theSent[] = {MakeMeasurement(PE_13, 231, 456, SensorStatus_t::SUCCESS, 7, 2'000'000),
+                                         MakeMeasurement(PE_14, -105, 998, SensorStatus_t::SUCCESS, 0x01020304, 0x1122334455667788),
+                                         MakeMeasurement(static_cast<PinName>(0x1234), 0, 0, SensorStatus_t::ERROR_BAD_CHECKSUM,
+                                                         UINT32_MAX, 0)};
+        for (const auto & m : theSent)
+        {
+            theChecker.Expect(thePublisher.Enqueue(m), "a reading was refused by an empty queue");
+        }
+        theChecker.Expect(thePublisher.GetQueuedCount() == 3, "queued count wrong");
+
+        const auto theSentBytes = thePublisher.Publish();
+        theChecker.Expect(theSentBytes == 12 + 3 * 20, "datagram size is not a 12-byte header plus 20 bytes a record");
+        theChecker.Expect(thePublisher.GetQueuedCount() == 0, "the queue was not drained");
+
+        const auto theBatch = theCollector.Receive();
+        theChecker.Expect(theBatch.IsValid, "the datagram does not decode");
+        theChecker.Expect(theBatch.Version == 2, "format version is not 2");
+        theChecker.Expect(theBatch.Sequence == 1, "the first batch is not sequence 1");
+        theChecker.Expect(theBatch.Dropped == 0, "drops reported without back-pressure");
+        theChecker.Expect(theBatch.Records.size() == 3, "record count wrong");
+
+        for (std::size_t i = 0; (i < theBatch.Records.size()) && (i < 3); i++)
+        {
+            const auto & r = theBatch.Records[i];
+            theChecker.Expect((r.Pin == static_cast<uint16_t>(theSent[i].SensorPin))
+                           && (r.TemperatureTenths == theSent[i].TemperatureTenths)
+                           && (r.HumidityTenths == theSent[i].HumidityTenths)
+                           && (r.Status == ToUnderlyingType(theSent[i].Status))
+                           && (r.Reserved == 0)
+                           && (r.SequenceNumber == theSent[i].SequenceNumber)
+                           && (r.SampleTimeUs == theSent[i].SampleTimeUs), "record fields do not round-trip");
+        }
+
+        // The raw bytes too, so that the byte order itself is pinned down.
+        uint8_t theRecord[20];
+        theChecker.Expect(NuerteyTelemetryPublisher<>::EncodeRecord(theRecord, theSent[1]) == 20, "EncodeRecord() size");
+        const uint8_t theExpected[20] = {PE_14, 0, 0x97, 0xFF, 0xE6, 0x03, 0, 0,
+                                         0x04, 0x03, 0x02, 0x01,
+                                         0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11};
+        theChecker.Expect(memcmp(theRecord, theExpected, sizeof(theRecord)) == 0, "record bytes are not little-endian as documented");
+    }
+
+    void CheckBackPressure(Checker_t & theChecker)
+    {
+        constexpr std::size_t CAPACITY = 8;
+        constexpr std::size_t BATCH = 5;
+
+        Collector theCollector;
+        NuerteyTelemetryPublisher<CAPACITY, BATCH> thePublisher(NetworkInterface::get_default_instance(), GetCollectorAddress());
+        theChecker.Expect(theCollector.IsBound() && (thePublisher.Open() == NSAPI_ERROR_OK), "loopback sockets did not open");
+
+        uint32_t theRefused = 0;
+        for (int16_t i = 0; i < 11; i++)
+        {
+            theRefused += thePublisher.Enqueue(MakeMeasurement(PE_13, i, 0)) ? 0 : 1;
+        }
+        theChecker.Expect(theRefused == 3, "a full queue did not refuse readings");
+        theChecker.Expect(thePublisher.GetDroppedCount() == 3, "refusals not counted as dropped");
+        theChecker.Expect(thePublisher.GetQueuedCount() == CAPACITY, "queue not at capacity");
+
+        (void)thePublisher.Publish();
+        (void)thePublisher.Publish();
+        theChecker.Expect(thePublisher.Publish() == 0, "a drained queue was published");
+
+        const auto theFirst = theCollector.Receive();
+        const auto theSecond = theCollector.Receive();
+        theChecker.Expect(theFirst.IsValid && theSecond.IsValid && (theCollector.GetPendingCount() == 0),
+                          "expected exactly two datagrams");
+        theChecker.Expect((theFirst.Records.size() == BATCH) && (theSecond.Records.size() == CAPACITY - BATCH),
+                          "backlog not split into maximum-size batches");
+        theChecker.Expect((theFirst.Sequence == 1) && (theSecond.Sequence == 2), "batch sequence not consecutive");
+        theChecker.Expect((theFirst.Dropped == 3) && (theSecond.Dropped == 3), "header does not report the drops");
+        theChecker.Expect(thePublisher.GetPublishedBatchCount() == 2, "published batch count wrong");
+
+        // The oldest readings survive; the refused ones are the newest.
+        std::vector<int16_t> theReceived;
+        for (const auto & b : {theFirst, theSecond})
+        {
+            for (const auto & r : b.Records)
+            {
+                theReceived.push_back(r.TemperatureTenths);
+            }
+        }
+        std::vector<int16_t> theOldest(CAPACITY);
+        for (std::size_t i = 0; i < CAPACITY; i++)
+        {
+            theOldest[i] = static_cast<int16_t>(i);
+        }
+        theChecker.Expect(theReceived == theOldest, "queued readings were overwritten or reordered");
+    }
+
+    void CheckScheduling(Checker_t & theChecker)
+    {
+        Collector theCollector;
+        EventQueue theQueue;
+        NuerteyTelemetryPublisher<> thePublisher(NetworkInterface::get_default_instance(), GetCollectorAddress());
+        theChecker.Expect(theCollector.IsBound() && (thePublisher.Open() == NSAPI_ERROR_OK), "loopback sockets did not open");
+
+        theChecker.Expect(thePublisher.Start(theQueue, 5) != 0, "Start() did not schedule publishing");
+        (void)thePublisher.Enqueue(MakeMeasurement(PE_13, 1, 1));
+        theQueue.dispatch(20);
+        theChecker.Expect(theCollector.GetPendingCount() == 1, "the scheduled publish did not send the reading");
+
+        thePublisher.Stop();
+        (void)thePublisher.Enqueue(MakeMeasurement(PE_13, 2, 2));
+        theQueue.dispatch(20);
+        theChecker.Expect(theCollector.GetPendingCount() == 1, "publishing continued after Stop()");
+        theChecker.Expect(theQueue.GetPendingCount() == 0, "Stop() left the event scheduled");
+    }
+
+    void CheckConcurrentProducers(Checker_t & theChecker, const Options_t & theOptions)
+    {
+        Collector theCollector;
+        NuerteyTelemetryPublisher<16, 8> thePublisher(NetworkInterface::get_default_instance(), GetCollectorAddress());
+        theChecker.Expect(theCollector.IsBound() && (thePublisher.Open() == NSAPI_ERROR_OK), "loopback sockets did not open");
+
+        std::atomic<std::size_t> theFinished(0);
+        std::vector<std::thread> theProducers;
+        for (std::size_t p = 0; p < theOptions.Producers; p++)
+        {
+            theProducers.emplace_back([&, p]()
+            {
+                // The pin identifies the producer, the sequence number the order.
+                for (uint32_t i = 0; i < theOptions.Items; i++)
+                {
+                    (void)thePublisher.Enqueue(MakeMeasurement(static_cast<PinName>(p), 0, 0, SensorStatus_t::SUCCESS, i));
+                    if ((i % 64) == 0)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                theFinished.fetch_add(1);
+            });
+        }
+
+        std::vector<int64_t> theLastSeen(theOptions.Producers, -1);
+        uint64_t theReceived = 0;
+        uint64_t theOutOfOrder = 0;
+        uint32_t theLastDropped = 0;
+        uint32_t theNextSequence = 1;
+        bool     isHeaderConsistent = true;
+
+        const auto Collect = [&]()
+        {
+            while (theCollector.GetPendingCount() != 0)
+            {
+                const auto theBatch = theCollector.Receive();
+                isHeaderConsistent = isHeaderConsistent && theBatch.IsValid && (theBatch.Sequence == theNextSequence++)
+                                  && (theBatch.Dropped >= theLastDropped);
+                theLastDropped = theBatch.Dropped;
+
+                for (const auto & r : theBatch.Records)
+                {
+                    ++theReceived;
+                    if ((r.Pin >= theOptions.Producers) || (static_cast<int64_t>(r.SequenceNumber) <= theLastSeen[r.Pin]))
+                    {
+                        ++theOutOfOrder;
+                        continue;
+                    }
+                    theLastSeen[r.Pin] = r.SequenceNumber;
+                }
+            }
+        };
+
+        while (theFinished.load() < theOptions.Producers)
+        {
+            (void)thePublisher.Publish();
+            Collect();
+            std::this_thread::yield();
+        }
+        for (auto & theProducer : theProducers)
+        {
+            theProducer.join();
+        }
+        while (thePublisher.Publish() > 0)
+        {
+        }
+        Collect();
+
+        const auto theTotal = static_cast<uint64_t>(theOptions.Producers) * theOptions.Items;
+        printf("concurrency: producers=%zu items=%u received=%llu dropped=%u batches=%u out_of_order=%llu\n",
+               theOptions.Producers, theOptions.Items, static_cast<unsigned long long>(theReceived),
+               thePublisher.GetDroppedCount(), thePublisher.GetPublishedBatchCount(),
+               static_cast<unsigned long long>(theOutOfOrder));
+
+        theChecker.Expect(theReceived + thePublisher.GetDroppedCount() == theTotal, "readings neither received nor counted as dropped");
+        theChecker.Expect(theOutOfOrder == 0, "readings duplicated or reordered");
+        theChecker.Expect(isHeaderConsistent, "batch sequence or dropped count inconsistent");
+        theChecker.Expect(theLastDropped == thePublisher.GetDroppedCount(), "last header does not carry the final drop count");
+    }
+
+}
+
+int main(int argc, char * argv[])
+{
+    Options_t theOptions;
+
+    if (!ParseOptions(argc, argv, { { "--producers", theOptions.Producers, 1 },
+                                    { "--items",     theOptions.Items,     1, UINT32_MAX } },
+                      "[--producers N] [--items N]"))
+    {
+        return EXIT_FAILURE;
+    }
+
+    Checker_t theChecker;
+    CheckPacking(theChecker);
+    CheckBackPressure(theChecker);
+    CheckScheduling(theChecker);
+    CheckConcurrentProducers(theChecker, theOptions);
+
+    return theChecker.Finish();
+}
@@ -0,0 +1,282 @@
+/***********************************************************************
+* @file      DHT11TimingProfileStoreTest.cpp
+*
+*    Host-side test of the timing profile and calibration store (see
+*    NuerteyTimingProfileStore.h).
+*
+* @brief   Saves and loads through a HeapBlockDevice of two 512-byte erase
+*          units, i.e. exactly the A and B slots:
+*
+*            - round trip: profiles and calibrations of several pins come
+*              back from a fresh store as saved, Save() alternates slots
+*              and skips the device altogether when nothing changed;
+*            - upgrade: a version 1 image (profiles only) in slot A loads
+*              with identity calibrations, is marked dirty, and the next
+*              Save() writes it as version 2 to slot B;
+*            - wrap: the generation counts through 0xFFFF to 0 and the
+*              slot holding generation 0 is still taken as the newest;
+*            - torn save: with the slot a Save() would write erased but
+*              never programmed, as a reset between the two would leave
+*              it, Load() returns the previous image. Likewise with the
+*              newest slot corrupted;
+*            - a device too small for slot B still loads slot A, but
+*              refuses to Save().
+*
+* @note    Uses the host stand-in for Mbed in tools/host, e.g.:
+*
+*            g++ -std=c++20 -O2 -Ihost -I.. DHT11TimingProfileStoreTest.cpp -o DHT11TimingProfileStoreTest
+*            ./DHT11TimingProfileStoreTest
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "mbed.h"
+#include "DHT11TestSupport.h"
+#include "NuerteyTimingProfileStore.h"
+
+namespace
+{
+    using Store_t = NuerteyTimingProfileStore<>;
+
+    constexpr bd_size_t ERASE_SIZE_BYTES = 512;
+    constexpr bd_addr_t SLOT_A_ADDRESS   = 0;
+    constexpr bd_addr_t SLOT_B_ADDRESS   = ERASE_SIZE_BYTES;
+
+    constexpr TimingProfile_t      PROFILE_A     = { 25, 68, 44, 12 };
+    constexpr TimingProfile_t      PROFILE_B     = { 30, 72, 50, 3 };
+    constexpr ReadingCalibration_t CALIBRATION_A = { -12, CALIBRATION_UNITY_GAIN + 200, 35, CALIBRATION_UNITY_GAIN - 300 };
+
+    bool IsEqual(const TimingProfile_t & theLeft, const TimingProfile_t & theRight)
+    {
+        return (theLeft.ZeroHighUs == theRight.ZeroHighUs) && (theLeft.OneHighUs == theRight.OneHighUs)
+            && (theLeft.ThresholdUs == theRight.ThresholdUs) && (theLeft.LearnedReads == theRight.LearnedReads);
+    }
+
+    bool IsEqual(const ReadingCalibration_t & theLeft, const ReadingCalibration_t & theRight)
+    {
+        return (theLeft.TemperatureOffsetTenths == theRight.TemperatureOffsetTenths)
+            && (theLeft.TemperatureGain == theRight.TemperatureGain)
+            && (theLeft.HumidityOffsetTenths == theRight.HumidityOffsetTenths)
+            && (theLeft.HumidityGain == theRight.HumidityGain);
+    }
+
+    // Profile of the pin in a store freshly loaded from theDevice.
+    bool LoadProfile(BlockDevice & theDevice, const PinName & thePin, TimingProfile_t & theProfile,
+                     uint16_t & theGeneration)
+    {
+        Store_t theStore(theDevice);
+        const auto isLoaded = (theStore.Load() == BD_ERROR_OK) && theStore.Find(thePin, theProfile);
+        theGeneration = theStore.GetGeneration();
+        return isLoaded;
+    }
+
+    uint8_t ReadByte(BlockDevice & theDevice, const bd_addr_t & theAddress)
+    {
+        std::vector<uint8_t> theBlock(ERASE_SIZE_BYTES);
+        const auto theBase = theAddress - (theAddress % ERASE_SIZE_BYTES);
+        (void)theDevice.read(theBlock.data(), theBase, theBlock.size());
+        return theBlock[theAddress - theBase];
+    }
+
+    uint32_t Crc32(const uint8_t * theData, const std::size_t & theLength)
+    {
+        uint32_t theCrc = 0xFFFFFFFF;
+
+        for (std::size_t i = 0; i < theLength; ++i)
+        {
+            theCrc ^= theData[i];
+            for (auto k = 0; k < 8; ++k)
+            {
+                theCrc = (theCrc & 1U) ? ((theCrc >> 1) ^ 0xEDB88320) : (theCrc >> 1);
+            }
+        }
+
+        return ~theCrc;
+    }
+
+    void CheckRoundTrip(Checker_t & theChecker)
+    {
+        HeapBlockDevice theDevice(2 * ERASE_SIZE_BYTES, ERASE_SIZE_BYTES);
+        Store_t theStore(theDevice);
+
+        theChecker.Expect(theStore.Load() == BD_ERROR_OK, "Load() of a blank device failed");
+        theChecker.Expect(theStore.GetEntryCount() == 0, "blank device yields entries");
+        theChecker.Expect(theStore.Update(PE_13, PROFILE_A) && theStore.Update(PE_13, CALIBRATION_A)
+                       && theStore.Update(PE_14, PROFILE_B), "Update() refused plausible entries");
+        theChecker.Expect(theStore.Save() == BD_ERROR_OK, "first Save() failed");
+        theChecker.Expect((theStore.GetGeneration() == 1) && (ReadByte(theDevice, SLOT_A_ADDRESS) == 'D')
+                       && (ReadByte(theDevice, SLOT_B_ADDRESS) == 0xFF), "first Save() did not go to slot A");
+
+        Store_t theReloaded(theDevice);
+        TimingProfile_t theProfile{};
+        ReadingCalibration_t theCalibration{};
+        theChecker.Expect(theReloaded.Load() == BD_ERROR_OK, "Load() of a saved image failed");
+        theChecker.Expect((theReloaded.GetEntryCount() == 2) && !theReloaded.IsDirty(), "reloaded table differs in size");
+        theChecker.Expect(theReloaded.Find(PE_13, theProfile) && IsEqual(theProfile, PROFILE_A), "PE_13 profile lost");
+        theChecker.Expect(theReloaded.Find(PE_13, theCalibration) && IsEqual(theCalibration, CALIBRATION_A),
+                          "PE_13 calibration lost");
+        theChecker.Expect(theReloaded.Find(PE_14, theCalibration) && IsEqual(theCalibration, IDENTITY_READING_CALIBRATION),
+                          "PE_14 calibration is not the identity");
+        theChecker.Expect(!theReloaded.Find(PE_15, theProfile), "PE_15 found though never stored");
+
+        // Nothing changed: no erase, no program.
+        theDevice.erase(SLOT_B_ADDRESS, ERASE_SIZE_BYTES);
+        theChecker.Expect((theReloaded.Save() == BD_ERROR_OK) && (ReadByte(theDevice, SLOT_B_ADDRESS) == 0xFF),
+                          "Save() of an unchanged table touched the device");
+
+        // A learned-reads count alone is not worth an erase either.
+        auto theCounted = PROFILE_A;
+        ++theCounted.LearnedReads;
+        theChecker.Expect(theReloaded.Update(PE_13, theCounted) && !theReloaded.IsDirty(), "learned-reads churn dirtied the table");
+
+        auto theMoved = PROFILE_B;
+        theMoved.ThresholdUs = 52;
+        theChecker.Expect(theReloaded.Update(PE_14, theMoved) && theReloaded.IsDirty(), "changed threshold left the table clean");
+        theChecker.Expect(theReloaded.Save() == BD_ERROR_OK, "second Save() failed");
+        theChecker.Expect((theReloaded.GetGeneration() == 2) && (ReadByte(theDevice, SLOT_B_ADDRESS) == 'D'),
+                          "second Save() did not go to slot B");
+
+        uint16_t theGeneration = 0;
+        theChecker.Expect(LoadProfile(theDevice, PE_14, theProfile, theGeneration) && IsEqual(theProfile, theMoved)
+                       && (theGeneration == 2), "slot B not taken as the newest");
+    }
+
+    void CheckUpgrade(Checker_t & theChecker)
+    {
+        HeapBlockDevice theDevice(2 * ERASE_SIZE_BYTES, ERASE_SIZE_BYTES);
+
+        // As written before the calibrations, and the slots, were added.
+        std::vector<uint8_t> theImage(ERASE_SIZE_BYTES, 0xFF);
+        memcpy(theImage.data(), "DHTP", 4);
+        theImage[4] = Store_t::LEGACY_FORMAT_VERSION;
+        theImage[5] = 1;
+        theImage[6] = theImage[7] = 0;
+        // One entry; the unused ones are zeroed as the old Save() did.
+        auto pTheEntry = &theImage[Store_t::STORE_HEADER_SIZE_BYTES];
+        memset(pTheEntry, 0, Store_t::LEGACY_IMAGE_SIZE_BYTES - Store_t::STORE_HEADER_SIZE_BYTES - 4);
+        pTheEntry[0] = static_cast<uint8_t>(PE_15);
+        pTheEntry[4] = PROFILE_A.ZeroHighUs;
+        pTheEntry[5] = PROFILE_A.OneHighUs;
+        pTheEntry[6] = PROFILE_A.ThresholdUs;
+        pTheEntry[7] = PROFILE_A.LearnedReads;
+
+        const auto theCrc = Crc32(theImage.data(), Store_t::LEGACY_IMAGE_SIZE_BYTES - 4);
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            theImage[Store_t::LEGACY_IMAGE_SIZE_BYTES - 4 + i] = static_cast<uint8_t>(theCrc >> (8 * i));
+        }
+        theDevice.program(theImage.data(), SLOT_A_ADDRESS, theImage.size());
+
+        Store_t theStore(theDevice);
+        TimingProfile_t theProfile{};
+        ReadingCalibration_t theCalibration{};
+        theChecker.Expect(theStore.Load() == BD_ERROR_OK, "Load() of a version 1 image failed");
+        theChecker.Expect(theStore.Find(PE_15, theProfile) && IsEqual(theProfile, PROFILE_A), "version 1 profile lost");
+        theChecker.Expect(theStore.Find(PE_15, theCalibration) && IsEqual(theCalibration, IDENTITY_READING_CALIBRATION),
+                          "version 1 entry not given the identity calibration");
+        theChecker.Expect(theStore.IsDirty() && (theStore.GetGeneration() == 0), "version 1 image not due an upgrade");
+        theChecker.Expect(theStore.Save() == BD_ERROR_OK, "upgrading Save() failed");
+        theChecker.Expect((ReadByte(theDevice, SLOT_B_ADDRESS + 4) == Store_t::STORE_FORMAT_VERSION)
+                       && (ReadByte(theDevice, SLOT_A_ADDRESS + 4) == Store_t::LEGACY_FORMAT_VERSION),
+                          "upgrade did not go to slot B, leaving slot A as it was");
+
+        uint16_t theGeneration = 0;
+        theChecker.Expect(LoadProfile(theDevice, PE_15, theProfile, theGeneration) && IsEqual(theProfile, PROFILE_A)
+                       && (theGeneration == 1), "upgraded image not taken as the newest");
+    }
+
+    void CheckWrapAndTornSave(Checker_t & theChecker)
+    {
+        HeapBlockDevice theDevice(2 * ERASE_SIZE_BYTES, ERASE_SIZE_BYTES);
+        Store_t theStore(theDevice);
+        auto theProfile = PROFILE_A;
+        auto isSaved = (theStore.Load() == BD_ERROR_OK);
+
+        // Generations 1 to 0xFFFF, then 0: alternate thresholds so that
+        // every Save() has something to write.
+        for (uint32_t i = 1; isSaved && (i <= 0x10000); ++i)
+        {
+            theProfile.ThresholdUs = static_cast<uint8_t>(PROFILE_A.ThresholdUs + (i & 1));
+            isSaved = theStore.Update(PE_13, theProfile) && (theStore.Save() == BD_ERROR_OK);
+        }
+        theChecker.Expect(isSaved && (theStore.GetGeneration() == 0), "generation did not wrap to 0");
+
+        // Even generations go to slot B: 0 there beats 0xFFFF in slot A.
+        TimingProfile_t theLoaded{};
+        uint16_t theGeneration = 1;
+        theChecker.Expect(LoadProfile(theDevice, PE_13, theLoaded, theGeneration) && IsEqual(theLoaded, theProfile)
+                       && (theGeneration == 0), "wrapped generation not taken as the newest");
+
+        // Reset between the erase and the program of the next Save().
+        theDevice.erase(SLOT_A_ADDRESS, ERASE_SIZE_BYTES);
+        theChecker.Expect(LoadProfile(theDevice, PE_13, theLoaded, theGeneration) && IsEqual(theLoaded, theProfile)
+                       && (theGeneration == 0), "torn Save() lost the previous image");
+
+        Store_t theResumed(theDevice);
+        auto theNext = theProfile;
+        theNext.ThresholdUs = 48;
+        theChecker.Expect((theResumed.Load() == BD_ERROR_OK) && theResumed.Update(PE_13, theNext)
+                       && (theResumed.Save() == BD_ERROR_OK) && (theResumed.GetGeneration() == 1),
+                          "Save() after a torn one failed");
+        theChecker.Expect(LoadProfile(theDevice, PE_13, theLoaded, theGeneration) && IsEqual(theLoaded, theNext)
+                       && (theGeneration == 1), "image saved after a torn Save() not taken as the newest");
+
+        // A corrupted newest slot falls back to the other.
+        std::vector<uint8_t> theBlock(ERASE_SIZE_BYTES);
+        theDevice.read(theBlock.data(), SLOT_A_ADDRESS, theBlock.size());
+        theBlock[Store_t::STORE_HEADER_SIZE_BYTES + 6] ^= 0x01;
+        theDevice.erase(SLOT_A_ADDRESS, ERASE_SIZE_BYTES);
+        theDevice.program(theBlock.data(), SLOT_A_ADDRESS, theBlock.size());
+        theChecker.Expect(LoadProfile(theDevice, PE_13, theLoaded, theGeneration) && IsEqual(theLoaded, theProfile)
+                       && (theGeneration == 0), "corrupted newest slot not passed over");
+    }
+
+    void CheckSmallDevice(Checker_t & theChecker)
+    {
+        HeapBlockDevice theLarge(2 * ERASE_SIZE_BYTES, ERASE_SIZE_BYTES);
+        Store_t theStore(theLarge);
+        (void)theStore.Load();
+        theStore.Update(PE_13, PROFILE_A);
+        theChecker.Expect(theStore.Save() == BD_ERROR_OK, "Save() to a two-unit device failed");
+
+        std::vector<uint8_t> theBlock(ERASE_SIZE_BYTES);
+        theLarge.read(theBlock.data(), SLOT_A_ADDRESS, theBlock.size());
+
+        HeapBlockDevice theSmall(ERASE_SIZE_BYTES, ERASE_SIZE_BYTES);
+        theSmall.program(theBlock.data(), SLOT_A_ADDRESS, theBlock.size());
+
+        TimingProfile_t theLoaded{};
+        uint16_t theGeneration = 0;
+        theChecker.Expect(LoadProfile(theSmall, PE_13, theLoaded, theGeneration) && IsEqual(theLoaded, PROFILE_A),
+                          "slot A of a one-unit device not loaded");
+
+        Store_t theSmallStore(theSmall);
+        (void)theSmallStore.Load();
+        theSmallStore.Update(PE_13, PROFILE_B);
+        theChecker.Expect(theSmallStore.Save() == BD_ERROR_DEVICE_ERROR, "Save() to a one-unit device not refused");
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    if (!ParseOptions(argc, argv, {}))
+    {
+        return EXIT_FAILURE;
+    }
+
+    Checker_t theChecker;
+
+    CheckRoundTrip(theChecker);
+    CheckUpgrade(theChecker);
+    CheckWrapAndTornSave(theChecker);
+    CheckSmallDevice(theChecker);
+
+    return theChecker.Finish();
+}
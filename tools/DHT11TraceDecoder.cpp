@@ -0,0 +1,125 @@
+/***********************************************************************
+* @file      DHT11TraceDecoder.cpp
+*
+*    Host-side decoder for the raw frame traces emitted by the driver's
+*    trace mode (see NuerteyDHT11Trace.h).
+*
+* @brief   Read captured console output, decode every "#D" trace line
+*          with the driver's own frame arithmetic (NuerteyDHT11Protocol.h)
+*          and reconstruct the human-readable lines that main.cpp used to
+*          format on the MCU, dew point included. All other lines are
+*          passed through unchanged.
+*
+* @note    Build and run on the host, e.g.:
+*
+*            g++ -std=c++17 -O2 -I.. DHT11TraceDecoder.cpp -o DHT11TraceDecoder
+*            ./DHT11TraceDecoder captured_console.log
+*            picocom -b 9600 /dev/ttyACM0 | ./DHT11TraceDecoder
+*
+*          With no file argument, standard input is decoded.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include "NuerteyDHT11Trace.h"
+
+namespace
+{
+    void PrintReading(const TraceRecord_t & theRecord)
+    {
+        printf("[%lu ms] sensor %u (%s)\n", static_cast<unsigned long>(theRecord.TimestampMs),
+               static_cast<unsigned>(theRecord.SensorPin),
+               (theRecord.Model == SensorModel_t::DHT22) ? "DHT22" : "DHT11");
+
+        // The status is what the driver concluded on the MCU. Re-validate
+        // regardless, so that corruption in transit does not go unnoticed.
+        if (theRecord.Status != SensorStatus_t::SUCCESS)
+        {
+            printf("Error! g_DHT11.ReadData() returned: [%d] -> %s\n",
+                   ToUnderlyingType(theRecord.Status), make_error_code(theRecord.Status).message().c_str());
+            return;
+        }
+
+        if (!IsChecksumValid(theRecord.Frame))
+        {
+            printf("Error! trace frame failed checksum validation on the host\n");
+            return;
+        }
+
+        auto theTemperatureTenths = (theRecord.Model == SensorModel_t::DHT22)
+                                  ? DecodeTemperatureTenths<DHT22_t>(theRecord.Frame)
+                                  : DecodeTemperatureTenths<DHT11_t>(theRecord.Frame);
+        auto theHumidityTenths    = (theRecord.Model == SensorModel_t::DHT22)
+                                  ? DecodeHumidityTenths<DHT22_t>(theRecord.Frame)
+                                  : DecodeHumidityTenths<DHT11_t>(theRecord.Frame);
+
+        auto c   = static_cast<float>(theTemperatureTenths) / 10.0f;
+        auto h   = static_cast<float>(theHumidityTenths) / 10.0f;
+        auto f   = ConvertCelsiusToFarenheit(c);
+        auto k   = ConvertCelsiusToKelvin(c);
+        auto dp  = CalculateDewPoint(c, h);
+        auto dpf = CalculateDewPointFast(c, h);
+
+        printf("\nTemperature in Kelvin: %4.2fK, Celcius: %4.2f°C, Farenheit %4.2f°F\n", k, c, f);
+        printf("Humidity is %4.2f, Dewpoint: %4.2f, Dewpoint fast: %4.2f\n", h, dp, dpf);
+    }
+
+    void DecodeStream(std::istream & theInput)
+    {
+        std::string theLine;
+        TraceRecord_t theRecord;
+
+        while (std::getline(theInput, theLine))
+        {
+            // Console captures typically retain the "\r" of "\r\n".
+            while (!theLine.empty() && ((theLine.back() == '\r') || (theLine.back() == '\n')))
+            {
+                theLine.pop_back();
+            }
+
+            if (ParseTraceLine(theLine.c_str(), theLine.size(), theRecord))
+            {
+                PrintReading(theRecord);
+            }
+            else
+            {
+                printf("%s\n", theLine.c_str());
+            }
+        }
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc > 2)
+    {
+        fprintf(stderr, "Usage: %s [captured_console.log]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (argc == 2)
+    {
+        std::ifstream theFile(argv[1]);
+        if (!theFile)
+        {
+            fprintf(stderr, "Error! Unable to open \"%s\"\n", argv[1]);
+            return EXIT_FAILURE;
+        }
+
+        DecodeStream(theFile);
+    }
+    else
+    {
+        DecodeStream(std::cin);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,211 @@
+/***********************************************************************
+* @file      DHT11WorkStealingPool.h
+*
+*    Host-side work-stealing thread pool, for the gateway ingestion
+*    engine (see DHT11GatewayEngine.h).
+*
+* @brief   Every worker owns a deque of tasks. It takes work from the back
+*          of its own deque (newest first, while still in cache) and, once
+*          that is empty, steals from the front of the others' (oldest
+*          first), so a burst of work from one busy node spreads across
+*          all cores without a single shared queue for them to contend on.
+*          Tasks submitted from outside the pool are dealt round-robin;
+*          tasks submitted from within a worker go to its own deque.
+*
+*          Each deque has its own mutex, held only to push or pop, so
+*          contention stays low while tasks are coarse (a batch of frames,
+*          not a single one). Idle workers sleep rather than spin.
+*
+* @note    Tasks receive the index of the worker running them, so that
+*          callers can keep per-worker state without locking.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+class DHT11WorkStealingPool
+{
+public:
+    using Task_t = std::function<void(const std::size_t & theWorker)>;
+
+    // Zero threads means one per hardware thread.
+    explicit DHT11WorkStealingPool(const std::size_t & theThreads = 0)
+        : m_TheQueued(0)
+        , m_ThePending(0)
+        , m_TheNextWorker(0)
+        , m_TheSteals(0)
+        , m_IsStopping(false)
+    {
+        const auto theCount = (theThreads != 0) ? theThreads
+                            : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+        for (std::size_t i = 0; i < theCount; ++i)
+        {
+            m_TheWorkers.push_back(std::make_unique<Worker_t>());
+        }
+        for (std::size_t i = 0; i < theCount; ++i)
+        {
+            m_TheThreads.emplace_back(&DHT11WorkStealingPool::Run, this, i);
+        }
+    }
+
+    DHT11WorkStealingPool(const DHT11WorkStealingPool&) = delete;
+    DHT11WorkStealingPool& operator=(const DHT11WorkStealingPool&) = delete;
+
+    // Finishes the tasks already submitted, then joins the workers.
+    virtual ~DHT11WorkStealingPool()
+    {
+        Wait();
+
+        {
+            std::lock_guard<std::mutex> theLock(m_TheSleepMutex);
+            m_IsStopping = true;
+        }
+        m_TheWorkAvailable.notify_all();
+
+        for (auto & theThread : m_TheThreads)
+        {
+            theThread.join();
+        }
+    }
+
+    void Submit(Task_t && theTask)
+    {
+        const auto theWorker = (t_TheCurrentPool == this) ? t_TheCurrentWorker
+                             : (m_TheNextWorker.fetch_add(1, std::memory_order_relaxed) % m_TheWorkers.size());
+
+        m_ThePending.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> theLock(m_TheWorkers[theWorker]->Mutex);
+            m_TheWorkers[theWorker]->Tasks.push_back(std::move(theTask));
+        }
+        m_TheQueued.fetch_add(1, std::memory_order_release);
+
+        // Taking the sleep mutex orders this wake-up after any worker's
+        // last look at m_TheQueued, so that it cannot be lost.
+        {
+            std::lock_guard<std::mutex> theLock(m_TheSleepMutex);
+        }
+        m_TheWorkAvailable.notify_one();
+    }
+
+    // Blocks until every task submitted so far has run. Must not be called
+    // from within a task.
+    void Wait()
+    {
+        std::unique_lock<std::mutex> theLock(m_TheSleepMutex);
+        m_TheAllDone.wait(theLock, [this]() { return (m_ThePending.load(std::memory_order_acquire) == 0); });
+    }
+
+    std::size_t GetWorkerCount() const { return m_TheWorkers.size(); }
+    uint64_t    GetStealCount() const  { return m_TheSteals.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) Worker_t
+    {
+        std::mutex         Mutex;
+        std::deque<Task_t> Tasks;
+    };
+
+    bool PopOwn(const std::size_t & theWorker, Task_t & theTask)
+    {
+        auto & theOwn = *m_TheWorkers[theWorker];
+        std::lock_guard<std::mutex> theLock(theOwn.Mutex);
+
+        if (theOwn.Tasks.empty())
+        {
+            return false;
+        }
+        theTask = std::move(theOwn.Tasks.back());
+        theOwn.Tasks.pop_back();
+        return true;
+    }
+
+    bool Steal(const std::size_t & theWorker, Task_t & theTask)
+    {
+        for (std::size_t i = 1; i < m_TheWorkers.size(); ++i)
+        {
+            auto & theVictim = *m_TheWorkers[(theWorker + i) % m_TheWorkers.size()];
+            std::unique_lock<std::mutex> theLock(theVictim.Mutex, std::try_to_lock);
+
+            if (theLock.owns_lock() && !theVictim.Tasks.empty())
+            {
+                theTask = std::move(theVictim.Tasks.front());
+                theVictim.Tasks.pop_front();
+                m_TheSteals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Run(const std::size_t theWorker)
+    {
+        t_TheCurrentPool = this;
+        t_TheCurrentWorker = theWorker;
+
+        Task_t theTask;
+        while (true)
+        {
+            if (PopOwn(theWorker, theTask) || Steal(theWorker, theTask))
+            {
+                m_TheQueued.fetch_sub(1, std::memory_order_relaxed);
+                theTask(theWorker);
+                theTask = nullptr;
+
+                if (m_ThePending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    std::lock_guard<std::mutex> theLock(m_TheSleepMutex);
+                    m_TheAllDone.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> theLock(m_TheSleepMutex);
+            if (m_IsStopping)
+            {
+                return;
+            }
+
+            // A steal may have lost a try_lock race; re-scan if anything is
+            // still queued rather than sleep on it.
+            if (m_TheQueued.load(std::memory_order_acquire) == 0)
+            {
+                m_TheWorkAvailable.wait(theLock, [this]()
+                {
+                    return m_IsStopping || (m_TheQueued.load(std::memory_order_acquire) != 0);
+                });
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker_t>> m_TheWorkers;
+    std::vector<std::thread>               m_TheThreads;
+    std::atomic<std::size_t>               m_TheQueued;    // In some deque, not yet taken.
+    std::atomic<std::size_t>               m_ThePending;   // Submitted, not yet finished.
+    std::atomic<std::size_t>               m_TheNextWorker;
+    std::atomic<uint64_t>                  m_TheSteals;
+    std::mutex                             m_TheSleepMutex;
+    std::condition_variable                m_TheWorkAvailable;
+    std::condition_variable                m_TheAllDone;
+    bool                                   m_IsStopping;
+
+    static inline thread_local DHT11WorkStealingPool * t_TheCurrentPool = nullptr;
+    static inline thread_local std::size_t             t_TheCurrentWorker = 0;
+};
@@ -0,0 +1,99 @@
+/***********************************************************************
+* @file      DHT11TestSupport.h
+*
+*    Fixture shared by the host tests in tools/.
+*
+* @brief   Checker_t counts checks and failures, reporting each failure
+*          as it happens; Finish() prints the tally in the one format all
+*          of the tests use and yields main()'s exit status. ParseOptions()
+*          handles the "--name N" unsigned options the tests take, and the
+*          usage message for anything else.
+*
+* @note    Found, as is the Mbed stand-in, via -Itools/host (-Ihost from
+*          within tools/). Not for target builds.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <algorithm>
+
+struct Checker_t
+{
+    uint32_t Checks = 0;
+    uint32_t Failures = 0;
+
+    void Expect(const bool & theCondition, const char * theWhat)
+    {
+        ++Checks;
+        if (!theCondition)
+        {
+            fprintf(stderr, "Error! %s\n", theWhat);
+            ++Failures;
+        }
+    }
+
+    // Prints "checks=.. failures=..", then PASS or the failure count.
+    int Finish() const
+    {
+        printf("checks=%u failures=%u\n", Checks, Failures);
+
+        if (Failures != 0)
+        {
+            fprintf(stderr, "Error! %u check(s) failed\n", Failures);
+            return EXIT_FAILURE;
+        }
+
+        printf("PASS\n");
+        return EXIT_SUCCESS;
+    }
+};
+
+// "--name N", N clamped to [theMinimum, theMaximum] and stored in theValue.
+struct Option_t
+{
+    template <typename T>
+    Option_t(const char * theName, T & theValue, const unsigned long long & theMinimum = 0,
+             const unsigned long long & theMaximum = ~0ULL)
+        : Name(theName)
+        , Store([&theValue, theMinimum, theMaximum](const unsigned long long & theParsed)
+                {
+                    theValue = static_cast<T>(std::clamp(theParsed, theMinimum, theMaximum));
+                })
+    {
+    }
+
+    const char *                                     Name;
+    std::function<void(const unsigned long long &)>  Store;
+};
+
+// False, having printed the usage, on anything but the given options.
+inline bool ParseOptions(int argc, char * argv[], std::initializer_list<Option_t> theOptions,
+                         const char * theUsage = "")
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const auto theOption = std::find_if(theOptions.begin(), theOptions.end(), [&](const Option_t & o)
+                               { return !strcmp(argv[i], o.Name); });
+
+        if ((theOption == theOptions.end()) || (i + 1 >= argc))
+        {
+            fprintf(stderr, "Usage: %s%s%s\n", argv[0], (*theUsage != '\0') ? " " : "", theUsage);
+            return false;
+        }
+
+        theOption->Store(strtoull(argv[++i], nullptr, 10));
+    }
+
+    return true;
+}
@@ -0,0 +1,802 @@
+/***********************************************************************
+* @file      mbed.h
+*
+*    Host stand-in for the slice of the Mbed OS 5.11 API that the
+*    library's headers use, so that the host tests in tools/ can include
+*    those headers unmodified.
+*
+* @brief   Only what the headers under test touch is provided, and it
+*          behaves rather than merely compiles:
+*
+*            rtos      - Mutex (recursive, as Mbed's), ConditionVariable,
+*                        Kernel::get_ms_count(), ThisThread::sleep_for().
+*            events    - EventQueue, run on the calling thread by
+*                        dispatch(), so tests decide when deferred work
+*                        (sigio handlers, notifications) happens.
+*            drivers   - DigitalInOut reading an idle (high) line, i.e. no
+*                        sensor attached; CircularBuffer; the us ticker.
+*            storage   - BlockDevice, and a HeapBlockDevice that erases to
+*                        0xFF as flash does.
+*            netsocket - An in-process loopback network. UDP datagrams are
+*                        routed by port; TCP connections are pairs of byte
+*                        queues. Sockets are non-blocking in effect, and
+*                        raise sigio() on delivery as the real stack does.
+*
+* @note    Add -Itools/host (-Ihost from within tools/) ahead of the repo
+*          root so that this file is found as "mbed.h". Not for target
+*          builds.
+*
+* @author    Nuertey Odzeyem
+*
+* @date      October 17, 2026
+*
+* @copyright Copyright (c) 2021 Nuertey Odzeyem. All Rights Reserved.
+***********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+// ---------------------------------------------------------------------
+// Pins, GPIO and the microsecond ticker.
+// ---------------------------------------------------------------------
+typedef int PinName;
+enum { PA_0 = 0, PA_1, PA_2, PA_3, PE_13 = 77, PE_14, PE_15, NC = -1 };
+typedef enum { PullNone, PullUp, PullDown, PullDefault = PullUp } PinMode;
+
+typedef struct
+{
+    uint32_t          mask;
+    volatile uint32_t *reg_in;
+    PinName           pin;
+} gpio_t;
+
+inline int gpio_read(gpio_t * obj) { return ((*obj->reg_in & obj->mask) ? 1 : 0); }
+
+typedef uint64_t us_timestamp_t;
+struct ticker_data_t {};
+
+inline us_timestamp_t HostMicroseconds()
+{
+    static const auto theEpoch = std::chrono::steady_clock::now();
+    return static_cast<us_timestamp_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                       std::chrono::steady_clock::now() - theEpoch).count());
+}
+
+inline const ticker_data_t * get_us_ticker_data() { static ticker_data_t theTicker; return &theTicker; }
+inline us_timestamp_t ticker_read_us(const ticker_data_t *) { return HostMicroseconds(); }
+inline uint32_t us_ticker_read() { return static_cast<uint32_t>(HostMicroseconds()); }
+
+inline void wait_us(int us)
+{
+    const auto theEnd = HostMicroseconds() + static_cast<us_timestamp_t>(us);
+    while (HostMicroseconds() < theEnd)
+    {
+    }
+}
+
+typedef int nsapi_error_t;
+typedef int nsapi_size_or_error_t;
+enum
+{
+    NSAPI_ERROR_OK           =     0,
+    NSAPI_ERROR_WOULD_BLOCK  = -3001,
+    NSAPI_ERROR_PARAMETER    = -3003,
+    NSAPI_ERROR_NO_SOCKET    = -3005,
+    NSAPI_ERROR_NO_ADDRESS   = -3006,
+    NSAPI_ERROR_NO_MEMORY    = -3007,
+    NSAPI_ERROR_NO_CONNECTION = -3008,
+    NSAPI_ERROR_ADDRESS_IN_USE = -3018
+};
+
+namespace mbed {
+
+template <typename F> class Callback;
+
+template <typename R, typename... A>
+class Callback<R(A...)>
+{
+public:
+    Callback() = default;
+    Callback(std::nullptr_t) {}
+
+    template <typename T, typename M>
+    Callback(T * pTheObject, M theMethod)
+        : m_TheFunction([pTheObject, theMethod](A... theArguments) { return (pTheObject->*theMethod)(theArguments...); })
+    {
+    }
+
+    template <typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Callback>::value>::type>
+    Callback(F theFunction) : m_TheFunction(theFunction) {}
+
+    R operator()(A... theArguments) const { return m_TheFunction(theArguments...); }
+    R call(A... theArguments) const { return m_TheFunction(theArguments...); }
+    explicit operator bool() const { return static_cast<bool>(m_TheFunction); }
+
+private:
+    std::function<R(A...)> m_TheFunction;
+};
+
+template <typename T, typename R, typename... A>
+Callback<R(A...)> callback(T * pTheObject, R (T::*theMethod)(A...)) { return Callback<R(A...)>(pTheObject, theMethod); }
+
+template <typename T, typename R, typename... A>
+Callback<R(A...)> callback(const T * pTheObject, R (T::*theMethod)(A...) const) { return Callback<R(A...)>(pTheObject, theMethod); }
+
+// Nobody drives the line, so it idles high (pulled up).
+class DigitalInOut
+{
+public:
+    DigitalInOut(PinName thePin)
+    {
+        static volatile uint32_t theIdleInput = 0xFFFFFFFF;
+        gpio.mask = 1;
+        gpio.reg_in = &theIdleInput;
+        gpio.pin = thePin;
+    }
+
+    void output() {}
+    void input() {}
+    void mode(PinMode) {}
+    void write(int) {}
+    int read() { return gpio_read(&gpio); }
+    DigitalInOut & operator=(int) { return *this; }
+    operator int() { return read(); }
+
+protected:
+    gpio_t gpio;
+};
+
+// Stands in for masking interrupts.
+inline std::recursive_mutex & HostCriticalSection() { static std::recursive_mutex theMutex; return theMutex; }
+
+class CriticalSectionLock
+{
+public:
+    CriticalSectionLock() { HostCriticalSection().lock(); }
+    ~CriticalSectionLock() { HostCriticalSection().unlock(); }
+};
+
+// As Mbed's, push() overwrites the oldest element when full.
+template <typename T, uint32_t BUFFER_SIZE, typename CounterType = uint32_t>
+class CircularBuffer
+{
+public:
+    void push(const T & theData)
+    {
+        CriticalSectionLock lock;
+        m_TheBuffer[m_TheHead] = theData;
+        m_TheHead = (m_TheHead + 1) % BUFFER_SIZE;
+        if (m_IsFull)
+        {
+            m_TheTail = m_TheHead;
+        }
+        m_IsFull = (m_TheHead == m_TheTail);
+    }
+
+    bool pop(T & theData)
+    {
+        CriticalSectionLock lock;
+        if (!m_IsFull && (m_TheHead == m_TheTail))
+        {
+            return false;
+        }
+        theData = m_TheBuffer[m_TheTail];
+        m_TheTail = (m_TheTail + 1) % BUFFER_SIZE;
+        m_IsFull = false;
+        return true;
+    }
+
+    bool empty() const { CriticalSectionLock lock; return (!m_IsFull && (m_TheHead == m_TheTail)); }
+    bool full() const  { CriticalSectionLock lock; return m_IsFull; }
+
+    CounterType size() const
+    {
+        CriticalSectionLock lock;
+        return m_IsFull ? BUFFER_SIZE : static_cast<CounterType>((m_TheHead + BUFFER_SIZE - m_TheTail) % BUFFER_SIZE);
+    }
+
+    void reset() { CriticalSectionLock lock; m_TheHead = m_TheTail = 0; m_IsFull = false; }
+
+private:
+    T           m_TheBuffer[BUFFER_SIZE] = {};
+    CounterType m_TheHead = 0;
+    CounterType m_TheTail = 0;
+    bool        m_IsFull = false;
+};
+
+typedef uint64_t bd_addr_t;
+typedef uint64_t bd_size_t;
+enum
+{
+    BD_ERROR_OK           =     0,
+    BD_ERROR_DEVICE_ERROR = -4001
+};
+
+class BlockDevice
+{
+public:
+    virtual ~BlockDevice() = default;
+
+    virtual int init() = 0;
+    virtual int deinit() = 0;
+    virtual int read(void * pTheBuffer, bd_addr_t theAddress, bd_size_t theSize) = 0;
+    virtual int program(const void * pTheBuffer, bd_addr_t theAddress, bd_size_t theSize) = 0;
+    virtual int erase(bd_addr_t, bd_size_t) { return BD_ERROR_OK; }
+    virtual bd_size_t get_read_size() const = 0;
+    virtual bd_size_t get_program_size() const = 0;
+    virtual bd_size_t get_erase_size() const { return get_program_size(); }
+    virtual bd_size_t get_erase_size(bd_addr_t) const { return get_erase_size(); }
+    virtual int get_erase_value() const { return -1; }
+    virtual bd_size_t size() const = 0;
+};
+
+// Unlike Mbed's, erase() really does set the erased units to 0xFF, as
+// flash would, so that tests can leave a slot erased but unprogrammed.
+class HeapBlockDevice : public BlockDevice
+{
+public:
+    HeapBlockDevice(bd_size_t theSize, bd_size_t theBlockSize = 512)
+        : m_TheData(theSize, 0xFF)
+        , m_TheBlockSize(theBlockSize)
+    {
+    }
+
+    int init() override { return BD_ERROR_OK; }
+    int deinit() override { return BD_ERROR_OK; }
+
+    int read(void * pTheBuffer, bd_addr_t theAddress, bd_size_t theSize) override
+    {
+        if (!IsValid(theAddress, theSize, m_TheBlockSize))
+        {
+            return BD_ERROR_DEVICE_ERROR;
+        }
+        memcpy(pTheBuffer, &m_TheData[theAddress], theSize);
+        return BD_ERROR_OK;
+    }
+
+    int program(const void * pTheBuffer, bd_addr_t theAddress, bd_size_t theSize) override
+    {
+        if (!IsValid(theAddress, theSize, m_TheBlockSize))
+        {
+            return BD_ERROR_DEVICE_ERROR;
+        }
+        memcpy(&m_TheData[theAddress], pTheBuffer, theSize);
+        return BD_ERROR_OK;
+    }
+
+    int erase(bd_addr_t theAddress, bd_size_t theSize) override
+    {
+        if (!IsValid(theAddress, theSize, m_TheBlockSize))
+        {
+            return BD_ERROR_DEVICE_ERROR;
+        }
+        memset(&m_TheData[theAddress], 0xFF, theSize);
+        return BD_ERROR_OK;
+    }
+
+    bd_size_t get_read_size() const override { return m_TheBlockSize; }
+    bd_size_t get_program_size() const override { return m_TheBlockSize; }
+    bd_size_t get_erase_size() const override { return m_TheBlockSize; }
+    bd_size_t get_erase_size(bd_addr_t) const override { return m_TheBlockSize; }
+    int get_erase_value() const override { return 0xFF; }
+    bd_size_t size() const override { return m_TheData.size(); }
+
+private:
+    bool IsValid(bd_addr_t theAddress, bd_size_t theSize, bd_size_t theUnit) const
+    {
+        return ((theAddress % theUnit) == 0) && ((theSize % theUnit) == 0)
+            && ((theAddress + theSize) <= m_TheData.size());
+    }
+
+    std::vector<uint8_t> m_TheData;
+    bd_size_t            m_TheBlockSize;
+};
+
+} // namespace mbed
+
+using namespace mbed;
+
+// ---------------------------------------------------------------------
+// RTOS.
+// ---------------------------------------------------------------------
+namespace rtos {
+
+namespace Kernel
+{
+    inline uint64_t get_ms_count() { return (HostMicroseconds() / 1000); }
+}
+
+namespace ThisThread
+{
+    inline void sleep_for(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+    inline void yield() { std::this_thread::yield(); }
+}
+
+class Mutex
+{
+public:
+    void lock() { m_TheMutex.lock(); }
+    bool trylock() { return m_TheMutex.try_lock(); }
+    void unlock() { m_TheMutex.unlock(); }
+
+private:
+    friend class ConditionVariable;
+    std::recursive_mutex m_TheMutex;
+};
+
+class ConditionVariable
+{
+public:
+    explicit ConditionVariable(Mutex & theMutex) : m_TheMutex(theMutex) {}
+
+    void wait() { m_TheCondition.wait(m_TheMutex.m_TheMutex); }
+
+    // As Mbed's: true if the wait timed out.
+    bool wait_for(uint32_t ms)
+    {
+        return (m_TheCondition.wait_for(m_TheMutex.m_TheMutex, std::chrono::milliseconds(ms)) == std::cv_status::timeout);
+    }
+
+    void notify_one() { m_TheCondition.notify_one(); }
+    void notify_all() { m_TheCondition.notify_all(); }
+
+private:
+    Mutex &                     m_TheMutex;
+    std::condition_variable_any m_TheCondition;
+};
+
+} // namespace rtos
+
+using namespace rtos;
+
+// ---------------------------------------------------------------------
+// Events.
+// ---------------------------------------------------------------------
+namespace events {
+
+// Thread-safe to post to; events run only within dispatch(), on the
+// dispatching thread.
+class EventQueue
+{
+public:
+    explicit EventQueue(unsigned = 32 * 64) : m_TheNextId(1) {}
+
+    template <typename F>
+    int call(F theFunction) { return Post(0, 0, std::function<void()>(theFunction)); }
+
+    template <typename T, typename M>
+    int call(T * pTheObject, M theMethod) { return Post(0, 0, [pTheObject, theMethod]() { (void)(pTheObject->*theMethod)(); }); }
+
+    template <typename T, typename M>
+    int call_in(int ms, T * pTheObject, M theMethod) { return Post(ms, 0, [pTheObject, theMethod]() { (void)(pTheObject->*theMethod)(); }); }
+
+    template <typename T, typename M>
+    int call_every(int ms, T * pTheObject, M theMethod) { return Post(ms, ms, [pTheObject, theMethod]() { (void)(pTheObject->*theMethod)(); }); }
+
+    void cancel(int theId)
+    {
+        std::lock_guard<std::mutex> theLock(m_TheMutex);
+        m_TheEvents.erase(theId);
+    }
+
+    // Runs every event that is due, and those they post, for ms
+    // milliseconds; zero runs what is due now and returns.
+    void dispatch(int ms = 0)
+    {
+        const auto theEndMs = Kernel::get_ms_count() + static_cast<uint64_t>(std::max(ms, 0));
+
+        do
+        {
+            while (RunOne())
+            {
+            }
+
+            if (ms > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        while (Kernel::get_ms_count() < theEndMs);
+    }
+
+    std::size_t GetPendingCount()
+    {
+        std::lock_guard<std::mutex> theLock(m_TheMutex);
+        return m_TheEvents.size();
+    }
+
+private:
+    struct Event_t
+    {
+        uint64_t              DueMs;
+        int                   PeriodMs;
+        std::function<void()> Function;
+    };
+
+    int Post(const int & theDelayMs, const int & thePeriodMs, std::function<void()> && theFunction)
+    {
+        std::lock_guard<std::mutex> theLock(m_TheMutex);
+        const auto theId = m_TheNextId++;
+        m_TheEvents[theId] = Event_t{Kernel::get_ms_count() + static_cast<uint64_t>(theDelayMs), thePeriodMs,
+                                     std::move(theFunction)};
+        return theId;
+    }
+
+    // Oldest due event first.
+    bool RunOne()
+    {
+        std::function<void()> theFunction;
+        {
+            std::lock_guard<std::mutex> theLock(m_TheMutex);
+            const auto theNowMs = Kernel::get_ms_count();
+
+            auto theEvent = std::find_if(m_TheEvents.begin(), m_TheEvents.end(),
+                                         [&](const auto & e) { return (e.second.DueMs <= theNowMs); });
+            if (theEvent == m_TheEvents.end())
+            {
+                return false;
+            }
+
+            theFunction = theEvent->second.Function;
+            if (theEvent->second.PeriodMs > 0)
+            {
+                theEvent->second.DueMs = theNowMs + static_cast<uint64_t>(theEvent->second.PeriodMs);
+            }
+            else
+            {
+                m_TheEvents.erase(theEvent);
+            }
+        }
+
+        theFunction();
+        return true;
+    }
+
+    std::mutex              m_TheMutex;
+    std::map<int, Event_t>  m_TheEvents;
+    int                     m_TheNextId;
+};
+
+} // namespace events
+
+using namespace events;
+
+// ---------------------------------------------------------------------
+// Loopback network.
+// ---------------------------------------------------------------------
+class SocketAddress
+{
+public:
+    SocketAddress() : m_ThePort(0) { m_TheAddress[0] = '\0'; }
+
+    SocketAddress(const char * theAddress, uint16_t thePort) : m_ThePort(thePort)
+    {
+        snprintf(m_TheAddress, sizeof(m_TheAddress), "%s", (theAddress != nullptr) ? theAddress : "");
+    }
+
+    const char * get_ip_address() const { return (m_TheAddress[0] != '\0') ? m_TheAddress : nullptr; }
+    uint16_t get_port() const { return m_ThePort; }
+    void set_port(uint16_t thePort) { m_ThePort = thePort; }
+
+    bool operator==(const SocketAddress & theOther) const
+    {
+        return (m_ThePort == theOther.m_ThePort) && (strcmp(m_TheAddress, theOther.m_TheAddress) == 0);
+    }
+    bool operator!=(const SocketAddress & theOther) const { return !(*this == theOther); }
+
+    explicit operator bool() const { return (m_TheAddress[0] != '\0'); }
+
+private:
+    char     m_TheAddress[48];
+    uint16_t m_ThePort;
+};
+
+// Every interface is the loopback; they all share one address space.
+class NetworkInterface
+{
+public:
+    virtual ~NetworkInterface() = default;
+
+    static NetworkInterface * get_default_instance() { static NetworkInterface theLoopback; return &theLoopback; }
+
+    nsapi_error_t connect() { return NSAPI_ERROR_OK; }
+    nsapi_error_t disconnect() { return NSAPI_ERROR_OK; }
+    const char * get_ip_address() { return HOST_LOOPBACK_ADDRESS; }
+
+    static constexpr const char * HOST_LOOPBACK_ADDRESS = "127.0.0.1";
+};
+
+class Socket
+{
+public:
+    virtual ~Socket() = default;
+
+    void set_blocking(bool) {}
+    void set_timeout(int) {}
+    void sigio(mbed::Callback<void()> theCallback) { m_TheSigio = theCallback; }
+
+protected:
+    void RaiseSigio()
+    {
+        if (m_TheSigio)
+        {
+            m_TheSigio();
+        }
+    }
+
+    mbed::Callback<void()> m_TheSigio;
+};
+
+class UDPSocket : public Socket
+{
+public:
+    virtual ~UDPSocket() { close(); }
+
+    nsapi_error_t open(NetworkInterface * pTheInterface)
+    {
+        return (pTheInterface != nullptr) ? NSAPI_ERROR_OK : NSAPI_ERROR_PARAMETER;
+    }
+
+    nsapi_error_t bind(uint16_t thePort)
+    {
+        auto & theRoutes = Routes();
+        if (thePort == 0)
+        {
+            thePort = NextEphemeralPort();
+        }
+        if (theRoutes.count(thePort) != 0)
+        {
+            return NSAPI_ERROR_ADDRESS_IN_USE;
+        }
+
+        close();
+        theRoutes[thePort] = this;
+        m_ThePort = thePort;
+        return NSAPI_ERROR_OK;
+    }
+
+    nsapi_error_t close()
+    {
+        if (m_ThePort != 0)
+        {
+            Routes().erase(m_ThePort);
+            m_ThePort = 0;
+        }
+        m_TheInbox.clear();
+        return NSAPI_ERROR_OK;
+    }
+
+    // Datagrams to nobody are lost, as they would be on the wire.
+    nsapi_size_or_error_t sendto(const SocketAddress & thePeer, const void * theData, unsigned theSize)
+    {
+        if (m_ThePort == 0)
+        {
+            (void)bind(0);
+        }
+
+        ++m_TheSentCount;
+        auto theRoute = Routes().find(thePeer.get_port());
+        if (theRoute != Routes().end())
+        {
+            const auto pTheBytes = static_cast<const uint8_t *>(theData);
+            theRoute->second->m_TheInbox.push_back(Datagram_t{SocketAddress(NetworkInterface::HOST_LOOPBACK_ADDRESS, m_ThePort),
+                                                   std::vector<uint8_t>(pTheBytes, pTheBytes + theSize)});
+            theRoute->second->RaiseSigio();
+        }
+        return static_cast<nsapi_size_or_error_t>(theSize);
+    }
+
+    // Oversized datagrams are truncated, as per POSIX.
+    nsapi_size_or_error_t recvfrom(SocketAddress * pThePeer, void * theBuffer, unsigned theSize)
+    {
+        if (m_TheInbox.empty())
+        {
+            return NSAPI_ERROR_WOULD_BLOCK;
+        }
+
+        const auto theDatagram = std::move(m_TheInbox.front());
+        m_TheInbox.pop_front();
+
+        if (pThePeer != nullptr)
+        {
+            *pThePeer = theDatagram.From;
+        }
+        const auto theLength = std::min<std::size_t>(theSize, theDatagram.Bytes.size());
+        memcpy(theBuffer, theDatagram.Bytes.data(), theLength);
+        return static_cast<nsapi_size_or_error_t>(theLength);
+    }
+
+    SocketAddress GetLocalAddress() const { return SocketAddress(NetworkInterface::HOST_LOOPBACK_ADDRESS, m_ThePort); }
+    std::size_t GetPendingCount() const { return m_TheInbox.size(); }
+    std::size_t GetSentCount() const { return m_TheSentCount; }
+
+private:
+    struct Datagram_t
+    {
+        SocketAddress        From;
+        std::vector<uint8_t> Bytes;
+    };
+
+    static std::map<uint16_t, UDPSocket *> & Routes() { static std::map<uint16_t, UDPSocket *> theRoutes; return theRoutes; }
+
+    static uint16_t NextEphemeralPort()
+    {
+        static uint16_t theNext = 49152;
+        while (Routes().count(theNext) != 0)
+        {
+            ++theNext;
+        }
+        return theNext++;
+    }
+
+    std::deque<Datagram_t> m_TheInbox;
+    uint16_t               m_ThePort = 0;
+    std::size_t            m_TheSentCount = 0;
+};
+
+class TCPServer;
+
+class TCPSocket : public Socket
+{
+public:
+    virtual ~TCPSocket() { close(); }
+
+    nsapi_error_t open(NetworkInterface * pTheInterface)
+    {
+        return (pTheInterface != nullptr) ? NSAPI_ERROR_OK : NSAPI_ERROR_PARAMETER;
+    }
+
+    inline nsapi_error_t connect(const SocketAddress & theServer);
+
+    nsapi_size_or_error_t send(const void * theData, unsigned theSize)
+    {
+        if (!m_pTheConnection || m_pTheConnection->IsClosed[1 - m_TheEnd])
+        {
+            return NSAPI_ERROR_NO_CONNECTION;
+        }
+
+        const auto pTheBytes = static_cast<const uint8_t *>(theData);
+        auto & theInbox = m_pTheConnection->Inbox[1 - m_TheEnd];
+        theInbox.insert(theInbox.end(), pTheBytes, pTheBytes + theSize);
+        return static_cast<nsapi_size_or_error_t>(theSize);
+    }
+
+    // 0 once the peer has closed and everything it sent has been read.
+    nsapi_size_or_error_t recv(void * theBuffer, unsigned theSize)
+    {
+        if (!m_pTheConnection)
+        {
+            return NSAPI_ERROR_NO_CONNECTION;
+        }
+
+        auto & theInbox = m_pTheConnection->Inbox[m_TheEnd];
+        if (theInbox.empty())
+        {
+            return m_pTheConnection->IsClosed[1 - m_TheEnd] ? 0 : NSAPI_ERROR_WOULD_BLOCK;
+        }
+
+        const auto theLength = std::min<std::size_t>(theSize, theInbox.size());
+        std::copy(theInbox.begin(), theInbox.begin() + theLength, static_cast<uint8_t *>(theBuffer));
+        theInbox.erase(theInbox.begin(), theInbox.begin() + theLength);
+        return static_cast<nsapi_size_or_error_t>(theLength);
+    }
+
+    nsapi_error_t close()
+    {
+        if (m_pTheConnection)
+        {
+            m_pTheConnection->IsClosed[m_TheEnd] = true;
+            m_pTheConnection.reset();
+        }
+        return NSAPI_ERROR_OK;
+    }
+
+private:
+    friend class TCPServer;
+
+    struct Connection_t
+    {
+        std::vector<uint8_t> Inbox[2];          // Indexed by the receiving end.
+        bool                 IsClosed[2] = { false, false };
+    };
+
+    std::shared_ptr<Connection_t> m_pTheConnection;
+    std::size_t                   m_TheEnd = 0;  // 0 for the client, 1 for the server's end.
+};
+
+class TCPServer : public Socket
+{
+public:
+    virtual ~TCPServer() { close(); }
+
+    nsapi_error_t open(NetworkInterface * pTheInterface)
+    {
+        return (pTheInterface != nullptr) ? NSAPI_ERROR_OK : NSAPI_ERROR_PARAMETER;
+    }
+
+    nsapi_error_t bind(uint16_t thePort)
+    {
+        if (Listeners().count(thePort) != 0)
+        {
+            return NSAPI_ERROR_ADDRESS_IN_USE;
+        }
+        m_ThePort = thePort;
+        return NSAPI_ERROR_OK;
+    }
+
+    nsapi_error_t listen(int = 1)
+    {
+        Listeners()[m_ThePort] = this;
+        return NSAPI_ERROR_OK;
+    }
+
+    nsapi_error_t accept(TCPSocket * pTheConnection, SocketAddress * pThePeer = nullptr)
+    {
+        if (m_TheBacklog.empty())
+        {
+            return NSAPI_ERROR_WOULD_BLOCK;
+        }
+
+        pTheConnection->close();
+        pTheConnection->m_pTheConnection = m_TheBacklog.front();
+        pTheConnection->m_TheEnd = 1;
+        m_TheBacklog.pop_front();
+
+        if (pThePeer != nullptr)
+        {
+            *pThePeer = SocketAddress(NetworkInterface::HOST_LOOPBACK_ADDRESS, 0);
+        }
+        return NSAPI_ERROR_OK;
+    }
+
+    nsapi_error_t close()
+    {
+        auto theListener = Listeners().find(m_ThePort);
+        if ((theListener != Listeners().end()) && (theListener->second == this))
+        {
+            Listeners().erase(theListener);
+        }
+        m_TheBacklog.clear();
+        return NSAPI_ERROR_OK;
+    }
+
+private:
+    friend class TCPSocket;
+
+    static std::map<uint16_t, TCPServer *> & Listeners() { static std::map<uint16_t, TCPServer *> theListeners; return theListeners; }
+
+    std::deque<std::shared_ptr<TCPSocket::Connection_t>> m_TheBacklog;
+    uint16_t                                             m_ThePort = 0;
+};
+
+inline nsapi_error_t TCPSocket::connect(const SocketAddress & theServer)
+{
+    auto theListener = TCPServer::Listeners().find(theServer.get_port());
+    if (theListener == TCPServer::Listeners().end())
+    {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    close();
+    m_pTheConnection = std::make_shared<Connection_t>();
+    m_TheEnd = 0;
+    theListener->second->m_TheBacklog.push_back(m_pTheConnection);
+    theListener->second->RaiseSigio();
+    return NSAPI_ERROR_OK;
+}